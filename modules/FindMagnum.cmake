@@ -720,7 +720,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL Primitives)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
-        # No special setup for SceneGraph library
+        # SceneGraph library
+        elseif(_component STREQUAL SceneGraph)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
         # No special setup for Shaders library
         # No special setup for Shapes library
 
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+#             Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+#
+
+# Converts output of Corrade::TestSuite::Tester benchmarks to JSON so the
+# results can be tracked over time. Usage:
+#
+#   ./MathMatrixBenchmark | ./benchmarks-to-json.py MathMatrixBenchmark
+#   ./benchmarks-to-json.py MathMatrixBenchmark < output.txt > output.json
+#
+# Lines other than BENCH results are ignored, the script exits with a non-zero
+# code if the output contains test failures or no benchmark results at all.
+
+import argparse
+import json
+import re
+import sys
+
+# ANSI color escape sequences, present with CORRADE_TEST_COLOR=ON
+ansi_re = re.compile(r'\x1b\[[0-9;]*m')
+
+#  BENCH [01]   14.52 ± 0.51   ns benchmark()@49x1000000 (wall time)
+bench_re = re.compile(r'^\s*BENCH \[(?P<index>\d+)\]\s+'
+                      r'(?P<value>[0-9.]+)(?:\s*(?:±|\+-)\s*(?P<deviation>[0-9.]+))?\s+'
+                      r'(?P<unit>\S+)\s+'
+                      r'(?P<name>[^\s(@]+)\(\)'
+                      r'(?:@(?P<batches>\d+)x(?P<iterations>\d+))?'
+                      r'(?:\s+\((?P<type>[^)]+)\))?')
+
+fail_re = re.compile(r'^\s*(FAIL|THROW|XPASS)\b')
+
+def parse(lines):
+    results = []
+    failed = False
+    for line in lines:
+        line = ansi_re.sub('', line)
+        if fail_re.match(line):
+            failed = True
+            continue
+
+        match = bench_re.match(line)
+        if not match: continue
+
+        result = {
+            'index': int(match.group('index')),
+            'name': match.group('name'),
+            'value': float(match.group('value')),
+            'unit': match.group('unit')
+        }
+        if match.group('deviation') is not None:
+            result['deviation'] = float(match.group('deviation'))
+        if match.group('batches') is not None:
+            result['batches'] = int(match.group('batches'))
+            result['iterations'] = int(match.group('iterations'))
+        if match.group('type') is not None:
+            result['type'] = match.group('type')
+        results += [result]
+
+    return results, failed
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Convert Corrade benchmark output to JSON")
+    parser.add_argument('suite', help="benchmark suite name to put in the output")
+    parser.add_argument('--commit', help="commit hash to put in the output")
+    args = parser.parse_args()
+
+    results, failed = parse(sys.stdin)
+
+    out = {'suite': args.suite, 'benchmarks': results}
+    if args.commit: out['commit'] = args.commit
+    json.dump(out, sys.stdout, indent=2, ensure_ascii=False)
+    sys.stdout.write('\n')
+
+    if failed:
+        sys.stderr.write("{}: the output contains test failures\n".format(args.suite))
+        sys.exit(1)
+    if not results:
+        sys.stderr.write("{}: no benchmark results found\n".format(args.suite))
+        sys.exit(1)
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+#             Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+#
+
+# Compares two JSON files produced by benchmarks-to-json.py, usually results
+# of the same suite built from the base commit and from the tested commit and
+# run on the same machine. Usage:
+#
+#   ./compare-benchmarks.py baseline.json current.json
+#   ./compare-benchmarks.py baseline.json current.json --threshold 1.5
+#
+# Prints a table with ratios of all benchmarks present in both files and exits
+# with a non-zero code if any of them got slower than the threshold. Since the
+# measurements are noisy, a difference smaller than the sum of standard
+# deviations is never considered a regression.
+
+import argparse
+import json
+import sys
+
+def compare(baseline, current, threshold):
+    baseline_results = {}
+    for result in baseline['benchmarks']:
+        baseline_results[result['name']] = result
+
+    regressions = []
+    rows = []
+    for result in current['benchmarks']:
+        name = result['name']
+        if name not in baseline_results:
+            rows += [(name, None, result['value'], None, result['unit'], "new")]
+            continue
+
+        base = baseline_results[name]
+        if base['unit'] != result['unit'] or not base['value']:
+            rows += [(name, base['value'], result['value'], None, result['unit'], "incomparable")]
+            continue
+
+        ratio = result['value']/base['value']
+        deviation = base.get('deviation', 0.0) + result.get('deviation', 0.0)
+        if ratio > threshold and result['value'] - base['value'] > deviation:
+            regressions += [name]
+            status = "REGRESSION"
+        else: status = ""
+        rows += [(name, base['value'], result['value'], ratio, result['unit'], status)]
+
+    return rows, regressions
+
+def format_value(value):
+    return "-" if value is None else "{:.2f}".format(value)
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Compare two benchmark JSON files")
+    parser.add_argument('baseline', help="results of the base commit")
+    parser.add_argument('current', help="results of the tested commit")
+    parser.add_argument('--threshold', type=float, default=1.25, help="slowdown ratio considered a regression (default: %(default)s)")
+    args = parser.parse_args()
+
+    with open(args.baseline) as f: baseline = json.load(f)
+    with open(args.current) as f: current = json.load(f)
+
+    rows, regressions = compare(baseline, current, args.threshold)
+
+    print("{}:".format(current['suite']))
+    for name, base, value, ratio, unit, status in rows:
+        ratio = "-" if ratio is None else "{:.2f}x".format(ratio)
+        print("  {:<40} {:>12} {:>12} {:>2} {:>7} {}".format(name, format_value(base), format_value(value), unit, ratio, status).rstrip())
+
+    if regressions:
+        sys.stderr.write("{}: {} benchmark(s) slower than {}x the baseline: {}\n".format(current['suite'], len(regressions), args.threshold, ', '.join(regressions)))
+        sys.exit(1)
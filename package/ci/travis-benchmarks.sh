@@ -0,0 +1,69 @@
+#!/bin/bash
+set -ev
+
+# Benchmarks are built in Release and only in this job, timings from debug,
+# sanitizer or coverage builds are meaningless. The same benchmarks are built
+# also from the parent commit (which is the target branch for pull requests)
+# and both are run alternately on the same machine, so the comparison isn't
+# affected by differences between CI machines.
+BENCHMARKS="MathMatrixBenchmark MathQuaternionBenchmark MathFrustumBenchmark MathColorBenchmark"
+
+# Corrade
+git clone --depth 1 git://github.com/mosra/corrade.git
+cd corrade
+mkdir build && cd build
+cmake .. \
+    -DCMAKE_INSTALL_PREFIX=$HOME/deps \
+    -DCMAKE_INSTALL_RPATH=$HOME/deps/lib \
+    -DCMAKE_BUILD_TYPE=Release \
+    -DWITH_INTERCONNECT=OFF \
+    -DWITH_PLUGINMANAGER=OFF \
+    -G Ninja
+ninja install
+cd ../..
+
+# Sources of the parent commit
+mkdir baseline
+git archive HEAD^ | tar -x -C baseline
+
+for source in . baseline; do
+    mkdir $source/build-benchmarks && cd $source/build-benchmarks
+    cmake .. \
+        -DCMAKE_PREFIX_PATH=$HOME/deps \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DWITH_AUDIO=OFF \
+        -DWITH_DEBUGTOOLS=OFF \
+        -DWITH_GL=OFF \
+        -DWITH_MESHTOOLS=OFF \
+        -DWITH_PRIMITIVES=OFF \
+        -DWITH_SCENEGRAPH=OFF \
+        -DWITH_SHADERS=OFF \
+        -DWITH_SHAPES=OFF \
+        -DWITH_TEXT=OFF \
+        -DWITH_TEXTURETOOLS=OFF \
+        -DWITH_TRADE=OFF \
+        -DBUILD_TESTS=ON \
+        -G Ninja
+    # The parent commit might not have all benchmarks yet
+    for benchmark in $BENCHMARKS; do
+        ninja $benchmark || [ "$source" == "baseline" ]
+    done
+    cd $TRAVIS_BUILD_DIR
+done
+
+mkdir -p benchmarks
+for benchmark in $BENCHMARKS; do
+    ./build-benchmarks/src/Magnum/Math/Test/$benchmark | ./package/ci/benchmarks-to-json.py $benchmark --commit $TRAVIS_COMMIT > benchmarks/$benchmark.json
+    if [ -e baseline/build-benchmarks/src/Magnum/Math/Test/$benchmark ]; then
+        ./baseline/build-benchmarks/src/Magnum/Math/Test/$benchmark | ./package/ci/benchmarks-to-json.py $benchmark > benchmarks/$benchmark-baseline.json
+    fi
+done
+
+# Compare only after everything was run, so all results are in the log
+status=0
+for benchmark in $BENCHMARKS; do
+    if [ -e benchmarks/$benchmark-baseline.json ]; then
+        ./package/ci/compare-benchmarks.py benchmarks/$benchmark-baseline.json benchmarks/$benchmark.json || status=1
+    fi
+done
+exit $status
@@ -171,6 +171,8 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
 
         Matrix4 _soundTransform;
         Float _gain;
+        /* Reused by setClean() to avoid allocations on every call */
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _objects;
 };
 
 template<UnsignedInt dimensions> inline PlayableGroup<dimensions>& PlayableGroup<dimensions>::setSoundTransformation(const Matrix4& matrix) {
@@ -186,13 +188,11 @@ template<UnsignedInt dimensions> inline PlayableGroup<dimensions>& PlayableGroup
 }
 
 template<UnsignedInt dimensions> inline void PlayableGroup<dimensions>::setClean() {
-    std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
-    objects.reserve(this->size());
-
+    _objects.clear();
     for(UnsignedInt i = 0; i < this->size(); ++i)
-        objects.push_back((*this)[i].object());
+        _objects.push_back((*this)[i].object());
 
-    SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+    SceneGraph::AbstractObject<dimensions, Float>::setClean(_objects);
 }
 
 /**
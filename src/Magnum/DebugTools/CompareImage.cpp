@@ -192,7 +192,7 @@ std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView
 
     /* Calculate mean delta. Do it the special way so we don't lose
        precision -- that would result in having false negatives! */
-    const Float mean = Math::Algorithms::kahanSum(delta.begin(), delta.end())/delta.size();
+    const Float mean = Math::Algorithms::mean(Containers::ArrayView<const Float>{delta.data(), delta.size()});
 
     return std::make_tuple(delta, max, mean);
 }
@@ -0,0 +1,107 @@
+#ifndef Magnum_Math_Algorithms_FlattenBezier_h
+#define Magnum_Math_Algorithms_FlattenBezier_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::flattenBezier(), @ref Magnum::Math::Algorithms::flattenBezierInto()
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "Magnum/Math/Bezier.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace Implementation {
+
+/* Vector size is std::size_t while Bezier dimensions are UnsignedInt, so the
+   output vector can't take part in template argument deduction */
+template<UnsignedInt order, UnsignedInt dimensions, class T> void flattenBezierInto(const Bezier<order, dimensions, T>& curve, const T toleranceSquared, std::vector<Vector<std::size_t(dimensions), T>>& out, const UnsignedInt depth) {
+    /* Max squared distance of inner control points from the chord */
+    const Vector<dimensions, T> chord = curve[order] - curve[0];
+    const T chordLengthSquared = chord.dot();
+    bool flat = true;
+    for(std::size_t i = 1; i < order; ++i) {
+        const Vector<dimensions, T> d = curve[i] - curve[0];
+        const T t = chordLengthSquared == T(0) ? T(0) :
+            std::min(std::max(Math::dot(d, chord)/chordLengthSquared, T(0)), T(1));
+        if((d - chord*t).dot() > toleranceSquared) {
+            flat = false;
+            break;
+        }
+    }
+
+    if(flat || !depth) {
+        out.push_back(curve[order]);
+        return;
+    }
+
+    const std::pair<Bezier<order, dimensions, T>, Bezier<order, dimensions, T>> halves = curve.subdivide(0.5f);
+    flattenBezierInto(halves.first, toleranceSquared, out, depth - 1);
+    flattenBezierInto(halves.second, toleranceSquared, out, depth - 1);
+}
+
+}
+
+/**
+@brief Append a polyline approximation of a Bézier curve to a list
+@param[in] curve        Curve to flatten
+@param[in] tolerance    Max distance of the polyline from the curve
+@param[out] out         Where to append the points
+
+Same as @ref flattenBezier(), but appends the points to @p out and doesn't add
+the first control point, so a path consisting of many curves sharing end
+points can be flattened without duplicate points and without allocating a new
+list for each curve.
+*/
+template<UnsignedInt order, UnsignedInt dimensions, class T> void flattenBezierInto(const Bezier<order, dimensions, T>& curve, const T tolerance, std::vector<Vector<std::size_t(dimensions), T>>& out) {
+    Implementation::flattenBezierInto(curve, tolerance*tolerance, out, 16);
+}
+
+/**
+@brief Approximate a Bézier curve with a polyline
+@param curve        Curve to flatten
+@param tolerance    Max distance of the polyline from the curve
+
+Adaptively subdivides the curve in half until all control points of each part
+are closer than @p tolerance to the line connecting its end points. As the
+curve lies in the convex hull of its control points, the resulting polyline is
+then never farther than @p tolerance from the curve. Flat parts of the curve
+result in just a few points, while parts with high curvature are subdivided
+more. The subdivision depth is limited to 16 levels, giving at most 65537
+points. The returned list contains both end points.
+@see @ref flattenBezierInto()
+*/
+template<UnsignedInt order, UnsignedInt dimensions, class T> std::vector<Vector<dimensions, T>> flattenBezier(const Bezier<order, dimensions, T>& curve, const T tolerance) {
+    std::vector<Vector<dimensions, T>> out{curve[0]};
+    flattenBezierInto(curve, tolerance, out);
+    return out;
+}
+
+}}}
+
+#endif
@@ -26,10 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Math::Algorithms::kahanSum()
+ * @brief Function @ref Magnum::Math::Algorithms::kahanSum(), @ref Magnum::Math::Algorithms::kahanSumBlocksInto(), @ref Magnum::Math::Algorithms::mean(), @ref Magnum::Math::Algorithms::kahanDot(), @ref Magnum::Math::Algorithms::kahanDotBlocksInto(), @ref Magnum::Math::Algorithms::minmax()
  */
 
+#include <algorithm>
 #include <utility>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
 
 namespace Magnum { namespace Math { namespace Algorithms {
 
@@ -82,6 +85,251 @@ template<class Iterator, class T = typename std::decay<decltype(*std::declval<It
     return sum;
 }
 
+/**
+@brief Size of a block in batch reductions
+
+The array reduction functions such as @ref kahanSum(Corrade::Containers::ArrayView<const T>)
+split the input into blocks of this many items, calculate a partial result for
+each block and then combine the partial results in order. The result thus
+doesn't depend on how the blocks are distributed among threads. See
+@ref kahanSumBlocksInto() for an example.
+*/
+enum: std::size_t { ReductionBlockSize = 4096 };
+
+namespace Implementation {
+
+/* Count of independent accumulators in the block reduction. Each is
+   compensated separately, so the compiler can vectorize the loop without
+   reassociating floating-point operations. */
+enum: std::size_t { ReductionLanes = 8 };
+
+/* Accessors for contiguous and strided data, the stride is in bytes */
+template<class T> struct ContiguousAccess {
+    T operator()(std::size_t i) const { return data[i]; }
+    const T* data;
+};
+
+template<class T> struct StridedAccess {
+    T operator()(std::size_t i) const {
+        return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(data) + std::ptrdiff_t(i)*stride);
+    }
+    const T* data;
+    std::ptrdiff_t stride;
+};
+
+template<class T, class A, class B> struct ProductAccess {
+    T operator()(std::size_t i) const { return a(i)*b(i); }
+    A a;
+    B b;
+};
+
+/* Kahan sum of at most ReductionBlockSize items from given offset */
+template<class T, class Access> T kahanSumBlock(const Access& access, const std::size_t begin, const std::size_t end) {
+    T sum[ReductionLanes]{}, c[ReductionLanes]{};
+    std::size_t i = begin;
+    for(; i + ReductionLanes <= end; i += ReductionLanes) {
+        for(std::size_t l = 0; l != ReductionLanes; ++l) {
+            const T y = access(i + l) - c[l];
+            const T t = sum[l] + y;
+            c[l] = (t - sum[l]) - y;
+            sum[l] = t;
+        }
+    }
+    for(std::size_t l = 0; i != end; ++i, ++l) {
+        const T y = access(i) - c[l];
+        const T t = sum[l] + y;
+        c[l] = (t - sum[l]) - y;
+        sum[l] = t;
+    }
+
+    /* Combine the lanes, including their remaining compensation */
+    T total = T(0), totalC = T(0);
+    for(std::size_t l = 0; l != ReductionLanes; ++l) {
+        const T lane = sum[l] - c[l];
+        total = kahanSum(&lane, &lane + 1, total, &totalC);
+    }
+    return total;
+}
+
+template<class T, class Access> T kahanSumBlocks(const Access& access, const std::size_t size) {
+    T sum = T(0), c = T(0);
+    for(std::size_t i = 0; i < size; i += ReductionBlockSize) {
+        const T block = kahanSumBlock<T>(access, i, std::min(i + ReductionBlockSize, size));
+        sum = kahanSum(&block, &block + 1, sum, &c);
+    }
+    return sum;
+}
+
+template<class T, class Access> void kahanSumBlocksInto(const Access& access, const std::size_t size, T* const out) {
+    for(std::size_t i = 0, block = 0; i < size; i += ReductionBlockSize, ++block)
+        out[block] = kahanSumBlock<T>(access, i, std::min(i + ReductionBlockSize, size));
+}
+
+template<class T, class Access> std::pair<T, T> minmax(const Access& access, const std::size_t size) {
+    if(!size) return {T(0), T(0)};
+
+    T min[ReductionLanes], max[ReductionLanes];
+    for(std::size_t l = 0; l != ReductionLanes; ++l)
+        min[l] = max[l] = access(0);
+
+    std::size_t i = 0;
+    for(; i + ReductionLanes <= size; i += ReductionLanes) {
+        for(std::size_t l = 0; l != ReductionLanes; ++l) {
+            const T value = access(i + l);
+            min[l] = value < min[l] ? value : min[l];
+            max[l] = value > max[l] ? value : max[l];
+        }
+    }
+    for(std::size_t l = 0; i != size; ++i, ++l) {
+        const T value = access(i);
+        min[l] = value < min[l] ? value : min[l];
+        max[l] = value > max[l] ? value : max[l];
+    }
+
+    for(std::size_t l = 1; l != ReductionLanes; ++l) {
+        min[0] = min[l] < min[0] ? min[l] : min[0];
+        max[0] = max[l] > max[0] ? max[l] : max[0];
+    }
+    return {min[0], max[0]};
+}
+
+}
+
+/**
+@brief Kahan summation of an array
+
+Unlike @ref kahanSum(Iterator, Iterator, T, T*), which processes the values
+one after another, this splits the array into blocks of
+@ref ReductionBlockSize items and sums each block using eight independently
+compensated accumulators, allowing the compiler to vectorize the loop without
+sacrificing precision. The block sums are then Kahan-summed in order. The
+result is deterministic and equal to what's calculated by combining the
+output of @ref kahanSumBlocksInto().
+@see @ref mean(), @ref kahanDot()
+*/
+template<class T> T kahanSum(Corrade::Containers::ArrayView<const T> values) {
+    return Implementation::kahanSumBlocks<T>(Implementation::ContiguousAccess<T>{values.data()}, values.size());
+}
+
+/**
+@overload
+
+Sums @p size values starting at @p data, each @p stride bytes apart. Useful
+for example for summing a single component of interleaved vertex data. Like
+in all strided overloads in this header, each pointer is directly followed by
+its stride and the item count is last.
+*/
+template<class T> T kahanSum(const T* data, std::ptrdiff_t stride, std::size_t size) {
+    return Implementation::kahanSumBlocks<T>(Implementation::StridedAccess<T>{data, stride}, size);
+}
+
+/**
+@brief Kahan sums of array blocks
+
+Calculates sums of consecutive blocks of @ref ReductionBlockSize items. Size
+of @p blockSums is expected to be
+@cpp (values.size() + ReductionBlockSize - 1)/ReductionBlockSize @ce.
+Summing the output with @ref kahanSum(Iterator, Iterator, T, T*) gives the
+same result as @ref kahanSum(Corrade::Containers::ArrayView<const T>) on the
+whole array. This can be used to distribute a large reduction among multiple
+threads, while keeping the result bit-exact regardless of thread count:
+
+@code{.cpp}
+Containers::ArrayView<const Float> values;
+const std::size_t blockCount = (values.size() + Math::Algorithms::ReductionBlockSize - 1)/Math::Algorithms::ReductionBlockSize;
+Containers::Array<Float> blockSums{blockCount};
+
+// each thread processes a contiguous range of blocks
+const std::size_t blocksPerThread = (blockCount + threadCount - 1)/threadCount;
+std::size_t begin = threadId*blocksPerThread, end = std::min(begin + blocksPerThread, blockCount);
+Math::Algorithms::kahanSumBlocksInto(
+    values.slice(begin*Math::Algorithms::ReductionBlockSize, std::min(end*Math::Algorithms::ReductionBlockSize, values.size())),
+    blockSums.slice(begin, end));
+
+// after all threads are done
+Float sum = Math::Algorithms::kahanSum(blockSums.begin(), blockSums.end());
+@endcode
+*/
+template<class T> void kahanSumBlocksInto(Corrade::Containers::ArrayView<const T> values, Corrade::Containers::ArrayView<T> blockSums) {
+    CORRADE_ASSERT(blockSums.size() == (values.size() + ReductionBlockSize - 1)/ReductionBlockSize,
+        "Math::Algorithms::kahanSumBlocksInto(): expected" << (values.size() + ReductionBlockSize - 1)/ReductionBlockSize << "block sums but got" << blockSums.size(), );
+    Implementation::kahanSumBlocksInto(Implementation::ContiguousAccess<T>{values.data()}, values.size(), blockSums.data());
+}
+
+/**
+@brief Mean of an array
+
+Calculated as @ref kahanSum(Corrade::Containers::ArrayView<const T>) divided
+by the array size. For an empty array the result is NaN.
+*/
+template<class T> T mean(Corrade::Containers::ArrayView<const T> values) {
+    return kahanSum(values)/T(values.size());
+}
+
+/**
+@overload
+
+Averages @p size values starting at @p data, each @p stride bytes apart.
+*/
+template<class T> T mean(const T* data, std::ptrdiff_t stride, std::size_t size) {
+    return kahanSum(data, stride, size)/T(size);
+}
+
+/**
+@brief Dot product of two arrays
+
+Sums products of corresponding items using the same blocked algorithm as
+@ref kahanSum(Corrade::Containers::ArrayView<const T>). Sizes of both arrays
+are expected to be the same.
+@see @ref kahanDotBlocksInto()
+*/
+template<class T> T kahanDot(Corrade::Containers::ArrayView<const T> a, Corrade::Containers::ArrayView<const T> b) {
+    CORRADE_ASSERT(a.size() == b.size(),
+        "Math::Algorithms::kahanDot(): expected arrays of the same size, got" << a.size() << "and" << b.size(), {});
+    return Implementation::kahanSumBlocks<T>(Implementation::ProductAccess<T, Implementation::ContiguousAccess<T>, Implementation::ContiguousAccess<T>>{{a.data()}, {b.data()}}, a.size());
+}
+
+/**
+@overload
+
+Multiplies @p size values starting at @p a and @p b, each @p strideA and
+@p strideB bytes apart.
+*/
+template<class T> T kahanDot(const T* a, std::ptrdiff_t strideA, const T* b, std::ptrdiff_t strideB, std::size_t size) {
+    return Implementation::kahanSumBlocks<T>(Implementation::ProductAccess<T, Implementation::StridedAccess<T>, Implementation::StridedAccess<T>>{{a, strideA}, {b, strideB}}, size);
+}
+
+/**
+@brief Dot products of array blocks
+
+Counterpart to @ref kahanSumBlocksInto() for @ref kahanDot(). Sizes of
+@p a and @p b are expected to be the same, size of @p blockSums is expected
+to be @cpp (a.size() + ReductionBlockSize - 1)/ReductionBlockSize @ce.
+*/
+template<class T> void kahanDotBlocksInto(Corrade::Containers::ArrayView<const T> a, Corrade::Containers::ArrayView<const T> b, Corrade::Containers::ArrayView<T> blockSums) {
+    CORRADE_ASSERT(a.size() == b.size(),
+        "Math::Algorithms::kahanDotBlocksInto(): expected arrays of the same size, got" << a.size() << "and" << b.size(), );
+    CORRADE_ASSERT(blockSums.size() == (a.size() + ReductionBlockSize - 1)/ReductionBlockSize,
+        "Math::Algorithms::kahanDotBlocksInto(): expected" << (a.size() + ReductionBlockSize - 1)/ReductionBlockSize << "block sums but got" << blockSums.size(), );
+    Implementation::kahanSumBlocksInto(Implementation::ProductAccess<T, Implementation::ContiguousAccess<T>, Implementation::ContiguousAccess<T>>{{a.data()}, {b.data()}}, a.size(), blockSums.data());
+}
+
+/**
+@brief Minimum and maximum of a strided array
+
+Processes @p size values starting at @p data, each @p stride bytes apart, for
+example a single component of vertex positions in an interleaved buffer. For
+contiguous arrays use @ref Math::minmax(Corrade::Containers::ArrayView<const T>).
+Uses multiple independent accumulators so the loop can be vectorized. NaN
+values are ignored unless they're the first item. For an empty array returns
+a pair of zeros. As the minimum and maximum don't depend on order, the array
+can be split into arbitrary parts processed on different threads and the
+results combined using @ref Math::min() and @ref Math::max().
+*/
+template<class T> std::pair<T, T> minmax(const T* data, std::ptrdiff_t stride, std::size_t size) {
+    return Implementation::minmax<T>(Implementation::StridedAccess<T>{data, stride}, size);
+}
+
 }}}
 
 #endif
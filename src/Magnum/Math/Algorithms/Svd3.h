@@ -0,0 +1,347 @@
+#ifndef Magnum_Math_Algorithms_Svd3_h
+#define Magnum_Math_Algorithms_Svd3_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::eigenSymmetric3(), @ref Magnum::Math::Algorithms::svd3(), @ref Magnum::Math::Algorithms::eigenSymmetric3Into(), @ref Magnum::Math::Algorithms::svd3Into()
+ */
+
+#include <limits>
+#include <tuple>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/FunctionsFast.h"
+#include "Magnum/Math/Matrix.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace Implementation {
+
+/* Count of matrices processed at once by the batch variants. All operations
+   are done on this many independent values in a loop, allowing the compiler
+   to pipeline or vectorize them. */
+enum: std::size_t { Svd3BatchSize = 8 };
+
+/* Fixed count of Jacobi sweeps. The method converges quadratically, these
+   are enough to get the off-diagonal elements down to the type epsilon for
+   any input. */
+template<class T> struct JacobiSweeps;
+template<> struct JacobiSweeps<Float> { enum: std::size_t { Value = 4 }; };
+template<> struct JacobiSweeps<Double> { enum: std::size_t { Value = 4 }; };
+
+/* Inverse square root used for normalizing the rotations. For floats the
+   fast approximation with three Newton-Raphson iterations is precise enough
+   and, unlike std::sqrt() that has to handle errno, can be vectorized. */
+template<class T> inline T jacobiSqrtInverted(T value) {
+    return T(1)/std::sqrt(value);
+}
+template<> inline Float jacobiSqrtInverted<Float>(Float value) {
+    return sqrtInvertedFast<3>(value);
+}
+
+/* Jacobi rotation zeroing out apq, rotating also the remaining off-diagonal
+   elements arp, arq and eigenvector columns vp, vq. Calculated without
+   branches, the square root argument is nudged away from zero so apq == 0
+   results in an identity rotation. Based on Press, W. H. et al. (2007). "Numerical
+   Recipes", section 11.1. */
+template<std::size_t lanes, class T> inline void jacobiRotation(T(&app)[lanes], T(&aqq)[lanes], T(&apq)[lanes], T(&arp)[lanes], T(&arq)[lanes], T(&vp)[3][lanes], T(&vq)[3][lanes]) {
+    for(std::size_t l = 0; l != lanes; ++l) {
+        const T tau = aqq[l] - app[l];
+        const T sign = tau < T(0) ? T(-1) : T(1);
+        const T q = tau*tau + T(4)*apq[l]*apq[l] + std::numeric_limits<T>::min();
+        const T t = T(2)*apq[l]*sign/(std::abs(tau) + q*jacobiSqrtInverted(q));
+        const T c = jacobiSqrtInverted(T(1) + t*t);
+        const T s = t*c;
+
+        app[l] -= t*apq[l];
+        aqq[l] += t*apq[l];
+        apq[l] = T(0);
+
+        const T rp = arp[l];
+        arp[l] = c*rp - s*arq[l];
+        arq[l] = s*rp + c*arq[l];
+
+        for(std::size_t k = 0; k != 3; ++k) {
+            const T p = vp[k][l];
+            vp[k][l] = c*p - s*vq[k][l];
+            vq[k][l] = s*p + c*vq[k][l];
+        }
+    }
+}
+
+/* Swaps eigenvalues i and j together with their vectors if value i is
+   smaller, negating one of the vectors to keep the matrix a rotation */
+template<std::size_t lanes, class T> inline void sortSwap(T(&valueI)[lanes], T(&valueJ)[lanes], T(&vectorI)[3][lanes], T(&vectorJ)[3][lanes]) {
+    for(std::size_t l = 0; l != lanes; ++l) {
+        const bool swap = valueI[l] < valueJ[l];
+        const T vi = valueI[l];
+        const T vj = valueJ[l];
+        valueI[l] = swap ? vj : vi;
+        valueJ[l] = swap ? vi : vj;
+        for(std::size_t k = 0; k != 3; ++k) {
+            const T a = vectorI[k][l];
+            const T b = vectorJ[k][l];
+            vectorI[k][l] = swap ? b : a;
+            vectorJ[k][l] = swap ? -a : b;
+        }
+    }
+}
+
+/* Givens rotation zeroing out b in a column of m, row j, against a in row i
+   of the same column. Applied to rows of m and accumulated into columns of
+   u. Degenerate case of both being zero results in an identity rotation. */
+template<std::size_t lanes, class T> inline void givensRotation(T(&m)[3][3][lanes], T(&u)[3][3][lanes], std::size_t column, std::size_t i, std::size_t j) {
+    for(std::size_t l = 0; l != lanes; ++l) {
+        const T a = m[column][i][l];
+        const T b = m[column][j][l];
+        const T rhoSquared = a*a + b*b;
+        /* Selecting only between constants, otherwise GCC refuses to
+           vectorize the loop */
+        const T valid = rhoSquared > std::numeric_limits<T>::min() ? T(1) : T(0);
+        const T invRho = jacobiSqrtInverted(rhoSquared + (T(1) - valid));
+        const T c = a*invRho*valid + (T(1) - valid);
+        const T s = b*invRho*valid;
+
+        for(std::size_t k = 0; k != 3; ++k) {
+            const T mi = m[k][i][l];
+            const T mj = m[k][j][l];
+            m[k][i][l] = c*mi + s*mj;
+            m[k][j][l] = c*mj - s*mi;
+
+            const T ui = u[i][k][l];
+            const T uj = u[j][k][l];
+            u[i][k][l] = c*ui + s*uj;
+            u[j][k][l] = c*uj - s*ui;
+        }
+    }
+}
+
+/* Eigendecomposition of given count of symmetric matrices, with the upper
+   triangle stored as a00, a11, a22, a01, a02, a12, and eigenvectors as
+   column, row, lane */
+template<std::size_t lanes, class T> void eigenSymmetric3(T(&a)[6][lanes], T(&v)[3][3][lanes]) {
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            for(std::size_t l = 0; l != lanes; ++l)
+                v[col][row][l] = col == row ? T(1) : T(0);
+
+    for(std::size_t i = 0; i != JacobiSweeps<T>::Value; ++i) {
+        jacobiRotation(a[0], a[1], a[3], a[4], a[5], v[0], v[1]);
+        jacobiRotation(a[0], a[2], a[4], a[3], a[5], v[0], v[2]);
+        jacobiRotation(a[1], a[2], a[5], a[3], a[4], v[1], v[2]);
+    }
+
+    sortSwap(a[0], a[1], v[0], v[1]);
+    sortSwap(a[0], a[2], v[0], v[2]);
+    sortSwap(a[1], a[2], v[1], v[2]);
+}
+
+/* SVD of given count of matrices, stored as column, row, lane */
+template<std::size_t lanes, class T> void svd3(const T(&m)[3][3][lanes], T(&u)[3][3][lanes], T(&w)[3][lanes], T(&v)[3][3][lanes]) {
+    /* Upper triangle of M^T M */
+    T a[6][lanes];
+    constexpr std::size_t columnI[]{0, 1, 2, 0, 0, 1};
+    constexpr std::size_t columnJ[]{0, 1, 2, 1, 2, 2};
+    for(std::size_t i = 0; i != 6; ++i)
+        for(std::size_t l = 0; l != lanes; ++l)
+            a[i][l] = m[columnI[i]][0][l]*m[columnJ[i]][0][l] +
+                      m[columnI[i]][1][l]*m[columnJ[i]][1][l] +
+                      m[columnI[i]][2][l]*m[columnJ[i]][2][l];
+
+    eigenSymmetric3(a, v);
+
+    /* Columns of M V are now orthogonal with lengths being the singular
+       values, QR-decompose them to get U and the signed values */
+    T r[3][3][lanes];
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            for(std::size_t l = 0; l != lanes; ++l) {
+                r[col][row][l] = m[0][row][l]*v[col][0][l] +
+                                 m[1][row][l]*v[col][1][l] +
+                                 m[2][row][l]*v[col][2][l];
+                u[col][row][l] = col == row ? T(1) : T(0);
+            }
+
+    givensRotation(r, u, 0, 0, 1);
+    givensRotation(r, u, 0, 0, 2);
+    givensRotation(r, u, 1, 1, 2);
+
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t l = 0; l != lanes; ++l)
+            w[i][l] = r[i][i][l];
+}
+
+/* Conversion between matrices and the lane layout */
+template<std::size_t lanes, class T> inline void toLanes(const Matrix3x3<T>* matrices, T(&out)[3][3][lanes]) {
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            for(std::size_t l = 0; l != lanes; ++l)
+                out[col][row][l] = matrices[l][col][row];
+}
+
+template<std::size_t lanes, class T> inline void fromLanes(const T(&in)[3][3][lanes], Matrix3x3<T>* matrices) {
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            for(std::size_t l = 0; l != lanes; ++l)
+                matrices[l][col][row] = in[col][row][l];
+}
+
+template<std::size_t lanes, class T> inline void fromLanes(const T(&in)[3][lanes], Vector3<T>* vectors) {
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t l = 0; l != lanes; ++l)
+            vectors[l][i] = in[i][l];
+}
+
+template<std::size_t lanes, class T> void eigenSymmetric3Into(const Matrix3x3<T>* matrices, Matrix3x3<T>* vectors, Vector3<T>* values) {
+    T a[6][lanes];
+    for(std::size_t l = 0; l != lanes; ++l) {
+        a[0][l] = matrices[l][0][0];
+        a[1][l] = matrices[l][1][1];
+        a[2][l] = matrices[l][2][2];
+        a[3][l] = matrices[l][1][0];
+        a[4][l] = matrices[l][2][0];
+        a[5][l] = matrices[l][2][1];
+    }
+
+    T v[3][3][lanes];
+    eigenSymmetric3(a, v);
+
+    fromLanes(v, vectors);
+    for(std::size_t l = 0; l != lanes; ++l)
+        values[l] = {a[0][l], a[1][l], a[2][l]};
+}
+
+template<std::size_t lanes, class T> void svd3Into(const Matrix3x3<T>* matrices, Matrix3x3<T>* u, Vector3<T>* w, Matrix3x3<T>* v) {
+    T m[3][3][lanes], ul[3][3][lanes], wl[3][lanes], vl[3][3][lanes];
+    toLanes(matrices, m);
+    svd3(m, ul, wl, vl);
+    fromLanes(ul, u);
+    fromLanes(wl, w);
+    fromLanes(vl, v);
+}
+
+}
+
+/**
+@brief Eigendecomposition of a symmetric 3x3 matrix
+
+Returns a rotation matrix with eigenvectors in columns and a vector of
+corresponding eigenvalues, sorted from largest to smallest, such that: @f[
+    M = V \Lambda V^T
+@f]
+
+Only the upper triangle of @p m is used, the matrix is expected to be
+symmetric. Unlike the generic @ref svd(), the decomposition is calculated using
+a fixed number of cyclic Jacobi sweeps with no data-dependent branches, making
+it suitable for processing many matrices at once, such as covariance matrices
+when calculating oriented bounding boxes.
+@see @ref eigenSymmetric3Into(), @ref svd3()
+*/
+template<class T> std::pair<Matrix3x3<T>, Vector3<T>> eigenSymmetric3(const Matrix3x3<T>& m) {
+    std::pair<Matrix3x3<T>, Vector3<T>> out{NoInit, NoInit};
+    Implementation::eigenSymmetric3Into<1>(&m, &out.first, &out.second);
+    return out;
+}
+
+/**
+@brief Singular value decomposition of a 3x3 matrix
+
+Returns rotation matrices @f$ U @f$, @f$ V @f$ and a vector of singular values
+such that: @f[
+    M = U \Sigma V^T
+@f]
+
+The singular values are sorted by magnitude from largest to smallest. To
+keep both @f$ U @f$ and @f$ V @f$ rotations, the last singular value is
+negative if @p m has a negative determinant. That makes the result directly
+usable for polar decomposition, where @f$ R = U V^T @f$ is the closest
+rotation to @p m:
+
+@code{.cpp}
+Matrix3x3 u, v;
+Vector3 w;
+std::tie(u, w, v) = Math::Algorithms::svd3(m);
+Matrix3x3 rotation = u*v.transposed();
+@endcode
+
+Calculated by finding eigenvectors of @f$ M^T M @f$ using
+@ref eigenSymmetric3() and then orthogonalizing @f$ M V @f$ with Givens
+rotations, as described in *McAdams, A. et al. (2011). "Computing the Singular
+Value Decomposition of 3x3 matrices with minimal branching and elementary
+floating point operations"*. Compared to the generic @ref svd() there are no
+data-dependent branches and the iteration count is fixed. The precision of
+singular values much smaller than the largest one is limited because the
+condition number gets squared in @f$ M^T M @f$.
+@see @ref svd3Into()
+*/
+template<class T> std::tuple<Matrix3x3<T>, Vector3<T>, Matrix3x3<T>> svd3(const Matrix3x3<T>& m) {
+    std::tuple<Matrix3x3<T>, Vector3<T>, Matrix3x3<T>> out{Matrix3x3<T>{NoInit}, Vector3<T>{NoInit}, Matrix3x3<T>{NoInit}};
+    Implementation::svd3Into<1>(&m, &std::get<0>(out), &std::get<1>(out), &std::get<2>(out));
+    return out;
+}
+
+/**
+@brief Eigendecomposition of an array of symmetric 3x3 matrices
+
+Equivalent to calling @ref eigenSymmetric3() on every item of @p matrices,
+but processes the matrices in groups of eight with each step done on all of
+them at once. As the calculation has no data-dependent branches, this allows
+the compiler to pipeline or vectorize the operations across the matrices.
+Processing of large arrays can be also split into ranges done on multiple
+threads. Sizes of all arrays are expected to be the same.
+*/
+template<class T> void eigenSymmetric3Into(Corrade::Containers::ArrayView<const Matrix3x3<T>> matrices, Corrade::Containers::ArrayView<Matrix3x3<T>> vectors, Corrade::Containers::ArrayView<Vector3<T>> values) {
+    CORRADE_ASSERT(vectors.size() == matrices.size() && values.size() == matrices.size(),
+        "Math::Algorithms::eigenSymmetric3Into(): expected" << matrices.size() << "output items but got" << vectors.size() << "and" << values.size(), );
+    std::size_t i = 0;
+    for(; i + Implementation::Svd3BatchSize <= matrices.size(); i += Implementation::Svd3BatchSize)
+        Implementation::eigenSymmetric3Into<Implementation::Svd3BatchSize>(matrices + i, vectors + i, values + i);
+    for(; i < matrices.size(); ++i)
+        Implementation::eigenSymmetric3Into<1>(matrices + i, vectors + i, values + i);
+}
+
+/**
+@brief Singular value decomposition of an array of 3x3 matrices
+
+Equivalent to calling @ref svd3() on every item of @p matrices, but processes
+the matrices in groups of eight the same way as @ref eigenSymmetric3Into().
+Sizes of all arrays are expected to be the same.
+*/
+template<class T> void svd3Into(Corrade::Containers::ArrayView<const Matrix3x3<T>> matrices, Corrade::Containers::ArrayView<Matrix3x3<T>> u, Corrade::Containers::ArrayView<Vector3<T>> w, Corrade::Containers::ArrayView<Matrix3x3<T>> v) {
+    CORRADE_ASSERT(u.size() == matrices.size() && w.size() == matrices.size() && v.size() == matrices.size(),
+        "Math::Algorithms::svd3Into(): expected" << matrices.size() << "output items but got" << u.size() << Corrade::Utility::Debug::nospace << "," << w.size() << "and" << v.size(), );
+    std::size_t i = 0;
+    for(; i + Implementation::Svd3BatchSize <= matrices.size(); i += Implementation::Svd3BatchSize)
+        Implementation::svd3Into<Implementation::Svd3BatchSize>(matrices + i, u + i, w + i, v + i);
+    for(; i < matrices.size(); ++i)
+        Implementation::svd3Into<1>(matrices + i, u + i, w + i, v + i);
+}
+
+}}}
+
+#endif
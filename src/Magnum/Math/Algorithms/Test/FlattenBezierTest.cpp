@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Algorithms/FlattenBezier.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct FlattenBezierTest: Corrade::TestSuite::Tester {
+    explicit FlattenBezierTest();
+
+    void line();
+    void cubic();
+    void cubic3D();
+    void into();
+    void degenerate();
+};
+
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::CubicBezier2D<Float> CubicBezier2D;
+typedef Math::CubicBezier3D<Float> CubicBezier3D;
+
+FlattenBezierTest::FlattenBezierTest() {
+    addTests({&FlattenBezierTest::line,
+              &FlattenBezierTest::cubic,
+              &FlattenBezierTest::cubic3D,
+              &FlattenBezierTest::into,
+              &FlattenBezierTest::degenerate});
+}
+
+namespace {
+
+/* Max distance of the curve, sampled at many points, from the polyline */
+template<class BezierType, class VectorType> Float maxDistance(const BezierType& bezier, const std::vector<VectorType>& polyline) {
+    Float max = 0.0f;
+    for(std::size_t i = 0; i <= 1000; ++i) {
+        const VectorType p = bezier.value(Float(i)/1000.0f);
+        Float min = Math::Constants<Float>::inf();
+        for(std::size_t j = 1; j < polyline.size(); ++j) {
+            const VectorType segment = polyline[j] - polyline[j - 1];
+            const Float t = Math::clamp(Math::dot(p - polyline[j - 1], segment)/segment.dot(), 0.0f, 1.0f);
+            min = Math::min(min, (p - polyline[j - 1] - segment*t).length());
+        }
+        max = Math::max(max, min);
+    }
+    return max;
+}
+
+}
+
+void FlattenBezierTest::line() {
+    /* Collinear control points result in just the end points */
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{1.0f, 2.0f}, Vector2{3.0f, 6.0f}, Vector2{5.0f, 10.0f}};
+
+    const std::vector<Math::Vector<2, Float>> points = flattenBezier(bezier, 0.001f);
+    CORRADE_COMPARE(points.size(), 2);
+    CORRADE_COMPARE(points[0], bezier[0]);
+    CORRADE_COMPARE(points[1], bezier[3]);
+}
+
+void FlattenBezierTest::cubic() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    const std::vector<Math::Vector<2, Float>> coarse = flattenBezier(bezier, 1.0f);
+    const std::vector<Math::Vector<2, Float>> fine = flattenBezier(bezier, 0.01f);
+    CORRADE_COMPARE(coarse.front(), bezier[0]);
+    CORRADE_COMPARE(coarse.back(), bezier[3]);
+    CORRADE_COMPARE(fine.front(), bezier[0]);
+    CORRADE_COMPARE(fine.back(), bezier[3]);
+
+    /* Finer tolerance results in more points */
+    CORRADE_COMPARE_AS(coarse.size(), std::size_t{4}, Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(fine.size(), coarse.size(), Corrade::TestSuite::Compare::Greater);
+
+    /* The polyline is within the tolerance */
+    CORRADE_COMPARE_AS(maxDistance(bezier, coarse), 1.0f, Corrade::TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxDistance(bezier, fine), 0.01f, Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FlattenBezierTest::cubic3D() {
+    CubicBezier3D bezier{Vector3{0.0f, 0.0f, 0.0f}, Vector3{10.0f, 15.0f, -5.0f}, Vector3{20.0f, 4.0f, 8.0f}, Vector3{5.0f, -20.0f, 0.0f}};
+
+    const std::vector<Math::Vector<3, Float>> points = flattenBezier(bezier, 0.05f);
+    CORRADE_COMPARE(points.front(), bezier[0]);
+    CORRADE_COMPARE(points.back(), bezier[3]);
+    CORRADE_COMPARE_AS(maxDistance(bezier, points), 0.05f, Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FlattenBezierTest::into() {
+    CubicBezier2D a{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+    CubicBezier2D b{Vector2{5.0f, -20.0f}, Vector2{0.0f, -30.0f}, Vector2{-10.0f, -5.0f}, Vector2{0.0f, 0.0f}};
+
+    std::vector<Math::Vector<2, Float>> points{a[0]};
+    flattenBezierInto(a, 0.1f, points);
+    const std::size_t aSize = points.size();
+    flattenBezierInto(b, 0.1f, points);
+
+    /* The first point of each curve isn't added */
+    CORRADE_COMPARE(aSize, flattenBezier(a, 0.1f).size());
+    CORRADE_COMPARE(points.size(), aSize + flattenBezier(b, 0.1f).size() - 1);
+    CORRADE_COMPARE(points[aSize - 1], b[0]);
+    CORRADE_COMPARE(points.back(), b[3]);
+}
+
+void FlattenBezierTest::degenerate() {
+    /* Start and end are the same, the distance is measured from the point */
+    CubicBezier2D loop{Vector2{0.0f, 0.0f}, Vector2{10.0f, 10.0f}, Vector2{-10.0f, 10.0f}, Vector2{0.0f, 0.0f}};
+    const std::vector<Math::Vector<2, Float>> points = flattenBezier(loop, 0.1f);
+    CORRADE_COMPARE_AS(points.size(), std::size_t{8}, Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(maxDistance(loop, points), 0.1f, Corrade::TestSuite::Compare::LessOrEqual);
+
+    /* A single point */
+    CubicBezier2D point{Vector2{1.0f, 2.0f}, Vector2{1.0f, 2.0f}, Vector2{1.0f, 2.0f}, Vector2{1.0f, 2.0f}};
+    CORRADE_COMPARE(flattenBezier(point, 0.1f).size(), 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::FlattenBezierTest)
@@ -23,8 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Algorithms/KahanSum.h"
@@ -38,18 +43,56 @@ struct KahanSumTest: TestSuite::Tester {
     void integers();
     void iterative();
 
+    void array();
+    void arrayStrided();
+    void arrayEmpty();
+    void blocks();
+    void blocksWrongSize();
+    void mean();
+    void dot();
+    void dotStrided();
+    void dotBlocks();
+    void dotWrongSize();
+    void minmax();
+    void minmaxStrided();
+
     void accumulate100k();
     void kahan100k();
+    void kahanArray100k();
+    void kahanStrided100k();
+    void dotNaive100k();
+    void kahanDot100k();
+    void minmaxElement100k();
+    void minmax100k();
 
 };
 
 KahanSumTest::KahanSumTest() {
     addTests({&KahanSumTest::floats,
               &KahanSumTest::integers,
-              &KahanSumTest::iterative});
+              &KahanSumTest::iterative,
+
+              &KahanSumTest::array,
+              &KahanSumTest::arrayStrided,
+              &KahanSumTest::arrayEmpty,
+              &KahanSumTest::blocks,
+              &KahanSumTest::blocksWrongSize,
+              &KahanSumTest::mean,
+              &KahanSumTest::dot,
+              &KahanSumTest::dotStrided,
+              &KahanSumTest::dotBlocks,
+              &KahanSumTest::dotWrongSize,
+              &KahanSumTest::minmax,
+              &KahanSumTest::minmaxStrided});
 
     addBenchmarks({&KahanSumTest::accumulate100k,
-                   &KahanSumTest::kahan100k}, 50);
+                   &KahanSumTest::kahan100k,
+                   &KahanSumTest::kahanArray100k,
+                   &KahanSumTest::kahanStrided100k,
+                   &KahanSumTest::dotNaive100k,
+                   &KahanSumTest::kahanDot100k,
+                   &KahanSumTest::minmaxElement100k,
+                   &KahanSumTest::minmax100k}, 50);
 }
 
 namespace {
@@ -84,6 +127,27 @@ template<class T> struct Iterator
         std::size_t _i{};
 };
 
+/* Deterministic pseudo-random values in the [-0.5, 0.5) range */
+std::vector<Float> randomData(std::size_t size, Float seed) {
+    std::vector<Float> out(size);
+    for(std::size_t i = 0; i != size; ++i) {
+        const Double x = std::sin(Double(i)*12.9898 + Double(seed))*43758.5453;
+        out[i] = Float(x - std::floor(x)) - 0.5f;
+    }
+    return out;
+}
+
+Double referenceSum(const std::vector<Float>& data) {
+    Double sum{};
+    for(Float i: data) sum += Double(i);
+    return sum;
+}
+
+struct Vertex {
+    Float position[3];
+    Float weight;
+};
+
 }
 
 void KahanSumTest::floats() {
@@ -143,6 +207,162 @@ void KahanSumTest::iterative() {
     }
 }
 
+void KahanSumTest::array() {
+    /* Naive summation would stay at 1.0 as the small values get lost */
+    std::vector<Float> data(1000001, 1.0e-8f);
+    data[0] = 1.0f;
+
+    const Float sum = kahanSum(Containers::ArrayView<const Float>{data.data(), data.size()});
+    CORRADE_COMPARE(sum, 1.01f);
+    CORRADE_COMPARE(std::accumulate(data.begin(), data.end(), 0.0f), 1.0f);
+
+    /* Random values, compared to a sum in doubles */
+    const std::vector<Float> random = randomData(100003, 0.0f);
+    CORRADE_COMPARE(kahanSum(Containers::ArrayView<const Float>{random.data(), random.size()}),
+        Float(referenceSum(random)));
+
+    /* Sizes not divisible by lane count or block size */
+    for(std::size_t size: {1, 7, 9, 4095, 4097}) {
+        std::vector<Float> ones(size, 1.0f);
+        CORRADE_COMPARE(kahanSum(Containers::ArrayView<const Float>{ones.data(), ones.size()}), Float(size));
+    }
+}
+
+void KahanSumTest::arrayStrided() {
+    std::vector<Vertex> vertices(10000);
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = {{1.0f, Float(i), -1.0f}, 0.5f};
+
+    CORRADE_COMPARE(kahanSum(&vertices[0].position[1], sizeof(Vertex), vertices.size()), 49995000.0f);
+    CORRADE_COMPARE(kahanSum(&vertices[0].weight, sizeof(Vertex), vertices.size()), 5000.0f);
+
+    /* Negative stride goes backwards */
+    CORRADE_COMPARE(kahanSum(&vertices.back().position[0], -std::ptrdiff_t(sizeof(Vertex)), vertices.size()), 10000.0f);
+}
+
+void KahanSumTest::arrayEmpty() {
+    CORRADE_COMPARE(kahanSum(Containers::ArrayView<const Float>{}), 0.0f);
+    CORRADE_COMPARE(kahanDot(Containers::ArrayView<const Float>{}, Containers::ArrayView<const Float>{}), 0.0f);
+    CORRADE_COMPARE(Algorithms::minmax(static_cast<const Float*>(nullptr), sizeof(Float), 0), std::make_pair(0.0f, 0.0f));
+}
+
+void KahanSumTest::blocks() {
+    const std::vector<Float> data = randomData(10*ReductionBlockSize + 123, 1.0f);
+    const Containers::ArrayView<const Float> view{data.data(), data.size()};
+    const Float expected = kahanSum(view);
+
+    /* Distributing the blocks among a varying count of "threads" has to give
+       bit-exact results */
+    const std::size_t blockCount = (data.size() + ReductionBlockSize - 1)/ReductionBlockSize;
+    CORRADE_COMPARE(blockCount, 11);
+    for(std::size_t threadCount: {1, 2, 3, 4, 7, 11}) {
+
+        std::vector<Float> blockSums(blockCount);
+        const std::size_t blocksPerThread = (blockCount + threadCount - 1)/threadCount;
+        for(std::size_t thread = 0; thread != threadCount; ++thread) {
+            const std::size_t begin = std::min(thread*blocksPerThread, blockCount);
+            const std::size_t end = std::min(begin + blocksPerThread, blockCount);
+            kahanSumBlocksInto(
+                view.slice(std::min(begin*ReductionBlockSize, data.size()), std::min(end*ReductionBlockSize, data.size())),
+                Containers::ArrayView<Float>{blockSums.data(), blockSums.size()}.slice(begin, end));
+        }
+
+        const Float sum = kahanSum(blockSums.begin(), blockSums.end());
+        CORRADE_VERIFY(sum == expected);
+    }
+}
+
+void KahanSumTest::blocksWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<Float> data(ReductionBlockSize + 1);
+    Float blockSums[3];
+    kahanSumBlocksInto(Containers::ArrayView<const Float>{data.data(), data.size()}, Containers::ArrayView<Float>{blockSums});
+    CORRADE_COMPARE(out.str(), "Math::Algorithms::kahanSumBlocksInto(): expected 2 block sums but got 3\n");
+}
+
+void KahanSumTest::mean() {
+    const Float data[]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f};
+    CORRADE_COMPARE(Algorithms::mean(Containers::ArrayView<const Float>{data}), 5.5f);
+
+    /* Every second item */
+    CORRADE_COMPARE(Algorithms::mean(data, 2*sizeof(Float), 5), 5.0f);
+
+    const std::vector<Double> doubles(12345, 0.1);
+    CORRADE_COMPARE(Algorithms::mean(Containers::ArrayView<const Double>{doubles.data(), doubles.size()}), 0.1);
+}
+
+void KahanSumTest::dot() {
+    const std::vector<Float> a = randomData(50001, 2.0f);
+    const std::vector<Float> b = randomData(50001, 3.0f);
+
+    Double expected{};
+    for(std::size_t i = 0; i != a.size(); ++i)
+        expected += Double(a[i])*Double(b[i]);
+
+    CORRADE_COMPARE(kahanDot(Containers::ArrayView<const Float>{a.data(), a.size()}, Containers::ArrayView<const Float>{b.data(), b.size()}), Float(expected));
+}
+
+void KahanSumTest::dotStrided() {
+    std::vector<Vertex> vertices(1000);
+    std::vector<Float> weights(1000);
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        vertices[i] = {{0.0f, Float(i), 0.0f}, 0.25f};
+        weights[i] = 2.0f;
+    }
+
+    CORRADE_COMPARE(kahanDot(&vertices[0].position[1], sizeof(Vertex), weights.data(), sizeof(Float), vertices.size()), 999000.0f);
+    CORRADE_COMPARE(kahanDot(&vertices[0].weight, sizeof(Vertex), &vertices[0].weight, sizeof(Vertex), vertices.size()), 62.5f);
+}
+
+void KahanSumTest::dotBlocks() {
+    const std::vector<Float> a = randomData(3*ReductionBlockSize + 5, 4.0f);
+    const std::vector<Float> b = randomData(3*ReductionBlockSize + 5, 5.0f);
+    const Containers::ArrayView<const Float> viewA{a.data(), a.size()};
+    const Containers::ArrayView<const Float> viewB{b.data(), b.size()};
+
+    Float blockSums[4];
+    kahanDotBlocksInto(viewA, viewB, Containers::ArrayView<Float>{blockSums});
+    CORRADE_VERIFY(kahanSum(blockSums, blockSums + 4) == kahanDot(viewA, viewB));
+}
+
+void KahanSumTest::dotWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Float a[3]{}, b[4]{}, blockSums[2];
+    kahanDot(Containers::ArrayView<const Float>{a}, Containers::ArrayView<const Float>{b});
+    kahanDotBlocksInto(Containers::ArrayView<const Float>{a}, Containers::ArrayView<const Float>{b}, Containers::ArrayView<Float>{blockSums, 1});
+    kahanDotBlocksInto(Containers::ArrayView<const Float>{a}, Containers::ArrayView<const Float>{a}, Containers::ArrayView<Float>{blockSums});
+    CORRADE_COMPARE(out.str(),
+        "Math::Algorithms::kahanDot(): expected arrays of the same size, got 3 and 4\n"
+        "Math::Algorithms::kahanDotBlocksInto(): expected arrays of the same size, got 3 and 4\n"
+        "Math::Algorithms::kahanDotBlocksInto(): expected 1 block sums but got 2\n");
+}
+
+void KahanSumTest::minmax() {
+    const std::vector<Float> data = randomData(10007, 6.0f);
+    const auto expected = std::minmax_element(data.begin(), data.end());
+    CORRADE_COMPARE(Algorithms::minmax(data.data(), sizeof(Float), data.size()),
+        std::make_pair(*expected.first, *expected.second));
+
+    /* Extremes in the remainder and in the first item */
+    const Float remainder[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, -3.0f, 8.0f};
+    CORRADE_COMPARE(Algorithms::minmax(remainder, sizeof(Float), 10), std::make_pair(-3.0f, 8.0f));
+    const Int first[]{-5, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 99};
+    CORRADE_COMPARE(Algorithms::minmax(first, sizeof(Int), 17), std::make_pair(-5, 99));
+}
+
+void KahanSumTest::minmaxStrided() {
+    std::vector<Vertex> vertices(100);
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = {{Float(i), -Float(i), 0.0f}, Float(i % 7)};
+
+    CORRADE_COMPARE(Algorithms::minmax(&vertices[0].position[1], sizeof(Vertex), vertices.size()), std::make_pair(-99.0f, 0.0f));
+    CORRADE_COMPARE(Algorithms::minmax(&vertices[0].weight, sizeof(Vertex), vertices.size()), std::make_pair(0.0f, 6.0f));
+}
+
 void KahanSumTest::accumulate100k() {
     std::vector<Float> data(100000, 1.0f);
 
@@ -165,6 +385,74 @@ void KahanSumTest::kahan100k() {
     CORRADE_COMPARE(Float(a), 100000.0f);
 }
 
+void KahanSumTest::kahanArray100k() {
+    std::vector<Float> data(100000, 1.0f);
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = kahanSum(Containers::ArrayView<const Float>{data.data(), data.size()});
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+void KahanSumTest::kahanStrided100k() {
+    std::vector<Vertex> data(100000, Vertex{{0.0f, 1.0f, 0.0f}, 0.0f});
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = kahanSum(&data[0].position[1], sizeof(Vertex), data.size());
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+void KahanSumTest::dotNaive100k() {
+    std::vector<Float> data(100000, 1.0f);
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = std::inner_product(data.begin(), data.end(), data.begin(), 0.0f);
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+void KahanSumTest::kahanDot100k() {
+    std::vector<Float> data(100000, 1.0f);
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = kahanDot(Containers::ArrayView<const Float>{data.data(), data.size()}, Containers::ArrayView<const Float>{data.data(), data.size()});
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+void KahanSumTest::minmaxElement100k() {
+    const std::vector<Float> data = randomData(100000, 7.0f);
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        const auto minmax = std::minmax_element(data.begin(), data.end());
+        a = *minmax.second - *minmax.first;
+    }
+
+    CORRADE_VERIFY(Float(a) > 0.99f);
+}
+
+void KahanSumTest::minmax100k() {
+    const std::vector<Float> data = randomData(100000, 7.0f);
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        const std::pair<Float, Float> minmax = Algorithms::minmax(data.data(), sizeof(Float), data.size());
+        a = minmax.second - minmax.first;
+    }
+
+    CORRADE_VERIFY(Float(a) > 0.99f);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::KahanSumTest)
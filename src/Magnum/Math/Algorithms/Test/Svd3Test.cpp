@@ -0,0 +1,381 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Algorithms/Svd.h"
+#include "Magnum/Math/Algorithms/Svd3.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct Svd3Test: Corrade::TestSuite::Tester {
+    explicit Svd3Test();
+
+    void eigenSymmetric();
+    void eigenSymmetricDiagonal();
+    void eigenSymmetricRepeated();
+    template<class T> void eigenSymmetricRandom();
+    void svd();
+    void svdNegativeDeterminant();
+    void svdRankDeficient();
+    template<class T> void svdRandom();
+    void polarDecomposition();
+    void eigenSymmetricInto();
+    void svdInto();
+    void intoSizeMismatch();
+
+    void eigenSymmetric1k();
+    void eigenSymmetric1kGeneric();
+    void svd1k();
+    void svd1kGeneric();
+};
+
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Deg<Float> Deg;
+
+Svd3Test::Svd3Test() {
+    addTests({&Svd3Test::eigenSymmetric,
+              &Svd3Test::eigenSymmetricDiagonal,
+              &Svd3Test::eigenSymmetricRepeated,
+              &Svd3Test::eigenSymmetricRandom<Float>,
+              &Svd3Test::eigenSymmetricRandom<Double>,
+              &Svd3Test::svd,
+              &Svd3Test::svdNegativeDeterminant,
+              &Svd3Test::svdRankDeficient,
+              &Svd3Test::svdRandom<Float>,
+              &Svd3Test::svdRandom<Double>,
+              &Svd3Test::polarDecomposition,
+              &Svd3Test::eigenSymmetricInto,
+              &Svd3Test::svdInto,
+              &Svd3Test::intoSizeMismatch});
+
+    addBenchmarks({&Svd3Test::eigenSymmetric1k,
+                   &Svd3Test::eigenSymmetric1kGeneric,
+                   &Svd3Test::svd1k,
+                   &Svd3Test::svd1kGeneric}, 10);
+}
+
+namespace {
+
+/* Deterministic pseudo-random matrix with elements in [-1, 1] */
+template<class T> Math::Matrix3x3<T> randomMatrix(std::size_t i) {
+    Math::Matrix3x3<T> out;
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            out[col][row] = T(std::fmod(std::sin(Double(i*9 + col*3 + row)*12.9898 + 78.233)*43758.5453, 1.0));
+    return out;
+}
+
+template<class T> T determinant(const Math::Matrix3x3<T>& m) {
+    return m.determinant();
+}
+
+/* Magnitudes of generic SVD singular values, sorted from largest */
+template<class T> Math::Vector3<T> genericSingularValues(const Math::Matrix3x3<T>& m) {
+    Math::Vector3<T> w{std::get<1>(Algorithms::svd(RectangularMatrix<3, 3, T>{m}))};
+    for(std::size_t i = 0; i != 3; ++i) w[i] = std::abs(w[i]);
+    if(w[0] < w[1]) std::swap(w[0], w[1]);
+    if(w[0] < w[2]) std::swap(w[0], w[2]);
+    if(w[1] < w[2]) std::swap(w[1], w[2]);
+    return w;
+}
+
+}
+
+void Svd3Test::eigenSymmetric() {
+    const Matrix3x3 m{Vector3{2.0f, 1.0f, 0.0f},
+                      Vector3{1.0f, 2.0f, 0.0f},
+                      Vector3{0.0f, 0.0f, 5.0f}};
+
+    Matrix3x3 v{NoInit};
+    Vector3 values{NoInit};
+    std::tie(v, values) = eigenSymmetric3(m);
+    CORRADE_COMPARE(values, (Vector3{5.0f, 3.0f, 1.0f}));
+    CORRADE_COMPARE(v*Matrix3x3::fromDiagonal(values)*v.transposed(), m);
+    CORRADE_COMPARE(v*v.transposed(), Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+
+    /* Eigenvectors, up to sign */
+    CORRADE_COMPARE(Math::abs(v[0]), Vector3::zAxis());
+    CORRADE_COMPARE(Math::abs(v[1]), (Vector3{1.0f, 1.0f, 0.0f}.normalized()));
+    CORRADE_COMPARE(Math::abs(v[2]), (Vector3{1.0f, 1.0f, 0.0f}.normalized()));
+}
+
+void Svd3Test::eigenSymmetricDiagonal() {
+    Matrix3x3 v{NoInit};
+    Vector3 values{NoInit};
+    std::tie(v, values) = eigenSymmetric3(Matrix3x3::fromDiagonal({-1.0f, 3.0f, 2.0f}));
+    CORRADE_COMPARE(values, (Vector3{3.0f, 2.0f, -1.0f}));
+    CORRADE_COMPARE(Math::abs(v[0]), Vector3::yAxis());
+    CORRADE_COMPARE(Math::abs(v[1]), Vector3::zAxis());
+    CORRADE_COMPARE(Math::abs(v[2]), Vector3::xAxis());
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+}
+
+void Svd3Test::eigenSymmetricRepeated() {
+    /* Shouldn't produce NaNs for identity or a zero matrix */
+    Matrix3x3 v{NoInit};
+    Vector3 values{NoInit};
+    std::tie(v, values) = eigenSymmetric3(Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(values, Vector3{1.0f});
+    CORRADE_COMPARE(v, Matrix3x3{IdentityInit});
+
+    std::tie(v, values) = eigenSymmetric3(Matrix3x3{ZeroInit});
+    CORRADE_COMPARE(values, Vector3{0.0f});
+    CORRADE_COMPARE(v, Matrix3x3{IdentityInit});
+}
+
+template<class T> void Svd3Test::eigenSymmetricRandom() {
+    setTestCaseName(std::is_same<T, Double>::value ? "eigenSymmetricRandom<Double>" : "eigenSymmetricRandom<Float>");
+
+    /* Covariance-like symmetric positive semidefinite matrices, for which the
+       eigenvalues are equal to singular values */
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        const Math::Matrix3x3<T> a = randomMatrix<T>(i);
+        const Math::Matrix3x3<T> m = a.transposed()*a;
+
+        Math::Matrix3x3<T> v{NoInit};
+        Math::Vector3<T> values{NoInit};
+        std::tie(v, values) = eigenSymmetric3(m);
+
+        const Math::Vector3<T> expected = genericSingularValues(m);
+        const T epsilon = TypeTraits<T>::epsilon()*T(8)*values[0];
+        if((Math::abs(values - expected) > Math::Vector3<T>{epsilon}).any() ||
+           (Math::abs((v*Math::Matrix3x3<T>::fromDiagonal(values)*v.transposed() - m).toVector()) > Math::Vector<9, T>{epsilon}).any() ||
+           v*v.transposed() != Math::Matrix3x3<T>{IdentityInit} ||
+           !TypeTraits<T>::equals(v.determinant(), T(1)))
+            ++mismatches;
+    }
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+void Svd3Test::svd() {
+    const Matrix3x3 m{Vector3{3.0f, 2.0f, 2.0f},
+                      Vector3{2.0f, 3.0f, -2.0f},
+                      Vector3{0.0f, 0.0f, 1.0f}};
+
+    Matrix3x3 u{NoInit}, v{NoInit};
+    Vector3 w{NoInit};
+    std::tie(u, w, v) = svd3(m);
+    CORRADE_COMPARE(w, genericSingularValues(m));
+    CORRADE_COMPARE(u*Matrix3x3::fromDiagonal(w)*v.transposed(), m);
+    CORRADE_COMPARE(u*u.transposed(), Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(v*v.transposed(), Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(u.determinant(), 1.0f);
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+}
+
+void Svd3Test::svdNegativeDeterminant() {
+    /* Mirrored, the last singular value is negative so U and V can stay
+       rotations */
+    const Matrix3x3 m = Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, 3.0f}.normalized()).rotationScaling()*Matrix3x3::fromDiagonal({2.0f, -3.0f, 0.5f});
+
+    Matrix3x3 u{NoInit}, v{NoInit};
+    Vector3 w{NoInit};
+    std::tie(u, w, v) = svd3(m);
+    CORRADE_COMPARE(w, (Vector3{3.0f, 2.0f, -0.5f}));
+    CORRADE_COMPARE(u*Matrix3x3::fromDiagonal(w)*v.transposed(), m);
+    CORRADE_COMPARE(u.determinant(), 1.0f);
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+}
+
+void Svd3Test::svdRankDeficient() {
+    /* Rank 1 and rank 0 shouldn't produce NaNs */
+    const Matrix3x3 m{Vector3{1.0f, 2.0f, 3.0f},
+                      Vector3{2.0f, 4.0f, 6.0f},
+                      Vector3{-1.0f, -2.0f, -3.0f}};
+
+    Matrix3x3 u{NoInit}, v{NoInit};
+    Vector3 w{NoInit};
+    std::tie(u, w, v) = svd3(m);
+    CORRADE_COMPARE(w, (Vector3{Math::sqrt(14.0f)*Math::sqrt(6.0f), 0.0f, 0.0f}));
+    CORRADE_COMPARE(u*Matrix3x3::fromDiagonal(w)*v.transposed(), m);
+    CORRADE_COMPARE(u.determinant(), 1.0f);
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+
+    std::tie(u, w, v) = svd3(Matrix3x3{ZeroInit});
+    CORRADE_COMPARE(w, Vector3{0.0f});
+    CORRADE_COMPARE(u, Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(v, Matrix3x3{IdentityInit});
+}
+
+template<class T> void Svd3Test::svdRandom() {
+    setTestCaseName(std::is_same<T, Double>::value ? "svdRandom<Double>" : "svdRandom<Float>");
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        const Math::Matrix3x3<T> m = randomMatrix<T>(i);
+
+        Math::Matrix3x3<T> u{NoInit}, v{NoInit};
+        Math::Vector3<T> w{NoInit};
+        std::tie(u, w, v) = svd3(m);
+
+        /* Small singular values lose precision due to squaring of the
+           condition number, so the error is relative to the largest one */
+        const Math::Vector3<T> expected = genericSingularValues(m);
+        const T epsilon = std::sqrt(TypeTraits<T>::epsilon())*w[0];
+        if((Math::abs(Math::abs(w) - expected) > Math::Vector3<T>{epsilon}).any() ||
+           (w[2] < T(0)) != (m.determinant() < T(0)) ||
+           (Math::abs((u*Math::Matrix3x3<T>::fromDiagonal(w)*v.transposed() - m).toVector()) > Math::Vector<9, T>{TypeTraits<T>::epsilon()*T(16)*w[0]}).any() ||
+           u*u.transposed() != Math::Matrix3x3<T>{IdentityInit} ||
+           v*v.transposed() != Math::Matrix3x3<T>{IdentityInit} ||
+           !TypeTraits<T>::equals(u.determinant(), T(1)) ||
+           !TypeTraits<T>::equals(v.determinant(), T(1)))
+            ++mismatches;
+    }
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+void Svd3Test::polarDecomposition() {
+    const Matrix3x3 rotation = Matrix4::rotation(Deg(-75.0f), Vector3{3.0f, -1.0f, 0.5f}.normalized()).rotationScaling();
+    const Matrix3x3 stretch{Vector3{2.0f, 0.5f, 0.0f},
+                            Vector3{0.5f, 1.5f, 0.25f},
+                            Vector3{0.0f, 0.25f, 3.0f}};
+
+    Matrix3x3 u{NoInit}, v{NoInit};
+    Vector3 w{NoInit};
+    std::tie(u, w, v) = svd3(rotation*stretch);
+    CORRADE_COMPARE(u*v.transposed(), rotation);
+    CORRADE_COMPARE(v*Matrix3x3::fromDiagonal(w)*v.transposed(), stretch);
+}
+
+void Svd3Test::eigenSymmetricInto() {
+    Matrix3x3 matrices[5];
+    for(std::size_t i = 0; i != 5; ++i) {
+        const Matrix3x3 a = randomMatrix<Float>(i);
+        matrices[i] = a.transposed()*a;
+    }
+
+    Matrix3x3 vectors[5];
+    Vector3 values[5];
+    Algorithms::eigenSymmetric3Into<Float>(matrices, vectors, values);
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_COMPARE(vectors[i], eigenSymmetric3(matrices[i]).first);
+        CORRADE_COMPARE(values[i], eigenSymmetric3(matrices[i]).second);
+    }
+}
+
+void Svd3Test::svdInto() {
+    Matrix3x3 matrices[5];
+    for(std::size_t i = 0; i != 5; ++i)
+        matrices[i] = randomMatrix<Float>(i);
+
+    Matrix3x3 u[5], v[5];
+    Vector3 w[5];
+    Algorithms::svd3Into<Float>(matrices, u, w, v);
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_COMPARE(u[i], std::get<0>(svd3(matrices[i])));
+        CORRADE_COMPARE(w[i], std::get<1>(svd3(matrices[i])));
+        CORRADE_COMPARE(v[i], std::get<2>(svd3(matrices[i])));
+    }
+}
+
+void Svd3Test::intoSizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Matrix3x3 matrices[3];
+    Matrix3x3 u[3], v[2];
+    Vector3 w[3];
+    Algorithms::eigenSymmetric3Into<Float>(matrices, v, w);
+    Algorithms::svd3Into<Float>(matrices, u, w, v);
+    CORRADE_COMPARE(out.str(),
+        "Math::Algorithms::eigenSymmetric3Into(): expected 3 output items but got 2 and 3\n"
+        "Math::Algorithms::svd3Into(): expected 3 output items but got 3, 3 and 2\n");
+}
+
+namespace {
+
+constexpr std::size_t BenchmarkSize = 1000;
+
+template<class T> std::vector<Math::Matrix3x3<T>> benchmarkMatrices(bool symmetric) {
+    std::vector<Math::Matrix3x3<T>> out;
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        const Math::Matrix3x3<T> a = randomMatrix<T>(i);
+        out.push_back(symmetric ? a.transposed()*a : a);
+    }
+    return out;
+}
+
+}
+
+void Svd3Test::eigenSymmetric1k() {
+    const std::vector<Matrix3x3> matrices = benchmarkMatrices<Float>(true);
+    std::vector<Matrix3x3> vectors(BenchmarkSize);
+    std::vector<Vector3> values(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        Algorithms::eigenSymmetric3Into<Float>({matrices.data(), matrices.size()}, {vectors.data(), vectors.size()}, {values.data(), values.size()});
+
+    CORRADE_VERIFY(values.back()[0] > 0.0f);
+}
+
+void Svd3Test::eigenSymmetric1kGeneric() {
+    const std::vector<Matrix3x3> matrices = benchmarkMatrices<Float>(true);
+    std::vector<Vector3> values(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            values[i] = Vector3{std::get<1>(Algorithms::svd(RectangularMatrix<3, 3, Float>{matrices[i]}))};
+
+    CORRADE_VERIFY(values.back()[0] > 0.0f);
+}
+
+void Svd3Test::svd1k() {
+    const std::vector<Matrix3x3> matrices = benchmarkMatrices<Float>(false);
+    std::vector<Matrix3x3> u(BenchmarkSize), v(BenchmarkSize);
+    std::vector<Vector3> w(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        Algorithms::svd3Into<Float>({matrices.data(), matrices.size()}, {u.data(), u.size()}, {w.data(), w.size()}, {v.data(), v.size()});
+
+    CORRADE_VERIFY(w.back()[0] > 0.0f);
+}
+
+void Svd3Test::svd1kGeneric() {
+    const std::vector<Matrix3x3> matrices = benchmarkMatrices<Float>(false);
+    std::vector<RectangularMatrix<3, 3, Float>> u(BenchmarkSize);
+    std::vector<Math::Vector<3, Float>> w(BenchmarkSize);
+    std::vector<Matrix3x3> v(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            std::tie(u[i], w[i], v[i]) = Algorithms::svd(RectangularMatrix<3, 3, Float>{matrices[i]});
+
+    CORRADE_VERIFY(w.back()[0] != 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::Svd3Test)
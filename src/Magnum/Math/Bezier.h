@@ -31,6 +31,7 @@
  */
 
 #include <array>
+#include <Corrade/Containers/Containers.h>
 
 #include "Magnum/Math/Vector.h"
 
@@ -154,6 +155,61 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
             return {left, right};
         }
 
+        /**
+         * @brief Polynomial coefficients
+         *
+         * Returns the curve converted from the Bernstein basis to the power
+         * basis, i.e. vectors @f$ \boldsymbol{c}_k @f$ such that @f[
+         *      \boldsymbol{B}(t) = \sum_{k=0}^n \boldsymbol{c}_k t^k
+         * @f]
+         *
+         * Evaluating the polynomial using Horner's scheme needs only
+         * @f$ n @f$ multiply-adds per dimension compared to
+         * @f$ \frac{n(n + 1)}{2} @f$ linear interpolations done by
+         * @ref value(), at the cost of slightly lower precision for high
+         * orders. Calculate the coefficients once and reuse them if you need
+         * to evaluate the curve many times.
+         * @see @ref valueInto()
+         */
+        std::array<Vector<dimensions, T>, order + 1> coefficients() const {
+            std::array<Vector<dimensions, T>, order + 1> out;
+            T binomialNK = T(1);
+            for(std::size_t k = 0; k <= order; ++k) {
+                Vector<dimensions, T> sum;
+                T binomialKI = T(1);
+                for(std::size_t i = 0; i <= k; ++i) {
+                    sum += ((k - i) % 2 ? -binomialKI : binomialKI)*_data[i];
+                    binomialKI = binomialKI*T(k - i)/T(i + 1);
+                }
+                out[k] = binomialNK*sum;
+                binomialNK = binomialNK*T(order - k)/T(k + 1);
+            }
+            return out;
+        }
+
+        /**
+         * @brief Interpolate the curve at many positions
+         * @param[in] t     Interpolation factors
+         * @param[out] out  Where to put the points on the curve
+         *
+         * Calculates @ref coefficients() once and evaluates them for every
+         * item of @p t. The results are equal to calling @ref value() on
+         * each item up to floating-point precision. Size of @p t is expected
+         * to be the same as size of @p out. Include
+         * @ref Corrade/Containers/ArrayView.h in order to call this function.
+         */
+        void valueInto(Corrade::Containers::ArrayView<const T> t, Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const {
+            CORRADE_ASSERT(t.size() == out.size(),
+                "Math::Bezier::valueInto(): expected" << t.size() << "output items but got" << out.size(), );
+            const std::array<Vector<dimensions, T>, order + 1> c = coefficients();
+            for(std::size_t i = 0; i != t.size(); ++i) {
+                Vector<dimensions, T> value = c[order];
+                for(std::size_t k = order; k != 0; --k)
+                    value = value*t[i] + c[k - 1];
+                out[i] = value;
+            }
+        }
+
     private:
         /* Implementation for Bezier<order, dimensions, T>::Bezier(const Bezier<order, dimensions, U>&) */
         template<class U, std::size_t ...sequence> constexpr explicit Bezier(Implementation::Sequence<sequence...>, const Bezier<order, dimensions, U>& other) noexcept: _data{Vector<dimensions, T>(other._data[sequence])...} {}
@@ -0,0 +1,164 @@
+#ifndef Magnum_Math_BezierArcLength_h
+#define Magnum_Math_BezierArcLength_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Math::BezierArcLength
+ */
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Bezier.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Arc-length table of a Bézier curve
+@tparam order       Order of Bézier curve
+@tparam dimensions  Dimensions of control points
+@tparam T           Underlying data type
+
+The interpolation factor of a @ref Bezier doesn't generally correspond to the
+distance traveled along the curve, so moving an object along the curve with a
+uniformly increasing factor results in varying speed. This class samples the
+curve at uniformly distributed factors, calculates cumulative lengths of the
+resulting polyline and then maps a distance along the curve back to an
+interpolation factor, allowing for constant-speed traversal:
+
+@code{.cpp}
+Math::BezierArcLength<3, 3, Float> arcLength{curve, 128};
+
+Float distance = 0.0f;
+for(;;) {
+    Vector3 position = curve.value(arcLength.parameter(distance));
+    distance += speed*timeDelta;
+    // ...
+}
+@endcode
+
+The table is calculated once in the constructor, each lookup is then a binary
+search in the table and a linear interpolation. Precision of the mapping
+depends on the number of segments, the length is underestimated with an error
+decreasing quadratically with segment count.
+*/
+template<UnsignedInt order, UnsignedInt dimensions, class T> class BezierArcLength {
+    public:
+        /**
+         * @brief Constructor
+         * @param curve     Curve to calculate the table for
+         * @param segments  Count of uniformly distributed segments
+         *
+         * Expects that @p segments is at least @cpp 1 @ce. If the assertion
+         * fails and graceful assertions are enabled, the table is left with
+         * zero segments and zero length, @ref parameter() then returns
+         * @cpp 0 @ce for zero distance and @cpp 1 @ce otherwise.
+         */
+        explicit BezierArcLength(const Bezier<order, dimensions, T>& curve, std::size_t segments = 64);
+
+        /** @brief Curve the table is calculated for */
+        const Bezier<order, dimensions, T>& curve() const { return _curve; }
+
+        /** @brief Count of segments */
+        std::size_t segmentCount() const { return _lengths.size() - 1; }
+
+        /**
+         * @brief Cumulative lengths
+         *
+         * Item @cpp i @ce is the length of the curve between interpolation
+         * factors @cpp 0 @ce and @cpp i/segmentCount() @ce. The array has
+         * @ref segmentCount() + @cpp 1 @ce items, the first being always
+         * zero.
+         */
+        Corrade::Containers::ArrayView<const T> lengths() const {
+            return {_lengths.data(), _lengths.size()};
+        }
+
+        /** @brief Total length of the curve */
+        T length() const { return _lengths.back(); }
+
+        /**
+         * @brief Interpolation factor for given distance along the curve
+         *
+         * Distances outside of the @f$ [0, l] @f$ range, where @f$ l @f$ is
+         * @ref length(), are clamped to the curve end points.
+         * @see @ref parametersInto(), @ref Bezier::value()
+         */
+        T parameter(T distance) const;
+
+        /**
+         * @brief Interpolation factors for many distances along the curve
+         *
+         * Equivalent to calling @ref parameter() on each item of
+         * @p distances. The result can be passed directly to
+         * @ref Bezier::valueInto(). Size of @p distances is expected to be
+         * the same as size of @p out.
+         */
+        void parametersInto(Corrade::Containers::ArrayView<const T> distances, Corrade::Containers::ArrayView<T> out) const;
+
+    private:
+        Bezier<order, dimensions, T> _curve;
+        std::vector<T> _lengths;
+};
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> BezierArcLength<order, dimensions, T>::BezierArcLength(const Bezier<order, dimensions, T>& curve, const std::size_t segments): _curve{curve}, _lengths(1, T(0)) {
+    CORRADE_ASSERT(segments, "Math::BezierArcLength: expected at least one segment", );
+
+    std::vector<T> parameters(segments + 1);
+    for(std::size_t i = 0; i <= segments; ++i)
+        parameters[i] = T(i)/T(segments);
+    std::vector<Vector<dimensions, T>> points(segments + 1);
+    curve.valueInto({parameters.data(), parameters.size()}, {points.data(), points.size()});
+
+    _lengths.resize(segments + 1);
+    for(std::size_t i = 1; i <= segments; ++i)
+        _lengths[i] = _lengths[i - 1] + (points[i] - points[i - 1]).length();
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> T BezierArcLength<order, dimensions, T>::parameter(const T distance) const {
+    if(!(distance > T(0))) return T(0);
+    if(distance >= _lengths.back()) return T(1);
+
+    /* First length larger than the distance, the item before it is then
+       guaranteed to be smaller or equal, so the segment has non-zero
+       length */
+    const std::size_t next = std::upper_bound(_lengths.begin(), _lengths.end(), distance) - _lengths.begin();
+    const T segmentFactor = (distance - _lengths[next - 1])/(_lengths[next] - _lengths[next - 1]);
+    return (T(next - 1) + segmentFactor)/T(segmentCount());
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> void BezierArcLength<order, dimensions, T>::parametersInto(const Corrade::Containers::ArrayView<const T> distances, const Corrade::Containers::ArrayView<T> out) const {
+    CORRADE_ASSERT(distances.size() == out.size(),
+        "Math::BezierArcLength::parametersInto(): expected" << distances.size() << "output items but got" << out.size(), );
+    for(std::size_t i = 0; i != distances.size(); ++i)
+        out[i] = parameter(distances[i]);
+}
+
+}}
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef Magnum_Math_FunctionsFast_h
+#define Magnum_Math_FunctionsFast_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::sinFast(), @ref Magnum::Math::cosFast(), @ref Magnum::Math::sincosFast(), @ref Magnum::Math::exp2Fast(), @ref Magnum::Math::log2Fast(), @ref Magnum::Math::sqrtInvertedFast()
+ */
+
+#include <utility>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Math/Vector.h"
+
+namespace Magnum { namespace Math {
+
+namespace Implementation {
+    union FastFloatBits {
+        UnsignedInt u;
+        Float f;
+    };
+
+    /* Reduces the angle to [-π/4, π/4], calculates sine and cosine of the
+       reduced value and then swaps and negates them based on the quadrant.
+       Rounding to the nearest multiple of π/2 is done with a truncating
+       conversion, π/2 is split into three parts (Cody-Waite) so the first two
+       products are exact. Sine and cosine polynomials are from Cephes
+       sinf(). The quadrant fixup is done on the bit representation, as
+       compilers don't vectorize selects between floats that were calculated
+       differently. */
+    inline void sincosFast(const Float angle, Float& sin, Float& cos) {
+        const Int quadrant = Int(angle*0.636619772f + (angle < 0.0f ? -0.5f : 0.5f));
+        const Float j = Float(quadrant);
+        const Float x = ((angle - j*1.5703125f) - j*4.837512969970703125e-4f) - j*7.54978995489188216e-8f;
+        const Float x2 = x*x;
+
+        FastFloatBits s, c;
+        s.f = x + x*x2*(-1.6666654611e-1f + x2*(8.3321608736e-3f + x2*-1.9515295891e-4f));
+        c.f = 1.0f - 0.5f*x2 + x2*x2*(4.166664568298827e-2f + x2*(-1.388731625493765e-3f + x2*2.443315711809948e-5f));
+
+        const UnsignedInt swap = 0u - UnsignedInt(quadrant & 1);
+        FastFloatBits outSin, outCos;
+        outSin.u = ((s.u & ~swap) | (c.u & swap)) ^ (UnsignedInt(quadrant & 2) << 30);
+        outCos.u = ((c.u & ~swap) | (s.u & swap)) ^ (UnsignedInt((quadrant + 1) & 2) << 30);
+        sin = outSin.f;
+        cos = outCos.f;
+    }
+}
+
+/**
+@brief Fast approximate sine and cosine
+
+Calculates both values at once, the cost is roughly the same as for
+@ref sinFast() or @ref cosFast() alone. The angle is reduced to
+@f$ [-\frac{\pi}{4}, \frac{\pi}{4}] @f$ and the values are then calculated
+using minimax polynomials of degree 7 and 8. For angles in range
+@f$ [-10^4, 10^4] @f$ the max absolute error is @f$ 2^{-23} @f$ and the max
+error is 2 ULPs for results with magnitude above @f$ 10^{-3} @f$, closer to
+zero the absolute error bound applies. Beyond that range the precision of the
+range reduction degrades. There are no branches, so the function can be
+vectorized by the compiler. Use @ref sincos() for accurate results.
+@see @ref sincosFast(const Vector<size, Float>&)
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline std::pair<Float, Float> sincosFast(Rad<Float> angle);
+#else
+inline std::pair<Float, Float> sincosFast(const Unit<Rad, Float> angle) {
+    Float sin, cos;
+    Implementation::sincosFast(Float(angle), sin, cos);
+    return {sin, cos};
+}
+inline std::pair<Float, Float> sincosFast(const Unit<Deg, Float> angle) {
+    return sincosFast(Rad<Float>(angle));
+}
+#endif
+
+/**
+@brief Fast approximate sine
+
+See @ref sincosFast() for details about precision. Use @ref sin() for accurate
+results.
+@see @ref sinFast(const Vector<size, Float>&)
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float sinFast(Rad<Float> angle);
+#else
+inline Float sinFast(const Unit<Rad, Float> angle) {
+    Float sin, cos;
+    Implementation::sincosFast(Float(angle), sin, cos);
+    return sin;
+}
+inline Float sinFast(const Unit<Deg, Float> angle) { return sinFast(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast approximate cosine
+
+See @ref sincosFast() for details about precision. Use @ref cos() for accurate
+results.
+@see @ref cosFast(const Vector<size, Float>&)
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float cosFast(Rad<Float> angle);
+#else
+inline Float cosFast(const Unit<Rad, Float> angle) {
+    Float sin, cos;
+    Implementation::sincosFast(Float(angle), sin, cos);
+    return cos;
+}
+inline Float cosFast(const Unit<Deg, Float> angle) { return cosFast(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast approximate base-2 exponential
+
+Splits the exponent into integral and fractional part, calculates
+@f$ 2^f @f$ for the fractional part using a minimax polynomial of degree 6
+and puts the integral part directly into the exponent bits. Max error is 2
+ULPs, results for integral exponents are exact. The @p exponent is clamped to range @f$ [-126, 127] @f$ so the result is
+always a normalized finite value, for NaN the result is unspecified. There are
+no branches, so the function can be vectorized by the compiler. Use
+@ref pow() or @ref exp() for accurate results.
+@see @ref exp2Fast(const Vector<size, Float>&), @ref log2Fast()
+*/
+inline Float exp2Fast(const Float exponent) {
+    /* Clamping done on the bit representation, with a float select the
+       compiler wouldn't vectorize the conversion to integer below */
+    Implementation::FastFloatBits clamped, min, max;
+    clamped.f = exponent;
+    min.f = -126.0f;
+    max.f = 127.0f;
+    const UnsignedInt below = 0u - UnsignedInt(exponent < -126.0f);
+    const UnsignedInt above = 0u - UnsignedInt(exponent > 127.0f);
+    clamped.u = (clamped.u & ~(below|above)) | (min.u & below) | (max.u & above);
+
+    /* Floor, the conversion truncates towards zero */
+    Int integral = Int(clamped.f);
+    integral -= clamped.f < Float(integral);
+    const Float f = clamped.f - Float(integral);
+
+    Implementation::FastFloatBits out;
+    out.f = 1.0f + f*(0.693147044f + f*(0.240229306f + f*(0.0554852806f + f*(0.00967545156f + f*(0.00124678465f + f*0.000216129146f)))));
+    out.u += UnsignedInt(integral) << 23;
+    return out.f;
+}
+
+/**
+@brief Fast approximate base-2 logarithm
+
+Extracts the exponent from the floating-point representation and calculates
+the logarithm of the mantissa, normalized to range
+@f$ [\sqrt{\frac{1}{2}}, \sqrt{2}) @f$, using a minimax polynomial of degree 8.
+Max error is 2 ULPs. The @p value is expected to be positive, finite and
+normalized, otherwise the result is unspecified. There are no branches, so the
+function can be vectorized by the compiler. Use @ref log() for accurate
+results.
+@see @ref log2Fast(const Vector<size, Float>&), @ref exp2Fast()
+*/
+inline Float log2Fast(const Float value) {
+    /* Offsetting the representation by √½ before extracting the exponent
+       gives a mantissa in [√½, √2), centering the polynomial around zero.
+       Done purely with integer operations so it can be vectorized. */
+    Implementation::FastFloatBits bits;
+    bits.f = value;
+    const UnsignedInt offset = bits.u - 0x3f3504f3;
+    const Int exponent = Int(offset) >> 23;
+    bits.u -= offset & 0xff800000;
+    const Float f = bits.f - 1.0f;
+
+    return Float(exponent) + f*(1.442695f + f*(-0.721347347f + f*(0.480910643f + f*(-0.360703682f + f*(0.287916247f + f*(-0.238944831f + f*(0.215715624f + f*(-0.207269687f + f*0.125836898f))))))));
+}
+
+/**
+@brief Fast approximate inverse square root
+@tparam iterations  Count of Newton-Raphson iterations
+
+Starts with an estimate calculated by reinterpreting the floating-point
+representation as an integer and refines it using @p iterations steps of the
+Newton-Raphson method. Max relative error is about @f$ 3.4 \cdot 10^{-2} @f$
+with no iterations, @f$ 1.8 \cdot 10^{-3} @f$ (about 30000 ULPs) with one
+iteration, which is enough for normalizing shading vectors, and
+@f$ 4.8 \cdot 10^{-6} @f$ (about 80 ULPs) with two iterations. The @p value is
+expected to be positive, finite and normalized, otherwise the result is
+unspecified. There are no branches, so the function can be vectorized by the
+compiler. Use @ref sqrtInverted() for accurate results.
+@see @ref sqrtInvertedFast(const Vector<size, Float>&)
+*/
+template<UnsignedInt iterations = 1> inline Float sqrtInvertedFast(const Float value) {
+    Implementation::FastFloatBits bits;
+    bits.f = value;
+    bits.u = 0x5f375a86 - (bits.u >> 1);
+
+    const Float half = 0.5f*value;
+    for(UnsignedInt i = 0; i != iterations; ++i)
+        bits.f = bits.f*(1.5f - half*bits.f*bits.f);
+    return bits.f;
+}
+
+/**
+@brief Fast approximate sine and cosine of a vector
+
+Angles are expected to be in radians. Calls @ref sincosFast(Rad<Float>) on all
+components.
+*/
+template<std::size_t size> std::pair<Vector<size, Float>, Vector<size, Float>> sincosFast(const Vector<size, Float>& angles) {
+    std::pair<Vector<size, Float>, Vector<size, Float>> out{NoInit, NoInit};
+    for(std::size_t i = 0; i != size; ++i)
+        std::tie(out.first[i], out.second[i]) = sincosFast(Rad<Float>(angles[i]));
+    return out;
+}
+
+/**
+@brief Fast approximate sine of a vector
+
+Angles are expected to be in radians. Calls @ref sinFast(Rad<Float>) on all
+components.
+*/
+template<std::size_t size> Vector<size, Float> sinFast(const Vector<size, Float>& angles) {
+    Vector<size, Float> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = sinFast(Rad<Float>(angles[i]));
+    return out;
+}
+
+/**
+@brief Fast approximate cosine of a vector
+
+Angles are expected to be in radians. Calls @ref cosFast(Rad<Float>) on all
+components.
+*/
+template<std::size_t size> Vector<size, Float> cosFast(const Vector<size, Float>& angles) {
+    Vector<size, Float> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = cosFast(Rad<Float>(angles[i]));
+    return out;
+}
+
+/**
+@brief Fast approximate base-2 exponential of a vector
+
+Calls @ref exp2Fast(Float) on all components.
+*/
+template<std::size_t size> Vector<size, Float> exp2Fast(const Vector<size, Float>& exponent) {
+    Vector<size, Float> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = exp2Fast(exponent[i]);
+    return out;
+}
+
+/**
+@brief Fast approximate base-2 logarithm of a vector
+
+Calls @ref log2Fast(Float) on all components.
+*/
+template<std::size_t size> Vector<size, Float> log2Fast(const Vector<size, Float>& value) {
+    Vector<size, Float> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = log2Fast(value[i]);
+    return out;
+}
+
+/**
+@brief Fast approximate inverse square root of a vector
+
+Calls @ref sqrtInvertedFast(Float) on all components.
+*/
+template<UnsignedInt iterations = 1, std::size_t size> Vector<size, Float> sqrtInvertedFast(const Vector<size, Float>& value) {
+    Vector<size, Float> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = sqrtInvertedFast<iterations>(value[i]);
+    return out;
+}
+
+}}
+
+#endif
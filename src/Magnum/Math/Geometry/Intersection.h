@@ -31,6 +31,7 @@
  */
 
 #include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Geometry/Distance.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector3.h"
@@ -142,6 +143,63 @@ template<class T> inline T planeLine(const Vector3<T>& planePosition, const Vect
     return (f - dot(planeNormal, p))/dot(planeNormal, r);
 }
 
+/**
+@brief Intersection of a ray and a triangle
+@param origin       Ray origin
+@param direction    Ray direction, doesn't need to be normalized
+@param a            First triangle vertex
+@param b            Second triangle vertex
+@param c            Third triangle vertex
+
+Returns a vector containing the intersection distance @f$ t @f$ and barycentric
+coordinates @f$ u @f$, @f$ v @f$ of the intersection point, which then lies at
+@f$ \boldsymbol{o} + t \boldsymbol{d} = (1 - u - v) \boldsymbol{a} + u \boldsymbol{b} + v \boldsymbol{c} @f$.
+If the ray doesn't hit the triangle, if the triangle lies behind the ray origin
+or if the ray is parallel to the triangle, @f$ t @f$ is @f$ \infty @f$ and the
+barycentric coordinates are unspecified. Both sides of the triangle are hit.
+
+Uses the Möller--Trumbore algorithm. The edge tests are inclusive, but the
+barycentric coordinates are calculated in floating-point with rounding errors,
+so a ray going very close to an edge or vertex shared by two triangles of a
+closed mesh may still miss both of them. The algorithm is not watertight and
+if that matters, the neighboring triangles need to be tested with some
+tolerance.
+@see @ref rayTriangle(const RayPacket<4>&, const Vector3<Float>&, const Vector3<Float>&, const Vector3<Float>&, RayPacketHits<4>&)
+*/
+template<class T> Vector3<T> rayTriangle(const Vector3<T>& origin, const Vector3<T>& direction, const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& c);
+
+/**
+@brief Intersection of a ray and an axis-aligned box
+@param origin           Ray origin
+@param inverseDirection Inverted ray direction, i.e. @cpp 1.0f/direction @ce
+@param range            Axis-aligned box
+
+Returns distance @f$ t @f$ at which the ray enters the box, @cpp 0 @ce if the
+origin is inside the box and @f$ \infty @f$ if the ray misses the box or the
+box lies behind the ray origin. Uses the slab method, which needs the inverted
+ray direction --- since the same ray is usually tested against many boxes, it's
+expected to be calculated upfront. Zero direction components are handled
+correctly as long as the origin doesn't lie exactly on the box boundary in
+given axis.
+@see @ref rayRange(const RayPacket<4>&, const Range3D<Float>&, const RayPacketHits<4>&)
+*/
+template<class T> T rayRange(const Vector3<T>& origin, const Vector3<T>& inverseDirection, const Range3D<T>& range);
+
+/**
+@brief Intersection of a ray and a sphere
+@param origin       Ray origin
+@param direction    Ray direction, doesn't need to be normalized
+@param center       Sphere center
+@param radius       Sphere radius
+
+Returns the smallest non-negative distance @f$ t @f$ at which the ray hits the
+sphere surface --- if the origin is inside the sphere, it's the distance at
+which the ray leaves it. If the ray misses the sphere or the sphere lies behind
+the ray origin, returns @f$ \infty @f$.
+@see @ref raySphere(const RayPacket<4>&, const Vector3<Float>&, Float, RayPacketHits<4>&)
+*/
+template<class T> T raySphere(const Vector3<T>& origin, const Vector3<T>& direction, const Vector3<T>& center, T radius);
+
 /**
 @brief Intersection of a point and a camera frustum
 @param point    Point
@@ -169,6 +227,67 @@ of the frustum, since checking the corners is less efficient.
 */
 template<class T> bool boxFrustum(const Range3D<T>& box, const Frustum<T>& frustum);
 
+/**
+@brief Intersection of a sphere and a camera frustum
+@param center   Sphere center
+@param radius   Sphere radius
+@param frustum  Frustum planes with normals pointing outwards
+
+Returns @cpp true @ce if the sphere intersects with the camera frustum.
+
+Checks for each plane of the frustum whether the sphere center is further than
+@p radius behind the plane. The plane normals don't need to be normalized. Same
+as with @ref boxFrustum(), a sphere that lies outside of the frustum but not
+completely behind any single plane is considered as intersecting.
+*/
+template<class T> bool sphereFrustum(const Vector3<T>& center, T radius, const Frustum<T>& frustum);
+
+template<class T> Vector3<T> rayTriangle(const Vector3<T>& origin, const Vector3<T>& direction, const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& c) {
+    const Vector3<T> e1 = b - a;
+    const Vector3<T> e2 = c - a;
+    const Vector3<T> p = cross(direction, e2);
+    const T det = dot(e1, p);
+
+    /* Ray parallel to the triangle plane */
+    if(det == T(0)) return {Constants<T>::inf(), T(0), T(0)};
+
+    const T invDet = T(1)/det;
+    const Vector3<T> s = origin - a;
+    const T u = dot(s, p)*invDet;
+    const Vector3<T> q = cross(s, e1);
+    const T v = dot(direction, q)*invDet;
+    const T t = dot(e2, q)*invDet;
+
+    /* The negated comparisons make NaNs count as a miss */
+    if(!(u >= T(0) && v >= T(0) && u + v <= T(1) && t >= T(0)))
+        return {Constants<T>::inf(), u, v};
+
+    return {t, u, v};
+}
+
+template<class T> T rayRange(const Vector3<T>& origin, const Vector3<T>& inverseDirection, const Range3D<T>& range) {
+    const Vector3<T> t1 = (range.min() - origin)*inverseDirection;
+    const Vector3<T> t2 = (range.max() - origin)*inverseDirection;
+    const T tNear = Math::max(Math::min(t1, t2).max(), T(0));
+    const T tFar = Math::max(t1, t2).min();
+    return tNear <= tFar ? tNear : Constants<T>::inf();
+}
+
+template<class T> T raySphere(const Vector3<T>& origin, const Vector3<T>& direction, const Vector3<T>& center, const T radius) {
+    const Vector3<T> oc = origin - center;
+    const T a = dot(direction, direction);
+    const T b = dot(oc, direction);
+    const T c = dot(oc, oc) - radius*radius;
+    const T discriminant = b*b - a*c;
+    if(discriminant < T(0)) return Constants<T>::inf();
+
+    const T sqrtDiscriminant = std::sqrt(discriminant);
+    const T tNear = (-b - sqrtDiscriminant)/a;
+    if(tNear >= T(0)) return tNear;
+    const T tFar = (-b + sqrtDiscriminant)/a;
+    return tFar >= T(0) ? tFar : Constants<T>::inf();
+}
+
 template<class T> bool pointFrustum(const Vector3<T>& point, const Frustum<T>& frustum) {
     for(const Vector4<T>& plane: frustum.planes()) {
         /* The point is in front of one of the frustum planes (normals point
@@ -202,6 +321,16 @@ template<class T> bool boxFrustum(const Range3D<T>& box, const Frustum<T>& frust
     return true;
 }
 
+template<class T> bool sphereFrustum(const Vector3<T>& center, const T radius, const Frustum<T>& frustum) {
+    for(const Vector4<T>& plane: frustum.planes()) {
+        /* The sphere is completely in front of one of the frustum planes */
+        if(Distance::pointPlaneScaled<T>(center, plane) < -radius*plane.xyz().length())
+            return false;
+    }
+
+    return true;
+}
+
 }}}}
 
 #endif
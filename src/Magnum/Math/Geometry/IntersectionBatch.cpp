@@ -0,0 +1,395 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IntersectionBatch.h"
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Math { namespace Geometry { namespace Intersection {
+
+namespace {
+
+/* Range3D is expected to be six tightly packed floats, min followed by max,
+   so the blocked box test can address the components directly */
+static_assert(sizeof(Range3D<Float>) == 6*sizeof(Float), "unexpected Range3D layout");
+
+/* Frustum planes split into separate components. The tests use the exact same
+   operations as pointPlaneScaled(), so the results match the scalar
+   boxFrustum() and sphereFrustum(). The blocked variants test eight items at
+   once plane by plane, which lets the compiler keep the plane in registers
+   and vectorize over the items --- about twice as fast as testing one item
+   against all planes at a time. */
+struct FrustumPlanes {
+    explicit FrustumPlanes(const Frustum<Float>& frustum);
+
+    bool box(const Range3D<Float>& box) const;
+    UnsignedByte boxes8(const Range3D<Float>* boxes) const;
+    bool sphere(const Vector3<Float>& center, Float radius) const;
+    UnsignedByte spheres8(const Vector3<Float>* centers, const Float* radii) const;
+
+    Float x[6], y[6], z[6], w[6];
+    /* Plane normal lengths for the sphere test, negated */
+    Float length[6];
+};
+
+FrustumPlanes::FrustumPlanes(const Frustum<Float>& frustum) {
+    for(std::size_t i = 0; i != 6; ++i) {
+        const Vector4<Float>& plane = frustum[i];
+        x[i] = plane.x();
+        y[i] = plane.y();
+        z[i] = plane.z();
+        w[i] = plane.w();
+        length[i] = -plane.xyz().length();
+    }
+}
+
+inline bool FrustumPlanes::box(const Range3D<Float>& box) const {
+    const Vector3<Float>& min = box.min();
+    const Vector3<Float>& max = box.max();
+
+    /* For each plane test only the corner that's furthest along the plane
+       normal, if even that one is behind the plane, all others are too */
+    bool inside = true;
+    for(std::size_t i = 0; i != 6; ++i) {
+        const Float px = x[i] >= 0.0f ? max.x() : min.x();
+        const Float py = y[i] >= 0.0f ? max.y() : min.y();
+        const Float pz = z[i] >= 0.0f ? max.z() : min.z();
+        inside &= x[i]*px + y[i]*py + z[i]*pz + w[i] >= 0.0f;
+    }
+
+    return inside;
+}
+
+inline UnsignedByte FrustumPlanes::boxes8(const Range3D<Float>* const boxes) const {
+    const Float* const data = boxes->data();
+
+    bool inside[8];
+    for(std::size_t j = 0; j != 8; ++j) inside[j] = true;
+
+    for(std::size_t i = 0; i != 6; ++i) {
+        /* Pick the corner components once per plane instead of per box */
+        const Float* const px = data + (x[i] >= 0.0f ? 3 : 0);
+        const Float* const py = data + (y[i] >= 0.0f ? 4 : 1);
+        const Float* const pz = data + (z[i] >= 0.0f ? 5 : 2);
+        for(std::size_t j = 0; j != 8; ++j)
+            inside[j] &= x[i]*px[6*j] + y[i]*py[6*j] + z[i]*pz[6*j] + w[i] >= 0.0f;
+    }
+
+    UnsignedByte out = 0;
+    for(std::size_t j = 0; j != 8; ++j)
+        out |= UnsignedByte(inside[j]) << j;
+    return out;
+}
+
+inline bool FrustumPlanes::sphere(const Vector3<Float>& center, const Float radius) const {
+    bool inside = true;
+    for(std::size_t i = 0; i != 6; ++i)
+        inside &= x[i]*center.x() + y[i]*center.y() + z[i]*center.z() + w[i] >= radius*length[i];
+
+    return inside;
+}
+
+inline UnsignedByte FrustumPlanes::spheres8(const Vector3<Float>* const centers, const Float* const radii) const {
+    bool inside[8];
+    for(std::size_t j = 0; j != 8; ++j) inside[j] = true;
+
+    for(std::size_t i = 0; i != 6; ++i)
+        for(std::size_t j = 0; j != 8; ++j)
+            inside[j] &= x[i]*centers[j].x() + y[i]*centers[j].y() + z[i]*centers[j].z() + w[i] >= radii[j]*length[i];
+
+    UnsignedByte out = 0;
+    for(std::size_t j = 0; j != 8; ++j)
+        out |= UnsignedByte(inside[j]) << j;
+    return out;
+}
+
+/* Calls block(i) for each complete block of eight items and single(i) for the
+   remaining ones, output(i, bits) then receives visibility of up to eight
+   items starting at i */
+template<class Block, class Single, class Output> void forEachBlock(const std::size_t size, const Block& block, const Single& single, const Output& output) {
+    const std::size_t blockEnd = size & ~std::size_t{7};
+    for(std::size_t i = 0; i != blockEnd; i += 8)
+        output(i, block(i));
+
+    if(blockEnd == size) return;
+    UnsignedByte bits = 0;
+    for(std::size_t i = blockEnd; i != size; ++i)
+        bits |= UnsignedByte(single(i)) << (i - blockEnd);
+    output(blockEnd, bits);
+}
+
+template<class Block, class Single> void bitsInto(const std::size_t size, const Block& block, const Single& single, UnsignedByte* const visible) {
+    forEachBlock(size, block, single, [&](std::size_t i, UnsignedByte bits) {
+        visible[i/8] = bits;
+    });
+}
+
+/* Writing the index unconditionally and advancing the output only for
+   visible items avoids a hard-to-predict branch */
+template<class Block, class Single> std::size_t indicesInto(const std::size_t size, const Block& block, const Single& single, UnsignedInt* const indices) {
+    std::size_t count = 0;
+    forEachBlock(size, block, single, [&](std::size_t i, UnsignedByte bits) {
+        for(std::size_t j = 0, end = Math::min(size - i, std::size_t{8}); j != end; ++j) {
+            indices[count] = UnsignedInt(i + j);
+            count += (bits >> j) & 1;
+        }
+    });
+
+    return count;
+}
+
+template<class Block, class Single> void masksInto(const std::size_t size, const Corrade::Containers::ArrayView<const Frustum<Float>> frusta, const Block& block, const Single& single, UnsignedInt* const visible) {
+    for(std::size_t i = 0; i != size; ++i) visible[i] = 0;
+
+    for(std::size_t f = 0; f != frusta.size(); ++f) {
+        const FrustumPlanes planes{frusta[f]};
+        forEachBlock(size, [&](std::size_t i) {
+            return block(planes, i);
+        }, [&](std::size_t i) {
+            return single(planes, i);
+        }, [&](std::size_t i, UnsignedByte bits) {
+            for(std::size_t j = 0, end = Math::min(size - i, std::size_t{8}); j != end; ++j)
+                visible[i + j] |= UnsignedInt((bits >> j) & 1) << f;
+        });
+    }
+}
+
+/* Packet kernels, written with plain per-lane loops without any branches so
+   the compiler can turn each loop into a few SIMD instructions. The math is
+   the same as in the single-ray variants in Intersection.h. The conditions
+   are combined with & instead of && to avoid short-circuiting branches, the
+   hit mask is assembled in a separate loop. */
+template<UnsignedInt size> inline UnsignedByte packetMask(const Int(&hit)[size]) {
+    UnsignedByte mask = 0;
+    for(UnsignedInt i = 0; i != size; ++i)
+        mask |= UnsignedByte(hit[i] << i);
+    return mask;
+}
+
+template<UnsignedInt size> UnsignedByte rayTrianglePacket(const RayPacket<size>& rays, const Vector3<Float>& a, const Vector3<Float>& b, const Vector3<Float>& c, RayPacketHits<size>& hits) {
+    const Vector3<Float> e1 = b - a;
+    const Vector3<Float> e2 = c - a;
+
+    Int hit[size];
+    for(UnsignedInt i = 0; i != size; ++i) {
+        /* p = d × e2 */
+        const Float px = rays.directionY[i]*e2.z() - rays.directionZ[i]*e2.y();
+        const Float py = rays.directionZ[i]*e2.x() - rays.directionX[i]*e2.z();
+        const Float pz = rays.directionX[i]*e2.y() - rays.directionY[i]*e2.x();
+        const Float det = e1.x()*px + e1.y()*py + e1.z()*pz;
+        const Float invDet = 1.0f/det;
+
+        /* s = o - a, q = s × e1 */
+        const Float sx = rays.originX[i] - a.x();
+        const Float sy = rays.originY[i] - a.y();
+        const Float sz = rays.originZ[i] - a.z();
+        const Float u = (sx*px + sy*py + sz*pz)*invDet;
+        const Float qx = sy*e1.z() - sz*e1.y();
+        const Float qy = sz*e1.x() - sx*e1.z();
+        const Float qz = sx*e1.y() - sy*e1.x();
+        const Float v = (rays.directionX[i]*qx + rays.directionY[i]*qy + rays.directionZ[i]*qz)*invDet;
+        const Float t = (e2.x()*qx + e2.y()*qy + e2.z()*qz)*invDet;
+
+        hit[i] = (det != 0.0f) & (u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (t >= 0.0f) & (t < hits.distance[i]);
+        hits.distance[i] = hit[i] ? t : hits.distance[i];
+        hits.u[i] = hit[i] ? u : hits.u[i];
+        hits.v[i] = hit[i] ? v : hits.v[i];
+    }
+
+    return packetMask(hit);
+}
+
+template<UnsignedInt size> UnsignedByte rayRangePacket(const RayPacket<size>& rays, const Range3D<Float>& range, const RayPacketHits<size>& hits) {
+    const Vector3<Float>& min = range.min();
+    const Vector3<Float>& max = range.max();
+
+    Int hit[size];
+    for(UnsignedInt i = 0; i != size; ++i) {
+        const Float x1 = (min.x() - rays.originX[i])*rays.inverseDirectionX[i];
+        const Float x2 = (max.x() - rays.originX[i])*rays.inverseDirectionX[i];
+        const Float y1 = (min.y() - rays.originY[i])*rays.inverseDirectionY[i];
+        const Float y2 = (max.y() - rays.originY[i])*rays.inverseDirectionY[i];
+        const Float z1 = (min.z() - rays.originZ[i])*rays.inverseDirectionZ[i];
+        const Float z2 = (max.z() - rays.originZ[i])*rays.inverseDirectionZ[i];
+
+        /* Same operand order as Math::min() and Math::max() so NaNs are
+           treated the same way as in the single-ray variant */
+        const Float xNear = x2 < x1 ? x2 : x1, xFar = x1 < x2 ? x2 : x1;
+        const Float yNear = y2 < y1 ? y2 : y1, yFar = y1 < y2 ? y2 : y1;
+        const Float zNear = z2 < z1 ? z2 : z1, zFar = z1 < z2 ? z2 : z1;
+
+        Float tNear = xNear;
+        tNear = tNear < yNear ? yNear : tNear;
+        tNear = tNear < zNear ? zNear : tNear;
+        tNear = tNear < 0.0f ? 0.0f : tNear;
+        Float tFar = xFar;
+        tFar = yFar < tFar ? yFar : tFar;
+        tFar = zFar < tFar ? zFar : tFar;
+
+        hit[i] = (tNear <= tFar) & (tNear < hits.distance[i]);
+    }
+
+    return packetMask(hit);
+}
+
+template<UnsignedInt size> UnsignedByte raySpherePacket(const RayPacket<size>& rays, const Vector3<Float>& center, const Float radius, RayPacketHits<size>& hits) {
+    const Float radiusSquared = radius*radius;
+
+    Int hit[size];
+    for(UnsignedInt i = 0; i != size; ++i) {
+        const Float ocx = rays.originX[i] - center.x();
+        const Float ocy = rays.originY[i] - center.y();
+        const Float ocz = rays.originZ[i] - center.z();
+        const Float a = rays.directionX[i]*rays.directionX[i] + rays.directionY[i]*rays.directionY[i] + rays.directionZ[i]*rays.directionZ[i];
+        const Float b = ocx*rays.directionX[i] + ocy*rays.directionY[i] + ocz*rays.directionZ[i];
+        const Float c = ocx*ocx + ocy*ocy + ocz*ocz - radiusSquared;
+        const Float discriminant = b*b - a*c;
+
+        /* Clamping the discriminant avoids a NaN for rays that miss, the
+           hit condition below rejects those */
+        const Float sqrtDiscriminant = std::sqrt(discriminant < 0.0f ? 0.0f : discriminant);
+        const Float tNear = (-b - sqrtDiscriminant)/a;
+        const Float tFar = (-b + sqrtDiscriminant)/a;
+        const Float t = tNear >= 0.0f ? tNear : tFar;
+
+        hit[i] = (discriminant >= 0.0f) & (t >= 0.0f) & (t < hits.distance[i]);
+        hits.distance[i] = hit[i] ? t : hits.distance[i];
+    }
+
+    return packetMask(hit);
+}
+
+}
+
+UnsignedByte rayTriangle(const RayPacket<4>& rays, const Vector3<Float>& a, const Vector3<Float>& b, const Vector3<Float>& c, RayPacketHits<4>& hits) {
+    return rayTrianglePacket(rays, a, b, c, hits);
+}
+
+UnsignedByte rayTriangle(const RayPacket<8>& rays, const Vector3<Float>& a, const Vector3<Float>& b, const Vector3<Float>& c, RayPacketHits<8>& hits) {
+    return rayTrianglePacket(rays, a, b, c, hits);
+}
+
+UnsignedByte rayRange(const RayPacket<4>& rays, const Range3D<Float>& range, const RayPacketHits<4>& hits) {
+    return rayRangePacket(rays, range, hits);
+}
+
+UnsignedByte rayRange(const RayPacket<8>& rays, const Range3D<Float>& range, const RayPacketHits<8>& hits) {
+    return rayRangePacket(rays, range, hits);
+}
+
+UnsignedByte raySphere(const RayPacket<4>& rays, const Vector3<Float>& center, const Float radius, RayPacketHits<4>& hits) {
+    return raySpherePacket(rays, center, radius, hits);
+}
+
+UnsignedByte raySphere(const RayPacket<8>& rays, const Vector3<Float>& center, const Float radius, RayPacketHits<8>& hits) {
+    return raySpherePacket(rays, center, radius, hits);
+}
+
+void boxFrustumInto(const Corrade::Containers::ArrayView<const Range3D<Float>> boxes, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte> visible) {
+    CORRADE_ASSERT(visible.size() == (boxes.size() + 7)/8,
+        "Math::Geometry::Intersection::boxFrustumInto(): wrong output size, got" << visible.size() << "but expected" << (boxes.size() + 7)/8, );
+
+    const FrustumPlanes planes{frustum};
+    bitsInto(boxes.size(), [&](std::size_t i) {
+        return planes.boxes8(boxes + i);
+    }, [&](std::size_t i) {
+        return planes.box(boxes[i]);
+    }, visible.data());
+}
+
+std::size_t boxFrustumIndicesInto(const Corrade::Containers::ArrayView<const Range3D<Float>> boxes, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt> indices) {
+    CORRADE_ASSERT(indices.size() >= boxes.size(),
+        "Math::Geometry::Intersection::boxFrustumIndicesInto(): output too small, got" << indices.size() << "but expected at least" << boxes.size(), {});
+
+    const FrustumPlanes planes{frustum};
+    return indicesInto(boxes.size(), [&](std::size_t i) {
+        return planes.boxes8(boxes + i);
+    }, [&](std::size_t i) {
+        return planes.box(boxes[i]);
+    }, indices.data());
+}
+
+void sphereFrustumInto(const Corrade::Containers::ArrayView<const Vector3<Float>> centers, const Corrade::Containers::ArrayView<const Float> radii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte> visible) {
+    CORRADE_ASSERT(centers.size() == radii.size(),
+        "Math::Geometry::Intersection::sphereFrustumInto(): expected the same number of centers and radii, got" << centers.size() << "and" << radii.size(), );
+    CORRADE_ASSERT(visible.size() == (centers.size() + 7)/8,
+        "Math::Geometry::Intersection::sphereFrustumInto(): wrong output size, got" << visible.size() << "but expected" << (centers.size() + 7)/8, );
+
+    const FrustumPlanes planes{frustum};
+    bitsInto(centers.size(), [&](std::size_t i) {
+        return planes.spheres8(centers + i, radii + i);
+    }, [&](std::size_t i) {
+        return planes.sphere(centers[i], radii[i]);
+    }, visible.data());
+}
+
+std::size_t sphereFrustumIndicesInto(const Corrade::Containers::ArrayView<const Vector3<Float>> centers, const Corrade::Containers::ArrayView<const Float> radii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt> indices) {
+    CORRADE_ASSERT(centers.size() == radii.size(),
+        "Math::Geometry::Intersection::sphereFrustumIndicesInto(): expected the same number of centers and radii, got" << centers.size() << "and" << radii.size(), {});
+    CORRADE_ASSERT(indices.size() >= centers.size(),
+        "Math::Geometry::Intersection::sphereFrustumIndicesInto(): output too small, got" << indices.size() << "but expected at least" << centers.size(), {});
+
+    const FrustumPlanes planes{frustum};
+    return indicesInto(centers.size(), [&](std::size_t i) {
+        return planes.spheres8(centers + i, radii + i);
+    }, [&](std::size_t i) {
+        return planes.sphere(centers[i], radii[i]);
+    }, indices.data());
+}
+
+void boxFrustaInto(const Corrade::Containers::ArrayView<const Range3D<Float>> boxes, const Corrade::Containers::ArrayView<const Frustum<Float>> frusta, const Corrade::Containers::ArrayView<UnsignedInt> visible) {
+    CORRADE_ASSERT(frusta.size() <= 32,
+        "Math::Geometry::Intersection::boxFrustaInto(): expected at most 32 frusta, got" << frusta.size(), );
+    CORRADE_ASSERT(visible.size() == boxes.size(),
+        "Math::Geometry::Intersection::boxFrustaInto(): wrong output size, got" << visible.size() << "but expected" << boxes.size(), );
+
+    masksInto(boxes.size(), frusta, [&](const FrustumPlanes& planes, std::size_t i) {
+        return planes.boxes8(boxes + i);
+    }, [&](const FrustumPlanes& planes, std::size_t i) {
+        return planes.box(boxes[i]);
+    }, visible.data());
+}
+
+void sphereFrustaInto(const Corrade::Containers::ArrayView<const Vector3<Float>> centers, const Corrade::Containers::ArrayView<const Float> radii, const Corrade::Containers::ArrayView<const Frustum<Float>> frusta, const Corrade::Containers::ArrayView<UnsignedInt> visible) {
+    CORRADE_ASSERT(centers.size() == radii.size(),
+        "Math::Geometry::Intersection::sphereFrustaInto(): expected the same number of centers and radii, got" << centers.size() << "and" << radii.size(), );
+    CORRADE_ASSERT(frusta.size() <= 32,
+        "Math::Geometry::Intersection::sphereFrustaInto(): expected at most 32 frusta, got" << frusta.size(), );
+    CORRADE_ASSERT(visible.size() == centers.size(),
+        "Math::Geometry::Intersection::sphereFrustaInto(): wrong output size, got" << visible.size() << "but expected" << centers.size(), );
+
+    masksInto(centers.size(), frusta, [&](const FrustumPlanes& planes, std::size_t i) {
+        return planes.spheres8(centers + i, radii + i);
+    }, [&](const FrustumPlanes& planes, std::size_t i) {
+        return planes.sphere(centers[i], radii[i]);
+    }, visible.data());
+}
+
+}}}}
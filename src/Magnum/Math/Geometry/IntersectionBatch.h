@@ -0,0 +1,272 @@
+#ifndef Magnum_Math_Geometry_IntersectionBatch_h
+#define Magnum_Math_Geometry_IntersectionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Geometry::Intersection::boxFrustumInto(), @ref Magnum::Math::Geometry::Intersection::boxFrustumIndicesInto(), @ref Magnum::Math::Geometry::Intersection::sphereFrustumInto(), @ref Magnum::Math::Geometry::Intersection::sphereFrustumIndicesInto(), @ref Magnum::Math::Geometry::Intersection::boxFrustaInto(), @ref Magnum::Math::Geometry::Intersection::sphereFrustaInto(), @ref Magnum::Math::Geometry::Intersection::rayTriangle(), @ref Magnum::Math::Geometry::Intersection::rayRange(), @ref Magnum::Math::Geometry::Intersection::raySphere(), class @ref Magnum::Math::Geometry::Intersection::RayPacket, @ref Magnum::Math::Geometry::Intersection::RayPacketHits, typedef @ref Magnum::Math::Geometry::Intersection::RayPacket4, @ref Magnum::Math::Geometry::Intersection::RayPacket8, @ref Magnum::Math::Geometry::Intersection::RayPacketHits4, @ref Magnum::Math::Geometry::Intersection::RayPacketHits8
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math { namespace Geometry { namespace Intersection {
+
+/**
+@brief Intersection of axis-aligned boxes and a camera frustum
+@param boxes    Axis-aligned boxes
+@param frustum  Frustum planes with normals pointing outwards
+@param visible  Where to put the visibility bits
+
+Batch variant of @ref boxFrustum(). Sets bit @cpp i % 8 @ce of byte
+@cpp visible[i/8] @ce if @cpp boxes[i] @ce intersects the frustum, using the
+same bit order as @ref BoolVector. Unused bits of the last byte are set to
+zero. Size of @p visible is expected to be @cpp (boxes.size() + 7)/8 @ce.
+
+Instead of testing all eight corners, for each plane only the corner furthest
+along the plane normal is checked, with the planes preprocessed upfront. The
+result is the same as with @ref boxFrustum() --- i.e., a box that lies outside
+of the frustum but doesn't lie completely on the outer side of any plane is
+considered intersecting.
+@see @ref boxFrustumIndicesInto(), @ref boxFrustaInto()
+*/
+MAGNUM_EXPORT void boxFrustumInto(Corrade::Containers::ArrayView<const Range3D<Float>> boxes, const Frustum<Float>& frustum, Corrade::Containers::ArrayView<UnsignedByte> visible);
+
+/**
+@brief Indices of axis-aligned boxes intersecting a camera frustum
+@param boxes    Axis-aligned boxes
+@param frustum  Frustum planes with normals pointing outwards
+@param indices  Where to put indices of the intersecting boxes
+
+Like @ref boxFrustumInto(), but writes the indices of intersecting boxes in
+ascending order to the front of @p indices and returns their count. Size of
+@p indices is expected to be at least @cpp boxes.size() @ce, the contents past
+the returned count are unspecified.
+*/
+MAGNUM_EXPORT std::size_t boxFrustumIndicesInto(Corrade::Containers::ArrayView<const Range3D<Float>> boxes, const Frustum<Float>& frustum, Corrade::Containers::ArrayView<UnsignedInt> indices);
+
+/**
+@brief Intersection of spheres and a camera frustum
+@param centers  Sphere centers
+@param radii    Sphere radii
+@param frustum  Frustum planes with normals pointing outwards
+@param visible  Where to put the visibility bits
+
+Batch variant of @ref sphereFrustum(), see @ref boxFrustumInto() for
+description of the output. Sizes of @p centers and @p radii are expected to be
+the same, size of @p visible is expected to be
+@cpp (centers.size() + 7)/8 @ce.
+@see @ref sphereFrustumIndicesInto(), @ref sphereFrustaInto()
+*/
+MAGNUM_EXPORT void sphereFrustumInto(Corrade::Containers::ArrayView<const Vector3<Float>> centers, Corrade::Containers::ArrayView<const Float> radii, const Frustum<Float>& frustum, Corrade::Containers::ArrayView<UnsignedByte> visible);
+
+/**
+@brief Indices of spheres intersecting a camera frustum
+@param centers  Sphere centers
+@param radii    Sphere radii
+@param frustum  Frustum planes with normals pointing outwards
+@param indices  Where to put indices of the intersecting spheres
+
+Like @ref sphereFrustumInto(), but outputs a list of indices, see
+@ref boxFrustumIndicesInto() for details.
+*/
+MAGNUM_EXPORT std::size_t sphereFrustumIndicesInto(Corrade::Containers::ArrayView<const Vector3<Float>> centers, Corrade::Containers::ArrayView<const Float> radii, const Frustum<Float>& frustum, Corrade::Containers::ArrayView<UnsignedInt> indices);
+
+/**
+@brief Intersection of axis-aligned boxes and multiple camera frusta
+@param boxes    Axis-aligned boxes
+@param frusta   Frusta, at most 32
+@param visible  Where to put the visibility masks
+
+Sets bit @cpp j @ce of @cpp visible[i] @ce if @cpp boxes[i] @ce intersects
+@cpp frusta[j] @ce, a box is thus visible in at least one of the frusta if its
+mask is non-zero. Useful for example for culling against all shadow map
+cascades at once. The test is conservative in the same way as with
+@ref boxFrustum(). Size of @p visible is expected to be the same as size of
+@p boxes.
+*/
+MAGNUM_EXPORT void boxFrustaInto(Corrade::Containers::ArrayView<const Range3D<Float>> boxes, Corrade::Containers::ArrayView<const Frustum<Float>> frusta, Corrade::Containers::ArrayView<UnsignedInt> visible);
+
+/**
+@brief Intersection of spheres and multiple camera frusta
+@param centers  Sphere centers
+@param radii    Sphere radii
+@param frusta   Frusta, at most 32
+@param visible  Where to put the visibility masks
+
+Sphere variant of @ref boxFrustaInto(). Sizes of @p centers, @p radii and
+@p visible are expected to be the same.
+*/
+MAGNUM_EXPORT void sphereFrustaInto(Corrade::Containers::ArrayView<const Vector3<Float>> centers, Corrade::Containers::ArrayView<const Float> radii, Corrade::Containers::ArrayView<const Frustum<Float>> frusta, Corrade::Containers::ArrayView<UnsignedInt> visible);
+
+/**
+@brief Ray packet
+
+A fixed number of rays stored in a structure-of-arrays layout, so the packet
+intersection functions such as
+@ref rayTriangle(const RayPacket<4>&, const Vector3<Float>&, const Vector3<Float>&, const Vector3<Float>&, RayPacketHits<4>&)
+can process all rays at once with SIMD instructions. Meant for coherent rays
+traversing the same acceleration structure, for example a BVH built over
+triangles of a @ref Trade::MeshData3D --- the whole packet descends into a
+node if any of its rays hits the node bounds. Only packets of 4 and 8 rays are
+supported, see @ref RayPacket4 and @ref RayPacket8.
+@see @ref RayPacketHits
+*/
+template<UnsignedInt size> struct RayPacket {
+    static_assert(size == 4 || size == 8, "only packets of 4 and 8 rays are supported");
+
+    /**
+     * @brief Set a ray
+     *
+     * Besides origin and direction calculates also the inverted direction
+     * used by @ref rayRange(const RayPacket<4>&, const Range3D<Float>&, const RayPacketHits<4>&).
+     * The direction doesn't need to be normalized.
+     */
+    void set(UnsignedInt i, const Vector3<Float>& origin, const Vector3<Float>& direction) {
+        originX[i] = origin.x();
+        originY[i] = origin.y();
+        originZ[i] = origin.z();
+        directionX[i] = direction.x();
+        directionY[i] = direction.y();
+        directionZ[i] = direction.z();
+        inverseDirectionX[i] = 1.0f/direction.x();
+        inverseDirectionY[i] = 1.0f/direction.y();
+        inverseDirectionZ[i] = 1.0f/direction.z();
+    }
+
+    Float originX[size];            /**< @brief Origin X components */
+    Float originY[size];            /**< @brief Origin Y components */
+    Float originZ[size];            /**< @brief Origin Z components */
+    Float directionX[size];         /**< @brief Direction X components */
+    Float directionY[size];         /**< @brief Direction Y components */
+    Float directionZ[size];         /**< @brief Direction Z components */
+    Float inverseDirectionX[size];  /**< @brief Inverted direction X components */
+    Float inverseDirectionY[size];  /**< @brief Inverted direction Y components */
+    Float inverseDirectionZ[size];  /**< @brief Inverted direction Z components */
+};
+
+/** @brief Packet of four rays */
+typedef RayPacket<4> RayPacket4;
+
+/** @brief Packet of eight rays */
+typedef RayPacket<8> RayPacket8;
+
+/**
+@brief Ray packet hits
+
+Closest hits found so far for each ray in a @ref RayPacket. The default
+constructor sets all distances to @f$ \infty @f$, set them to a finite value
+to limit the ray length.
+*/
+template<UnsignedInt size> struct RayPacketHits {
+    static_assert(size == 4 || size == 8, "only packets of 4 and 8 rays are supported");
+
+    /** @brief Constructor */
+    /*implicit*/ RayPacketHits() {
+        for(UnsignedInt i = 0; i != size; ++i) {
+            distance[i] = Constants<Float>::inf();
+            u[i] = v[i] = 0.0f;
+        }
+    }
+
+    /** @brief Distance of the closest hit along each ray direction */
+    Float distance[size];
+
+    /** @brief First barycentric coordinate of the closest triangle hit */
+    Float u[size];
+
+    /** @brief Second barycentric coordinate of the closest triangle hit */
+    Float v[size];
+};
+
+/** @brief Hits of a packet of four rays */
+typedef RayPacketHits<4> RayPacketHits4;
+
+/** @brief Hits of a packet of eight rays */
+typedef RayPacketHits<8> RayPacketHits8;
+
+/**
+@brief Intersection of a ray packet and a triangle
+@param rays     Ray packet
+@param a        First triangle vertex
+@param b        Second triangle vertex
+@param c        Third triangle vertex
+@param hits     Closest hits found so far
+
+Packet variant of @ref rayTriangle(const Vector3<T>&, const Vector3<T>&, const Vector3<T>&, const Vector3<T>&, const Vector3<T>&).
+For each ray that hits the triangle closer than @cpp hits.distance[i] @ce
+updates the distance and barycentric coordinates. Returns a mask with bit
+@cpp i @ce set for each updated ray, so the caller can record which triangle
+was hit. The calculation is the same as in the single-ray variant, so the
+results are the same as well.
+*/
+MAGNUM_EXPORT UnsignedByte rayTriangle(const RayPacket<4>& rays, const Vector3<Float>& a, const Vector3<Float>& b, const Vector3<Float>& c, RayPacketHits<4>& hits);
+
+/** @overload */
+MAGNUM_EXPORT UnsignedByte rayTriangle(const RayPacket<8>& rays, const Vector3<Float>& a, const Vector3<Float>& b, const Vector3<Float>& c, RayPacketHits<8>& hits);
+
+/**
+@brief Intersection of a ray packet and an axis-aligned box
+@param rays     Ray packet
+@param range    Axis-aligned box
+@param hits     Closest hits found so far
+
+Packet variant of @ref rayRange(const Vector3<T>&, const Vector3<T>&, const Range3D<T>&).
+Returns a mask with bit @cpp i @ce set if ray @cpp i @ce enters the box before
+@cpp hits.distance[i] @ce. Meant for BVH traversal --- if the mask is zero,
+none of the rays can find a closer hit inside the box and the whole node can
+be skipped.
+*/
+MAGNUM_EXPORT UnsignedByte rayRange(const RayPacket<4>& rays, const Range3D<Float>& range, const RayPacketHits<4>& hits);
+
+/** @overload */
+MAGNUM_EXPORT UnsignedByte rayRange(const RayPacket<8>& rays, const Range3D<Float>& range, const RayPacketHits<8>& hits);
+
+/**
+@brief Intersection of a ray packet and a sphere
+@param rays     Ray packet
+@param center   Sphere center
+@param radius   Sphere radius
+@param hits     Closest hits found so far
+
+Packet variant of @ref raySphere(const Vector3<T>&, const Vector3<T>&, const Vector3<T>&, T).
+For each ray that hits the sphere closer than @cpp hits.distance[i] @ce
+updates the distance, the barycentric coordinates are left untouched. Returns
+a mask with bit @cpp i @ce set for each updated ray.
+*/
+MAGNUM_EXPORT UnsignedByte raySphere(const RayPacket<4>& rays, const Vector3<Float>& center, Float radius, RayPacketHits<4>& hits);
+
+/** @overload */
+MAGNUM_EXPORT UnsignedByte raySphere(const RayPacket<8>& rays, const Vector3<Float>& center, Float radius, RayPacketHits<8>& hits);
+
+}}}}
+
+#endif
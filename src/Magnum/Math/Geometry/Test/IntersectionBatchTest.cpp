@@ -0,0 +1,571 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+#include "Magnum/Math/Geometry/IntersectionBatch.h"
+
+namespace Magnum { namespace Math { namespace Geometry { namespace Test {
+
+struct IntersectionBatchTest: Corrade::TestSuite::Tester {
+    explicit IntersectionBatchTest();
+
+    void boxFrustum();
+    void boxFrustumIndices();
+    void boxFrustumPadding();
+    void sphereFrustum();
+    void sphereFrustumIndices();
+    void boxFrusta();
+    void sphereFrusta();
+    void empty();
+    template<UnsignedInt size> void rayTrianglePacket();
+    template<UnsignedInt size> void rayRangePacket();
+    template<UnsignedInt size> void raySpherePacket();
+    void rayPacketClosestHit();
+
+    void boxFrustum200k();
+    void boxFrustum200kIndices();
+    void boxFrustum200kScalar();
+    void sphereFrustum200k();
+    void sphereFrustum200kScalar();
+    void boxFrusta200k();
+    void rayTriangle64kScalar();
+    void rayTriangle64kPacket4();
+    void rayTriangle64kPacket8();
+    void rayRange64kScalar();
+    void rayRange64kPacket8();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Frustum<Float> Frustum;
+typedef Math::Range3D<Float> Range3D;
+typedef Math::Deg<Float> Deg;
+
+IntersectionBatchTest::IntersectionBatchTest() {
+    addTests({&IntersectionBatchTest::boxFrustum,
+              &IntersectionBatchTest::boxFrustumIndices,
+              &IntersectionBatchTest::boxFrustumPadding,
+              &IntersectionBatchTest::sphereFrustum,
+              &IntersectionBatchTest::sphereFrustumIndices,
+              &IntersectionBatchTest::boxFrusta,
+              &IntersectionBatchTest::sphereFrusta,
+              &IntersectionBatchTest::empty,
+              &IntersectionBatchTest::rayTrianglePacket<4>,
+              &IntersectionBatchTest::rayTrianglePacket<8>,
+              &IntersectionBatchTest::rayRangePacket<4>,
+              &IntersectionBatchTest::rayRangePacket<8>,
+              &IntersectionBatchTest::raySpherePacket<4>,
+              &IntersectionBatchTest::raySpherePacket<8>,
+              &IntersectionBatchTest::rayPacketClosestHit});
+
+    addBenchmarks({&IntersectionBatchTest::boxFrustum200k,
+                   &IntersectionBatchTest::boxFrustum200kIndices,
+                   &IntersectionBatchTest::boxFrustum200kScalar,
+                   &IntersectionBatchTest::sphereFrustum200k,
+                   &IntersectionBatchTest::sphereFrustum200kScalar,
+                   &IntersectionBatchTest::boxFrusta200k,
+                   &IntersectionBatchTest::rayTriangle64kScalar,
+                   &IntersectionBatchTest::rayTriangle64kPacket4,
+                   &IntersectionBatchTest::rayTriangle64kPacket8,
+                   &IntersectionBatchTest::rayRange64kScalar,
+                   &IntersectionBatchTest::rayRange64kPacket8}, 10);
+}
+
+namespace {
+
+/* A perspective camera looking down -Z from the origin and few cascade-like
+   slices of it */
+const Frustum CameraFrustum = Frustum::fromMatrix(
+    Matrix4::perspectiveProjection(Deg{60.0f}, 1.5f, 0.5f, 50.0f));
+
+const Frustum CascadeFrusta[]{
+    Frustum::fromMatrix(Matrix4::perspectiveProjection(Deg{60.0f}, 1.5f, 0.5f, 5.0f)),
+    Frustum::fromMatrix(Matrix4::perspectiveProjection(Deg{60.0f}, 1.5f, 5.0f, 15.0f)),
+    Frustum::fromMatrix(Matrix4::perspectiveProjection(Deg{60.0f}, 1.5f, 15.0f, 50.0f))};
+
+/* Deterministic boxes of varying sizes scattered around the camera, a good
+   portion of them inside, outside and crossing the frustum planes */
+Corrade::Containers::Array<Range3D> boxes(const std::size_t count) {
+    Corrade::Containers::Array<Range3D> out{count};
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 center{Float(Int(i*7 % 101) - 50),
+                             Float(Int(i*13 % 61) - 30),
+                             Float(Int(i*3 % 79) - 70)};
+        const Vector3 halfSize{0.25f + Float(i % 5)*0.5f,
+                               0.25f + Float(i % 3)*0.75f,
+                               0.25f + Float(i % 7)*0.25f};
+        out[i] = Range3D{center - halfSize, center + halfSize};
+    }
+    return out;
+}
+
+Corrade::Containers::Array<Float> radii(const std::size_t count) {
+    Corrade::Containers::Array<Float> out{count};
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = 0.25f + Float(i % 9)*0.5f;
+    return out;
+}
+
+Corrade::Containers::Array<Vector3> centers(const Corrade::Containers::ArrayView<const Range3D> boxes) {
+    Corrade::Containers::Array<Vector3> out{boxes.size()};
+    for(std::size_t i = 0; i != boxes.size(); ++i)
+        out[i] = boxes[i].center();
+    return out;
+}
+
+/* Deterministic rays from around the origin, mostly pointing down -Z towards
+   the boxes, with some of them parallel to the axes */
+Vector3 rayOrigin(const std::size_t i) {
+    return {Float(Int(i*5 % 11) - 5)*0.25f,
+            Float(Int(i*3 % 7) - 3)*0.25f,
+            Float(i % 3)};
+}
+
+Vector3 rayDirection(const std::size_t i) {
+    return {i % 5 ? Float(Int(i*7 % 13) - 6)*0.1f : 0.0f,
+            i % 4 ? Float(Int(i*11 % 17) - 8)*0.1f : 0.0f,
+            i % 6 ? -1.0f - Float(i % 3) : -0.5f};
+}
+
+}
+
+template<UnsignedInt size> void IntersectionBatchTest::rayTrianglePacket() {
+    const Vector3 triangles[][3]{
+        {{-2.0f, -2.0f, -5.0f}, {2.0f, -2.0f, -5.0f}, {-2.0f, 2.0f, -5.0f}},
+        {{0.0f, 0.0f, -1.0f}, {0.5f, 0.0f, -2.0f}, {0.0f, 0.5f, -1.5f}},
+        /* Parallel to the Z axis */
+        {{-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -10.0f}}};
+
+    std::size_t mismatches = 0, hitCount = 0;
+    for(std::size_t packet = 0; packet != 64; ++packet) {
+        Intersection::RayPacket<size> rays;
+        for(UnsignedInt i = 0; i != size; ++i)
+            rays.set(i, rayOrigin(packet*size + i), rayDirection(packet*size + i));
+
+        for(const auto& triangle: triangles) {
+            Intersection::RayPacketHits<size> hits;
+            const UnsignedByte mask = Intersection::rayTriangle(rays, triangle[0], triangle[1], triangle[2], hits);
+            for(UnsignedInt i = 0; i != size; ++i) {
+                const Vector3 expected = Intersection::rayTriangle(rayOrigin(packet*size + i), rayDirection(packet*size + i), triangle[0], triangle[1], triangle[2]);
+                const bool hit = expected.x() != Constants<Float>::inf();
+                if(bool(mask & (1 << i)) != hit || hits.distance[i] != expected.x() || (hit && (hits.u[i] != expected.y() || hits.v[i] != expected.z())))
+                    ++mismatches;
+                if(hit) ++hitCount;
+            }
+        }
+    }
+
+    CORRADE_COMPARE_AS(hitCount, std::size_t{10}, Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+template<UnsignedInt size> void IntersectionBatchTest::rayRangePacket() {
+    const Corrade::Containers::Array<Range3D> in = boxes(50);
+
+    std::size_t mismatches = 0, hitCount = 0;
+    for(std::size_t packet = 0; packet != 64; ++packet) {
+        Intersection::RayPacket<size> rays;
+        Intersection::RayPacketHits<size> hits;
+        for(UnsignedInt i = 0; i != size; ++i) {
+            rays.set(i, rayOrigin(packet*size + i), rayDirection(packet*size + i));
+            /* Limit some of the rays */
+            if(i % 2) hits.distance[i] = 20.0f;
+        }
+
+        for(const Range3D& box: in) {
+            const UnsignedByte mask = Intersection::rayRange(rays, box, hits);
+            for(UnsignedInt i = 0; i != size; ++i) {
+                const Float expected = Intersection::rayRange(rayOrigin(packet*size + i), 1.0f/rayDirection(packet*size + i), box);
+                const bool hit = expected < hits.distance[i];
+                if(bool(mask & (1 << i)) != hit) ++mismatches;
+                if(hit) ++hitCount;
+            }
+        }
+    }
+
+    CORRADE_COMPARE_AS(hitCount, std::size_t{10}, Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+template<UnsignedInt size> void IntersectionBatchTest::raySpherePacket() {
+    const Corrade::Containers::Array<Vector3> c = centers(boxes(50));
+    const Corrade::Containers::Array<Float> r = radii(c.size());
+
+    std::size_t mismatches = 0, hitCount = 0;
+    for(std::size_t packet = 0; packet != 64; ++packet) {
+        Intersection::RayPacket<size> rays;
+        for(UnsignedInt i = 0; i != size; ++i)
+            rays.set(i, rayOrigin(packet*size + i), rayDirection(packet*size + i));
+
+        for(std::size_t j = 0; j != c.size(); ++j) {
+            Intersection::RayPacketHits<size> hits;
+            const UnsignedByte mask = Intersection::raySphere(rays, c[j], r[j], hits);
+            for(UnsignedInt i = 0; i != size; ++i) {
+                const Float expected = Intersection::raySphere(rayOrigin(packet*size + i), rayDirection(packet*size + i), c[j], r[j]);
+                const bool hit = expected != Constants<Float>::inf();
+                if(bool(mask & (1 << i)) != hit || hits.distance[i] != expected)
+                    ++mismatches;
+                if(hit) ++hitCount;
+            }
+        }
+    }
+
+    CORRADE_COMPARE_AS(hitCount, std::size_t{10}, Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+namespace {
+
+/* A grid of triangles facing +Z at various depths */
+Corrade::Containers::Array<Vector3> triangleSoup(const std::size_t count) {
+    Corrade::Containers::Array<Vector3> out{count*3};
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 base{Float(Int(i % 16) - 8)*0.5f,
+                           Float(Int(i/16 % 16) - 8)*0.5f,
+                           -1.0f - Float(i % 7)};
+        out[i*3 + 0] = base;
+        out[i*3 + 1] = base + Vector3{1.0f, 0.0f, 0.0f};
+        out[i*3 + 2] = base + Vector3{0.0f, 1.0f, 0.25f};
+    }
+    return out;
+}
+
+}
+
+void IntersectionBatchTest::boxFrustum() {
+    const Corrade::Containers::Array<Range3D> in = boxes(1000);
+    Corrade::Containers::Array<UnsignedByte> visible{(in.size() + 7)/8};
+    Intersection::boxFrustumInto(in, CameraFrustum, visible);
+
+    std::size_t mismatchCount = 0, visibleCount = 0;
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        const bool expected = Intersection::boxFrustum(in[i], CameraFrustum);
+        if(bool(visible[i/8] & (1 << i%8)) != expected) ++mismatchCount;
+        if(expected) ++visibleCount;
+    }
+
+    CORRADE_COMPARE(mismatchCount, 0);
+    /* Verify the data set is not degenerate */
+    CORRADE_COMPARE_AS(visibleCount, std::size_t{50}, Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(visibleCount, std::size_t{950}, Corrade::TestSuite::Compare::Less);
+}
+
+void IntersectionBatchTest::boxFrustumIndices() {
+    const Corrade::Containers::Array<Range3D> in = boxes(1000);
+    Corrade::Containers::Array<UnsignedInt> indices{in.size()};
+    const std::size_t count = Intersection::boxFrustumIndicesInto(in, CameraFrustum, indices);
+
+    std::vector<UnsignedInt> expected;
+    for(std::size_t i = 0; i != in.size(); ++i)
+        if(Intersection::boxFrustum(in[i], CameraFrustum))
+            expected.push_back(UnsignedInt(i));
+
+    CORRADE_COMPARE(count, expected.size());
+    CORRADE_COMPARE(std::vector<UnsignedInt>(indices.begin(), indices.begin() + count), expected);
+}
+
+void IntersectionBatchTest::boxFrustumPadding() {
+    /* Ten boxes, all visible -- the unused bits of the last byte should be
+       cleared */
+    Range3D in[10];
+    for(Range3D& box: in) box = Range3D{{-1.0f, -1.0f, -10.0f}, {1.0f, 1.0f, -5.0f}};
+    UnsignedByte visible[]{0xff, 0xff};
+    Intersection::boxFrustumInto(in, CameraFrustum, visible);
+
+    CORRADE_COMPARE(visible[0], 0xff);
+    CORRADE_COMPARE(visible[1], 0x03);
+}
+
+void IntersectionBatchTest::sphereFrustum() {
+    const Corrade::Containers::Array<Vector3> in = centers(boxes(1000));
+    const Corrade::Containers::Array<Float> r = radii(in.size());
+    Corrade::Containers::Array<UnsignedByte> visible{(in.size() + 7)/8};
+    Intersection::sphereFrustumInto(in, r, CameraFrustum, visible);
+
+    std::size_t mismatchCount = 0, visibleCount = 0;
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        const bool expected = Intersection::sphereFrustum(in[i], r[i], CameraFrustum);
+        if(bool(visible[i/8] & (1 << i%8)) != expected) ++mismatchCount;
+        if(expected) ++visibleCount;
+    }
+
+    CORRADE_COMPARE(mismatchCount, 0);
+    CORRADE_COMPARE_AS(visibleCount, std::size_t{50}, Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(visibleCount, std::size_t{950}, Corrade::TestSuite::Compare::Less);
+}
+
+void IntersectionBatchTest::sphereFrustumIndices() {
+    const Corrade::Containers::Array<Vector3> in = centers(boxes(1000));
+    const Corrade::Containers::Array<Float> r = radii(in.size());
+    Corrade::Containers::Array<UnsignedInt> indices{in.size()};
+    const std::size_t count = Intersection::sphereFrustumIndicesInto(in, r, CameraFrustum, indices);
+
+    std::vector<UnsignedInt> expected;
+    for(std::size_t i = 0; i != in.size(); ++i)
+        if(Intersection::sphereFrustum(in[i], r[i], CameraFrustum))
+            expected.push_back(UnsignedInt(i));
+
+    CORRADE_COMPARE(count, expected.size());
+    CORRADE_COMPARE(std::vector<UnsignedInt>(indices.begin(), indices.begin() + count), expected);
+}
+
+void IntersectionBatchTest::boxFrusta() {
+    const Corrade::Containers::Array<Range3D> in = boxes(1000);
+    Corrade::Containers::Array<UnsignedInt> visible{in.size()};
+    Intersection::boxFrustaInto(in, CascadeFrusta, visible);
+
+    std::size_t mismatchCount = 0, multipleCount = 0;
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        UnsignedInt expected = 0;
+        for(std::size_t j = 0; j != 3; ++j)
+            expected |= UnsignedInt(Intersection::boxFrustum(in[i], CascadeFrusta[j])) << j;
+        if(visible[i] != expected) ++mismatchCount;
+        if(expected & (expected - 1)) ++multipleCount;
+    }
+
+    CORRADE_COMPARE(mismatchCount, 0);
+    /* Boxes crossing a cascade boundary are in more than one */
+    CORRADE_COMPARE_AS(multipleCount, std::size_t{0}, Corrade::TestSuite::Compare::Greater);
+}
+
+void IntersectionBatchTest::sphereFrusta() {
+    const Corrade::Containers::Array<Vector3> in = centers(boxes(1000));
+    const Corrade::Containers::Array<Float> r = radii(in.size());
+    Corrade::Containers::Array<UnsignedInt> visible{in.size()};
+    Intersection::sphereFrustaInto(in, r, CascadeFrusta, visible);
+
+    std::size_t mismatchCount = 0;
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        UnsignedInt expected = 0;
+        for(std::size_t j = 0; j != 3; ++j)
+            expected |= UnsignedInt(Intersection::sphereFrustum(in[i], r[i], CascadeFrusta[j])) << j;
+        if(visible[i] != expected) ++mismatchCount;
+    }
+
+    CORRADE_COMPARE(mismatchCount, 0);
+}
+
+void IntersectionBatchTest::empty() {
+    /* Shouldn't crash or write anything */
+    Intersection::boxFrustumInto(nullptr, CameraFrustum, nullptr);
+    Intersection::sphereFrustumInto(nullptr, nullptr, CameraFrustum, nullptr);
+    Intersection::boxFrustaInto(nullptr, CascadeFrusta, nullptr);
+    CORRADE_COMPARE(Intersection::boxFrustumIndicesInto(nullptr, CameraFrustum, nullptr), 0);
+    CORRADE_COMPARE(Intersection::sphereFrustumIndicesInto(nullptr, nullptr, CameraFrustum, nullptr), 0);
+}
+
+void IntersectionBatchTest::rayPacketClosestHit() {
+    Intersection::RayPacket4 rays;
+    for(UnsignedInt i = 0; i != 4; ++i)
+        rays.set(i, {Float(i)*0.1f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f});
+
+    /* Limit the last ray so it doesn't reach anything */
+    Intersection::RayPacketHits4 hits;
+    hits.distance[3] = 0.5f;
+
+    /* Far triangle first, then a closer one that's hit only by the first two
+       rays, then the far one again which shouldn't update anything */
+    CORRADE_COMPARE(Intersection::rayTriangle(rays, {-1.0f, -1.0f, -3.0f}, {2.0f, -1.0f, -3.0f}, {-1.0f, 2.0f, -3.0f}, hits), 0x7);
+    CORRADE_COMPARE(Intersection::rayTriangle(rays, {-1.0f, -1.0f, -2.0f}, {0.725f, -1.0f, -2.0f}, {-1.0f, 2.0f, -2.0f}, hits), 0x3);
+    CORRADE_COMPARE(Intersection::rayTriangle(rays, {-1.0f, -1.0f, -3.0f}, {2.0f, -1.0f, -3.0f}, {-1.0f, 2.0f, -3.0f}, hits), 0);
+    CORRADE_COMPARE(hits.distance[0], 2.0f);
+    CORRADE_COMPARE(hits.distance[1], 2.0f);
+    CORRADE_COMPARE(hits.distance[2], 3.0f);
+    CORRADE_COMPARE(hits.distance[3], 0.5f);
+
+    /* Box test honors the current distances */
+    CORRADE_COMPARE(Intersection::rayRange(rays, Range3D{{-1.0f, -1.0f, -2.5f}, {1.0f, 1.0f, -2.25f}}, hits), 0x4);
+    CORRADE_COMPARE(Intersection::rayRange(rays, Range3D{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 0.0f}}, hits), 0xf);
+
+    /* Sphere doesn't touch the barycentrics */
+    const Float u = hits.u[0];
+    CORRADE_COMPARE(Intersection::raySphere(rays, {0.0f, 0.0f, -1.5f}, 0.25f, hits), 0x7);
+    CORRADE_COMPARE(hits.distance[0], 1.25f);
+    CORRADE_COMPARE(hits.u[0], u);
+}
+
+void IntersectionBatchTest::boxFrustum200k() {
+    const Corrade::Containers::Array<Range3D> in = boxes(200000);
+    Corrade::Containers::Array<UnsignedByte> visible{(in.size() + 7)/8};
+    CORRADE_BENCHMARK(1)
+        Intersection::boxFrustumInto(in, CameraFrustum, visible);
+
+    CORRADE_VERIFY(visible[0] || visible[1]);
+}
+
+void IntersectionBatchTest::boxFrustum200kIndices() {
+    const Corrade::Containers::Array<Range3D> in = boxes(200000);
+    Corrade::Containers::Array<UnsignedInt> indices{in.size()};
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1)
+        count = Intersection::boxFrustumIndicesInto(in, CameraFrustum, indices);
+
+    CORRADE_VERIFY(count);
+}
+
+void IntersectionBatchTest::boxFrustum200kScalar() {
+    const Corrade::Containers::Array<Range3D> in = boxes(200000);
+    Corrade::Containers::Array<UnsignedByte> visible{(in.size() + 7)/8};
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != in.size(); ++i)
+            visible[i/8] = (visible[i/8] & ~(1 << i%8)) | (Intersection::boxFrustum(in[i], CameraFrustum) << i%8);
+
+    CORRADE_VERIFY(visible[0] || visible[1]);
+}
+
+void IntersectionBatchTest::sphereFrustum200k() {
+    const Corrade::Containers::Array<Vector3> in = centers(boxes(200000));
+    const Corrade::Containers::Array<Float> r = radii(in.size());
+    Corrade::Containers::Array<UnsignedByte> visible{(in.size() + 7)/8};
+    CORRADE_BENCHMARK(1)
+        Intersection::sphereFrustumInto(in, r, CameraFrustum, visible);
+
+    CORRADE_VERIFY(visible[0] || visible[1]);
+}
+
+void IntersectionBatchTest::sphereFrustum200kScalar() {
+    const Corrade::Containers::Array<Vector3> in = centers(boxes(200000));
+    const Corrade::Containers::Array<Float> r = radii(in.size());
+    Corrade::Containers::Array<UnsignedByte> visible{(in.size() + 7)/8};
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != in.size(); ++i)
+            visible[i/8] = (visible[i/8] & ~(1 << i%8)) | (Intersection::sphereFrustum(in[i], r[i], CameraFrustum) << i%8);
+
+    CORRADE_VERIFY(visible[0] || visible[1]);
+}
+
+void IntersectionBatchTest::boxFrusta200k() {
+    const Corrade::Containers::Array<Range3D> in = boxes(200000);
+    Corrade::Containers::Array<UnsignedInt> visible{in.size()};
+    CORRADE_BENCHMARK(1)
+        Intersection::boxFrustaInto(in, CascadeFrusta, visible);
+
+    UnsignedInt any = 0;
+    for(UnsignedInt mask: visible) any |= mask;
+    CORRADE_COMPARE(any, 0x7);
+}
+
+/* Each benchmark traces 65536 rays against 64 triangles or boxes, divide the
+   time per iteration by 65536 to get rays per second */
+void IntersectionBatchTest::rayTriangle64kScalar() {
+    const Corrade::Containers::Array<Vector3> triangles = triangleSoup(64);
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1) {
+        hitCount = 0;
+        for(std::size_t i = 0; i != 65536; ++i) {
+            const Vector3 origin = rayOrigin(i), direction = rayDirection(i);
+            Float distance = Constants<Float>::inf();
+            for(std::size_t j = 0; j != triangles.size(); j += 3)
+                distance = Math::min(distance, Intersection::rayTriangle(origin, direction, triangles[j], triangles[j + 1], triangles[j + 2]).x());
+            if(distance != Constants<Float>::inf()) ++hitCount;
+        }
+    }
+
+    CORRADE_VERIFY(hitCount);
+}
+
+namespace {
+
+template<UnsignedInt size> std::size_t traceTrianglePackets(const Corrade::Containers::ArrayView<const Vector3> triangles) {
+    std::size_t hitCount = 0;
+    for(std::size_t i = 0; i != 65536; i += size) {
+        Intersection::RayPacket<size> rays;
+        for(UnsignedInt j = 0; j != size; ++j)
+            rays.set(j, rayOrigin(i + j), rayDirection(i + j));
+        Intersection::RayPacketHits<size> hits;
+        for(std::size_t j = 0; j != triangles.size(); j += 3)
+            Intersection::rayTriangle(rays, triangles[j], triangles[j + 1], triangles[j + 2], hits);
+        for(UnsignedInt j = 0; j != size; ++j)
+            if(hits.distance[j] != Constants<Float>::inf()) ++hitCount;
+    }
+    return hitCount;
+}
+
+}
+
+void IntersectionBatchTest::rayTriangle64kPacket4() {
+    const Corrade::Containers::Array<Vector3> triangles = triangleSoup(64);
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1)
+        hitCount = traceTrianglePackets<4>(triangles);
+
+    CORRADE_VERIFY(hitCount);
+}
+
+void IntersectionBatchTest::rayTriangle64kPacket8() {
+    const Corrade::Containers::Array<Vector3> triangles = triangleSoup(64);
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1)
+        hitCount = traceTrianglePackets<8>(triangles);
+
+    CORRADE_VERIFY(hitCount);
+}
+
+void IntersectionBatchTest::rayRange64kScalar() {
+    const Corrade::Containers::Array<Range3D> in = boxes(64);
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1) {
+        hitCount = 0;
+        for(std::size_t i = 0; i != 65536; ++i) {
+            const Vector3 origin = rayOrigin(i), inverseDirection = 1.0f/rayDirection(i);
+            for(const Range3D& box: in)
+                if(Intersection::rayRange(origin, inverseDirection, box) != Constants<Float>::inf()) ++hitCount;
+        }
+    }
+
+    CORRADE_VERIFY(hitCount);
+}
+
+void IntersectionBatchTest::rayRange64kPacket8() {
+    const Corrade::Containers::Array<Range3D> in = boxes(64);
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1) {
+        hitCount = 0;
+        for(std::size_t i = 0; i != 65536; i += 8) {
+            Intersection::RayPacket8 rays;
+            for(UnsignedInt j = 0; j != 8; ++j)
+                rays.set(j, rayOrigin(i + j), rayDirection(i + j));
+            const Intersection::RayPacketHits8 hits;
+            for(const Range3D& box: in) {
+                const UnsignedByte mask = Intersection::rayRange(rays, box, hits);
+                for(UnsignedInt j = 0; j != 8; ++j)
+                    hitCount += (mask >> j) & 1;
+            }
+        }
+    }
+
+    CORRADE_VERIFY(hitCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::IntersectionBatchTest)
@@ -36,8 +36,14 @@ struct IntersectionTest: Corrade::TestSuite::Tester {
     void planeLine();
     void lineLine();
 
+    void rayTriangle();
+    void rayTriangleSharedEdge();
+    void rayRange();
+    void raySphere();
+
     void pointFrustum();
     void boxFrustum();
+    void sphereFrustum();
 };
 
 typedef Math::Vector2<Float> Vector2;
@@ -51,8 +57,14 @@ IntersectionTest::IntersectionTest() {
     addTests({&IntersectionTest::planeLine,
               &IntersectionTest::lineLine,
 
+              &IntersectionTest::rayTriangle,
+              &IntersectionTest::rayTriangleSharedEdge,
+              &IntersectionTest::rayRange,
+              &IntersectionTest::raySphere,
+
               &IntersectionTest::pointFrustum,
-              &IntersectionTest::boxFrustum});
+              &IntersectionTest::boxFrustum,
+              &IntersectionTest::sphereFrustum});
 }
 
 void IntersectionTest::planeLine() {
@@ -107,6 +119,82 @@ void IntersectionTest::lineLine() {
         {0.0f, 0.0f}, {1.0f, 2.0f}), Constants::inf());
 }
 
+void IntersectionTest::rayTriangle() {
+    const Vector3 a{-1.0f, -1.0f, -2.0f};
+    const Vector3 b{ 1.0f, -1.0f, -2.0f};
+    const Vector3 c{-1.0f,  1.0f, -2.0f};
+
+    /* Hit, barycentric coordinates reconstruct the hit point */
+    const Vector3 hit = Intersection::rayTriangle({-0.5f, 0.0f, 0.0f}, {0.0f, 0.0f, -0.5f}, a, b, c);
+    CORRADE_COMPARE(hit, (Vector3{4.0f, 0.25f, 0.5f}));
+    CORRADE_COMPARE((1.0f - hit.y() - hit.z())*a + hit.y()*b + hit.z()*c,
+        (Vector3{-0.5f, 0.0f, -2.0f}));
+
+    /* Back side is hit as well */
+    CORRADE_COMPARE(Intersection::rayTriangle({-0.5f, 0.0f, -4.0f}, {0.0f, 0.0f, 1.0f}, a, b, c).x(), 2.0f);
+
+    /* Outside of the triangle */
+    CORRADE_COMPARE(Intersection::rayTriangle({0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, -1.0f}, a, b, c).x(), Constants::inf());
+
+    /* Triangle behind the origin */
+    CORRADE_COMPARE(Intersection::rayTriangle({-0.5f, 0.0f, -3.0f}, {0.0f, 0.0f, -1.0f}, a, b, c).x(), Constants::inf());
+
+    /* Parallel to the triangle */
+    CORRADE_COMPARE(Intersection::rayTriangle({-0.5f, 0.0f, -2.0f}, {1.0f, 0.0f, 0.0f}, a, b, c).x(), Constants::inf());
+}
+
+void IntersectionTest::rayTriangleSharedEdge() {
+    /* Two triangles of a quad, a ray going exactly through the diagonal and
+       through a shared vertex has to hit at least one of them */
+    const Vector3 a{-1.0f, -1.0f, 0.0f};
+    const Vector3 b{ 1.0f, -1.0f, 0.0f};
+    const Vector3 c{ 1.0f,  1.0f, 0.0f};
+    const Vector3 d{-1.0f,  1.0f, 0.0f};
+
+    for(const Vector3& origin: {Vector3{0.0f, 0.0f, 1.0f},
+                                Vector3{0.5f, 0.5f, 1.0f},
+                                Vector3{1.0f, 1.0f, 1.0f}}) {
+        const Float t = Math::min(
+            Intersection::rayTriangle(origin, {0.0f, 0.0f, -1.0f}, a, b, c).x(),
+            Intersection::rayTriangle(origin, {0.0f, 0.0f, -1.0f}, a, c, d).x());
+        CORRADE_COMPARE(t, 1.0f);
+    }
+}
+
+void IntersectionTest::rayRange() {
+    const Range3D box{{-1.0f, -1.0f, -3.0f}, {1.0f, 1.0f, -1.0f}};
+
+    /* Entering the box */
+    CORRADE_COMPARE(Intersection::rayRange({0.0f, 0.0f, 0.0f}, 1.0f/Vector3{0.0f, 0.0f, -1.0f}, box), 1.0f);
+    CORRADE_COMPARE(Intersection::rayRange({0.0f, 0.0f, 0.0f}, 1.0f/Vector3{0.25f, 0.25f, -1.0f}, box), 1.0f);
+
+    /* Origin inside */
+    CORRADE_COMPARE(Intersection::rayRange({0.5f, 0.0f, -2.0f}, 1.0f/Vector3{1.0f, 0.0f, 0.0f}, box), 0.0f);
+
+    /* Missing the box, box behind the origin */
+    CORRADE_COMPARE(Intersection::rayRange({0.0f, 2.0f, 0.0f}, 1.0f/Vector3{0.0f, 0.0f, -1.0f}, box), Constants::inf());
+    CORRADE_COMPARE(Intersection::rayRange({0.0f, 0.0f, 0.0f}, 1.0f/Vector3{0.0f, 0.0f, 1.0f}, box), Constants::inf());
+    CORRADE_COMPARE(Intersection::rayRange({0.0f, 0.0f, 0.0f}, 1.0f/Vector3{1.0f, 0.0f, -0.5f}, box), Constants::inf());
+}
+
+void IntersectionTest::raySphere() {
+    const Vector3 center{0.0f, 0.0f, -5.0f};
+
+    /* Direction doesn't need to be normalized */
+    CORRADE_COMPARE(Intersection::raySphere({}, {0.0f, 0.0f, -1.0f}, center, 2.0f), 3.0f);
+    CORRADE_COMPARE(Intersection::raySphere({}, {0.0f, 0.0f, -2.0f}, center, 2.0f), 1.5f);
+
+    /* Tangent */
+    CORRADE_COMPARE(Intersection::raySphere({2.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, center, 2.0f), 5.0f);
+
+    /* Origin inside gives the exit distance */
+    CORRADE_COMPARE(Intersection::raySphere({0.0f, 0.0f, -5.0f}, {0.0f, 0.0f, -1.0f}, center, 2.0f), 2.0f);
+
+    /* Miss, behind the origin */
+    CORRADE_COMPARE(Intersection::raySphere({3.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, center, 2.0f), Constants::inf());
+    CORRADE_COMPARE(Intersection::raySphere({}, {0.0f, 0.0f, 1.0f}, center, 2.0f), Constants::inf());
+}
+
 void IntersectionTest::pointFrustum() {
     const Frustum frustum{
         {1.0f, 0.0f, 0.0f, 0.0f},
@@ -140,6 +228,27 @@ void IntersectionTest::boxFrustum() {
     CORRADE_VERIFY(!Intersection::boxFrustum(Range3D{Vector3{-10.0f}, Vector3{-5.0f}}, frustum));
 }
 
+void IntersectionTest::sphereFrustum() {
+    /* Same as above, but with planes not normalized */
+    const Frustum frustum{
+        {2.0f, 0.0f, 0.0f, 0.0f},
+        {-2.0f, 0.0f, 0.0f, 20.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 10.0f},
+        {0.0f, 0.0f, 0.5f, 0.0f},
+        {0.0f, 0.0f, -0.5f, 5.0f}};
+
+    CORRADE_VERIFY(Intersection::sphereFrustum({5.0f, 5.0f, 5.0f}, 1.0f, frustum));
+    /* Bigger than frustum, but still intersects */
+    CORRADE_VERIFY(Intersection::sphereFrustum({5.0f, 5.0f, 5.0f}, 100.0f, frustum));
+    /* Center outside, but touches the frustum */
+    CORRADE_VERIFY(Intersection::sphereFrustum({-1.0f, 5.0f, 5.0f}, 1.0f, frustum));
+    CORRADE_VERIFY(Intersection::sphereFrustum({5.0f, 5.0f, 11.5f}, 2.0f, frustum));
+    /* Outside of frustum */
+    CORRADE_VERIFY(!Intersection::sphereFrustum({-1.5f, 5.0f, 5.0f}, 1.0f, frustum));
+    CORRADE_VERIFY(!Intersection::sphereFrustum({5.0f, 5.0f, 12.5f}, 2.0f, frustum));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::IntersectionTest)
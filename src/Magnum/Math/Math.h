@@ -42,6 +42,7 @@ namespace Magnum { namespace Math {
 /* Class Constants used only statically */
 
 template<UnsignedInt, UnsignedInt, class> class Bezier;
+template<UnsignedInt, UnsignedInt, class> class BezierArcLength;
 template<UnsignedInt dimensions, class T> using QuadraticBezier = Bezier<2, dimensions, T>;
 template<UnsignedInt dimensions, class T> using CubicBezier = Bezier<3, dimensions, T>;
 template<class T> using QuadraticBezier2D = QuadraticBezier<2, T>;
@@ -29,12 +29,15 @@
  * @brief Class @ref Magnum::Math::Matrix, typedef @ref Magnum::Math::Matrix2x2, @ref Magnum::Math::Matrix3x3, @ref Magnum::Math::Matrix4x4
  */
 
+#include <type_traits>
+
 #include "Magnum/Math/RectangularMatrix.h"
 
 namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t, class> struct MatrixDeterminant;
+    template<std::size_t, class> struct MatrixInverted;
 }
 
 /**
@@ -149,6 +152,10 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          * determinant is computed directly: @f[
          *      \det(A) = a_{0, 0} a_{1, 1} - a_{1, 0} a_{0, 1}
          * @f]
+         *
+         * For 3x3 and 4x4 matrices the expansion is done in a closed form,
+         * with the 2x2 subdeterminants shared instead of being recalculated
+         * for each cofactor.
          */
         T determinant() const { return Implementation::MatrixDeterminant<size, T>()(*this); }
 
@@ -158,13 +165,19 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          * Computed using Cramer's rule: @f[
          *      A^{-1} = \frac{1}{\det(A)} Adj(A)
          * @f]
+         * For 3x3 and 4x4 matrices the adjugate is calculated in a closed
+         * form from shared 2x2 subdeterminants, which is considerably faster
+         * than going through @ref ij() for each element.
+         *
          * See @ref invertedOrthogonal(), @ref Matrix3::invertedRigid() and
          * @ref Matrix4::invertedRigid() which are faster alternatives for
          * particular matrix types.
          * @see @ref Algorithms::gaussJordanInverted()
          * @m_keyword{inverse(),GLSL inverse(),}
          */
-        Matrix<size, T> inverted() const;
+        Matrix<size, T> inverted() const {
+            return Implementation::MatrixInverted<size, T>()(*this);
+        }
 
         /**
          * @brief Inverted orthogonal matrix
@@ -282,6 +295,34 @@ template<std::size_t size, class T> T MatrixDeterminant<size, T>::operator()(con
     return out;
 }
 
+template<class T> struct MatrixDeterminant<4, T> {
+    T operator()(const Matrix<4, T>& m) const {
+        /* 2x2 subdeterminants of the first two and last two columns, each
+           shared by two terms of the Laplace expansion */
+        const T s0 = m[0][0]*m[1][1] - m[1][0]*m[0][1];
+        const T s1 = m[0][0]*m[1][2] - m[1][0]*m[0][2];
+        const T s2 = m[0][0]*m[1][3] - m[1][0]*m[0][3];
+        const T s3 = m[0][1]*m[1][2] - m[1][1]*m[0][2];
+        const T s4 = m[0][1]*m[1][3] - m[1][1]*m[0][3];
+        const T s5 = m[0][2]*m[1][3] - m[1][2]*m[0][3];
+        const T c0 = m[2][0]*m[3][1] - m[3][0]*m[2][1];
+        const T c1 = m[2][0]*m[3][2] - m[3][0]*m[2][2];
+        const T c2 = m[2][0]*m[3][3] - m[3][0]*m[2][3];
+        const T c3 = m[2][1]*m[3][2] - m[3][1]*m[2][2];
+        const T c4 = m[2][1]*m[3][3] - m[3][1]*m[2][3];
+        const T c5 = m[2][2]*m[3][3] - m[3][2]*m[2][3];
+        return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+    }
+};
+
+template<class T> struct MatrixDeterminant<3, T> {
+    constexpr T operator()(const Matrix<3, T>& m) const {
+        return m[0][0]*(m[1][1]*m[2][2] - m[2][1]*m[1][2]) -
+               m[1][0]*(m[0][1]*m[2][2] - m[2][1]*m[0][2]) +
+               m[2][0]*(m[0][1]*m[1][2] - m[1][1]*m[0][2]);
+    }
+};
+
 template<class T> struct MatrixDeterminant<2, T> {
     constexpr T operator()(const Matrix<2, T>& m) const {
         return m[0][0]*m[1][1] - m[1][0]*m[0][1];
@@ -294,6 +335,105 @@ template<class T> struct MatrixDeterminant<1, T> {
     }
 };
 
+template<std::size_t size, class T> struct MatrixInverted {
+    Matrix<size, T> operator()(const Matrix<size, T>& m) const;
+};
+
+template<std::size_t size, class T> Matrix<size, T> MatrixInverted<size, T>::operator()(const Matrix<size, T>& m) const {
+    Matrix<size, T> out{NoInit};
+
+    const T _determinant = m.determinant();
+
+    for(std::size_t col = 0; col != size; ++col)
+        for(std::size_t row = 0; row != size; ++row)
+            out[col][row] = (((row+col) & 1) ? -1 : 1)*m.ij(row, col).determinant()/_determinant;
+
+    return out;
+}
+
+/* Multiplying by a reciprocal of the determinant is cheaper than dividing by
+   it, but for integral types the reciprocal would get truncated to zero */
+template<class T, bool = std::is_floating_point<T>::value> struct InverseDeterminant {
+    explicit InverseDeterminant(T determinant): _value{T(1)/determinant} {}
+    T operator()(T value) const { return value*_value; }
+
+    private:
+        T _value;
+};
+
+template<class T> struct InverseDeterminant<T, false> {
+    explicit InverseDeterminant(T determinant): _value{determinant} {}
+    T operator()(T value) const { return value/_value; }
+
+    private:
+        T _value;
+};
+
+template<class T> struct MatrixInverted<4, T> {
+    Matrix<4, T> operator()(const Matrix<4, T>& m) const {
+        /* Same subdeterminants as in MatrixDeterminant<4, T>, each of them is
+           then used in four elements of the adjugate. Inverse of a transposed
+           matrix is a transposed inverse, so the column-major layout doesn't
+           need any special handling. */
+        const T s0 = m[0][0]*m[1][1] - m[1][0]*m[0][1];
+        const T s1 = m[0][0]*m[1][2] - m[1][0]*m[0][2];
+        const T s2 = m[0][0]*m[1][3] - m[1][0]*m[0][3];
+        const T s3 = m[0][1]*m[1][2] - m[1][1]*m[0][2];
+        const T s4 = m[0][1]*m[1][3] - m[1][1]*m[0][3];
+        const T s5 = m[0][2]*m[1][3] - m[1][2]*m[0][3];
+        const T c0 = m[2][0]*m[3][1] - m[3][0]*m[2][1];
+        const T c1 = m[2][0]*m[3][2] - m[3][0]*m[2][2];
+        const T c2 = m[2][0]*m[3][3] - m[3][0]*m[2][3];
+        const T c3 = m[2][1]*m[3][2] - m[3][1]*m[2][2];
+        const T c4 = m[2][1]*m[3][3] - m[3][1]*m[2][3];
+        const T c5 = m[2][2]*m[3][3] - m[3][2]*m[2][3];
+
+        const InverseDeterminant<T> invDeterminant{s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0};
+
+        Matrix<4, T> out{NoInit};
+        out[0][0] = invDeterminant( m[1][1]*c5 - m[1][2]*c4 + m[1][3]*c3);
+        out[0][1] = invDeterminant(-m[0][1]*c5 + m[0][2]*c4 - m[0][3]*c3);
+        out[0][2] = invDeterminant( m[3][1]*s5 - m[3][2]*s4 + m[3][3]*s3);
+        out[0][3] = invDeterminant(-m[2][1]*s5 + m[2][2]*s4 - m[2][3]*s3);
+        out[1][0] = invDeterminant(-m[1][0]*c5 + m[1][2]*c2 - m[1][3]*c1);
+        out[1][1] = invDeterminant( m[0][0]*c5 - m[0][2]*c2 + m[0][3]*c1);
+        out[1][2] = invDeterminant(-m[3][0]*s5 + m[3][2]*s2 - m[3][3]*s1);
+        out[1][3] = invDeterminant( m[2][0]*s5 - m[2][2]*s2 + m[2][3]*s1);
+        out[2][0] = invDeterminant( m[1][0]*c4 - m[1][1]*c2 + m[1][3]*c0);
+        out[2][1] = invDeterminant(-m[0][0]*c4 + m[0][1]*c2 - m[0][3]*c0);
+        out[2][2] = invDeterminant( m[3][0]*s4 - m[3][1]*s2 + m[3][3]*s0);
+        out[2][3] = invDeterminant(-m[2][0]*s4 + m[2][1]*s2 - m[2][3]*s0);
+        out[3][0] = invDeterminant(-m[1][0]*c3 + m[1][1]*c1 - m[1][2]*c0);
+        out[3][1] = invDeterminant( m[0][0]*c3 - m[0][1]*c1 + m[0][2]*c0);
+        out[3][2] = invDeterminant(-m[3][0]*s3 + m[3][1]*s1 - m[3][2]*s0);
+        out[3][3] = invDeterminant( m[2][0]*s3 - m[2][1]*s1 + m[2][2]*s0);
+        return out;
+    }
+};
+
+template<class T> struct MatrixInverted<3, T> {
+    Matrix<3, T> operator()(const Matrix<3, T>& m) const {
+        /* Rows of the adjugate are cross products of the columns */
+        const T a00 = m[1][1]*m[2][2] - m[2][1]*m[1][2];
+        const T a01 = m[2][1]*m[0][2] - m[0][1]*m[2][2];
+        const T a02 = m[0][1]*m[1][2] - m[1][1]*m[0][2];
+
+        const InverseDeterminant<T> invDeterminant{m[0][0]*a00 + m[1][0]*a01 + m[2][0]*a02};
+
+        Matrix<3, T> out{NoInit};
+        out[0][0] = invDeterminant(a00);
+        out[0][1] = invDeterminant(a01);
+        out[0][2] = invDeterminant(a02);
+        out[1][0] = invDeterminant(m[2][0]*m[1][2] - m[1][0]*m[2][2]);
+        out[1][1] = invDeterminant(m[0][0]*m[2][2] - m[2][0]*m[0][2]);
+        out[1][2] = invDeterminant(m[1][0]*m[0][2] - m[0][0]*m[1][2]);
+        out[2][0] = invDeterminant(m[1][0]*m[2][1] - m[2][0]*m[1][1]);
+        out[2][1] = invDeterminant(m[2][0]*m[0][1] - m[0][0]*m[2][1]);
+        out[2][2] = invDeterminant(m[0][0]*m[1][1] - m[1][0]*m[0][1]);
+        return out;
+    }
+};
+
 }
 #endif
 
@@ -322,18 +462,6 @@ template<std::size_t size, class T> Matrix<size-1, T> Matrix<size, T>::ij(const
     return out;
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
-    Matrix<size, T> out{NoInit};
-
-    const T _determinant = determinant();
-
-    for(std::size_t col = 0; col != size; ++col)
-        for(std::size_t row = 0; row != size; ++row)
-            out[col][row] = (((row+col) & 1) ? -1 : 1)*ij(row, col).determinant()/_determinant;
-
-    return out;
-}
-
 }}
 
 namespace Corrade { namespace Utility {
@@ -0,0 +1,322 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "PackingBatch.h"
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* Written so the compiler is able to autovectorize the loops --- no
+   branches, no function calls and a single type conversion. Hand-written SSE2
+   kernels were measured to be no faster than what GCC and Clang produce from
+   these with optimizations enabled. */
+template<class T> void unpackIntoImplementation(const T* const src, Float* const dst, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i)
+        dst[i] = unpack<Float, T>(src[i]);
+}
+
+template<class T> void packIntoImplementation(const Float* const src, T* const dst, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i)
+        dst[i] = pack<T, Float>(src[i]);
+}
+
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const UnsignedByte> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    unpackIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const Byte> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    unpackIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const UnsignedShort> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    unpackIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const Short> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    unpackIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<UnsignedByte> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    packIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<Byte> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    packIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<UnsignedShort> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    packIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<Short> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    packIntoImplementation(src.data(), dst.data(), src.size());
+}
+
+namespace {
+
+/* Lookup tables for conversion between 8-bit sRGB and linear floats. Linear
+   value for each 8-bit sRGB value and smallest linear value that packs to
+   given 8-bit sRGB value (the first item is unused). Generated offline from
+   the scalar Color3 conversion functions. The thresholds were found by
+   bisecting on the float bit representation, which is ordered the same way
+   as the values in range [0, 1]. Due to rounding, the calculation doesn't
+   reach 255 at all (1.0 gives 254), so the last threshold is NaN. Being
+   constant-initialized, the tables need no runtime setup. */
+const Float SrgbToLinear[256]{
+    0.0f, 0.000303526991f, 0.000607053982f, 0.000910580973f,
+    0.00121410796f, 0.00151763496f, 0.00182116195f, 0.00212468882f,
+    0.00242821593f, 0.00273174304f, 0.00303526991f, 0.00334653561f,
+    0.00367650692f, 0.00402471703f, 0.00439144205f, 0.00477695325f,
+    0.00518151699f, 0.00560539169f, 0.00604883255f, 0.00651209103f,
+    0.00699541019f, 0.00749903172f, 0.00802319217f, 0.00856812485f,
+    0.00913405698f, 0.00972121768f, 0.010329823f, 0.0109600937f,
+    0.0116122449f, 0.012286487f, 0.0129830306f, 0.0137020806f,
+    0.0144438436f, 0.0152085144f, 0.0159962922f, 0.0168073755f,
+    0.0176419523f, 0.0185002182f, 0.0193823613f, 0.0202885624f,
+    0.0212190095f, 0.0221738834f, 0.0231533647f, 0.0241576303f,
+    0.0251868572f, 0.0262412224f, 0.0273208916f, 0.0284260381f,
+    0.0295568332f, 0.0307134409f, 0.0318960287f, 0.0331047624f,
+    0.0343398079f, 0.0356013142f, 0.036889445f, 0.0382043645f,
+    0.0395462364f, 0.0409151986f, 0.0423114114f, 0.0437350273f,
+    0.045186203f, 0.0466650836f, 0.048171822f, 0.0497065634f,
+    0.0512694679f, 0.0528606549f, 0.0544802807f, 0.0561284944f,
+    0.0578054339f, 0.0595112406f, 0.061246071f, 0.0630100295f,
+    0.0648032799f, 0.0666259527f, 0.068478182f, 0.0703601092f,
+    0.0722718611f, 0.0742135793f, 0.0761853904f, 0.0781874284f,
+    0.0802198276f, 0.0822827145f, 0.0843762159f, 0.0865004659f,
+    0.0886556059f, 0.0908417329f, 0.093058981f, 0.0953074843f,
+    0.0975873619f, 0.0998987406f, 0.102241747f, 0.104616493f,
+    0.107023112f, 0.109461717f, 0.111932434f, 0.114435382f,
+    0.116970673f, 0.119538434f, 0.122138798f, 0.124771841f,
+    0.127437696f, 0.13013649f, 0.132868335f, 0.135633349f,
+    0.138431624f, 0.141263306f, 0.144128487f, 0.147027284f,
+    0.149959803f, 0.152926162f, 0.155926466f, 0.158960864f,
+    0.1620294f, 0.165132225f, 0.168269396f, 0.171441093f,
+    0.174647391f, 0.177888408f, 0.181164235f, 0.18447499f,
+    0.187820762f, 0.191201672f, 0.194617808f, 0.198069304f,
+    0.201556236f, 0.205078706f, 0.20863685f, 0.212230727f,
+    0.215860531f, 0.219526231f, 0.223227978f, 0.226965889f,
+    0.23074007f, 0.234550655f, 0.238397658f, 0.242281199f,
+    0.246201396f, 0.25015837f, 0.254152179f, 0.258182913f,
+    0.262250721f, 0.266355664f, 0.270497859f, 0.274677366f,
+    0.278894335f, 0.283148795f, 0.287440896f, 0.291770697f,
+    0.296138316f, 0.300543845f, 0.304987371f, 0.309468955f,
+    0.313988745f, 0.318546832f, 0.323143244f, 0.327778131f,
+    0.332451582f, 0.337163657f, 0.341914445f, 0.346704096f,
+    0.351532698f, 0.356400251f, 0.361306876f, 0.366252691f,
+    0.371237785f, 0.376262218f, 0.381326109f, 0.386429518f,
+    0.391572565f, 0.396755308f, 0.401977867f, 0.407240301f,
+    0.412542701f, 0.417885154f, 0.423267752f, 0.428690553f,
+    0.434153706f, 0.439657241f, 0.445201248f, 0.450785846f,
+    0.456411064f, 0.462077051f, 0.467783839f, 0.473531544f,
+    0.479320228f, 0.48514998f, 0.491020888f, 0.496933043f,
+    0.502886593f, 0.50888145f, 0.514917791f, 0.520995677f,
+    0.527115226f, 0.533276498f, 0.539479613f, 0.545724571f,
+    0.55201149f, 0.55834049f, 0.56471163f, 0.571124911f,
+    0.577580512f, 0.584078491f, 0.590618908f, 0.597201884f,
+    0.603827417f, 0.610495627f, 0.617206633f, 0.623960435f,
+    0.630757213f, 0.637596965f, 0.644479752f, 0.651405692f,
+    0.658374846f, 0.665387332f, 0.672443211f, 0.679542542f,
+    0.686685443f, 0.693871915f, 0.701102018f, 0.708375931f,
+    0.715693653f, 0.723055243f, 0.730460882f, 0.737910569f,
+    0.745404363f, 0.752942324f, 0.760524631f, 0.768151283f,
+    0.775822341f, 0.783537924f, 0.791298032f, 0.799102843f,
+    0.806952357f, 0.814846694f, 0.822785854f, 0.830769956f,
+    0.838799119f, 0.846873283f, 0.854992688f, 0.863157272f,
+    0.871367216f, 0.87962234f, 0.887923181f, 0.896269381f,
+    0.904661357f, 0.913098693f, 0.921582043f, 0.930110872f,
+    0.938685894f, 0.947306573f, 0.955973506f, 0.964686275f,
+    0.973445475f, 0.982250571f, 0.991102219f, 1.0f
+};
+
+const Float LinearToSrgbThresholds[256]{
+    0.0f, 0.000303526991f, 0.000607053982f, 0.000910580973f,
+    0.00121410796f, 0.00151763496f, 0.00182116195f, 0.00212468882f,
+    0.00242821593f, 0.00273174304f, 0.00303526991f, 0.00334653584f,
+    0.00367650785f, 0.00402471749f, 0.00439144205f, 0.00477695325f,
+    0.00518151699f, 0.00560539169f, 0.00604883302f, 0.00651209056f,
+    0.00699540973f, 0.00749903126f, 0.00802319217f, 0.00856812485f,
+    0.00913405977f, 0.00972121768f, 0.010329823f, 0.0109600937f,
+    0.011612244f, 0.012286487f, 0.0129830306f, 0.0137020834f,
+    0.0144438464f, 0.0152085172f, 0.015996296f, 0.0168073773f,
+    0.017641956f, 0.0185002219f, 0.0193823613f, 0.020288568f,
+    0.0212190133f, 0.0221738871f, 0.0231533684f, 0.024157634f,
+    0.0251868609f, 0.0262412261f, 0.0273208953f, 0.0284260437f,
+    0.0295568369f, 0.0307134464f, 0.0318960398f, 0.0331047736f,
+    0.0343398117f, 0.0356013216f, 0.0368894525f, 0.0382043719f,
+    0.0395462476f, 0.0409152098f, 0.0423114225f, 0.0437350385f,
+    0.0451862141f, 0.0466650948f, 0.0481718332f, 0.0497065708f,
+    0.0512694642f, 0.0528606512f, 0.0544802807f, 0.0561284944f,
+    0.0578054339f, 0.0595112406f, 0.0612460673f, 0.0630100295f,
+    0.0648032799f, 0.0666259527f, 0.068478182f, 0.0703601092f,
+    0.0722718611f, 0.0742135793f, 0.0761853904f, 0.0781874284f,
+    0.0802198276f, 0.0822827145f, 0.0843762159f, 0.0865004659f,
+    0.0886556059f, 0.0908417255f, 0.093058981f, 0.0953074843f,
+    0.0975873619f, 0.0998987406f, 0.102241747f, 0.104616493f,
+    0.107023112f, 0.109461717f, 0.111932434f, 0.114435375f,
+    0.116970673f, 0.119538449f, 0.122138791f, 0.124771833f,
+    0.127437696f, 0.13013649f, 0.132868335f, 0.135633349f,
+    0.138431624f, 0.141263306f, 0.144128487f, 0.147027284f,
+    0.149959803f, 0.152926162f, 0.155926466f, 0.158960864f,
+    0.1620294f, 0.165132225f, 0.168269426f, 0.171441123f,
+    0.174647421f, 0.177888438f, 0.18116428f, 0.184475034f,
+    0.187820807f, 0.191201702f, 0.194617853f, 0.198069334f,
+    0.201556265f, 0.205078751f, 0.20863688f, 0.212230772f,
+    0.215860516f, 0.219526201f, 0.223227963f, 0.226965874f,
+    0.230740115f, 0.23455064f, 0.238397628f, 0.242281184f,
+    0.246201381f, 0.25015834f, 0.254152149f, 0.258182913f,
+    0.262250721f, 0.266355664f, 0.270497829f, 0.274677366f,
+    0.278894305f, 0.283148795f, 0.287440866f, 0.291770697f,
+    0.296138316f, 0.300543845f, 0.304987341f, 0.309468955f,
+    0.313988745f, 0.318546802f, 0.323143244f, 0.327778131f,
+    0.332451552f, 0.337163627f, 0.341914445f, 0.346704066f,
+    0.351532698f, 0.356400222f, 0.361306846f, 0.366252661f,
+    0.371237755f, 0.376262188f, 0.381326079f, 0.386429489f,
+    0.391572535f, 0.396755278f, 0.401977837f, 0.407240272f,
+    0.412542671f, 0.417885125f, 0.423267722f, 0.428690553f,
+    0.434153676f, 0.439657211f, 0.445201218f, 0.450785816f,
+    0.456411064f, 0.462077022f, 0.467783809f, 0.473531514f,
+    0.479320198f, 0.48514995f, 0.491020858f, 0.496933103f,
+    0.502886593f, 0.50888145f, 0.514917791f, 0.520995677f,
+    0.527115226f, 0.533276498f, 0.539479613f, 0.545724571f,
+    0.55201149f, 0.55834049f, 0.564711571f, 0.571124911f,
+    0.577580512f, 0.584078491f, 0.590618908f, 0.597201884f,
+    0.603827417f, 0.610495627f, 0.617206633f, 0.623960435f,
+    0.630757213f, 0.637596905f, 0.644479752f, 0.651405692f,
+    0.658374846f, 0.665387332f, 0.672443211f, 0.679542601f,
+    0.686685443f, 0.693871915f, 0.701102018f, 0.708375871f,
+    0.715693593f, 0.723055243f, 0.730460823f, 0.737910509f,
+    0.745404303f, 0.752942324f, 0.760524571f, 0.768151224f,
+    0.775822282f, 0.783537865f, 0.791298032f, 0.799102783f,
+    0.806952298f, 0.814846635f, 0.822785795f, 0.830769956f,
+    0.838799059f, 0.846873283f, 0.854992628f, 0.863157272f,
+    0.871367157f, 0.879622579f, 0.887923121f, 0.8962695f,
+    0.904661179f, 0.913098812f, 0.921581864f, 0.930110991f,
+    0.938685715f, 0.947306693f, 0.955973327f, 0.964686394f,
+    0.973445237f, 0.98225069f, 0.99110204f, Constants<Float>::nan()
+};
+
+/* Branchless binary search for the largest threshold not larger than the
+   value. Values below zero (and NaNs) end up the same as zero, values above
+   one the same as one. */
+inline UnsignedByte packSrgb(const Float value) {
+    std::size_t index = 0;
+    for(std::size_t step = 128; step; step >>= 1)
+        if(value >= LinearToSrgbThresholds[index + step]) index += step;
+    return UnsignedByte(index);
+}
+
+}
+
+void unpackSrgbInto(const Corrade::Containers::ArrayView<const UnsignedByte> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = SrgbToLinear[src[i]];
+}
+
+void packSrgbInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<UnsignedByte> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = packSrgb(src[i]);
+}
+
+void unpackSrgbInto(const Corrade::Containers::ArrayView<const Color3<UnsignedByte>> src, const Corrade::Containers::ArrayView<Color4<Float>> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = {SrgbToLinear[src[i].r()],
+                  SrgbToLinear[src[i].g()],
+                  SrgbToLinear[src[i].b()], 1.0f};
+}
+
+void unpackSrgbInto(const Corrade::Containers::ArrayView<const Color4<UnsignedByte>> src, const Corrade::Containers::ArrayView<Color4<Float>> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = {SrgbToLinear[src[i].r()],
+                  SrgbToLinear[src[i].g()],
+                  SrgbToLinear[src[i].b()], unpack<Float>(src[i].a())};
+}
+
+void packSrgbInto(const Corrade::Containers::ArrayView<const Color4<Float>> src, const Corrade::Containers::ArrayView<Color3<UnsignedByte>> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = {packSrgb(src[i].r()),
+                  packSrgb(src[i].g()),
+                  packSrgb(src[i].b())};
+}
+
+void packSrgbInto(const Corrade::Containers::ArrayView<const Color4<Float>> src, const Corrade::Containers::ArrayView<Color4<UnsignedByte>> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = {packSrgb(src[i].r()),
+                  packSrgb(src[i].g()),
+                  packSrgb(src[i].b()), pack<UnsignedByte>(src[i].a())};
+}
+
+}}
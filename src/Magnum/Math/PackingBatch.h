@@ -0,0 +1,194 @@
+#ifndef Magnum_Math_PackingBatch_h
+#define Magnum_Math_PackingBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackSrgbInto(), @ref Magnum::Math::packSrgbInto()
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Unpack unsigned integral values into a floating-point representation
+
+Batch variant of @ref unpack(), converting a whole array of values from full
+range of @ref Magnum::UnsignedByte "UnsignedByte" to range @f$ [0, 1] @f$. The
+result is bit-exact to calling @ref unpack() on each value separately, the
+loop is written to be autovectorized by the compiler. Sizes of @p src
+and @p dst are expected to be the same. Packed vector or pixel data can be
+passed in using @ref Corrade::Containers::arrayCast():
+
+@code{.cpp}
+Containers::ArrayView<const Color4ub> in;
+Containers::ArrayView<Color4> out;
+Math::unpackInto(Containers::arrayCast<const UnsignedByte>(in),
+                 Containers::arrayCast<Float>(out));
+@endcode
+
+@see @ref packInto(), @ref unpackSrgbInto()
+*/
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const UnsignedByte> src, Corrade::Containers::ArrayView<Float> dst);
+
+/**
+@overload
+
+Converts values from full range of @ref Magnum::Byte "Byte" to range
+@f$ [-1, 1] @f$.
+*/
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const Byte> src, Corrade::Containers::ArrayView<Float> dst);
+
+/**
+@overload
+
+Converts values from full range of @ref Magnum::UnsignedShort "UnsignedShort"
+to range @f$ [0, 1] @f$.
+*/
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const UnsignedShort> src, Corrade::Containers::ArrayView<Float> dst);
+
+/**
+@overload
+
+Converts values from full range of @ref Magnum::Short "Short" to range
+@f$ [-1, 1] @f$.
+*/
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const Short> src, Corrade::Containers::ArrayView<Float> dst);
+
+/**
+@brief Pack floating-point values into an unsigned integer representation
+
+Batch variant of @ref pack(), converting a whole array of values in range
+@f$ [0, 1] @f$ to full range of @ref Magnum::UnsignedByte "UnsignedByte".
+The result is bit-exact to calling @ref pack() on each value separately, the
+loop is written to be autovectorized by the compiler. Sizes of
+@p src and @p dst are expected to be the same.
+
+@attention Return value for floating point numbers outside the normalized
+    range is undefined.
+
+@see @ref unpackInto(), @ref packSrgbInto()
+*/
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<UnsignedByte> dst);
+
+/**
+@overload
+
+Converts values in range @f$ [-1, 1] @f$ to full range of
+@ref Magnum::Byte "Byte".
+*/
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<Byte> dst);
+
+/**
+@overload
+
+Converts values in range @f$ [0, 1] @f$ to full range of
+@ref Magnum::UnsignedShort "UnsignedShort".
+*/
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<UnsignedShort> dst);
+
+/**
+@overload
+
+Converts values in range @f$ [-1, 1] @f$ to full range of
+@ref Magnum::Short "Short".
+*/
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<Short> dst);
+
+/**
+@brief Unpack 8-bit sRGB values into linear floating-point representation
+
+Equivalent to calling @ref unpack() followed by the sRGB-to-linear conversion
+done by @ref Color3::fromSrgb() on each value, but using a precalculated
+256-entry lookup table instead of evaluating @ref std::pow() for every value.
+The result matches the scalar conversion up to floating-point precision of
+@ref std::pow() on given platform. Only the color channels are expected to be
+passed in, alpha is linear and should be converted using @ref unpackInto()
+instead. Sizes of @p src and @p dst are expected to be the same.
+@see @ref packSrgbInto()
+*/
+MAGNUM_EXPORT void unpackSrgbInto(Corrade::Containers::ArrayView<const UnsignedByte> src, Corrade::Containers::ArrayView<Float> dst);
+
+/**
+@brief Pack linear floating-point values into 8-bit sRGB representation
+
+Equivalent to calling the linear-to-sRGB conversion done by
+@ref Color3::toSrgb() followed by @ref pack() on each value, but using a
+precalculated lookup table of per-value thresholds instead of evaluating
+@ref std::pow() for every value. Values outside of range @f$ [0, 1] @f$ are
+clamped to it. For values very close to a rounding boundary the result may
+differ from the scalar conversion by one, depending on precision of
+@ref std::pow() on given platform. Only the color channels are expected to be passed in, alpha is linear and
+should be converted using @ref packInto() instead. Sizes of @p src and @p dst
+are expected to be the same.
+@see @ref unpackSrgbInto()
+*/
+MAGNUM_EXPORT void packSrgbInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<UnsignedByte> dst);
+
+/**
+@brief Unpack 8-bit sRGB colors into linear floating-point colors
+
+Batch variant of @ref Color4::fromSrgb(const Vector3<Integral>&, T), with
+alpha set to @cpp 1.0f @ce. Uses the same lookup table as
+@ref unpackSrgbInto(Corrade::Containers::ArrayView<const UnsignedByte>, Corrade::Containers::ArrayView<Float>).
+Sizes of @p src and @p dst are expected to be the same.
+*/
+MAGNUM_EXPORT void unpackSrgbInto(Corrade::Containers::ArrayView<const Color3<UnsignedByte>> src, Corrade::Containers::ArrayView<Color4<Float>> dst);
+
+/**
+@overload
+
+Batch variant of @ref Color4::fromSrgbAlpha(const Vector4<Integral>&), alpha
+is converted linearly.
+*/
+MAGNUM_EXPORT void unpackSrgbInto(Corrade::Containers::ArrayView<const Color4<UnsignedByte>> src, Corrade::Containers::ArrayView<Color4<Float>> dst);
+
+/**
+@brief Pack linear floating-point colors into 8-bit sRGB colors
+
+Batch variant of @ref Color3::toSrgb() for the color channels of @p src,
+alpha is ignored. Uses the same lookup table as
+@ref packSrgbInto(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedByte>),
+values outside of range @f$ [0, 1] @f$ are clamped to it. Sizes of @p src
+and @p dst are expected to be the same.
+*/
+MAGNUM_EXPORT void packSrgbInto(Corrade::Containers::ArrayView<const Color4<Float>> src, Corrade::Containers::ArrayView<Color3<UnsignedByte>> dst);
+
+/**
+@overload
+
+Batch variant of @ref Color4::toSrgbAlpha(), alpha is converted linearly
+using @ref pack().
+*/
+MAGNUM_EXPORT void packSrgbInto(Corrade::Containers::ArrayView<const Color4<Float>> src, Corrade::Containers::ArrayView<Color4<UnsignedByte>> dst);
+
+}}
+
+#endif
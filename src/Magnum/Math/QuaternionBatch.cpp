@@ -0,0 +1,95 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "QuaternionBatch.h"
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* Same operations as the scalar lerp() and slerp(), just without the
+   normalization assertions so the loops stay tight. The phase is accessed
+   through a functor so the same code is used for both the constant and the
+   per-item variant. */
+template<class Phase> void lerpIntoImplementation(const Quaternion<Float>* const a, const Quaternion<Float>* const b, const Phase& t, Quaternion<Float>* const out, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = ((1.0f - t(i))*a[i] + t(i)*b[i]).normalized();
+}
+
+template<class Phase> void slerpIntoImplementation(const Quaternion<Float>* const a, const Quaternion<Float>* const b, const Phase& t, Quaternion<Float>* const out, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i) {
+        const Float cosHalfAngle = dot(a[i], b[i]);
+
+        /* Same or opposite quaternions would divide by zero, the scalar
+           version returns the first quaternion for those. To avoid a
+           data-dependent branch in the loop, the interpolation is done for
+           all items, with the angle replaced by one that gives a finite
+           result, and the first quaternion is then blended in using a mask
+           that is either zero or one. */
+        const Float parallel = std::abs(cosHalfAngle) >= 1.0f ? 1.0f : 0.0f;
+        const Float angle = std::acos(parallel ? 0.0f : cosHalfAngle);
+        const Quaternion<Float> interpolated = (std::sin((1.0f - t(i))*angle)*a[i] + std::sin(t(i)*angle)*b[i])/std::sin(angle);
+        out[i] = parallel*a[i] + (1.0f - parallel)*interpolated;
+    }
+}
+
+}
+
+void lerpInto(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Float t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    CORRADE_ASSERT(normalizedA.size() == normalizedB.size() && normalizedA.size() == out.size(),
+        "Math::lerpInto(): expected arrays of the same size, got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << "and" << out.size(), );
+
+    lerpIntoImplementation(normalizedA, normalizedB, [t](std::size_t) { return t; }, out, out.size());
+}
+
+void lerpInto(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    CORRADE_ASSERT(normalizedA.size() == normalizedB.size() && normalizedA.size() == t.size() && normalizedA.size() == out.size(),
+        "Math::lerpInto(): expected arrays of the same size, got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+
+    const Float* const phase = t;
+    lerpIntoImplementation(normalizedA, normalizedB, [phase](std::size_t i) { return phase[i]; }, out, out.size());
+}
+
+void slerpInto(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Float t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    CORRADE_ASSERT(normalizedA.size() == normalizedB.size() && normalizedA.size() == out.size(),
+        "Math::slerpInto(): expected arrays of the same size, got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << "and" << out.size(), );
+
+    slerpIntoImplementation(normalizedA, normalizedB, [t](std::size_t) { return t; }, out, out.size());
+}
+
+void slerpInto(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    CORRADE_ASSERT(normalizedA.size() == normalizedB.size() && normalizedA.size() == t.size() && normalizedA.size() == out.size(),
+        "Math::slerpInto(): expected arrays of the same size, got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+
+    const Float* const phase = t;
+    slerpIntoImplementation(normalizedA, normalizedB, [phase](std::size_t i) { return phase[i]; }, out, out.size());
+}
+
+}}
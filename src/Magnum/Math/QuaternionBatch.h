@@ -0,0 +1,91 @@
+#ifndef Magnum_Math_QuaternionBatch_h
+#define Magnum_Math_QuaternionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::lerpInto(), @ref Magnum::Math::slerpInto()
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Normalized linear interpolation of two quaternion arrays
+@param normalizedA  First quaternions
+@param normalizedB  Second quaternions
+@param t            Interpolation phase
+@param out          Where to put the interpolated quaternions
+
+Batch variant of @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T),
+interpolating @cpp normalizedA[i] @ce and @cpp normalizedB[i] @ce into
+@cpp out[i] @ce. The results are the same as calling the scalar function on
+each pair, the loop is written to be autovectorized by the compiler. All
+quaternions are expected to be normalized, which is not checked for
+performance reasons. Sizes of all arrays are expected to be the same. The
+function has no state, so processing of large arrays can be split into
+ranges done on multiple threads.
+@see @ref slerpInto()
+*/
+MAGNUM_EXPORT void lerpInto(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Float t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+/**
+@overload
+
+Interpolates each pair with a different phase @cpp t[i] @ce. Size of @p t is
+expected to be the same as sizes of the other arrays.
+*/
+MAGNUM_EXPORT void lerpInto(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+/**
+@brief Spherical linear interpolation of two quaternion arrays
+@param normalizedA  First quaternions
+@param normalizedB  Second quaternions
+@param t            Interpolation phase
+@param out          Where to put the interpolated quaternions
+
+Batch variant of @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T),
+with the same requirements as @ref lerpInto(). The results are the same as
+calling the scalar function on each pair.
+*/
+MAGNUM_EXPORT void slerpInto(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Float t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+/**
+@overload
+
+Interpolates each pair with a different phase @cpp t[i] @ce. Size of @p t is
+expected to be the same as sizes of the other arrays.
+*/
+MAGNUM_EXPORT void slerpInto(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+}}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Ashwin Ravichandran <ashwinravichandran24@gmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/BezierArcLength.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::CubicBezier2D<Float> CubicBezier2D;
+typedef Math::CubicBezier3D<Float> CubicBezier3D;
+typedef Math::CubicBezier2D<Double> CubicBezier2Dd;
+
+struct BezierArcLengthTest: Corrade::TestSuite::Tester {
+    explicit BezierArcLengthTest();
+
+    void construct();
+    void constructZeroSegments();
+    void lengthLine();
+    void lengthQuarterCircle();
+    void lengthDouble();
+    void parameterLine();
+    void parameterOutOfRange();
+    void parameterConstantSpeed3D();
+    void parametersInto();
+    void parametersIntoSizeMismatch();
+
+    void parameter100k();
+};
+
+BezierArcLengthTest::BezierArcLengthTest() {
+    addTests({&BezierArcLengthTest::construct,
+              &BezierArcLengthTest::constructZeroSegments,
+              &BezierArcLengthTest::lengthLine,
+              &BezierArcLengthTest::lengthQuarterCircle,
+              &BezierArcLengthTest::lengthDouble,
+              &BezierArcLengthTest::parameterLine,
+              &BezierArcLengthTest::parameterOutOfRange,
+              &BezierArcLengthTest::parameterConstantSpeed3D,
+              &BezierArcLengthTest::parametersInto,
+              &BezierArcLengthTest::parametersIntoSizeMismatch});
+
+    addBenchmarks({&BezierArcLengthTest::parameter100k}, 10);
+}
+
+namespace {
+
+/* Straight line with unevenly distributed control points, so the factor
+   doesn't correspond to the distance */
+constexpr CubicBezier2D Line{Vector2{0.0f, 0.0f}, Vector2{6.0f, 8.0f}, Vector2{7.2f, 9.6f}, Vector2{9.0f, 12.0f}};
+
+/* Quarter circle with radius 2 */
+constexpr Float CircleK = 0.5522847498f*2.0f;
+constexpr CubicBezier2D QuarterCircle{Vector2{2.0f, 0.0f}, Vector2{2.0f, CircleK}, Vector2{CircleK, 2.0f}, Vector2{0.0f, 2.0f}};
+
+}
+
+void BezierArcLengthTest::construct() {
+    BezierArcLength<3, 2, Float> a{Line, 16};
+    CORRADE_COMPARE(a.curve(), Line);
+    CORRADE_COMPARE(a.segmentCount(), 16);
+    CORRADE_COMPARE(a.lengths().size(), 17);
+    CORRADE_COMPARE(a.lengths()[0], 0.0f);
+    CORRADE_COMPARE(a.lengths()[16], a.length());
+
+    /* Lengths are monotonic */
+    std::size_t nonMonotonic = 0;
+    for(std::size_t i = 1; i != a.lengths().size(); ++i)
+        if(a.lengths()[i] < a.lengths()[i - 1]) ++nonMonotonic;
+    CORRADE_COMPARE(nonMonotonic, 0);
+
+    BezierArcLength<3, 2, Float> b{Line};
+    CORRADE_COMPARE(b.segmentCount(), 64);
+}
+
+void BezierArcLengthTest::constructZeroSegments() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    BezierArcLength<3, 2, Float> a{Line, 0};
+    CORRADE_COMPARE(out.str(), "Math::BezierArcLength: expected at least one segment\n");
+
+    /* The object is left in a usable degenerate state */
+    CORRADE_COMPARE(a.segmentCount(), 0);
+    CORRADE_COMPARE(a.lengths().size(), 1);
+    CORRADE_COMPARE(a.length(), 0.0f);
+    CORRADE_COMPARE(a.parameter(0.0f), 0.0f);
+    CORRADE_COMPARE(a.parameter(5.0f), 1.0f);
+}
+
+void BezierArcLengthTest::lengthLine() {
+    /* Collinear points, so the length is exact regardless of segment count */
+    CORRADE_COMPARE((BezierArcLength<3, 2, Float>{Line, 1}.length()), 15.0f);
+    CORRADE_COMPARE((BezierArcLength<3, 2, Float>{Line, 7}.length()), 15.0f);
+}
+
+void BezierArcLengthTest::lengthQuarterCircle() {
+    /* The length is underestimated, converging with more segments */
+    const Float expected = Constants<Float>::piHalf()*2.0f;
+    const Float coarse = BezierArcLength<3, 2, Float>{QuarterCircle, 4}.length();
+    const Float fine = BezierArcLength<3, 2, Float>{QuarterCircle, 256}.length();
+    CORRADE_COMPARE_AS(coarse, fine, Corrade::TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(fine, expected + 0.0005f, Corrade::TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(fine, expected - 0.0005f, Corrade::TestSuite::Compare::Greater);
+}
+
+void BezierArcLengthTest::lengthDouble() {
+    const CubicBezier2Dd line{CubicBezier2D{Line}};
+    CORRADE_COMPARE((BezierArcLength<3, 2, Double>{line, 8}.length()), 15.0);
+}
+
+void BezierArcLengthTest::parameterLine() {
+    BezierArcLength<3, 2, Float> a{Line, 64};
+
+    CORRADE_COMPARE(a.parameter(0.0f), 0.0f);
+    CORRADE_COMPARE(a.parameter(15.0f), 1.0f);
+
+    /* Point at given distance is at given distance */
+    for(Float distance: {1.0f, 5.0f, 7.5f, 12.0f, 14.5f}) {
+        const Float t = a.parameter(distance);
+        CORRADE_COMPARE_AS(Math::abs(Line.value(t).length() - distance), 0.01f,
+            Corrade::TestSuite::Compare::Less);
+    }
+
+    /* Values of the table map exactly to the segment factors */
+    CORRADE_COMPARE(a.parameter(a.lengths()[16]), 0.25f);
+    CORRADE_COMPARE(a.parameter(a.lengths()[48]), 0.75f);
+}
+
+void BezierArcLengthTest::parameterOutOfRange() {
+    BezierArcLength<3, 2, Float> a{Line, 8};
+    CORRADE_COMPARE(a.parameter(-1.0f), 0.0f);
+    CORRADE_COMPARE(a.parameter(100.0f), 1.0f);
+    CORRADE_COMPARE(a.parameter(Constants<Float>::nan()), 0.0f);
+}
+
+void BezierArcLengthTest::parameterConstantSpeed3D() {
+    const CubicBezier3D curve{Vector3{0.0f, 0.0f, 0.0f}, Vector3{10.0f, 15.0f, -5.0f}, Vector3{20.0f, 4.0f, 8.0f}, Vector3{5.0f, -20.0f, 0.0f}};
+    BezierArcLength<3, 3, Float> a{curve, 256};
+
+    /* Points at uniformly increasing distances are equally far apart */
+    const Float step = a.length()/20.0f;
+    Float minStep = Constants<Float>::inf(), maxStep = 0.0f;
+    for(std::size_t i = 1; i <= 20; ++i) {
+        const Float d = (curve.value(a.parameter(step*Float(i))) - curve.value(a.parameter(step*Float(i - 1)))).length();
+        minStep = Math::min(minStep, d);
+        maxStep = Math::max(maxStep, d);
+    }
+    CORRADE_COMPARE_AS(maxStep - minStep, step*0.02f, Corrade::TestSuite::Compare::Less);
+
+    /* Uniformly increasing factor on the other hand gives very uneven steps */
+    Float minUniformStep = Constants<Float>::inf(), maxUniformStep = 0.0f;
+    for(std::size_t i = 1; i <= 20; ++i) {
+        const Float d = (curve.value(Float(i)/20.0f) - curve.value(Float(i - 1)/20.0f)).length();
+        minUniformStep = Math::min(minUniformStep, d);
+        maxUniformStep = Math::max(maxUniformStep, d);
+    }
+    CORRADE_COMPARE_AS(maxUniformStep - minUniformStep, step*0.5f, Corrade::TestSuite::Compare::Greater);
+}
+
+void BezierArcLengthTest::parametersInto() {
+    BezierArcLength<3, 2, Float> a{QuarterCircle, 32};
+
+    const Float distances[]{-1.0f, 0.5f, 1.0f, 2.5f, 10.0f};
+    Float out[5];
+    a.parametersInto(distances, out);
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(out[i], a.parameter(distances[i]));
+
+    /* The output can be fed directly to Bezier::valueInto() */
+    Math::Vector<2, Float> points[5];
+    QuarterCircle.valueInto(out, points);
+    CORRADE_COMPARE(points[0], QuarterCircle[0]);
+    CORRADE_COMPARE(points[4], QuarterCircle[3]);
+}
+
+void BezierArcLengthTest::parametersIntoSizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    BezierArcLength<3, 2, Float> a{Line, 8};
+    const Float distances[3]{};
+    Float parameters[2];
+    a.parametersInto(distances, parameters);
+    CORRADE_COMPARE(out.str(), "Math::BezierArcLength::parametersInto(): expected 3 output items but got 2\n");
+}
+
+void BezierArcLengthTest::parameter100k() {
+    BezierArcLength<3, 2, Float> a{QuarterCircle, 256};
+
+    const Float step = a.length()/100000.0f;
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != 100000; ++i)
+            sum += a.parameter(step*Float(i));
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::BezierArcLengthTest)
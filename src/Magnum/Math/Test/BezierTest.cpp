@@ -25,11 +25,14 @@
 */
 
 #include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Configuration.h>
 
 #include "Magnum/Math/Bezier.h"
 #include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/Math/Functions.h"
 
 struct QBezier2D {
@@ -56,10 +59,13 @@ namespace Test {
 
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector2<Double> Vector2d;
+typedef Math::Vector3<Float> Vector3;
 typedef Math::Bezier<1, 2, Float> LinearBezier2D;
 typedef Math::QuadraticBezier2D<Float> QuadraticBezier2D;
 typedef Math::QuadraticBezier2D<Double> QuadraticBezier2Dd;
 typedef Math::CubicBezier2D<Float> CubicBezier2D;
+typedef Math::CubicBezier2D<Double> CubicBezier2Dd;
+typedef Math::CubicBezier3D<Float> CubicBezier3D;
 
 struct BezierTest : Corrade::TestSuite::Tester {
     explicit BezierTest();
@@ -82,8 +88,17 @@ struct BezierTest : Corrade::TestSuite::Tester {
     void subdivideQuadratic();
     void subdivideCubic();
 
+    void coefficientsLinear();
+    void coefficientsCubic();
+    void valueInto();
+    void valueIntoDouble();
+    void valueIntoSizeMismatch();
+
     void debug();
     void configuration();
+
+    void value100k();
+    void valueInto100k();
 };
 
 BezierTest::BezierTest() {
@@ -105,8 +120,17 @@ BezierTest::BezierTest() {
               &BezierTest::subdivideQuadratic,
               &BezierTest::subdivideCubic,
 
+              &BezierTest::coefficientsLinear,
+              &BezierTest::coefficientsCubic,
+              &BezierTest::valueInto,
+              &BezierTest::valueIntoDouble,
+              &BezierTest::valueIntoSizeMismatch,
+
               &BezierTest::debug,
               &BezierTest::configuration});
+
+    addBenchmarks({&BezierTest::value100k,
+                   &BezierTest::valueInto100k}, 10);
 }
 
 void BezierTest::construct() {
@@ -283,6 +307,58 @@ void BezierTest::subdivideCubic() {
     CORRADE_COMPARE(right, (CubicBezier2D{Vector2{7.10938f, 6.57812f}, Vector2{13.4375f, 8.6875f}, Vector2{16.25f, -2.0f}, Vector2{5.0f, -20.0f}}));
 }
 
+void BezierTest::coefficientsLinear() {
+    LinearBezier2D bezier{Vector2{1.0f, 2.0f}, Vector2{20.0f, 4.0f}};
+
+    const std::array<Math::Vector<2, Float>, 2> c = bezier.coefficients();
+    CORRADE_COMPARE(c[0], (Vector2{1.0f, 2.0f}));
+    CORRADE_COMPARE(c[1], (Vector2{19.0f, 2.0f}));
+}
+
+void BezierTest::coefficientsCubic() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    const std::array<Math::Vector<2, Float>, 4> c = bezier.coefficients();
+    CORRADE_COMPARE(c[0], (Vector2{0.0f, 0.0f}));
+    CORRADE_COMPARE(c[1], (Vector2{30.0f, 45.0f}));
+    CORRADE_COMPARE(c[2], (Vector2{0.0f, -78.0f}));
+    CORRADE_COMPARE(c[3], (Vector2{-25.0f, 13.0f}));
+}
+
+void BezierTest::valueInto() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    const Float t[]{0.0f, 0.2f, 0.5f, 0.7f, 1.0f};
+    Math::Vector<2, Float> out[5];
+    bezier.valueInto(t, out);
+    CORRADE_COMPARE(out[0], bezier[0]);
+    CORRADE_COMPARE(out[1], (Vector2{5.8f, 5.984f}));
+    CORRADE_COMPARE(out[2], (Vector2{11.875f, 4.625f}));
+    CORRADE_COMPARE(out[3], bezier.value(0.7f));
+    CORRADE_COMPARE(out[4], bezier[3]);
+}
+
+void BezierTest::valueIntoDouble() {
+    CubicBezier2Dd bezier{Vector2d{0.0, 0.0}, Vector2d{10.0, 15.0}, Vector2d{20.0, 4.0}, Vector2d{5.0, -20.0}};
+
+    const Double t[]{0.2, 0.5};
+    Math::Vector<2, Double> out[2];
+    bezier.valueInto(t, out);
+    CORRADE_COMPARE(out[0], (Vector2d{5.8, 5.984}));
+    CORRADE_COMPARE(out[1], (Vector2d{11.875, 4.625}));
+}
+
+void BezierTest::valueIntoSizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CubicBezier2D bezier;
+    const Float t[3]{};
+    Math::Vector<2, Float> values[2];
+    bezier.valueInto(t, values);
+    CORRADE_COMPARE(out.str(), "Math::Bezier::valueInto(): expected 3 output items but got 2\n");
+}
+
 void BezierTest::debug() {
     std::ostringstream out;
     Debug(&out) << CubicBezier2D{Vector2{0.0f, 1.0f}, Vector2{1.5f, -0.3f}, Vector2{2.1f, 0.5f}, Vector2{0.0f, 2.0f}};
@@ -300,6 +376,38 @@ void BezierTest::configuration() {
     CORRADE_COMPARE(c.value<CubicBezier2D>("bezier"), bezier);
 }
 
+namespace {
+    constexpr std::size_t BenchmarkSize = 100000;
+}
+
+void BezierTest::value100k() {
+    CubicBezier3D bezier{Vector3{0.0f, 0.0f, 0.0f}, Vector3{10.0f, 15.0f, -5.0f}, Vector3{20.0f, 4.0f, 8.0f}, Vector3{5.0f, -20.0f, 0.0f}};
+    std::vector<Float> t(BenchmarkSize);
+    for(std::size_t i = 0; i != BenchmarkSize; ++i)
+        t[i] = Float(i)/Float(BenchmarkSize - 1);
+    std::vector<Math::Vector<3, Float>> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = bezier.value(t[i]);
+
+    CORRADE_COMPARE(out.back(), bezier[3]);
+}
+
+void BezierTest::valueInto100k() {
+    CubicBezier3D bezier{Vector3{0.0f, 0.0f, 0.0f}, Vector3{10.0f, 15.0f, -5.0f}, Vector3{20.0f, 4.0f, 8.0f}, Vector3{5.0f, -20.0f, 0.0f}};
+    std::vector<Float> t(BenchmarkSize);
+    for(std::size_t i = 0; i != BenchmarkSize; ++i)
+        t[i] = Float(i)/Float(BenchmarkSize - 1);
+    std::vector<Math::Vector<3, Float>> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        bezier.valueInto(Corrade::Containers::arrayView(t.data(), t.size()),
+                         Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back(), bezier[3]);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::BezierTest)
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+/* Benchmarks of scalar color conversions and packing. The batch variants are
+   benchmarked in PackingBatchTest. Each benchmark processes Size items per
+   iteration. */
+struct ColorBenchmark: Corrade::TestSuite::Tester {
+    explicit ColorBenchmark();
+
+    void fromHsv();
+    void toHsv();
+    void fromSrgb();
+    void toSrgb();
+    void fromSrgbUnsignedByte();
+    void toSrgbUnsignedByte();
+    void pack();
+    void unpack();
+};
+
+typedef Math::Color3<Float> Color3;
+typedef Math::Color4<Float> Color4;
+typedef Math::Color3<UnsignedByte> Color3ub;
+typedef Math::Color4<UnsignedByte> Color4ub;
+typedef Math::Deg<Float> Deg;
+
+ColorBenchmark::ColorBenchmark() {
+    addBenchmarks({&ColorBenchmark::fromHsv,
+                   &ColorBenchmark::toHsv,
+                   &ColorBenchmark::fromSrgb,
+                   &ColorBenchmark::toSrgb,
+                   &ColorBenchmark::fromSrgbUnsignedByte,
+                   &ColorBenchmark::toSrgbUnsignedByte,
+                   &ColorBenchmark::pack,
+                   &ColorBenchmark::unpack}, 20);
+}
+
+namespace {
+
+constexpr std::size_t Size = 1000;
+
+/* Read in every benchmark iteration and used as an index offset, so the
+   compiler can't figure out all iterations calculate the same and do the
+   work just once */
+volatile std::size_t Zero = 0;
+
+std::vector<Color4> colors() {
+    std::vector<Color4> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = {Float(i % 7)/6.0f, Float(i % 13)/12.0f, Float(i % 256)/255.0f, 0.5f};
+    return out;
+}
+
+std::vector<Color4ub> colorsUnsignedByte() {
+    std::vector<Color4ub> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = {UnsignedByte(i*7), UnsignedByte(i*13), UnsignedByte(i), 0x80};
+    return out;
+}
+
+}
+
+void ColorBenchmark::fromHsv() {
+    std::vector<Color3::Hsv> in(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        in[i] = Color3::Hsv{Deg(Float(i % 360)), 0.75f, 0.5f};
+    std::vector<Color3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Color3::fromHsv(in[i + o]);
+    }
+
+    CORRADE_COMPARE(out[0], (Color3{0.5f, 0.125f, 0.125f}));
+}
+
+void ColorBenchmark::toHsv() {
+    const std::vector<Color4> in = colors();
+    std::vector<Color3::Hsv> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = in[i + o].rgb().toHsv();
+    }
+
+    CORRADE_COMPARE(Color3::fromHsv(out[17]), in[17].rgb());
+}
+
+void ColorBenchmark::fromSrgb() {
+    const std::vector<Color4> in = colors();
+    std::vector<Color4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Color4::fromSrgbAlpha(in[i + o]);
+    }
+
+    CORRADE_COMPARE(out[17].toSrgbAlpha(), in[17]);
+}
+
+void ColorBenchmark::toSrgb() {
+    const std::vector<Color4> in = colors();
+    std::vector<Vector4<Float>> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = in[i + o].toSrgbAlpha();
+    }
+
+    CORRADE_COMPARE(Color4::fromSrgbAlpha(out[17]), in[17]);
+}
+
+void ColorBenchmark::fromSrgbUnsignedByte() {
+    const std::vector<Color4ub> in = colorsUnsignedByte();
+    std::vector<Color4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Color4::fromSrgbAlpha(in[i + o]);
+    }
+
+    CORRADE_COMPARE(out[17], Color4::fromSrgbAlpha(Math::unpack<Color4>(in[17])));
+}
+
+void ColorBenchmark::toSrgbUnsignedByte() {
+    const std::vector<Color4> in = colors();
+    std::vector<Color4ub> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = in[i + o].toSrgbAlpha<UnsignedByte>();
+    }
+
+    CORRADE_COMPARE(out[0], (Color4ub{0x00, 0x00, 0x00, 0x7f}));
+}
+
+void ColorBenchmark::pack() {
+    const std::vector<Color4> in = colors();
+    std::vector<Color4ub> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Math::pack<Color4ub>(in[i + o]);
+    }
+
+    CORRADE_COMPARE(out[0], (Color4ub{0x00, 0x00, 0x00, 0x7f}));
+}
+
+void ColorBenchmark::unpack() {
+    const std::vector<Color4ub> in = colorsUnsignedByte();
+    std::vector<Color4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Math::unpack<Color4>(in[i + o]);
+    }
+
+    CORRADE_COMPARE(Math::pack<Color4ub>(out[17]), in[17]);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::ColorBenchmark)
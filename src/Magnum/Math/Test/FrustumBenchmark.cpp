@@ -0,0 +1,134 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+/* Benchmarks of frustum construction and of the scalar frustum intersection
+   tests. The batch variants are benchmarked in IntersectionBatchTest. Each
+   benchmark processes Size items per iteration. */
+struct FrustumBenchmark: Corrade::TestSuite::Tester {
+    explicit FrustumBenchmark();
+
+    void fromMatrix();
+    void pointFrustum();
+    void sphereFrustum();
+    void boxFrustum();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Frustum<Float> Frustum;
+typedef Math::Range3D<Float> Range3D;
+typedef Math::Deg<Float> Deg;
+
+FrustumBenchmark::FrustumBenchmark() {
+    addBenchmarks({&FrustumBenchmark::fromMatrix,
+                   &FrustumBenchmark::pointFrustum,
+                   &FrustumBenchmark::sphereFrustum,
+                   &FrustumBenchmark::boxFrustum}, 20);
+}
+
+namespace {
+
+constexpr std::size_t Size = 1000;
+
+/* Read in every benchmark iteration and used as an index offset, so the
+   compiler can't figure out all iterations calculate the same and do the
+   work just once */
+volatile std::size_t Zero = 0;
+
+const Frustum CameraFrustum = Frustum::fromMatrix(
+    Matrix4::perspectiveProjection(Deg{60.0f}, 1.5f, 0.5f, 50.0f));
+
+/* Points scattered around the camera, some inside and some outside */
+std::vector<Vector3> points() {
+    std::vector<Vector3> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = {Float(Int(i*7 % 101) - 50),
+                  Float(Int(i*13 % 61) - 30),
+                  Float(Int(i*3 % 79) - 70)};
+    return out;
+}
+
+}
+
+void FrustumBenchmark::fromMatrix() {
+    std::vector<Matrix4> in(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        in[i] = Matrix4::perspectiveProjection(Deg{60.0f}, 1.5f, 0.5f, 50.0f)*
+            Matrix4::rotationY(Deg(Float(i)));
+    std::vector<Frustum> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Frustum::fromMatrix(in[i + o]);
+    }
+
+    CORRADE_COMPARE(out[0], CameraFrustum);
+}
+
+void FrustumBenchmark::pointFrustum() {
+    const std::vector<Vector3> in = points();
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != Size; ++i)
+            count += Geometry::Intersection::pointFrustum(in[i], CameraFrustum);
+
+    CORRADE_VERIFY(count);
+}
+
+void FrustumBenchmark::sphereFrustum() {
+    const std::vector<Vector3> in = points();
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != Size; ++i)
+            count += Geometry::Intersection::sphereFrustum(in[i], 2.5f, CameraFrustum);
+
+    CORRADE_VERIFY(count);
+}
+
+void FrustumBenchmark::boxFrustum() {
+    const std::vector<Vector3> in = points();
+    std::vector<Range3D> boxes(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        boxes[i] = Range3D{in[i] - Vector3{1.5f}, in[i] + Vector3{1.5f}};
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != Size; ++i)
+            count += Geometry::Intersection::boxFrustum(boxes[i], CameraFrustum);
+
+    CORRADE_VERIFY(count);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FrustumBenchmark)
@@ -0,0 +1,322 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsFast.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct FunctionsFastTest: Corrade::TestSuite::Tester {
+    explicit FunctionsFastTest();
+
+    void sincos();
+    void sincosDeg();
+    void sincosConsistency();
+    void exp2();
+    void exp2Integral();
+    void exp2Clamp();
+    void log2();
+    void log2Integral();
+    void sqrtInverted();
+    void vector();
+
+    void sinBenchmark();
+    void sinBenchmarkStd();
+    void sincosBenchmark();
+    void sincosBenchmarkStd();
+    void exp2Benchmark();
+    void exp2BenchmarkStd();
+    void log2Benchmark();
+    void log2BenchmarkStd();
+    void sqrtInvertedBenchmark();
+    void sqrtInvertedBenchmarkStd();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Rad<Float> Rad;
+typedef Math::Vector3<Float> Vector3;
+
+FunctionsFastTest::FunctionsFastTest() {
+    addTests({&FunctionsFastTest::sincos,
+              &FunctionsFastTest::sincosDeg,
+              &FunctionsFastTest::sincosConsistency,
+              &FunctionsFastTest::exp2,
+              &FunctionsFastTest::exp2Integral,
+              &FunctionsFastTest::exp2Clamp,
+              &FunctionsFastTest::log2,
+              &FunctionsFastTest::log2Integral,
+              &FunctionsFastTest::sqrtInverted,
+              &FunctionsFastTest::vector});
+
+    addBenchmarks({&FunctionsFastTest::sinBenchmark,
+                   &FunctionsFastTest::sinBenchmarkStd,
+                   &FunctionsFastTest::sincosBenchmark,
+                   &FunctionsFastTest::sincosBenchmarkStd,
+                   &FunctionsFastTest::exp2Benchmark,
+                   &FunctionsFastTest::exp2BenchmarkStd,
+                   &FunctionsFastTest::log2Benchmark,
+                   &FunctionsFastTest::log2BenchmarkStd,
+                   &FunctionsFastTest::sqrtInvertedBenchmark,
+                   &FunctionsFastTest::sqrtInvertedBenchmarkStd}, 100);
+}
+
+namespace {
+
+/* Distance of two floats in ULPs. Maps the bit representation to a
+   monotonic integer sequence so the distance is correct also across zero. */
+Long ulps(const Float a, const Float b) {
+    Int ai, bi;
+    std::memcpy(&ai, &a, 4);
+    std::memcpy(&bi, &b, 4);
+    const Long ao = ai < 0 ? -Long(ai & 0x7fffffff) : Long(ai);
+    const Long bo = bi < 0 ? -Long(bi & 0x7fffffff) : Long(bi);
+    return ao > bo ? ao - bo : bo - ao;
+}
+
+/* All normalized positive floats, sampled with a prime step */
+template<class F> void forPositiveFloats(F f) {
+    for(UnsignedInt bits = 0x00800000u; bits < 0x7f800000u; bits += 251) {
+        Float value;
+        std::memcpy(&value, &bits, 4);
+        f(value);
+    }
+}
+
+enum: std::size_t { BenchmarkSize = 1000 };
+
+}
+
+void FunctionsFastTest::sincos() {
+    Long maxUlps = 0;
+    Double maxAbsolute = 0.0;
+    for(Int i = -1000000; i <= 1000000; ++i) {
+        const Float angle = Float(i)*0.01f;
+        const std::pair<Float, Float> sincos = sincosFast(Rad(angle));
+        const Double sin = std::sin(Double(angle));
+        const Double cos = std::cos(Double(angle));
+
+        maxAbsolute = Math::max(maxAbsolute, std::abs(Double(sincos.first) - sin));
+        maxAbsolute = Math::max(maxAbsolute, std::abs(Double(sincos.second) - cos));
+        if(std::abs(sin) > 1.0e-3) maxUlps = Math::max(maxUlps, ulps(sincos.first, Float(sin)));
+        if(std::abs(cos) > 1.0e-3) maxUlps = Math::max(maxUlps, ulps(sincos.second, Float(cos)));
+    }
+
+    /* Documented bounds */
+    CORRADE_COMPARE_AS(maxUlps, Long{2}, Corrade::TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxAbsolute, 1.0/(1 << 23), Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FunctionsFastTest::sincosDeg() {
+    CORRADE_COMPARE(sinFast(Deg(30.0f)), 0.5f);
+    CORRADE_COMPARE(cosFast(Deg(60.0f)), 0.5f);
+    CORRADE_COMPARE(sincosFast(Deg(-90.0f)).first, -1.0f);
+    CORRADE_COMPARE(sincosFast(Deg(180.0f)).second, -1.0f);
+    CORRADE_COMPARE(sincosFast(Deg(270.0f)).first, -1.0f);
+    CORRADE_COMPARE(sincosFast(Deg(360.0f)).second, 1.0f);
+}
+
+void FunctionsFastTest::sincosConsistency() {
+    std::size_t mismatchCount = 0;
+    for(Int i = -1000; i <= 1000; ++i) {
+        const Rad angle{Float(i)*0.1f};
+        const std::pair<Float, Float> sincos = sincosFast(angle);
+        if(sinFast(angle) != sincos.first) ++mismatchCount;
+        if(cosFast(angle) != sincos.second) ++mismatchCount;
+    }
+
+    CORRADE_COMPARE(mismatchCount, 0);
+}
+
+void FunctionsFastTest::exp2() {
+    Long maxUlps = 0;
+    for(Int i = -1260000; i <= 1270000; ++i) {
+        const Float exponent = Float(i)*0.0001f;
+        maxUlps = Math::max(maxUlps, ulps(exp2Fast(exponent), Float(std::exp2(Double(exponent)))));
+    }
+
+    CORRADE_COMPARE_AS(maxUlps, Long{2}, Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FunctionsFastTest::exp2Integral() {
+    std::size_t mismatchCount = 0;
+    for(Int i = -126; i <= 127; ++i)
+        if(exp2Fast(Float(i)) != std::ldexp(1.0f, i)) ++mismatchCount;
+
+    CORRADE_COMPARE(mismatchCount, 0);
+}
+
+void FunctionsFastTest::exp2Clamp() {
+    CORRADE_VERIFY(exp2Fast(-1000.0f) == std::ldexp(1.0f, -126));
+    CORRADE_VERIFY(exp2Fast(1000.0f) == std::ldexp(1.0f, 127));
+}
+
+void FunctionsFastTest::log2() {
+    Long maxUlps = 0;
+    forPositiveFloats([&](Float value) {
+        maxUlps = Math::max(maxUlps, ulps(log2Fast(value), Float(std::log2(Double(value)))));
+    });
+
+    CORRADE_COMPARE_AS(maxUlps, Long{2}, Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FunctionsFastTest::log2Integral() {
+    std::size_t mismatchCount = 0;
+    for(Int i = -126; i <= 127; ++i)
+        if(log2Fast(std::ldexp(1.0f, i)) != Float(i)) ++mismatchCount;
+
+    CORRADE_COMPARE(mismatchCount, 0);
+}
+
+void FunctionsFastTest::sqrtInverted() {
+    Double maxRelative[3]{};
+    forPositiveFloats([&](Float value) {
+        const Double expected = 1.0/std::sqrt(Double(value));
+        maxRelative[0] = Math::max(maxRelative[0], std::abs(Double(sqrtInvertedFast<0>(value)) - expected)/expected);
+        maxRelative[1] = Math::max(maxRelative[1], std::abs(Double(sqrtInvertedFast<1>(value)) - expected)/expected);
+        maxRelative[2] = Math::max(maxRelative[2], std::abs(Double(sqrtInvertedFast<2>(value)) - expected)/expected);
+    });
+
+    CORRADE_COMPARE_AS(maxRelative[0], 3.5e-2, Corrade::TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxRelative[1], 1.8e-3, Corrade::TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxRelative[2], 4.8e-6, Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FunctionsFastTest::vector() {
+    const Vector3 angles{0.5f, -2.0f, 35.0f};
+    const std::pair<Vector3, Vector3> sincos = sincosFast(angles);
+    CORRADE_COMPARE(sincos.first, (Vector3{sinFast(Rad(0.5f)), sinFast(Rad(-2.0f)), sinFast(Rad(35.0f))}));
+    CORRADE_COMPARE(sincos.second, (Vector3{cosFast(Rad(0.5f)), cosFast(Rad(-2.0f)), cosFast(Rad(35.0f))}));
+    CORRADE_COMPARE(sinFast(angles), sincos.first);
+    CORRADE_COMPARE(cosFast(angles), sincos.second);
+
+    CORRADE_COMPARE(exp2Fast(Vector3{1.0f, -3.0f, 0.5f}), (Vector3{2.0f, 0.125f, 1.414213562f}));
+    CORRADE_COMPARE(log2Fast(Vector3{2.0f, 0.125f, 1.414213562f}), (Vector3{1.0f, -3.0f, 0.5f}));
+    CORRADE_COMPARE(sqrtInvertedFast<2>(Vector3{4.0f, 0.25f, 16.0f}), (Vector3{0.5f, 2.0f, 0.25f}));
+    CORRADE_COMPARE(sqrtInvertedFast(Vector3{4.0f, 0.25f, 16.0f}), (Vector3{sqrtInvertedFast(4.0f), sqrtInvertedFast(0.25f), sqrtInvertedFast(16.0f)}));
+}
+
+namespace {
+
+/* The inputs are perturbed in each iteration so the compiler can't hoist the
+   calculation out of the benchmark loop */
+template<class F> Float benchmarkLoop(F f, Float offset) {
+    Float data[BenchmarkSize];
+    for(std::size_t i = 0; i != BenchmarkSize; ++i)
+        data[i] = offset + Float(i)*0.01f;
+    for(std::size_t i = 0; i != BenchmarkSize; ++i)
+        data[i] = f(data[i]);
+    Float sum{};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i)
+        sum += data[i];
+    return sum;
+}
+
+}
+
+void FunctionsFastTest::sinBenchmark() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return sinFast(Rad(a)); }, out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::sinBenchmarkStd() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return Math::sin(Rad(a)); }, out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::sincosBenchmark() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) {
+            const std::pair<Float, Float> sincos = sincosFast(Rad(a));
+            return sincos.first + sincos.second;
+        }, out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::sincosBenchmarkStd() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) {
+            const std::pair<Float, Float> sincos = Math::sincos(Rad(a));
+            return sincos.first + sincos.second;
+        }, out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::exp2Benchmark() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return exp2Fast(a); }, out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::exp2BenchmarkStd() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return std::exp2(a); }, out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::log2Benchmark() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return log2Fast(a); }, 1.0f + out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::log2BenchmarkStd() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return std::log2(a); }, 1.0f + out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::sqrtInvertedBenchmark() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return sqrtInvertedFast(a); }, 1.0f + out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+void FunctionsFastTest::sqrtInvertedBenchmarkStd() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out += benchmarkLoop([](Float a) { return Math::sqrtInverted(a); }, 1.0f + out*1.0e-6f);
+    CORRADE_VERIFY(out == out);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsFastTest)
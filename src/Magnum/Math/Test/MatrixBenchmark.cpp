@@ -0,0 +1,387 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+/* Benchmarks of the most commonly used vector and matrix operations. Each
+   benchmark processes Size items per iteration, run the executable with
+   the output piped to package/ci/benchmarks-to-json.py to get the results in
+   a machine-readable form. */
+struct MatrixBenchmark: Corrade::TestSuite::Tester {
+    explicit MatrixBenchmark();
+
+    void vector3Add();
+    void vector3Dot();
+    void vector3Cross();
+    void vector3Normalized();
+    void vector4Lerp();
+
+    void matrix3Multiply();
+    void matrix3Inverted();
+    void matrix3InvertedCofactor();
+    void matrix4Multiply();
+    void matrix4TransformPoint();
+    void matrix4TransformVector();
+    void matrix4Determinant();
+    void matrix4DeterminantLaplace();
+    void matrix4Inverted();
+    void matrix4InvertedCofactor();
+    void matrix4InvertedRigid();
+    void matrix4InvertedOrthogonal();
+    void matrix4Transposed();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix3<Float> Matrix3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Deg<Float> Deg;
+
+MatrixBenchmark::MatrixBenchmark() {
+    addBenchmarks({&MatrixBenchmark::vector3Add,
+                   &MatrixBenchmark::vector3Dot,
+                   &MatrixBenchmark::vector3Cross,
+                   &MatrixBenchmark::vector3Normalized,
+                   &MatrixBenchmark::vector4Lerp,
+
+                   &MatrixBenchmark::matrix3Multiply,
+                   &MatrixBenchmark::matrix3Inverted,
+                   &MatrixBenchmark::matrix3InvertedCofactor,
+                   &MatrixBenchmark::matrix4Multiply,
+                   &MatrixBenchmark::matrix4TransformPoint,
+                   &MatrixBenchmark::matrix4TransformVector,
+                   &MatrixBenchmark::matrix4Determinant,
+                   &MatrixBenchmark::matrix4DeterminantLaplace,
+                   &MatrixBenchmark::matrix4Inverted,
+                   &MatrixBenchmark::matrix4InvertedCofactor,
+                   &MatrixBenchmark::matrix4InvertedRigid,
+                   &MatrixBenchmark::matrix4InvertedOrthogonal,
+                   &MatrixBenchmark::matrix4Transposed}, 20);
+}
+
+namespace {
+
+constexpr std::size_t Size = 1000;
+
+/* Read in every benchmark iteration and used as an index offset, so the
+   compiler can't figure out all iterations calculate the same and do the
+   work just once */
+volatile std::size_t Zero = 0;
+
+/* Generic Laplace expansion and cofactor inversion, all the way down to 1x1
+   matrices. Baseline for the closed-form 3x3 and 4x4 specializations. */
+template<std::size_t size, class T> T determinantLaplace(const Matrix<size, T>& m);
+
+template<std::size_t size, class T> struct DeterminantLaplace {
+    static T determinant(const Matrix<size, T>& m) {
+        T out(0);
+        for(std::size_t col = 0; col != size; ++col)
+            out += ((col & 1) ? -1 : 1)*m[col][0]*determinantLaplace(m.ij(col, 0));
+        return out;
+    }
+};
+
+template<class T> struct DeterminantLaplace<1, T> {
+    static T determinant(const Matrix<1, T>& m) { return m[0][0]; }
+};
+
+template<std::size_t size, class T> T determinantLaplace(const Matrix<size, T>& m) {
+    return DeterminantLaplace<size, T>::determinant(m);
+}
+
+template<std::size_t size, class T> Matrix<size, T> invertedCofactor(const Matrix<size, T>& m) {
+    Matrix<size, T> out{NoInit};
+    const T determinant = determinantLaplace(m);
+    for(std::size_t col = 0; col != size; ++col)
+        for(std::size_t row = 0; row != size; ++row)
+            out[col][row] = (((row+col) & 1) ? -1 : 1)*determinantLaplace(m.ij(row, col))/determinant;
+    return out;
+}
+
+std::vector<Vector3> vectors3(const Float offset) {
+    std::vector<Vector3> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = {Float(i % 7) + offset, Float(i % 13) - 6.0f, 1.0f + Float(i % 5)};
+    return out;
+}
+
+std::vector<Vector4> vectors4(const Float offset) {
+    std::vector<Vector4> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = {Float(i % 7) + offset, Float(i % 13) - 6.0f, 1.0f + Float(i % 5), 1.0f};
+    return out;
+}
+
+/* Rigid transformations, so all the inversion variants are applicable */
+std::vector<Matrix4> matrices4() {
+    std::vector<Matrix4> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = Matrix4::translation({Float(i % 7), Float(i % 11), -Float(i % 3)})*
+            Matrix4::rotationY(Deg(Float(i)))*
+            Matrix4::rotationX(Deg(Float(i*3)));
+    return out;
+}
+
+std::vector<Matrix4> rotations4() {
+    std::vector<Matrix4> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = Matrix4::rotationY(Deg(Float(i)))*
+            Matrix4::rotationX(Deg(Float(i*3)));
+    return out;
+}
+
+std::vector<Matrix3> matrices3() {
+    std::vector<Matrix3> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = Matrix3::translation({Float(i % 7), Float(i % 11)})*
+            Matrix3::rotation(Deg(Float(i)));
+    return out;
+}
+
+}
+
+void MatrixBenchmark::vector3Add() {
+    const std::vector<Vector3> a = vectors3(0.0f), b = vectors3(1.0f);
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o] + b[i];
+    }
+
+    CORRADE_COMPARE(out[1], a[1] + b[1]);
+}
+
+void MatrixBenchmark::vector3Dot() {
+    const std::vector<Vector3> a = vectors3(0.0f), b = vectors3(1.0f);
+    Float sum{};
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != Size; ++i)
+            sum += Math::dot(a[i], b[i]);
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+void MatrixBenchmark::vector3Cross() {
+    const std::vector<Vector3> a = vectors3(0.0f), b = vectors3(1.0f);
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Math::cross(a[i + o], b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], Math::cross(a[1], b[1]));
+}
+
+void MatrixBenchmark::vector3Normalized() {
+    const std::vector<Vector3> a = vectors3(1.0f);
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].normalized();
+    }
+
+    CORRADE_VERIFY(out[1].isNormalized());
+}
+
+void MatrixBenchmark::vector4Lerp() {
+    const std::vector<Vector4> a = vectors4(0.0f), b = vectors4(1.0f);
+    std::vector<Vector4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Math::lerp(a[i + o], b[i], 0.25f);
+    }
+
+    CORRADE_COMPARE(out[1], Math::lerp(a[1], b[1], 0.25f));
+}
+
+void MatrixBenchmark::matrix3Multiply() {
+    const std::vector<Matrix3> a = matrices3();
+    std::vector<Matrix3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o]*a[Size - i - 1];
+    }
+
+    CORRADE_COMPARE(out[1], a[1]*a[Size - 2]);
+}
+
+void MatrixBenchmark::matrix3Inverted() {
+    const std::vector<Matrix3> a = matrices3();
+    std::vector<Matrix3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].inverted();
+    }
+
+    CORRADE_COMPARE(out[17]*a[17], Matrix3{});
+}
+
+void MatrixBenchmark::matrix3InvertedCofactor() {
+    const std::vector<Matrix3> a = matrices3();
+    std::vector<Matrix<3, Float>> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = invertedCofactor<3, Float>(a[i + o]);
+    }
+
+    CORRADE_COMPARE(Matrix3{out[17]}, a[17].inverted());
+}
+
+void MatrixBenchmark::matrix4Multiply() {
+    const std::vector<Matrix4> a = matrices4();
+    std::vector<Matrix4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o]*a[Size - i - 1];
+    }
+
+    CORRADE_COMPARE(out[1], a[1]*a[Size - 2]);
+}
+
+void MatrixBenchmark::matrix4TransformPoint() {
+    const std::vector<Matrix4> a = matrices4();
+    const std::vector<Vector3> b = vectors3(0.0f);
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transformPoint(b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], a[1].transformPoint(b[1]));
+}
+
+void MatrixBenchmark::matrix4TransformVector() {
+    const std::vector<Matrix4> a = matrices4();
+    const std::vector<Vector3> b = vectors3(0.0f);
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transformVector(b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], a[1].transformVector(b[1]));
+}
+
+void MatrixBenchmark::matrix4Determinant() {
+    const std::vector<Matrix4> a = matrices4();
+    Float sum{};
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != Size; ++i)
+            sum += a[i].determinant();
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+void MatrixBenchmark::matrix4DeterminantLaplace() {
+    const std::vector<Matrix4> a = matrices4();
+    Float sum{};
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != Size; ++i)
+            sum += determinantLaplace<4, Float>(a[i]);
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+void MatrixBenchmark::matrix4Inverted() {
+    const std::vector<Matrix4> a = matrices4();
+    std::vector<Matrix4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].inverted();
+    }
+
+    CORRADE_COMPARE(out[17]*a[17], Matrix4{});
+}
+
+void MatrixBenchmark::matrix4InvertedCofactor() {
+    const std::vector<Matrix4> a = matrices4();
+    std::vector<Matrix<4, Float>> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = invertedCofactor<4, Float>(a[i + o]);
+    }
+
+    CORRADE_COMPARE(Matrix4{out[17]}, a[17].inverted());
+}
+
+void MatrixBenchmark::matrix4InvertedRigid() {
+    const std::vector<Matrix4> a = matrices4();
+    std::vector<Matrix4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].invertedRigid();
+    }
+
+    CORRADE_COMPARE(out[17]*a[17], Matrix4{});
+}
+
+void MatrixBenchmark::matrix4InvertedOrthogonal() {
+    const std::vector<Matrix4> a = rotations4();
+    std::vector<Matrix4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].invertedOrthogonal();
+    }
+
+    CORRADE_COMPARE(out[17].transposed(), a[17]);
+}
+
+void MatrixBenchmark::matrix4Transposed() {
+    const std::vector<Matrix4> a = matrices4();
+    std::vector<Matrix4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transposed();
+    }
+
+    CORRADE_COMPARE(out[17].transposed(), a[17]);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixBenchmark)
@@ -74,7 +74,12 @@ struct MatrixTest: Corrade::TestSuite::Tester {
     void trace();
     void ij();
     void determinant();
+    void determinant3();
+    void determinant4();
     void inverted();
+    void inverted3();
+    void inverted5();
+    void invertedIntegral();
     void invertedOrthogonal();
 
     void subclassTypes();
@@ -108,7 +113,12 @@ MatrixTest::MatrixTest() {
               &MatrixTest::trace,
               &MatrixTest::ij,
               &MatrixTest::determinant,
+              &MatrixTest::determinant3,
+              &MatrixTest::determinant4,
               &MatrixTest::inverted,
+              &MatrixTest::inverted3,
+              &MatrixTest::inverted5,
+              &MatrixTest::invertedIntegral,
               &MatrixTest::invertedOrthogonal,
 
               &MatrixTest::subclassTypes,
@@ -118,6 +128,50 @@ MatrixTest::MatrixTest() {
               &MatrixTest::configuration});
 }
 
+namespace {
+
+/* Generic Laplace expansion and cofactor inversion, all the way down to 1x1
+   matrices. Used to verify the closed-form 3x3 and 4x4 specializations
+   against. */
+template<std::size_t size, class T> T determinantLaplace(const Matrix<size, T>& m);
+
+template<std::size_t size, class T> struct DeterminantLaplace {
+    static T determinant(const Matrix<size, T>& m) {
+        T out(0);
+        for(std::size_t col = 0; col != size; ++col)
+            out += ((col & 1) ? -1 : 1)*m[col][0]*determinantLaplace(m.ij(col, 0));
+        return out;
+    }
+};
+
+template<class T> struct DeterminantLaplace<1, T> {
+    static T determinant(const Matrix<1, T>& m) { return m[0][0]; }
+};
+
+template<std::size_t size, class T> T determinantLaplace(const Matrix<size, T>& m) {
+    return DeterminantLaplace<size, T>::determinant(m);
+}
+
+template<std::size_t size, class T> Matrix<size, T> invertedCofactor(const Matrix<size, T>& m) {
+    Matrix<size, T> out{NoInit};
+    const T determinant = determinantLaplace(m);
+    for(std::size_t col = 0; col != size; ++col)
+        for(std::size_t row = 0; row != size; ++row)
+            out[col][row] = (((row+col) & 1) ? -1 : 1)*determinantLaplace(m.ij(row, col))/determinant;
+    return out;
+}
+
+const Matrix3x3 TestMatrix3{Vector3{3.0f,  5.0f, 8.0f},
+                            Vector3{4.0f,  4.0f, 7.0f},
+                            Vector3{7.0f, -1.0f, 8.0f}};
+
+const Matrix4x4 TestMatrix4{Vector4{3.0f,  5.0f, 8.0f, 4.0f},
+                            Vector4{4.0f,  4.0f, 7.0f, 3.0f},
+                            Vector4{7.0f, -1.0f, 8.0f, 0.0f},
+                            Vector4{9.0f,  4.0f, 5.0f, 9.0f}};
+
+}
+
 void MatrixTest::construct() {
     constexpr Matrix4x4 a = {Vector4(3.0f,  5.0f, 8.0f, -3.0f),
                              Vector4(4.5f,  4.0f, 7.0f,  2.0f),
@@ -317,6 +371,31 @@ void MatrixTest::determinant() {
     CORRADE_COMPARE(m.determinant(), -2);
 }
 
+void MatrixTest::determinant3() {
+    Matrix<3, Int> m{Vector<3, Int>{1, 2, 2},
+                     Vector<3, Int>{2, 3, -1},
+                     Vector<3, Int>{4, 1, 5}};
+    CORRADE_COMPARE(m.determinant(), -32);
+    CORRADE_COMPARE(m.determinant(), determinantLaplace(m));
+
+    CORRADE_COMPARE(TestMatrix3.determinant(), determinantLaplace(TestMatrix3));
+}
+
+void MatrixTest::determinant4() {
+    Matrix4x4i m{Vector4i{1, 2, 2, 1},
+                 Vector4i{2, 3, 2, -2},
+                 Vector4i{1, 1, 1, 0},
+                 Vector4i{3, 0, -4, 1}};
+    CORRADE_COMPARE(m.determinant(), determinantLaplace(m));
+
+    /* Every column swap flips the sign */
+    Matrix4x4i swapped{m[1], m[0], m[2], m[3]};
+    CORRADE_COMPARE(swapped.determinant(), -m.determinant());
+
+    CORRADE_COMPARE(TestMatrix4.determinant(), -412.0f);
+    CORRADE_COMPARE(TestMatrix4.determinant(), determinantLaplace(TestMatrix4));
+}
+
 void MatrixTest::inverted() {
     Matrix4x4 m(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
                 Vector4(4.0f,  4.0f, 7.0f, 3.0f),
@@ -334,6 +413,54 @@ void MatrixTest::inverted() {
     CORRADE_COMPARE(_inverse*m, Matrix4x4());
 }
 
+void MatrixTest::inverted3() {
+    Matrix3x3 inverse = TestMatrix3.inverted();
+    CORRADE_COMPARE(inverse, invertedCofactor(TestMatrix3));
+    CORRADE_COMPARE(inverse*TestMatrix3, Matrix3x3());
+    CORRADE_COMPARE(TestMatrix3*inverse, Matrix3x3());
+}
+
+void MatrixTest::inverted5() {
+    /* Goes through the generic code path */
+    Matrix<5, Float> m{Vector<5, Float>{1.0f, 2.0f, 2.0f, 1.0f,  0.0f},
+                       Vector<5, Float>{2.0f, 3.0f, 2.0f, 1.0f, -2.0f},
+                       Vector<5, Float>{1.0f, 1.0f, 1.0f, 1.0f,  0.0f},
+                       Vector<5, Float>{2.0f, 0.0f, 0.0f, 1.0f,  2.0f},
+                       Vector<5, Float>{3.0f, 1.0f, 0.0f, 1.0f, -2.0f}};
+    Matrix<5, Float> inverse = m.inverted();
+    CORRADE_COMPARE(inverse, invertedCofactor(m));
+    CORRADE_COMPARE(inverse*m, (Matrix<5, Float>{}));
+}
+
+void MatrixTest::invertedIntegral() {
+    /* Determinant of 1, so the inverse is integral as well */
+    Matrix<3, Int> m3{Vector<3, Int>{2, 1, 1},
+                      Vector<3, Int>{3, 2, 1},
+                      Vector<3, Int>{1, 1, 1}};
+    Matrix<3, Int> inverse3 = m3.inverted();
+    CORRADE_COMPARE(inverse3, invertedCofactor(m3));
+    CORRADE_COMPARE(inverse3*m3, (Matrix<3, Int>{}));
+
+    Matrix4x4i m4{Vector4i{1, 2, 0, -1},
+                  Vector4i{2, 5, 1, -2},
+                  Vector4i{0, 3, 4, 3},
+                  Vector4i{1, 2, 2, 6}};
+    Matrix4x4i inverse4 = m4.inverted();
+    CORRADE_COMPARE(inverse4, invertedCofactor(m4));
+    CORRADE_COMPARE(inverse4*m4, Matrix4x4i{});
+
+    /* Determinant of 2, the adjugate is divided by it with integer division
+       and not multiplied by a reciprocal that would get truncated to zero */
+    Matrix<3, Int> m3b{m3[0], m3[1], m3[2]*2};
+    CORRADE_COMPARE(m3b.determinant(), 2);
+    CORRADE_COMPARE(m3b.inverted(), invertedCofactor(m3b));
+    CORRADE_COMPARE(m3b.inverted()[0], (Vector<3, Int>{1, 0, 0}));
+
+    Matrix4x4i m4b{m4[0], m4[1], m4[2], m4[3]*2};
+    CORRADE_COMPARE(m4b.determinant(), 2);
+    CORRADE_COMPARE(m4b.inverted(), invertedCofactor(m4b));
+}
+
 void MatrixTest::invertedOrthogonal() {
     std::ostringstream o;
     Error redirectError{&o};
@@ -0,0 +1,388 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/TypeTraits.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct PackingBatchTest: Corrade::TestSuite::Tester {
+    explicit PackingBatchTest();
+
+    template<class T> void unpack();
+    template<class T> void pack();
+    void unpackSrgb();
+    void packSrgb();
+    void packSrgbOutOfRange();
+    void unpackSrgbColor3();
+    void unpackSrgbColor4();
+    void packSrgbColor3();
+    void packSrgbColor4();
+    void vectorData();
+
+    void unpackUnsignedByte100k();
+    void packUnsignedByte100k();
+    void unpackSrgb100k();
+    void unpackSrgb100kScalar();
+    void packSrgb100k();
+    void packSrgb100kScalar();
+    void unpackSrgbColor4ub100k();
+    void unpackSrgbColor4ub100kCalculated();
+    void packSrgbColor4ub100k();
+    void packSrgbColor4ub100kCalculated();
+};
+
+typedef Math::Color4<Float> Color4;
+typedef Math::Color3<UnsignedByte> Color3ub;
+typedef Math::Color4<UnsignedByte> Color4ub;
+
+PackingBatchTest::PackingBatchTest() {
+    addTests({&PackingBatchTest::unpack<UnsignedByte>,
+              &PackingBatchTest::unpack<Byte>,
+              &PackingBatchTest::unpack<UnsignedShort>,
+              &PackingBatchTest::unpack<Short>,
+              &PackingBatchTest::pack<UnsignedByte>,
+              &PackingBatchTest::pack<Byte>,
+              &PackingBatchTest::pack<UnsignedShort>,
+              &PackingBatchTest::pack<Short>,
+              &PackingBatchTest::unpackSrgb,
+              &PackingBatchTest::packSrgb,
+              &PackingBatchTest::packSrgbOutOfRange,
+              &PackingBatchTest::unpackSrgbColor3,
+              &PackingBatchTest::unpackSrgbColor4,
+              &PackingBatchTest::packSrgbColor3,
+              &PackingBatchTest::packSrgbColor4,
+              &PackingBatchTest::vectorData});
+
+    addBenchmarks({&PackingBatchTest::unpackUnsignedByte100k,
+                   &PackingBatchTest::packUnsignedByte100k,
+                   &PackingBatchTest::unpackSrgb100k,
+                   &PackingBatchTest::unpackSrgb100kScalar,
+                   &PackingBatchTest::packSrgb100k,
+                   &PackingBatchTest::packSrgb100kScalar,
+                   &PackingBatchTest::unpackSrgbColor4ub100k,
+                   &PackingBatchTest::unpackSrgbColor4ub100kCalculated,
+                   &PackingBatchTest::packSrgbColor4ub100k,
+                   &PackingBatchTest::packSrgbColor4ub100kCalculated}, 10);
+}
+
+namespace {
+
+/* All values of given integral type, repeated a few times and with one more
+   value at the end so the remainder of the vectorized loops gets exercised
+   as well */
+template<class T> std::vector<T> allValues() {
+    std::vector<T> out;
+    for(std::size_t repeat = 0; repeat != 3; ++repeat)
+        for(Long i = std::numeric_limits<T>::min(); i <= std::numeric_limits<T>::max(); ++i)
+            out.push_back(T(i));
+    out.push_back(std::numeric_limits<T>::max());
+    return out;
+}
+
+/* Values densely covering given range, not a multiple of SIMD width */
+std::vector<Float> rangeValues(Float min, Float max) {
+    std::vector<Float> out;
+    constexpr std::size_t Count = 100003;
+    for(std::size_t i = 0; i != Count; ++i)
+        out.push_back(min + (max - min)*Float(i)/Float(Count - 1));
+    return out;
+}
+
+/* Reference sRGB conversion, calculated independently of the Color3
+   implementation and in double precision */
+Double srgbToLinear(const Double srgb) {
+    return srgb <= 0.04045 ? srgb/12.92 : std::pow((srgb + 0.055)/1.055, 2.4);
+}
+
+Double linearToSrgb(const Double linear) {
+    return linear <= 0.0031308 ? linear*12.92 : 1.055*std::pow(linear, 1.0/2.4) - 0.055;
+}
+
+}
+
+template<class T> void PackingBatchTest::unpack() {
+    setTestCaseName(std::string{"unpack<"} + TypeTraits<T>::name() + ">");
+
+    const std::vector<T> in = allValues<T>();
+    std::vector<Float> out(in.size());
+    unpackInto(Corrade::Containers::arrayView(in.data(), in.size()),
+               Corrade::Containers::arrayView(out.data(), out.size()));
+
+    /* The output is expected to be bit-exact */
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != in.size(); ++i)
+        if(out[i] != Math::unpack<Float, T>(in[i])) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+template<class T> void PackingBatchTest::pack() {
+    setTestCaseName(std::string{"pack<"} + TypeTraits<T>::name() + ">");
+
+    const std::vector<Float> in = rangeValues(std::is_signed<T>::value ? -1.0f : 0.0f, 1.0f);
+    std::vector<T> out(in.size());
+    packInto(Corrade::Containers::arrayView(in.data(), in.size()),
+             Corrade::Containers::arrayView(out.data(), out.size()));
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != in.size(); ++i)
+        if(out[i] != Math::pack<T, Float>(in[i])) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+void PackingBatchTest::unpackSrgb() {
+    const std::vector<UnsignedByte> in = allValues<UnsignedByte>();
+    std::vector<Float> out(in.size());
+    unpackSrgbInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                   Corrade::Containers::arrayView(out.data(), out.size()));
+
+    /* Neighboring values differ by at least 3.0e-4, so this is strict enough
+       to catch an off-by-one in the table, while not depending on precision
+       of std::pow() */
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != in.size(); ++i)
+        if(std::abs(Double(out[i]) - srgbToLinear(in[i]/255.0)) > 1.0e-6) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+
+    /* Spot-check a few known values */
+    CORRADE_COMPARE(out[0], 0.0f);
+    CORRADE_COMPARE(out[0x33], 0.0331048f);
+    CORRADE_COMPARE(out[0xf3], 0.896269f);
+    CORRADE_COMPARE(out[0xff], 1.0f);
+}
+
+void PackingBatchTest::packSrgb() {
+    const std::vector<Float> in = rangeValues(0.0f, 1.0f);
+    std::vector<UnsignedByte> out(in.size());
+    packSrgbInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                 Corrade::Containers::arrayView(out.data(), out.size()));
+
+    /* Packing truncates, so values that are within floating-point precision
+       of an integer may end up on either side of it. Elsewhere the result
+       has to match exactly. */
+    std::size_t mismatches = 0;
+    std::size_t nearBoundary = 0;
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        const Double expected = linearToSrgb(Double(in[i]))*255.0;
+        const Double boundary = std::round(expected);
+        if(std::abs(expected - boundary) < 1.0e-3) {
+            ++nearBoundary;
+            if(out[i] != boundary && out[i] != boundary - 1.0) ++mismatches;
+        } else if(out[i] != UnsignedByte(expected)) ++mismatches;
+    }
+    CORRADE_COMPARE(mismatches, 0);
+    CORRADE_VERIFY(nearBoundary < in.size()/100);
+}
+
+void PackingBatchTest::packSrgbOutOfRange() {
+    const Float in[]{-1.0f, -0.0f, 1.0f, 1.5f, Constants<Float>::inf()};
+    UnsignedByte out[5];
+    packSrgbInto(in, out);
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[1], 0);
+    /* Not 255, consistently with the scalar conversion, which due to
+       rounding doesn't reach 255 either */
+    CORRADE_COMPARE(out[2], 254);
+    CORRADE_COMPARE(out[3], out[2]);
+    CORRADE_COMPARE(out[4], out[2]);
+}
+
+void PackingBatchTest::unpackSrgbColor3() {
+    const Color3ub in[]{{0x00, 0x33, 0xf3}, {0xff, 0x80, 0x01}};
+    Color4 out[2];
+    unpackSrgbInto(in, out);
+    CORRADE_COMPARE(out[0], Color4::fromSrgb(in[0]));
+    CORRADE_COMPARE(out[1], Color4::fromSrgb(in[1]));
+    CORRADE_COMPARE(out[0], (Color4{0.0f, 0.0331048f, 0.896269f, 1.0f}));
+}
+
+void PackingBatchTest::unpackSrgbColor4() {
+    const Color4ub in[]{{0x00, 0x33, 0xf3, 0x80}, {0xff, 0x80, 0x01, 0x00}};
+    Color4 out[2];
+    unpackSrgbInto(in, out);
+    CORRADE_COMPARE(out[0], Color4::fromSrgbAlpha(in[0]));
+    CORRADE_COMPARE(out[1], Color4::fromSrgbAlpha(in[1]));
+    CORRADE_COMPARE(out[0], (Color4{0.0f, 0.0331048f, 0.896269f, 0.501961f}));
+}
+
+void PackingBatchTest::packSrgbColor3() {
+    const Color4 in[]{{0.0f, 0.0331048f, 0.896269f, 0.5f}, {0.25f, 0.5f, 0.75f, 1.0f}};
+    Color3ub out[2];
+    packSrgbInto(in, out);
+    CORRADE_COMPARE(out[0], in[0].rgb().toSrgb<UnsignedByte>());
+    CORRADE_COMPARE(out[1], in[1].rgb().toSrgb<UnsignedByte>());
+    CORRADE_COMPARE(out[0], (Color3ub{0x00, 0x33, 0xf2}));
+}
+
+void PackingBatchTest::packSrgbColor4() {
+    const Color4 in[]{{0.0f, 0.0331048f, 0.896269f, 0.5f}, {0.25f, 0.5f, 0.75f, 1.0f}};
+    Color4ub out[2];
+    packSrgbInto(in, out);
+    CORRADE_COMPARE(out[0], in[0].toSrgbAlpha<UnsignedByte>());
+    CORRADE_COMPARE(out[1], in[1].toSrgbAlpha<UnsignedByte>());
+    CORRADE_COMPARE(out[0], (Color4ub{0x00, 0x33, 0xf2, 0x7f}));
+}
+
+void PackingBatchTest::vectorData() {
+    const Color4ub in[]{{0x33, 0xb5, 0x00, 0xff}, {0x00, 0x80, 0xff, 0x33}};
+    Color4 out[2];
+    unpackInto(Corrade::Containers::arrayCast<const UnsignedByte>(in),
+               Corrade::Containers::arrayCast<Float>(out));
+    CORRADE_COMPARE(out[0], Math::unpack<Color4>(in[0]));
+    CORRADE_COMPARE(out[1], Math::unpack<Color4>(in[1]));
+
+    Color4ub packed[2];
+    packInto(Corrade::Containers::arrayCast<const Float>(out),
+             Corrade::Containers::arrayCast<UnsignedByte>(packed));
+    CORRADE_COMPARE(packed[0], in[0]);
+    CORRADE_COMPARE(packed[1], in[1]);
+}
+
+namespace {
+    constexpr std::size_t BenchmarkSize = 100000;
+}
+
+void PackingBatchTest::unpackUnsignedByte100k() {
+    std::vector<UnsignedByte> in(BenchmarkSize, 0x7f);
+    std::vector<Float> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        unpackInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                   Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back(), 0.498039f);
+}
+
+void PackingBatchTest::packUnsignedByte100k() {
+    std::vector<Float> in(BenchmarkSize, 0.5f);
+    std::vector<UnsignedByte> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        packInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                 Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back(), 127);
+}
+
+void PackingBatchTest::unpackSrgb100k() {
+    std::vector<UnsignedByte> in(BenchmarkSize, 0xf3);
+    std::vector<Float> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        unpackSrgbInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                       Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back(), 0.896269f);
+}
+
+void PackingBatchTest::unpackSrgb100kScalar() {
+    std::vector<UnsignedByte> in(BenchmarkSize, 0xf3);
+    std::vector<Float> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Color3<Float>::fromSrgb(Vector3<UnsignedByte>{in[i]}).r();
+
+    CORRADE_COMPARE(out.back(), 0.896269f);
+}
+
+void PackingBatchTest::packSrgb100k() {
+    std::vector<Float> in(BenchmarkSize, 0.896269f);
+    std::vector<UnsignedByte> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        packSrgbInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                     Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back(), 0xf2);
+}
+
+void PackingBatchTest::packSrgb100kScalar() {
+    std::vector<Float> in(BenchmarkSize, 0.896269f);
+    std::vector<UnsignedByte> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Color3<Float>{in[i]}.toSrgb<UnsignedByte>().r();
+
+    CORRADE_COMPARE(out.back(), 0xf2);
+}
+
+void PackingBatchTest::unpackSrgbColor4ub100k() {
+    std::vector<Color4ub> in(BenchmarkSize, Color4ub{0x33, 0x80, 0xf3, 0x80});
+    std::vector<Color4> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        unpackSrgbInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                       Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back().b(), 0.896269f);
+}
+
+void PackingBatchTest::unpackSrgbColor4ub100kCalculated() {
+    std::vector<Color4ub> in(BenchmarkSize, Color4ub{0x33, 0x80, 0xf3, 0x80});
+    std::vector<Color4> out(BenchmarkSize);
+
+    /* What the scalar conversion was doing before it used lookup tables */
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Color4::fromSrgbAlpha(Math::unpack<Vector4<Float>>(in[i]));
+
+    CORRADE_COMPARE(out.back().b(), 0.896269f);
+}
+
+void PackingBatchTest::packSrgbColor4ub100k() {
+    std::vector<Color4> in(BenchmarkSize, Color4{0.0331048f, 0.5f, 0.896269f, 0.5f});
+    std::vector<Color4ub> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        packSrgbInto(Corrade::Containers::arrayView(in.data(), in.size()),
+                     Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back().b(), 0xf2);
+}
+
+void PackingBatchTest::packSrgbColor4ub100kCalculated() {
+    std::vector<Color4> in(BenchmarkSize, Color4{0.0331048f, 0.5f, 0.896269f, 0.5f});
+    std::vector<Color4ub> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Math::pack<Color4ub>(in[i].toSrgbAlpha());
+
+    CORRADE_COMPARE(out.back().b(), 0xf2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchTest)
@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/QuaternionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct QuaternionBatchTest: Corrade::TestSuite::Tester {
+    explicit QuaternionBatchTest();
+
+    void lerp();
+    void lerpPerItem();
+    void slerp();
+    void slerpPerItem();
+    void slerpSame();
+    void sizeMismatch();
+
+    void lerp100k();
+    void lerp100kScalar();
+    void slerp100k();
+    void slerp100kScalar();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Quaternion<Float> Quaternion;
+
+QuaternionBatchTest::QuaternionBatchTest() {
+    addTests({&QuaternionBatchTest::lerp,
+              &QuaternionBatchTest::lerpPerItem,
+              &QuaternionBatchTest::slerp,
+              &QuaternionBatchTest::slerpPerItem,
+              &QuaternionBatchTest::slerpSame,
+              &QuaternionBatchTest::sizeMismatch});
+
+    addBenchmarks({&QuaternionBatchTest::lerp100k,
+                   &QuaternionBatchTest::lerp100kScalar,
+                   &QuaternionBatchTest::slerp100k,
+                   &QuaternionBatchTest::slerp100kScalar}, 10);
+}
+
+namespace {
+
+/* Rotations around varying axes, count not a multiple of SIMD width */
+std::vector<Quaternion> rotations(std::size_t count, Float offset) {
+    std::vector<Quaternion> out;
+    for(std::size_t i = 0; i != count; ++i) {
+        const Float f = Float(i) + offset;
+        out.push_back(Quaternion::rotation(Deg(f*7.3f),
+            Vector3{std::sin(f), std::cos(f*0.7f), 0.5f}.normalized()));
+    }
+    return out;
+}
+
+constexpr std::size_t Count = 1003;
+
+}
+
+void QuaternionBatchTest::lerp() {
+    const std::vector<Quaternion> a = rotations(Count, 0.0f);
+    const std::vector<Quaternion> b = rotations(Count, 0.35f);
+    std::vector<Quaternion> out(Count);
+    lerpInto(Corrade::Containers::arrayView(a.data(), a.size()),
+             Corrade::Containers::arrayView(b.data(), b.size()), 0.3f,
+             Corrade::Containers::arrayView(out.data(), out.size()));
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != Count; ++i)
+        if(out[i] != Math::lerp(a[i], b[i], 0.3f)) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+void QuaternionBatchTest::lerpPerItem() {
+    const std::vector<Quaternion> a = rotations(Count, 0.0f);
+    const std::vector<Quaternion> b = rotations(Count, 0.35f);
+    std::vector<Float> t;
+    for(std::size_t i = 0; i != Count; ++i) t.push_back(Float(i)/Float(Count - 1));
+    std::vector<Quaternion> out(Count);
+    lerpInto(Corrade::Containers::arrayView(a.data(), a.size()),
+             Corrade::Containers::arrayView(b.data(), b.size()),
+             Corrade::Containers::arrayView(t.data(), t.size()),
+             Corrade::Containers::arrayView(out.data(), out.size()));
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != Count; ++i)
+        if(out[i] != Math::lerp(a[i], b[i], t[i])) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+    CORRADE_COMPARE(out.front(), a.front());
+    CORRADE_COMPARE(out.back(), b.back());
+}
+
+void QuaternionBatchTest::slerp() {
+    const std::vector<Quaternion> a = rotations(Count, 0.0f);
+    const std::vector<Quaternion> b = rotations(Count, 0.35f);
+    std::vector<Quaternion> out(Count);
+    slerpInto(Corrade::Containers::arrayView(a.data(), a.size()),
+              Corrade::Containers::arrayView(b.data(), b.size()), 0.3f,
+              Corrade::Containers::arrayView(out.data(), out.size()));
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != Count; ++i)
+        if(out[i] != Math::slerp(a[i], b[i], 0.3f)) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+}
+
+void QuaternionBatchTest::slerpPerItem() {
+    const std::vector<Quaternion> a = rotations(Count, 0.0f);
+    const std::vector<Quaternion> b = rotations(Count, 0.35f);
+    std::vector<Float> t;
+    for(std::size_t i = 0; i != Count; ++i) t.push_back(Float(i)/Float(Count - 1));
+    std::vector<Quaternion> out(Count);
+    slerpInto(Corrade::Containers::arrayView(a.data(), a.size()),
+              Corrade::Containers::arrayView(b.data(), b.size()),
+              Corrade::Containers::arrayView(t.data(), t.size()),
+              Corrade::Containers::arrayView(out.data(), out.size()));
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != Count; ++i)
+        if(out[i] != Math::slerp(a[i], b[i], t[i])) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+    CORRADE_COMPARE(out.front(), a.front());
+    CORRADE_COMPARE(out.back(), b.back());
+}
+
+void QuaternionBatchTest::slerpSame() {
+    /* Same quaternions shouldn't produce NaNs */
+    const Quaternion a[]{Quaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+                         Quaternion{}};
+    Quaternion out[2];
+    slerpInto(a, a, 0.75f, out);
+    CORRADE_COMPARE(out[0], a[0]);
+    CORRADE_COMPARE(out[1], a[1]);
+
+    /* Neither should opposite ones, mixed with ones that get interpolated */
+    const Quaternion b[]{-a[0], Quaternion::rotation(Deg(90.0f), Vector3::yAxis())};
+    slerpInto(a, b, 0.5f, out);
+    CORRADE_COMPARE(out[0], a[0]);
+    CORRADE_COMPARE(out[1], Math::slerp(a[1], b[1], 0.5f));
+}
+
+void QuaternionBatchTest::sizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Quaternion a[3];
+    const Quaternion b[2];
+    const Float t[3]{};
+    Quaternion result[3];
+    lerpInto(a, b, 0.5f, result);
+    lerpInto(a, a, Corrade::Containers::arrayView(t, 2), result);
+    slerpInto(a, a, 0.5f, Corrade::Containers::arrayView(result, 2));
+    slerpInto(a, b, t, result);
+    CORRADE_COMPARE(out.str(),
+        "Math::lerpInto(): expected arrays of the same size, got 3, 2 and 3\n"
+        "Math::lerpInto(): expected arrays of the same size, got 3, 3, 2 and 3\n"
+        "Math::slerpInto(): expected arrays of the same size, got 3, 3 and 2\n"
+        "Math::slerpInto(): expected arrays of the same size, got 3, 2, 3 and 3\n");
+}
+
+namespace {
+    constexpr std::size_t BenchmarkSize = 100000;
+}
+
+void QuaternionBatchTest::lerp100k() {
+    const std::vector<Quaternion> a = rotations(BenchmarkSize, 0.0f);
+    const std::vector<Quaternion> b = rotations(BenchmarkSize, 0.35f);
+    std::vector<Quaternion> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        lerpInto(Corrade::Containers::arrayView(a.data(), a.size()),
+                 Corrade::Containers::arrayView(b.data(), b.size()), 0.3f,
+                 Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back(), Math::lerp(a.back(), b.back(), 0.3f));
+}
+
+void QuaternionBatchTest::lerp100kScalar() {
+    const std::vector<Quaternion> a = rotations(BenchmarkSize, 0.0f);
+    const std::vector<Quaternion> b = rotations(BenchmarkSize, 0.35f);
+    std::vector<Quaternion> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Math::lerp(a[i], b[i], 0.3f);
+
+    CORRADE_COMPARE(out.back(), Math::lerp(a.back(), b.back(), 0.3f));
+}
+
+void QuaternionBatchTest::slerp100k() {
+    const std::vector<Quaternion> a = rotations(BenchmarkSize, 0.0f);
+    const std::vector<Quaternion> b = rotations(BenchmarkSize, 0.35f);
+    std::vector<Quaternion> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        slerpInto(Corrade::Containers::arrayView(a.data(), a.size()),
+                  Corrade::Containers::arrayView(b.data(), b.size()), 0.3f,
+                  Corrade::Containers::arrayView(out.data(), out.size()));
+
+    CORRADE_COMPARE(out.back(), Math::slerp(a.back(), b.back(), 0.3f));
+}
+
+void QuaternionBatchTest::slerp100kScalar() {
+    const std::vector<Quaternion> a = rotations(BenchmarkSize, 0.0f);
+    const std::vector<Quaternion> b = rotations(BenchmarkSize, 0.35f);
+    std::vector<Quaternion> out(BenchmarkSize);
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Math::slerp(a[i], b[i], 0.3f);
+
+    CORRADE_COMPARE(out.back(), Math::slerp(a.back(), b.back(), 0.3f));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::QuaternionBatchTest)
@@ -0,0 +1,274 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+/* Benchmarks of quaternion and dual quaternion composition and
+   transformation, with the equivalent matrix operations for comparison. Each
+   benchmark processes Size items per iteration. */
+struct QuaternionBenchmark: Corrade::TestSuite::Tester {
+    explicit QuaternionBenchmark();
+
+    void quaternionMultiply();
+    void quaternionNormalized();
+    void quaternionTransformVector();
+    void quaternionTransformVectorNormalized();
+    void quaternionToMatrix();
+    void quaternionSlerp();
+
+    void dualQuaternionMultiply();
+    void dualQuaternionTransformPoint();
+    void dualQuaternionTransformPointNormalized();
+    void dualQuaternionToMatrix();
+
+    void matrix4MultiplyRigid();
+    void matrix4TransformPointRigid();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+typedef Math::Deg<Float> Deg;
+
+QuaternionBenchmark::QuaternionBenchmark() {
+    addBenchmarks({&QuaternionBenchmark::quaternionMultiply,
+                   &QuaternionBenchmark::quaternionNormalized,
+                   &QuaternionBenchmark::quaternionTransformVector,
+                   &QuaternionBenchmark::quaternionTransformVectorNormalized,
+                   &QuaternionBenchmark::quaternionToMatrix,
+                   &QuaternionBenchmark::quaternionSlerp,
+
+                   &QuaternionBenchmark::dualQuaternionMultiply,
+                   &QuaternionBenchmark::dualQuaternionTransformPoint,
+                   &QuaternionBenchmark::dualQuaternionTransformPointNormalized,
+                   &QuaternionBenchmark::dualQuaternionToMatrix,
+
+                   &QuaternionBenchmark::matrix4MultiplyRigid,
+                   &QuaternionBenchmark::matrix4TransformPointRigid}, 20);
+}
+
+namespace {
+
+constexpr std::size_t Size = 1000;
+
+/* Read in every benchmark iteration and used as an index offset, so the
+   compiler can't figure out all iterations calculate the same and do the
+   work just once */
+volatile std::size_t Zero = 0;
+
+std::vector<Vector3> vectors() {
+    std::vector<Vector3> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = {Float(i % 7), Float(i % 13) - 6.0f, 1.0f + Float(i % 5)};
+    return out;
+}
+
+std::vector<Quaternion> quaternions() {
+    std::vector<Quaternion> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = Quaternion::rotation(Deg(Float(i)), Vector3::yAxis())*
+            Quaternion::rotation(Deg(Float(i*3)), Vector3::xAxis());
+    return out;
+}
+
+std::vector<DualQuaternion> dualQuaternions() {
+    std::vector<DualQuaternion> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = DualQuaternion::translation({Float(i % 7), Float(i % 11), -Float(i % 3)})*
+            DualQuaternion::rotation(Deg(Float(i)), Vector3::yAxis());
+    return out;
+}
+
+std::vector<Matrix4> matrices() {
+    std::vector<Matrix4> out(Size);
+    for(std::size_t i = 0; i != Size; ++i)
+        out[i] = Matrix4::translation({Float(i % 7), Float(i % 11), -Float(i % 3)})*
+            Matrix4::rotationY(Deg(Float(i)));
+    return out;
+}
+
+}
+
+void QuaternionBenchmark::quaternionMultiply() {
+    const std::vector<Quaternion> a = quaternions();
+    std::vector<Quaternion> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o]*a[Size - i - 1];
+    }
+
+    CORRADE_COMPARE(out[1], a[1]*a[Size - 2]);
+}
+
+void QuaternionBenchmark::quaternionNormalized() {
+    const std::vector<Quaternion> a = quaternions();
+    std::vector<Quaternion> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = (a[i + o]*2.0f).normalized();
+    }
+
+    CORRADE_COMPARE(out[1], a[1]);
+}
+
+void QuaternionBenchmark::quaternionTransformVector() {
+    const std::vector<Quaternion> a = quaternions();
+    const std::vector<Vector3> b = vectors();
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transformVector(b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], a[1].toMatrix()*b[1]);
+}
+
+void QuaternionBenchmark::quaternionTransformVectorNormalized() {
+    const std::vector<Quaternion> a = quaternions();
+    const std::vector<Vector3> b = vectors();
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transformVectorNormalized(b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], a[1].toMatrix()*b[1]);
+}
+
+void QuaternionBenchmark::quaternionToMatrix() {
+    const std::vector<Quaternion> a = quaternions();
+    std::vector<Matrix3x3<Float>> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].toMatrix();
+    }
+
+    CORRADE_COMPARE(Quaternion::fromMatrix(out[1]), a[1]);
+}
+
+void QuaternionBenchmark::quaternionSlerp() {
+    const std::vector<Quaternion> a = quaternions();
+    std::vector<Quaternion> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = Math::slerp(a[i + o], a[Size - i - 1], 0.25f);
+    }
+
+    CORRADE_VERIFY(out[1].isNormalized());
+}
+
+void QuaternionBenchmark::dualQuaternionMultiply() {
+    const std::vector<DualQuaternion> a = dualQuaternions();
+    std::vector<DualQuaternion> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o]*a[Size - i - 1];
+    }
+
+    CORRADE_COMPARE(out[1], a[1]*a[Size - 2]);
+}
+
+void QuaternionBenchmark::dualQuaternionTransformPoint() {
+    const std::vector<DualQuaternion> a = dualQuaternions();
+    const std::vector<Vector3> b = vectors();
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transformPoint(b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], a[1].toMatrix().transformPoint(b[1]));
+}
+
+void QuaternionBenchmark::dualQuaternionTransformPointNormalized() {
+    const std::vector<DualQuaternion> a = dualQuaternions();
+    const std::vector<Vector3> b = vectors();
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transformPointNormalized(b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], a[1].toMatrix().transformPoint(b[1]));
+}
+
+void QuaternionBenchmark::dualQuaternionToMatrix() {
+    const std::vector<DualQuaternion> a = dualQuaternions();
+    std::vector<Matrix4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].toMatrix();
+    }
+
+    CORRADE_COMPARE(DualQuaternion::fromMatrix(out[1]), a[1]);
+}
+
+void QuaternionBenchmark::matrix4MultiplyRigid() {
+    const std::vector<Matrix4> a = matrices();
+    std::vector<Matrix4> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o]*a[Size - i - 1];
+    }
+
+    CORRADE_COMPARE(out[1], a[1]*a[Size - 2]);
+}
+
+void QuaternionBenchmark::matrix4TransformPointRigid() {
+    const std::vector<Matrix4> a = matrices();
+    const std::vector<Vector3> b = vectors();
+    std::vector<Vector3> out(Size);
+    CORRADE_BENCHMARK(100) {
+        const std::size_t o = Zero;
+        for(std::size_t i = 0; i != Size; ++i)
+            out[i] = a[i + o].transformPoint(b[i]);
+    }
+
+    CORRADE_COMPARE(out[1], a[1].transformPoint(b[1]));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::QuaternionBenchmark)
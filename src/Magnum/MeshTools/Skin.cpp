@@ -0,0 +1,128 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skin.h"
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* The kernels are templated on whether normals are processed so the
+   position-only variants don't pay for a branch in the inner loop */
+template<bool withNormals> void skinLinearImplementation(const Matrix4* const joints, const Vector4ui* const jointIds, const Vector4* const jointWeights, const Vector3* const positions, const Vector3* const normals, Vector3* const transformedPositions, Vector3* const transformedNormals, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i) {
+        const Vector4ui& ids = jointIds[i];
+        const Vector4& weights = jointWeights[i];
+
+        /* Blend only the upper 3x4 part, column by column */
+        Vector3 blended[4];
+        for(std::size_t c = 0; c != 4; ++c)
+            blended[c] = joints[ids[0]][c].xyz()*weights[0] +
+                         joints[ids[1]][c].xyz()*weights[1] +
+                         joints[ids[2]][c].xyz()*weights[2] +
+                         joints[ids[3]][c].xyz()*weights[3];
+
+        const Vector3& p = positions[i];
+        transformedPositions[i] = blended[0]*p.x() + blended[1]*p.y() + blended[2]*p.z() + blended[3];
+
+        if(withNormals) {
+            const Vector3& n = normals[i];
+            transformedNormals[i] = (blended[0]*n.x() + blended[1]*n.y() + blended[2]*n.z()).normalized();
+        }
+    }
+}
+
+template<bool withNormals> void skinDualQuaternionImplementation(const DualQuaternion* const joints, const Vector4ui* const jointIds, const Vector4* const jointWeights, const Vector3* const positions, const Vector3* const normals, Vector3* const transformedPositions, Vector3* const transformedNormals, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i) {
+        const Vector4ui& ids = jointIds[i];
+        const Vector4& weights = jointWeights[i];
+
+        /* Blend, flipping joints that are on the other hemisphere */
+        const Quaternion& pivot = joints[ids[0]].real();
+        Quaternion real{{}, 0.0f}, dual{{}, 0.0f};
+        for(std::size_t j = 0; j != 4; ++j) {
+            const DualQuaternion& joint = joints[ids[j]];
+            const Float w = Math::dot(pivot, joint.real()) < 0.0f ? -weights[j] : weights[j];
+            real += joint.real()*w;
+            dual += joint.dual()*w;
+        }
+
+        /* Normalize. The dual part doesn't need to be made orthogonal to the
+           real part, as the non-orthogonal component doesn't contribute to
+           the translation calculated below. */
+        const Float invLength = 1.0f/real.length();
+        real *= invLength;
+        dual *= invLength;
+
+        /* Translation is the vector part of 2·dual·conjugate(real) */
+        const Vector3 translation = 2.0f*(real.scalar()*dual.vector() - dual.scalar()*real.vector() + Math::cross(real.vector(), dual.vector()));
+
+        transformedPositions[i] = real.transformVectorNormalized(positions[i]) + translation;
+        if(withNormals)
+            transformedNormals[i] = real.transformVectorNormalized(normals[i]);
+    }
+}
+
+}
+
+void skinLinearInto(const Corrade::Containers::ArrayView<const Matrix4> jointTransformations, const Corrade::Containers::ArrayView<const Vector4ui> jointIds, const Corrade::Containers::ArrayView<const Vector4> jointWeights, const Corrade::Containers::ArrayView<const Vector3> positions, const Corrade::Containers::ArrayView<Vector3> transformedPositions) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && jointWeights.size() == positions.size() && transformedPositions.size() == positions.size(),
+        "MeshTools::skinLinearInto(): expected" << positions.size() << "joint IDs, weights and output positions but got" << jointIds.size() << Debug::nospace << "," << jointWeights.size() << "and" << transformedPositions.size(), );
+
+    skinLinearImplementation<false>(jointTransformations, jointIds, jointWeights, positions, nullptr, transformedPositions, nullptr, positions.size());
+}
+
+void skinLinearInto(const Corrade::Containers::ArrayView<const Matrix4> jointTransformations, const Corrade::Containers::ArrayView<const Vector4ui> jointIds, const Corrade::Containers::ArrayView<const Vector4> jointWeights, const Corrade::Containers::ArrayView<const Vector3> positions, const Corrade::Containers::ArrayView<const Vector3> normals, const Corrade::Containers::ArrayView<Vector3> transformedPositions, const Corrade::Containers::ArrayView<Vector3> transformedNormals) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && jointWeights.size() == positions.size() && transformedPositions.size() == positions.size(),
+        "MeshTools::skinLinearInto(): expected" << positions.size() << "joint IDs, weights and output positions but got" << jointIds.size() << Debug::nospace << "," << jointWeights.size() << "and" << transformedPositions.size(), );
+    CORRADE_ASSERT(normals.size() == positions.size() && transformedNormals.size() == positions.size(),
+        "MeshTools::skinLinearInto(): expected" << positions.size() << "normals and output normals but got" << normals.size() << "and" << transformedNormals.size(), );
+
+    skinLinearImplementation<true>(jointTransformations, jointIds, jointWeights, positions, normals, transformedPositions, transformedNormals, positions.size());
+}
+
+void skinDualQuaternionInto(const Corrade::Containers::ArrayView<const DualQuaternion> jointTransformations, const Corrade::Containers::ArrayView<const Vector4ui> jointIds, const Corrade::Containers::ArrayView<const Vector4> jointWeights, const Corrade::Containers::ArrayView<const Vector3> positions, const Corrade::Containers::ArrayView<Vector3> transformedPositions) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && jointWeights.size() == positions.size() && transformedPositions.size() == positions.size(),
+        "MeshTools::skinDualQuaternionInto(): expected" << positions.size() << "joint IDs, weights and output positions but got" << jointIds.size() << Debug::nospace << "," << jointWeights.size() << "and" << transformedPositions.size(), );
+
+    skinDualQuaternionImplementation<false>(jointTransformations, jointIds, jointWeights, positions, nullptr, transformedPositions, nullptr, positions.size());
+}
+
+void skinDualQuaternionInto(const Corrade::Containers::ArrayView<const DualQuaternion> jointTransformations, const Corrade::Containers::ArrayView<const Vector4ui> jointIds, const Corrade::Containers::ArrayView<const Vector4> jointWeights, const Corrade::Containers::ArrayView<const Vector3> positions, const Corrade::Containers::ArrayView<const Vector3> normals, const Corrade::Containers::ArrayView<Vector3> transformedPositions, const Corrade::Containers::ArrayView<Vector3> transformedNormals) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && jointWeights.size() == positions.size() && transformedPositions.size() == positions.size(),
+        "MeshTools::skinDualQuaternionInto(): expected" << positions.size() << "joint IDs, weights and output positions but got" << jointIds.size() << Debug::nospace << "," << jointWeights.size() << "and" << transformedPositions.size(), );
+    CORRADE_ASSERT(normals.size() == positions.size() && transformedNormals.size() == positions.size(),
+        "MeshTools::skinDualQuaternionInto(): expected" << positions.size() << "normals and output normals but got" << normals.size() << "and" << transformedNormals.size(), );
+
+    skinDualQuaternionImplementation<true>(jointTransformations, jointIds, jointWeights, positions, normals, transformedPositions, transformedNormals, positions.size());
+}
+
+}}
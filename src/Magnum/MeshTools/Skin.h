@@ -0,0 +1,122 @@
+#ifndef Magnum_MeshTools_Skin_h
+#define Magnum_MeshTools_Skin_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::skinLinearInto(), @ref Magnum::MeshTools::skinDualQuaternionInto()
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Skin positions using linear blending
+@param[in] jointTransformations     Joint transformations
+@param[in] jointIds                 Four joint IDs for each vertex
+@param[in] jointWeights             Four joint weights for each vertex
+@param[in] positions                Vertex positions
+@param[out] transformedPositions    Where to put the skinned positions
+
+For each vertex blends the four joint transformations together and transforms
+the position with the result: @f[
+    \boldsymbol{p}' = \left(\sum_{i=0}^3 w_i \boldsymbol{M}_{j_i}\right) \boldsymbol{p}
+@f]
+
+Only the upper 3x4 part of the matrices is used. The weights are expected to
+add up to @cpp 1.0f @ce and all joint IDs are expected to be in bounds of
+@p jointTransformations, neither of which is checked for performance reasons.
+Unused influences can be given a zero weight and any valid joint ID. Sizes of
+@p jointIds, @p jointWeights, @p positions and @p transformedPositions are
+expected to be the same.
+
+The function has no state and writes only to the output arrays, so skinning a
+large mesh can be split into vertex ranges processed on multiple threads.
+@see @ref skinDualQuaternionInto(), @ref transformPointsInPlace()
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinLinearInto(Corrade::Containers::ArrayView<const Matrix4> jointTransformations, Corrade::Containers::ArrayView<const Vector4ui> jointIds, Corrade::Containers::ArrayView<const Vector4> jointWeights, Corrade::Containers::ArrayView<const Vector3> positions, Corrade::Containers::ArrayView<Vector3> transformedPositions);
+
+/**
+@brief Skin positions and normals using linear blending
+@param[in] jointTransformations     Joint transformations
+@param[in] jointIds                 Four joint IDs for each vertex
+@param[in] jointWeights             Four joint weights for each vertex
+@param[in] positions                Vertex positions
+@param[in] normals                  Vertex normals
+@param[out] transformedPositions    Where to put the skinned positions
+@param[out] transformedNormals      Where to put the skinned normals
+
+Same as above, in addition transforms the normals with the rotation and
+scaling part of the blended transformation and normalizes them. The joint
+transformations are expected to have uniform scaling, otherwise the normals
+won't be correct. Sizes of @p normals and @p transformedNormals are expected
+to be the same as size of @p positions.
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinLinearInto(Corrade::Containers::ArrayView<const Matrix4> jointTransformations, Corrade::Containers::ArrayView<const Vector4ui> jointIds, Corrade::Containers::ArrayView<const Vector4> jointWeights, Corrade::Containers::ArrayView<const Vector3> positions, Corrade::Containers::ArrayView<const Vector3> normals, Corrade::Containers::ArrayView<Vector3> transformedPositions, Corrade::Containers::ArrayView<Vector3> transformedNormals);
+
+/**
+@brief Skin positions using dual quaternion blending
+@param[in] jointTransformations     Normalized joint transformations
+@param[in] jointIds                 Four joint IDs for each vertex
+@param[in] jointWeights             Four joint weights for each vertex
+@param[in] positions                Vertex positions
+@param[out] transformedPositions    Where to put the skinned positions
+
+For each vertex blends the four joint transformations together, normalizes
+the result and transforms the position with it. Compared to
+@ref skinLinearInto() the blended transformation is always rigid, which
+avoids the volume loss ("candy wrapper" artifacts) around twisting joints.
+Joints with the real part on the opposite hemisphere than the first joint of
+given vertex get negated to ensure the shortest path is taken. The joint
+transformations are expected to be normalized, other requirements are the
+same as in @ref skinLinearInto().
+@see @ref transformPointsInPlace()
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinDualQuaternionInto(Corrade::Containers::ArrayView<const DualQuaternion> jointTransformations, Corrade::Containers::ArrayView<const Vector4ui> jointIds, Corrade::Containers::ArrayView<const Vector4> jointWeights, Corrade::Containers::ArrayView<const Vector3> positions, Corrade::Containers::ArrayView<Vector3> transformedPositions);
+
+/**
+@brief Skin positions and normals using dual quaternion blending
+@param[in] jointTransformations     Normalized joint transformations
+@param[in] jointIds                 Four joint IDs for each vertex
+@param[in] jointWeights             Four joint weights for each vertex
+@param[in] positions                Vertex positions
+@param[in] normals                  Vertex normals
+@param[out] transformedPositions    Where to put the skinned positions
+@param[out] transformedNormals      Where to put the skinned normals
+
+Same as above, in addition rotates the normals with the rotation part of the
+blended transformation. Sizes of @p normals and @p transformedNormals are
+expected to be the same as size of @p positions.
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinDualQuaternionInto(Corrade::Containers::ArrayView<const DualQuaternion> jointTransformations, Corrade::Containers::ArrayView<const Vector4ui> jointIds, Corrade::Containers::ArrayView<const Vector4> jointWeights, Corrade::Containers::ArrayView<const Vector3> positions, Corrade::Containers::ArrayView<const Vector3> normals, Corrade::Containers::ArrayView<Vector3> transformedPositions, Corrade::Containers::ArrayView<Vector3> transformedNormals);
+
+}}
+
+#endif
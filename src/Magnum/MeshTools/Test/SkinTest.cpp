@@ -0,0 +1,345 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Skin.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SkinTest: TestSuite::Tester {
+    explicit SkinTest();
+
+    void linearSingleJoint();
+    void linearBlend();
+    void linearNormals();
+    void dualQuaternionSingleJoint();
+    void dualQuaternionBlend();
+    void dualQuaternionAntipodal();
+    void dualQuaternionNormals();
+    void sizeMismatch();
+
+    void linear100k();
+    void linearNormals100k();
+    void dualQuaternion100k();
+    void dualQuaternionNormals100k();
+};
+
+SkinTest::SkinTest() {
+    addTests({&SkinTest::linearSingleJoint,
+              &SkinTest::linearBlend,
+              &SkinTest::linearNormals,
+              &SkinTest::dualQuaternionSingleJoint,
+              &SkinTest::dualQuaternionBlend,
+              &SkinTest::dualQuaternionAntipodal,
+              &SkinTest::dualQuaternionNormals,
+              &SkinTest::sizeMismatch});
+
+    addBenchmarks({&SkinTest::linear100k,
+                   &SkinTest::linearNormals100k,
+                   &SkinTest::dualQuaternion100k,
+                   &SkinTest::dualQuaternionNormals100k}, 10);
+}
+
+namespace {
+
+const Vector3 Positions[]{
+    {-3.0f,  4.0f, 34.0f},
+    { 2.5f, -15.0f, 1.5f},
+    { 0.0f,  1.0f, -1.0f}
+};
+
+const Vector3 Normals[]{
+    Vector3::xAxis(),
+    Vector3::yAxis(),
+    Vector3{1.0f, 1.0f, 0.0f}.normalized()
+};
+
+}
+
+void SkinTest::linearSingleJoint() {
+    const Matrix4 joints[]{
+        Matrix4::translation({1.0f, 2.0f, 3.0f}),
+        Matrix4::translation({0.5f, -1.0f, 2.0f})*
+            Matrix4::rotationZ(Deg(90.0f))*
+            Matrix4::scaling(Vector3{2.0f})
+    };
+    const Vector4ui ids[]{{1, 0, 0, 0}, {0, 1, 1, 1}, {1, 1, 0, 0}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f},
+                            {0.0f, 0.5f, 0.25f, 0.25f},
+                            {0.5f, 0.5f, 0.0f, 0.0f}};
+    Vector3 out[3];
+    skinLinearInto(joints, ids, weights, Positions, out);
+
+    /* All vertices are fully influenced by the second joint */
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(out[i], joints[1].transformPoint(Positions[i]));
+}
+
+void SkinTest::linearBlend() {
+    const Matrix4 joints[]{
+        Matrix4::translation({1.0f, 2.0f, 3.0f}),
+        Matrix4::rotationX(Deg(30.0f)),
+        Matrix4::scaling({1.0f, 2.0f, 3.0f})
+    };
+    const Vector4ui ids[]{{0, 1, 2, 0}, {2, 2, 2, 2}, {1, 0, 0, 0}};
+    const Vector4 weights[]{{0.25f, 0.5f, 0.25f, 0.0f},
+                            {0.25f, 0.25f, 0.25f, 0.25f},
+                            {0.75f, 0.25f, 0.0f, 0.0f}};
+    Vector3 out[3];
+    skinLinearInto(joints, ids, weights, Positions, out);
+
+    /* Blending the transformed positions gives the same result as blending
+       the transformations */
+    for(std::size_t i = 0; i != 3; ++i) {
+        Vector3 expected;
+        for(std::size_t j = 0; j != 4; ++j)
+            expected += joints[ids[i][j]].transformPoint(Positions[i])*weights[i][j];
+        CORRADE_COMPARE(out[i], expected);
+    }
+}
+
+void SkinTest::linearNormals() {
+    const Matrix4 joints[]{
+        Matrix4::rotationZ(Deg(90.0f))*Matrix4::scaling(Vector3{3.0f}),
+        Matrix4::translation({1.0f, 2.0f, 3.0f})
+    };
+    const Vector4ui ids[]{{0, 0, 0, 0}, {1, 0, 0, 0}, {0, 1, 0, 0}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f},
+                            {1.0f, 0.0f, 0.0f, 0.0f},
+                            {0.5f, 0.5f, 0.0f, 0.0f}};
+    Vector3 positions[3];
+    Vector3 normals[3];
+    skinLinearInto(joints, ids, weights, Positions, Normals, positions, normals);
+
+    /* Positions are the same as with the position-only variant */
+    Vector3 positionsOnly[3];
+    skinLinearInto(joints, ids, weights, Positions, positionsOnly);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(positions),
+        Corrade::Containers::arrayView(positionsOnly),
+        TestSuite::Compare::Container);
+
+    /* Normals are not translated and are renormalized after scaling */
+    CORRADE_COMPARE(normals[0], Vector3::yAxis());
+    CORRADE_COMPARE(normals[1], Vector3::yAxis());
+    CORRADE_COMPARE(normals[2], (Vector3{-1.0f, 1.0f, 0.0f}*1.5f + Vector3{1.0f, 1.0f, 0.0f}*0.5f).normalized());
+}
+
+void SkinTest::dualQuaternionSingleJoint() {
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, 2.0f, 3.0f}),
+        DualQuaternion::translation({0.5f, -1.0f, 2.0f})*
+            DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis())
+    };
+    const Vector4ui ids[]{{1, 0, 0, 0}, {0, 1, 1, 1}, {1, 1, 0, 0}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f},
+                            {0.0f, 0.5f, 0.25f, 0.25f},
+                            {0.5f, 0.5f, 0.0f, 0.0f}};
+    Vector3 out[3];
+    skinDualQuaternionInto(joints, ids, weights, Positions, out);
+
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(out[i], joints[1].transformPointNormalized(Positions[i]));
+}
+
+void SkinTest::dualQuaternionBlend() {
+    /* Two rotations around the same axis blended half-way is the rotation in
+       between */
+    const DualQuaternion joints[]{
+        DualQuaternion::rotation(Deg(20.0f), Vector3::zAxis()),
+        DualQuaternion::rotation(Deg(80.0f), Vector3::zAxis())
+    };
+    const Vector4ui ids[]{{0, 1, 0, 0}, {0, 1, 0, 0}, {0, 1, 0, 0}};
+    const Vector4 weights[]{{0.5f, 0.5f, 0.0f, 0.0f},
+                            {0.5f, 0.5f, 0.0f, 0.0f},
+                            {0.5f, 0.5f, 0.0f, 0.0f}};
+    Vector3 out[3];
+    skinDualQuaternionInto(joints, ids, weights, Positions, out);
+
+    /* Unlike linear blending, the length of the vector is preserved */
+    const Matrix4 expected = Matrix4::rotationZ(Deg(50.0f));
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(out[i], expected.transformPoint(Positions[i]));
+}
+
+void SkinTest::dualQuaternionAntipodal() {
+    /* The second joint is the same rotation as the first, just with the
+       quaternion negated. Without the hemisphere check the blend would
+       degenerate to zero. */
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, 2.0f, 3.0f})*
+            DualQuaternion::rotation(Deg(35.0f), Vector3::yAxis()),
+        -(DualQuaternion::translation({1.0f, 2.0f, 3.0f})*
+            DualQuaternion::rotation(Deg(35.0f), Vector3::yAxis()))
+    };
+    const Vector4ui ids[]{{0, 1, 0, 0}, {1, 0, 0, 0}, {0, 1, 0, 0}};
+    const Vector4 weights[]{{0.5f, 0.5f, 0.0f, 0.0f},
+                            {0.5f, 0.5f, 0.0f, 0.0f},
+                            {0.75f, 0.25f, 0.0f, 0.0f}};
+    Vector3 out[3];
+    skinDualQuaternionInto(joints, ids, weights, Positions, out);
+
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(out[i], joints[0].transformPointNormalized(Positions[i]));
+}
+
+void SkinTest::dualQuaternionNormals() {
+    const DualQuaternion joints[]{
+        DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis()),
+        DualQuaternion::translation({1.0f, 2.0f, 3.0f})
+    };
+    const Vector4ui ids[]{{0, 0, 0, 0}, {1, 0, 0, 0}, {0, 1, 0, 0}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f},
+                            {1.0f, 0.0f, 0.0f, 0.0f},
+                            {0.5f, 0.5f, 0.0f, 0.0f}};
+    Vector3 positions[3];
+    Vector3 normals[3];
+    skinDualQuaternionInto(joints, ids, weights, Positions, Normals, positions, normals);
+
+    Vector3 positionsOnly[3];
+    skinDualQuaternionInto(joints, ids, weights, Positions, positionsOnly);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(positions),
+        Corrade::Containers::arrayView(positionsOnly),
+        TestSuite::Compare::Container);
+
+    /* Normals are not translated, the last one is rotated by 45° */
+    CORRADE_COMPARE(normals[0], Vector3::yAxis());
+    CORRADE_COMPARE(normals[1], Vector3::yAxis());
+    CORRADE_COMPARE(normals[2], Vector3::yAxis());
+}
+
+void SkinTest::sizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Matrix4 matrices[1];
+    const DualQuaternion dualQuaternions[1];
+    const Vector4ui ids[3];
+    const Vector4 weights[2];
+    Vector3 result[3];
+    skinLinearInto(matrices, ids, weights, Positions, result);
+    skinLinearInto(matrices, ids, Corrade::Containers::arrayView(weights, 2), Positions, Normals, result, Corrade::Containers::arrayView(result, 2));
+    skinDualQuaternionInto(dualQuaternions, ids, weights, Positions, result);
+    skinDualQuaternionInto(dualQuaternions, ids, Corrade::Containers::arrayView(weights, 2), Positions, Normals, result, Corrade::Containers::arrayView(result, 2));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinLinearInto(): expected 3 joint IDs, weights and output positions but got 3, 2 and 3\n"
+        "MeshTools::skinLinearInto(): expected 3 joint IDs, weights and output positions but got 3, 2 and 3\n"
+        "MeshTools::skinDualQuaternionInto(): expected 3 joint IDs, weights and output positions but got 3, 2 and 3\n"
+        "MeshTools::skinDualQuaternionInto(): expected 3 joint IDs, weights and output positions but got 3, 2 and 3\n");
+}
+
+namespace {
+
+constexpr std::size_t BenchmarkVertexCount = 100000;
+constexpr std::size_t BenchmarkJointCount = 64;
+
+/* A long tube bent by a chain of joints, each vertex influenced by four
+   neighboring joints */
+struct BenchmarkData {
+    explicit BenchmarkData() {
+        for(std::size_t i = 0; i != BenchmarkJointCount; ++i) {
+            const Float f = Float(i);
+            dualQuaternions.push_back(
+                DualQuaternion::translation({0.0f, f, 0.0f})*
+                DualQuaternion::rotation(Deg(f*5.0f), Vector3{0.3f, 0.0f, 1.0f}.normalized()));
+            matrices.push_back(dualQuaternions.back().toMatrix());
+        }
+
+        for(std::size_t i = 0; i != BenchmarkVertexCount; ++i) {
+            const Float f = Float(i)/Float(BenchmarkVertexCount);
+            const Rad angle{Float(i)*0.1f};
+            positions.emplace_back(Math::cos(angle), f*Float(BenchmarkJointCount), Math::sin(angle));
+            normals.emplace_back(Math::cos(angle), 0.0f, Math::sin(angle));
+
+            const UnsignedInt joint = UnsignedInt(f*Float(BenchmarkJointCount - 3));
+            ids.emplace_back(joint, joint + 1, joint + 2, joint + 3);
+            weights.emplace_back(0.1f, 0.4f, 0.4f, 0.1f);
+        }
+
+        transformedPositions.resize(BenchmarkVertexCount);
+        transformedNormals.resize(BenchmarkVertexCount);
+    }
+
+    std::vector<Matrix4> matrices;
+    std::vector<DualQuaternion> dualQuaternions;
+    std::vector<Vector4ui> ids;
+    std::vector<Vector4> weights;
+    std::vector<Vector3> positions, normals, transformedPositions, transformedNormals;
+};
+
+template<class T> Corrade::Containers::ArrayView<T> view(std::vector<T>& v) {
+    return {v.data(), v.size()};
+}
+
+template<class T> Corrade::Containers::ArrayView<const T> view(const std::vector<T>& v) {
+    return {v.data(), v.size()};
+}
+
+}
+
+void SkinTest::linear100k() {
+    BenchmarkData data;
+
+    CORRADE_BENCHMARK(10)
+        skinLinearInto(view(data.matrices), view(data.ids), view(data.weights), view(data.positions), view(data.transformedPositions));
+
+    CORRADE_VERIFY(data.transformedPositions.back() != Vector3{});
+}
+
+void SkinTest::linearNormals100k() {
+    BenchmarkData data;
+
+    CORRADE_BENCHMARK(10)
+        skinLinearInto(view(data.matrices), view(data.ids), view(data.weights), view(data.positions), view(data.normals), view(data.transformedPositions), view(data.transformedNormals));
+
+    CORRADE_VERIFY(data.transformedNormals.back().isNormalized());
+}
+
+void SkinTest::dualQuaternion100k() {
+    BenchmarkData data;
+
+    CORRADE_BENCHMARK(10)
+        skinDualQuaternionInto(view(data.dualQuaternions), view(data.ids), view(data.weights), view(data.positions), view(data.transformedPositions));
+
+    CORRADE_VERIFY(data.transformedPositions.back() != Vector3{});
+}
+
+void SkinTest::dualQuaternionNormals100k() {
+    BenchmarkData data;
+
+    CORRADE_BENCHMARK(10)
+        skinDualQuaternionInto(view(data.dualQuaternions), view(data.ids), view(data.weights), view(data.positions), view(data.normals), view(data.transformedPositions), view(data.transformedNormals));
+
+    CORRADE_VERIFY(data.transformedNormals.back().isNormalized());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SkinTest)
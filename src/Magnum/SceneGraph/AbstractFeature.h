@@ -254,6 +254,9 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
          * @ref SceneGraph::CachedTransformation::Absolute "CachedTransformation::Absolute"
          * is enabled in @ref setCachedTransformations(), this function is
          * called to recalculate data based on absolute object transformation.
+         * When using the multithreaded @ref Object::setClean(const std::vector<std::reference_wrapper<Object<Transformation>>>&, UnsignedInt),
+         * this function can be called concurrently for features of different
+         * objects.
          *
          * Default implementation does nothing.
          * @see @ref scenegraph-features-caching, @ref cleanInverted()
@@ -266,7 +269,8 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
          * When object is cleaned and @ref CachedTransformation::InvertedAbsolute
          * is enabled in @ref setCachedTransformations(), this function is
          * called to recalculate data based on inverted absolute object
-         * transformation.
+         * transformation. Can be called concurrently for features of
+         * different objects, the same as @ref clean().
          *
          * Default implementation does nothing.
          * @see @ref scenegraph-features-caching, @ref clean()
@@ -280,6 +284,8 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
         friend Containers::LinkedList<AbstractFeature<dimensions, T>>;
         friend Containers::LinkedListItem<AbstractFeature<dimensions, T>, AbstractObject<dimensions, T>>;
         template<class> friend class Object;
+        template<UnsignedInt, class> friend class FlatObject;
+        template<UnsignedInt, class> friend class FlatScene;
         #endif
 
         CachedTransformations _cachedTransformations;
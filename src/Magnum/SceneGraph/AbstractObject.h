@@ -30,6 +30,7 @@
  */
 
 #include <functional>
+#include <type_traits>
 #include <vector>
 #include <Corrade/Containers/LinkedList.h>
 
@@ -124,6 +125,18 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             return *(new U{*this, std::forward<Args>(args)...});
         }
 
+        /**
+         * @brief Add a feature allocated from a pool
+         *
+         * Calling `object.addFeature<MyFeature>(pool, args...)` is equivalent
+         * to `new(pool) MyFeature{object, args...}`. Expects that the feature
+         * derives from @ref PoolAllocated, see @ref Pool for more information.
+         */
+        template<class U, class ...Args> U& addFeature(Pool& pool, Args... args) {
+            static_assert(std::is_base_of<PoolAllocated, U>::value, "only types deriving from PoolAllocated can be allocated from a pool");
+            return *(new(pool) U{*this, std::forward<Args>(args)...});
+        }
+
         /**
          * @brief Scene
          * @return Scene or @cpp nullptr @ce, if the object is not part of any
@@ -169,9 +182,27 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          * @warning This function cannot check if all objects are of the same
          *      @ref Object type, use typesafe @ref Object::transformationMatrices()
          *      when possible.
+         * @see @ref transformationMatricesInto()
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const {
-            return doTransformationMatrices(objects, initialTransformationMatrix);
+            std::vector<MatrixType> transformationMatrices;
+            doTransformationMatricesInto(objects, transformationMatrices, initialTransformationMatrix);
+            return transformationMatrices;
+        }
+
+        /**
+         * @brief Put transformation matrices of given set of objects relative to this object into given array
+         *
+         * Like @ref transformationMatrices(), but puts the result into
+         * @p transformationMatrices, reusing its memory. Useful for code
+         * that's executed every frame, see
+         * @ref Object::transformationMatricesInto() for more information.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe
+         *      @ref Object::transformationMatricesInto() when possible.
+         */
+        void transformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix = MatrixType()) const {
+            doTransformationMatricesInto(objects, transformationMatrices, initialTransformationMatrix);
         }
 
         /*@}*/
@@ -209,9 +240,10 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          * @brief Set object absolute transformation as dirty
          *
          * Calls @ref AbstractFeature::markDirty() on all object features and
-         * recursively calls @ref setDirty() on every child object which is not
-         * already dirty. If the object is already marked as dirty, the
-         * function does nothing.
+         * marks the object and all its children as dirty. Depending on the
+         * implementation, @ref AbstractFeature::markDirty() on features of the
+         * children might get called only later. If the object is already
+         * marked as dirty, the function does nothing.
          * @see @ref scenegraph-features-caching, @ref setClean(),
          *      @ref isDirty()
          */
@@ -250,7 +282,7 @@ template<UnsignedInt dimensions, class T> class AbstractObject
 
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
-        virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual void doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
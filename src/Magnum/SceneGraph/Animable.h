@@ -134,6 +134,26 @@ just puts itself to rest and waits until some animation changes its state to
 pernamently running into separate group, they will not be traversed every time
 the @ref AnimableGroup::step() gets called, saving precious frame time.
 
+@section SceneGraph-Animable-multithreading Stepping on multiple threads
+
+If the group contains many animables with independent animation steps, you
+can pass a thread count to @ref AnimableGroup::step(). The state changes and
+the @ref animationStarted(), @ref animationStopped() etc. callbacks are still
+processed on the calling thread in a deterministic order, only the
+@ref animationStep() calls are distributed across the threads:
+
+@code{.cpp}
+animables.step(timeline.lastFrameTime(), timeline.lastFrameDuration(), 0);
+@endcode
+
+The animation steps can transform their objects. Each object should be
+transformed from only one animable, and the steps can't change the object
+hierarchy. The dirty objects are registered in the scene and in a
+@ref SpatialIndex after all threads finish, in the same order as if the steps
+were done on a single thread. Custom features that modify state shared with
+other objects in @ref AbstractFeature::markDirty() are not made thread-safe
+this way.
+
 @section SceneGraph-Animable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -260,6 +280,10 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
          * was paused. If the animation is resumed from @ref AnimationState::Stopped,
          * @p time starts with zero.
          *
+         * When stepping on multiple threads, this function can be called
+         * concurrently for different animables. See
+         * @ref AnimableGroup::step() for details.
+         *
          * @see @ref state(), @ref duration(), @ref isRepeated(),
          *      @ref repeatCount()
          */
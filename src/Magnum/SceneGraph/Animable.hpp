@@ -33,6 +33,7 @@
 #include "Magnum/Math/Constants.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/Animable.h"
+#include "Magnum/SceneGraph/parallelImplementation.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -52,8 +53,10 @@ template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dime
     if(_previousState == AnimationState::Stopped && state == AnimationState::Paused)
         return *this;
 
-    /* Wake up the group in case no animations are running */
-    animables()->wakeUp = true;
+    /* Wake up the group in case no animations are running. Not done while
+       the group is stepping on multiple threads, as then this can be called
+       only on a running animable from its own animationStep(). */
+    if(!animables()->_steppingInParallel) animables()->wakeUp = true;
     _currentState = state;
     return *this;
 }
@@ -66,10 +69,14 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
     return static_cast<const AnimableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>::group());
 }
 
-template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta, const UnsignedInt threadCount) {
     if(!_runningCount && !wakeUp) return;
     wakeUp = false;
 
+    /* When stepping on multiple threads, the state changes are processed
+       here and the steps are only collected to be done afterwards */
+    _steps.clear();
+
     for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
         Animable<dimensions, T>& animable = (*this)[i];
 
@@ -135,10 +142,25 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
             "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
         CORRADE_ASSERT(delta >= 0.0f,
             "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable._startTime, delta);
+        if(threadCount == 1) animable.animationStep(time - animable._startTime, delta);
+        else _steps.emplace_back(&animable, time - animable._startTime);
     }
 
     CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+
+    if(_steps.empty()) return;
+
+    struct State {
+        const std::vector<std::pair<Animable<dimensions, T>*, Float>>& steps;
+        Float delta;
+    } state{_steps, delta};
+    _steppingInParallel = true;
+    Implementation::parallelForDeferred(_steps.size(), threadCount, [](void* data, std::size_t begin, std::size_t end) {
+        const State& state = *static_cast<const State*>(data);
+        for(std::size_t i = begin; i != end; ++i)
+            state.steps[i].first->animationStep(state.steps[i].second, state.delta);
+    }, &state);
+    _steppingInParallel = false;
 }
 
 }}
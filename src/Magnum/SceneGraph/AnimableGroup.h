@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::SceneGraph::AnimableGroup, alias @ref Magnum::SceneGraph::BasicAnimableGroup2D, @ref Magnum::SceneGraph::BasicAnimableGroup3D, typedef @ref Magnum::SceneGraph::AnimableGroup2D, @ref Magnum::SceneGraph::AnimableGroup3D
  */
 
+#include <utility>
+#include <vector>
+
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -48,7 +51,7 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
         /**
          * @brief Constructor
          */
-        explicit AnimableGroup(): _runningCount(0), wakeUp(false) {}
+        explicit AnimableGroup(): _runningCount(0), wakeUp(false), _steppingInParallel(false) {}
 
         /**
          * @brief Count of running animations
@@ -59,17 +62,42 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
 
         /**
          * @brief Perform animation step
-         * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
-         * @param delta     Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
+         * @param time          Absolute time (e.g. @ref Timeline::previousFrameTime())
+         * @param delta         Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
+         * @param threadCount   Count of threads to perform the animation
+         *      steps on. If set to @cpp 0 @ce, all available hardware threads
+         *      are used.
          *
          * If there are no running animations the function does nothing.
+         *
+         * If @p threadCount is not @cpp 1 @ce, state changes of all
+         * animables are processed first on the calling thread, in the order
+         * the animables were added to the group, together with calling
+         * @ref Animable::animationStarted(), @ref Animable::animationPaused(),
+         * @ref Animable::animationResumed() and @ref Animable::animationStopped().
+         * After that, @ref Animable::animationStep() of all running animables
+         * is called in chunks on multiple threads. In that case the
+         * implementations must be safe to be called concurrently for
+         * different animables and are allowed to call @ref Animable::setState()
+         * only on the animable itself, the change is then processed in the
+         * next step. The implementations can transform objects, but each
+         * object (and its children) should be transformed from only one
+         * animable and the hierarchy can't be changed. Registering the dirty
+         * objects in the scene and in a @ref SpatialIndex is deferred until
+         * all threads finish. Spawning the threads has a non-negligible
+         * overhead, so it's worth it only for large amounts of animables.
          * @see @ref runningCount()
          */
-        void step(Float time, Float delta);
+        void step(Float time, Float delta, UnsignedInt threadCount = 1);
 
     private:
         std::size_t _runningCount;
         bool wakeUp;
+        bool _steppingInParallel;
+
+        /* Animables to step on multiple threads with their animation time,
+           kept to reuse the memory */
+        std::vector<std::pair<Animable<dimensions, T>*, Float>> _steps;
 };
 
 /**
@@ -29,8 +29,13 @@
  * @brief Class @ref Magnum::SceneGraph::Camera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, alias @ref Magnum::SceneGraph::BasicCamera2D, @ref Magnum::SceneGraph::BasicCamera3D, typedef @ref Magnum::SceneGraph::Camera2D, @ref Magnum::SceneGraph::Camera3D
  */
 
+#include <functional>
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractFeature.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -52,8 +57,53 @@ enum class AspectRatioPolicy: UnsignedByte {
     Clip            /**< Clip on smaller side of view */
 };
 
+/**
+@brief Draw order
+
+Distance from the camera is measured along the view direction to center of
+the drawable bounding volume or to the object origin if the drawable has no
+bounding volume. In 2D the distance is always zero.
+@see @ref Camera::draw(DrawableGroup<dimensions, T>&, DrawOrder),
+    @ref Drawable::setSortKey()
+*/
+enum class DrawOrder: UnsignedByte {
+    /** Draw in order in which the drawables were added to the group */
+    Unsorted,
+
+    /**
+     * Sort by @ref Drawable::sortKey() to minimize state changes and then
+     * front-to-back to make use of early depth rejection. Suitable for
+     * opaque drawables.
+     */
+    StateFrontToBack,
+
+    /**
+     * Sort back-to-front and only then by @ref Drawable::sortKey(). Suitable
+     * for transparent drawables, which need to be blended in correct order.
+     */
+    BackToFrontState
+};
+
 namespace Implementation {
     template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRatioFix(AspectRatioPolicy aspectRatioPolicy, const Math::Vector2<T>& projectionScale, const Vector2i& viewport);
+
+    /* Temporary arrays used by Camera::draw(), stored in the camera so their
+       memory is reused across frames */
+    template<UnsignedInt dimensions, class T> struct CameraScratch {
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+        std::vector<MatrixTypeFor<dimensions, T>> transformations;
+        std::vector<UnsignedInt> drawList;
+        std::vector<UnsignedLong> sortKeys;
+        std::vector<UnsignedInt> sortScratch;
+
+        /* Used only by batched culling in 3D */
+        std::vector<RangeTypeFor<dimensions, T>> boxes;
+        std::vector<UnsignedInt> boxDrawables;
+        std::vector<VectorTypeFor<dimensions, T>> sphereCenters;
+        std::vector<T> sphereRadii;
+        std::vector<UnsignedInt> sphereDrawables;
+        std::vector<UnsignedByte> drawableVisible;
+    };
 }
 
 /**
@@ -79,6 +129,30 @@ camera.setProjectionMatrix(Matrix3::perspectiveProjection(35.0_degf, 1.0f, 0.001
       .setAspectRatioPolicy(SceneGraph::AspectRatioPolicy::Extend);
 @endcode
 
+@section SceneGraph-Camera-culling Frustum culling
+
+If any drawable in the group passed to @ref draw() has a bounding volume set,
+the drawables are culled against the view frustum before drawing. Absolute
+transformations of all drawables are calculated in a batch, world-space
+bounding volumes are tested against the frustum and only the visible
+drawables get their camera-relative transformation calculated and
+@ref Drawable::draw() called. In 3D, the bounds are tested against
+@ref Math::Frustum extracted from the projection and camera matrix, for
+@ref Magnum::Float "Float" scenes using the batched tests from
+@ref Math::Geometry::Intersection. In 2D, the bounds are transformed to
+clip space and tested against the @f$ [-1; 1] @f$ rectangle. The test is
+conservative, i.e. some drawables that are not visible may still be drawn.
+Count of drawables culled in the last @ref draw() call is available through
+@ref culledDrawableCount().
+
+@section SceneGraph-Camera-instancing Instanced drawing
+
+Visible @ref InstancedDrawable features in the drawn group are gathered into
+their @ref InstancedDrawableBatch and each batch is drawn with a single
+@ref InstancedDrawableBatch::draw() call, at the place of the first of its
+drawables in the draw order. See @ref SceneGraph-Drawable-instancing for more
+information.
+
 @section SceneGraph-Camera-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -201,10 +275,44 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables in order in which they were added to
+         * the group. If any drawable in the group has a bounding volume,
+         * drawables that are outside of the view frustum are skipped, see
+         * @ref SceneGraph-Camera-culling for more information. Instanced
+         * drawables are drawn in batches, see
+         * @ref SceneGraph-Camera-instancing.
+         * @see @ref culledDrawableCount(),
+         *      @ref draw(DrawableGroup<dimensions, T>&, DrawOrder)
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw in given order
+         *
+         * Like @ref draw(DrawableGroup<dimensions, T>&), but the visible
+         * drawables are sorted in given order before drawing. The sort keys
+         * are composed from @ref Drawable::sortKey() and quantized distance
+         * from the camera and sorted using radix sort. Commonly the opaque
+         * drawables are drawn first, followed by the transparent ones:
+         *
+         * @code{.cpp}
+         * camera.draw(opaqueDrawables, SceneGraph::DrawOrder::StateFrontToBack);
+         * camera.draw(transparentDrawables, SceneGraph::DrawOrder::BackToFrontState);
+         * @endcode
+         */
+        void draw(DrawableGroup<dimensions, T>& group, DrawOrder order);
+
+        /**
+         * @brief Count of drawables culled in last draw
+         *
+         * Count of drawables that were skipped in the last @ref draw() call
+         * because their bounding volume was outside of the view frustum.
+         * Initially @cpp 0 @ce.
+         * @see @ref Drawable::setBoundingBox(),
+         *      @ref Drawable::setBoundingSphere()
+         */
+        std::size_t culledDrawableCount() const { return _culledDrawableCount; }
+
     private:
         /** Recalculates camera matrix */
         void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix) override {
@@ -220,6 +328,9 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+        std::size_t _culledDrawableCount;
+
+        Implementation::CameraScratch<dimensions, T> _scratch;
 };
 
 /**
@@ -29,9 +29,17 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+#include "Magnum/Math/Geometry/IntersectionBatch.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
+#include "Magnum/SceneGraph/boundsImplementation.h"
+#include "Magnum/SceneGraph/sortImplementation.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -53,9 +61,141 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+/* Puts indices of drawables that are potentially visible to the front of
+   `scratch.drawList` in ascending order, returns their count. The draw list is
+   expected to have the same size as the group. `transformations` are
+   absolute, `matrix` is projection matrix multiplied with camera matrix. */
+template<UnsignedInt, class> struct DrawableCulling;
+
+/* In 2D the projection is affine, so the bounds are transformed into clip
+   space and tested against the [-1; 1] square */
+template<class T> struct DrawableCulling<2, T> {
+    static std::size_t visibleDrawables(DrawableGroup<2, T>& group, const std::vector<Math::Matrix3<T>>& transformations, const Math::Matrix3<T>& matrix, CameraScratch<2, T>& scratch) {
+        std::vector<UnsignedInt>& visible = scratch.drawList;
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != group.size(); ++i) {
+            const Drawable<2, T>& drawable = group[i];
+            const Math::Matrix3<T> clipMatrix = matrix*transformations[i];
+
+            Math::Range2D<T> clipBox;
+            if(drawable.boundingVolume() == BoundingVolume::Box)
+                clipBox = transformedBoundingBox<2, T>(clipMatrix, drawable.boundingBox());
+            else if(drawable.boundingVolume() == BoundingVolume::Sphere) {
+                const Math::Vector2<T> center = clipMatrix.transformPoint(drawable.boundingSphereCenter());
+                const Math::Matrix2x2<T> rotationScaling = clipMatrix.rotationScaling();
+                const Math::Vector2<T> extent{
+                    drawable.boundingSphereRadius()*rotationScaling.row(0).length(),
+                    drawable.boundingSphereRadius()*rotationScaling.row(1).length()};
+                clipBox = {center - extent, center + extent};
+            } else {
+                visible[count++] = i;
+                continue;
+            }
+
+            if((clipBox.min() <= Math::Vector2<T>{T(1)}).all() && (clipBox.max() >= Math::Vector2<T>{T(-1)}).all())
+                visible[count++] = i;
+        }
+
+        return count;
+    }
+};
+
+/* Batch frustum tests for the 3D variant below. Float has optimized
+   implementations in the Math library, other types test one by one. Plain
+   overloads and not a specialization of DrawableCulling, as that would
+   instantiate the Float drawable and feature classes before their exported
+   explicit instantiations. */
+template<class T> std::size_t boxFrustumIndicesInto(const std::vector<Math::Range3D<T>>& boxes, const Math::Frustum<T>& frustum, UnsignedInt* indices) {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != boxes.size(); ++i)
+        if(Math::Geometry::Intersection::boxFrustum<T>(boxes[i], frustum))
+            indices[count++] = i;
+    return count;
+}
+
+inline std::size_t boxFrustumIndicesInto(const std::vector<Range3D>& boxes, const Frustum& frustum, UnsignedInt* indices) {
+    return Math::Geometry::Intersection::boxFrustumIndicesInto({boxes.data(), boxes.size()}, frustum, {indices, boxes.size()});
+}
+
+template<class T> std::size_t sphereFrustumIndicesInto(const std::vector<Math::Vector3<T>>& centers, const std::vector<T>& radii, const Math::Frustum<T>& frustum, UnsignedInt* indices) {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != centers.size(); ++i)
+        if(Math::Geometry::Intersection::sphereFrustum(centers[i], radii[i], frustum))
+            indices[count++] = i;
+    return count;
+}
+
+inline std::size_t sphereFrustumIndicesInto(const std::vector<Vector3>& centers, const std::vector<Float>& radii, const Frustum& frustum, UnsignedInt* indices) {
+    return Math::Geometry::Intersection::sphereFrustumIndicesInto({centers.data(), centers.size()}, {radii.data(), radii.size()}, frustum, {indices, centers.size()});
 }
 
-template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
+/* In 3D, world-space boxes and spheres are gathered into contiguous arrays and
+   tested against the frustum in a batch */
+template<class T> struct DrawableCulling<3, T> {
+    static std::size_t visibleDrawables(DrawableGroup<3, T>& group, const std::vector<Math::Matrix4<T>>& transformations, const Math::Matrix4<T>& matrix, CameraScratch<3, T>& scratch) {
+        const Math::Frustum<T> frustum = Math::Frustum<T>::fromMatrix(matrix);
+
+        /* Gather world-space bounds, remember which drawable they belong
+           to. Drawables without a bounding volume are always visible. */
+        std::vector<UnsignedInt>& visible = scratch.drawList;
+        std::vector<Math::Range3D<T>>& boxes = scratch.boxes;
+        std::vector<UnsignedInt>& boxDrawables = scratch.boxDrawables;
+        std::vector<Math::Vector3<T>>& sphereCenters = scratch.sphereCenters;
+        std::vector<T>& sphereRadii = scratch.sphereRadii;
+        std::vector<UnsignedInt>& sphereDrawables = scratch.sphereDrawables;
+        std::vector<UnsignedByte>& drawableVisible = scratch.drawableVisible;
+        boxes.clear();
+        boxDrawables.clear();
+        sphereCenters.clear();
+        sphereRadii.clear();
+        sphereDrawables.clear();
+        drawableVisible.assign(group.size(), 0);
+        for(std::size_t i = 0; i != group.size(); ++i) {
+            const Drawable<3, T>& drawable = group[i];
+            if(drawable.boundingVolume() == BoundingVolume::Box) {
+                boxes.push_back(transformedBoundingBox<3, T>(transformations[i], drawable.boundingBox()));
+                boxDrawables.push_back(i);
+            } else if(drawable.boundingVolume() == BoundingVolume::Sphere) {
+                sphereCenters.push_back(transformations[i].transformPoint(drawable.boundingSphereCenter()));
+                sphereRadii.push_back(transformedBoundingSphereRadius<3, T>(transformations[i], drawable.boundingSphereRadius()));
+                sphereDrawables.push_back(i);
+            } else drawableVisible[i] = 1;
+        }
+
+        /* Test them in a batch, reusing the output array for the indices */
+        const std::size_t visibleBoxCount = boxFrustumIndicesInto(boxes, frustum, visible.data());
+        for(std::size_t i = 0; i != visibleBoxCount; ++i)
+            drawableVisible[boxDrawables[visible[i]]] = 1;
+        const std::size_t visibleSphereCount = sphereFrustumIndicesInto(sphereCenters, sphereRadii, frustum, visible.data());
+        for(std::size_t i = 0; i != visibleSphereCount; ++i)
+            drawableVisible[sphereDrawables[visible[i]]] = 1;
+
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != group.size(); ++i)
+            if(drawableVisible[i]) visible[count++] = i;
+
+        return count;
+    }
+};
+
+/* Distance of a drawable from the camera, `transformation` is relative to the
+   camera. There's no depth in 2D. */
+template<UnsignedInt, class> struct DrawableDepth;
+template<class T> struct DrawableDepth<2, T> {
+    static T depth(const Drawable<2, T>&, const Math::Matrix3<T>&) { return T(0); }
+};
+template<class T> struct DrawableDepth<3, T> {
+    static T depth(const Drawable<3, T>& drawable, const Math::Matrix4<T>& transformation) {
+        /* The camera looks in the direction of negative Z */
+        if(drawable.boundingVolume() == BoundingVolume::None)
+            return -transformation.translation().z();
+        return -transformation.transformPoint(drawable.boundingSphereCenter()).z();
+    }
+};
+
+}
+
+template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved), _culledDrawableCount{} {
     AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::InvertedAbsolute);
 }
 
@@ -83,23 +223,126 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::setViewpor
 }
 
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
+    draw(group, DrawOrder::Unsorted);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group, const DrawOrder order) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
 
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
 
-    /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
+    /* Take the temporary arrays out of the camera for the duration of the
+       call, so a drawable drawing another group with the same camera doesn't
+       overwrite them */
+    Implementation::CameraScratch<dimensions, T> scratch{std::move(_scratch)};
+
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects = scratch.objects;
+    objects.clear();
+    bool hasBoundingVolumes = false;
+    bool hasInstances = false;
+    for(std::size_t i = 0; i != group.size(); ++i) {
         objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+        if(group[i].boundingVolume() != BoundingVolume::None)
+            hasBoundingVolumes = true;
+        if(group[i].instanceBatch())
+            hasInstances = true;
+    }
+
+    /* Nothing to cull, sort or batch, compute transformations of all objects
+       in the group relative to the camera and draw them all */
+    std::vector<MatrixTypeFor<dimensions, T>>& transformations = scratch.transformations;
+    if(!hasBoundingVolumes && !hasInstances && order == DrawOrder::Unsorted) {
+        _culledDrawableCount = 0;
+        scene->transformationMatricesInto(objects, transformations, _cameraMatrix);
+
+        for(std::size_t i = 0; i != transformations.size(); ++i)
+            group[i].draw(transformations[i], *this);
+
+        _scratch = std::move(scratch);
+        return;
+    }
+
+    /* Compute absolute transformations, cull the bounding volumes and then
+       compute camera-relative transformations only for the visible ones */
+    std::vector<UnsignedInt>& visible = scratch.drawList;
+    visible.resize(group.size());
+    std::size_t visibleCount;
+    if(hasBoundingVolumes) {
+        scene->transformationMatricesInto(objects, transformations);
+        visibleCount = Implementation::DrawableCulling<dimensions, T>::visibleDrawables(group, transformations, _projectionMatrix*_cameraMatrix, scratch);
+        for(std::size_t i = 0; i != visibleCount; ++i)
+            transformations[visible[i]] = _cameraMatrix*transformations[visible[i]];
+    } else {
+        scene->transformationMatricesInto(objects, transformations, _cameraMatrix);
+        visibleCount = group.size();
+        for(std::size_t i = 0; i != visibleCount; ++i)
+            visible[i] = i;
+    }
+    _culledDrawableCount = group.size() - visibleCount;
+
+    /* Sort the visible drawables. Depth is quantized to 32 bits and put
+       either below or above the state key, for back-to-front order it's
+       inverted. */
+    if(order != DrawOrder::Unsorted) {
+        std::vector<UnsignedLong>& keys = scratch.sortKeys;
+        std::vector<UnsignedInt>& valueScratch = scratch.sortScratch;
+        keys.resize(visibleCount*2);
+        valueScratch.resize(visibleCount);
+        for(std::size_t i = 0; i != visibleCount; ++i) {
+            const Drawable<dimensions, T>& drawable = group[visible[i]];
+            const UnsignedInt depth = Implementation::sortableFloat(Float(Implementation::DrawableDepth<dimensions, T>::depth(drawable, transformations[visible[i]])));
+            keys[i] = order == DrawOrder::StateFrontToBack ?
+                UnsignedLong(drawable.sortKey()) << 32|depth :
+                UnsignedLong(~depth) << 32|drawable.sortKey();
+        }
+
+        Implementation::radixSort({keys.data(), visibleCount}, {visible.data(), visibleCount}, {keys.data() + visibleCount, visibleCount}, {valueScratch.data(), visibleCount});
+    }
+
+    if(!hasInstances) {
+        for(std::size_t i = 0; i != visibleCount; ++i)
+            group[visible[i]].draw(transformations[visible[i]], *this);
+
+        _scratch = std::move(scratch);
+        return;
+    }
+
+    /* Gather visible instanced drawables into their batches, keeping the draw
+       order */
+    for(std::size_t i = 0; i != visibleCount; ++i) {
+        Drawable<dimensions, T>& drawable = group[visible[i]];
+        if(InstancedDrawableBatch<dimensions, T>* const batch = drawable.instanceBatch()) {
+            batch->_transformationMatrices.push_back(transformations[visible[i]]);
+            batch->_drawables.push_back(static_cast<InstancedDrawable<dimensions, T>*>(&drawable));
+        }
+    }
+
+    /* Draw each batch at the place of its first drawable and skip the rest.
+       The gathered arrays are taken out of the batch for the duration of the
+       draw so they're empty for the subsequent drawables, and put back
+       afterwards to reuse the memory. */
+    for(std::size_t i = 0; i != visibleCount; ++i) {
+        Drawable<dimensions, T>& drawable = group[visible[i]];
+        InstancedDrawableBatch<dimensions, T>* const batch = drawable.instanceBatch();
+        if(!batch) {
+            drawable.draw(transformations[visible[i]], *this);
+            continue;
+        }
+
+        if(batch->_drawables.empty()) continue;
+
+        std::vector<MatrixTypeFor<dimensions, T>> batchTransformations{std::move(batch->_transformationMatrices)};
+        std::vector<InstancedDrawable<dimensions, T>*> batchDrawables{std::move(batch->_drawables)};
+        batch->draw({batchTransformations.data(), batchTransformations.size()}, {batchDrawables.data(), batchDrawables.size()}, *this);
+        batchTransformations.clear();
+        batchDrawables.clear();
+        batch->_transformationMatrices = std::move(batchTransformations);
+        batch->_drawables = std::move(batchDrawables);
+    }
 
-    /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+    _scratch = std::move(scratch);
 }
 
 }}
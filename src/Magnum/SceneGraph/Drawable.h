@@ -26,13 +26,26 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
+ * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, enum @ref Magnum::SceneGraph::BoundingVolume, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
 
+/**
+@brief Drawable bounding volume
+
+@see @ref Drawable::boundingVolume(), @ref Drawable::setBoundingBox(),
+    @ref Drawable::setBoundingSphere()
+*/
+enum class BoundingVolume: UnsignedByte {
+    None,       /**< No bounding volume, the drawable is never culled (default) */
+    Box,        /**< Axis-aligned bounding box */
+    Sphere      /**< Bounding sphere (or circle in 2D) */
+};
+
 /**
 @brief Drawable
 
@@ -160,6 +173,55 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+@section SceneGraph-Drawable-culling Frustum culling
+
+If the drawable has a bounding volume set using @ref setBoundingBox() or
+@ref setBoundingSphere(), @ref Camera::draw() tests it against the view
+frustum and doesn't call @ref draw() if the drawable is not visible. The
+volume is in object-local coordinates and should enclose everything the
+drawable draws:
+
+@code{.cpp}
+(new RedCube(&scene, &drawables))
+    ->setBoundingSphere({}, 1.0f);
+@endcode
+
+Drawables without a bounding volume are always drawn. Count of drawables that
+were culled in the last draw is available through
+@ref Camera::culledDrawableCount().
+
+@section SceneGraph-Drawable-sorting Draw order sorting
+
+To reduce redundant state changes, the drawables can be drawn sorted by a
+32-bit key describing the state they need. Pack the state into the key with
+the most expensive state changes in the highest bits, for example:
+
+@code{.cpp}
+drawable.setSortKey(UnsignedInt(shaderId) << 24|
+                    UnsignedInt(materialId) << 12|
+                    UnsignedInt(meshId));
+@endcode
+
+The drawables are then sorted by @ref Camera::draw(DrawableGroup<dimensions, T>&, DrawOrder)
+based on the key and distance from the camera, see @ref DrawOrder for more
+information.
+
+@section SceneGraph-Drawable-instancing Instanced drawing
+
+If there are many drawables sharing the same mesh and shader, it's possible to
+draw them all using a single instanced draw call. Instead of subclassing
+@ref Drawable, use an @ref InstancedDrawable referencing an
+@ref InstancedDrawableBatch which does the drawing, see its documentation for
+more information.
+
+@section SceneGraph-Drawable-lod Level of detail
+
+Distant objects covering only a few pixels on the screen can be drawn with
+simpler meshes. Subclass @ref LodDrawable instead of @ref Drawable and
+implement @ref LodDrawable::drawLevel() --- the level is chosen based on
+projected size of the bounding volume and thresholds in a shared
+@ref LodChain, see its documentation for more information.
+
 @section SceneGraph-Drawable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -174,6 +236,8 @@ errors. See also @ref compilation-speedup-hpp for more information.
     @ref Drawable2D, @ref Drawable3D, @ref DrawableGroup
 */
 template<UnsignedInt dimensions, class T> class Drawable: public AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T> {
+    friend InstancedDrawable<dimensions, T>;
+
     public:
         /**
          * @brief Constructor
@@ -199,6 +263,116 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /**
+         * @brief Bounding volume type
+         *
+         * @ref BoundingVolume::None by default.
+         * @see @ref setBoundingBox(), @ref setBoundingSphere()
+         */
+        BoundingVolume boundingVolume() const { return _boundingVolume; }
+
+        /**
+         * @brief Bounding box
+         *
+         * In object-local coordinates. If the bounding volume is a sphere,
+         * returns a box enclosing it. If there's no bounding volume, the value
+         * is undefined.
+         * @see @ref boundingVolume()
+         */
+        Math::Range<dimensions, T> boundingBox() const { return _boundingBox; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces bounding sphere, if set. The box is in object-local
+         * coordinates. See @ref SceneGraph-Drawable-culling for more
+         * information.
+         * @see @ref resetBoundingVolume()
+         */
+        Drawable<dimensions, T>& setBoundingBox(const Math::Range<dimensions, T>& box) {
+            _boundingBox = box;
+            _boundingVolume = BoundingVolume::Box;
+            return *this;
+        }
+
+        /**
+         * @brief Bounding sphere center
+         *
+         * In object-local coordinates. If the bounding volume is a box,
+         * returns its center. If there's no bounding volume, the value is
+         * undefined.
+         * @see @ref boundingVolume()
+         */
+        VectorTypeFor<dimensions, T> boundingSphereCenter() const {
+            return _boundingBox.center();
+        }
+
+        /**
+         * @brief Bounding sphere radius
+         *
+         * If the bounding volume is not a sphere, the value is undefined.
+         * @see @ref boundingVolume()
+         */
+        T boundingSphereRadius() const { return _boundingSphereRadius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces bounding box, if set. The sphere is in object-local
+         * coordinates. See @ref SceneGraph-Drawable-culling for more
+         * information.
+         * @see @ref resetBoundingVolume()
+         */
+        Drawable<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius) {
+            _boundingBox = {center - VectorTypeFor<dimensions, T>{radius},
+                            center + VectorTypeFor<dimensions, T>{radius}};
+            _boundingSphereRadius = radius;
+            _boundingVolume = BoundingVolume::Sphere;
+            return *this;
+        }
+
+        /**
+         * @brief Reset bounding volume
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable is then never culled.
+         */
+        Drawable<dimensions, T>& resetBoundingVolume() {
+            _boundingVolume = BoundingVolume::None;
+            return *this;
+        }
+
+        /**
+         * @brief Sort key
+         *
+         * @cpp 0 @ce by default.
+         * @see @ref SceneGraph-Drawable-sorting
+         */
+        UnsignedInt sortKey() const { return _sortKey; }
+
+        /**
+         * @brief Set sort key
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref SceneGraph-Drawable-sorting for more information.
+         */
+        Drawable<dimensions, T>& setSortKey(UnsignedInt key) {
+            _sortKey = key;
+            return *this;
+        }
+
+        /**
+         * @brief Instanced drawable batch
+         *
+         * If the drawable is an @ref InstancedDrawable, returns the batch it
+         * is drawn with, otherwise returns `nullptr`.
+         */
+        InstancedDrawableBatch<dimensions, T>* instanceBatch() const {
+            return _instanceBatch;
+        }
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix  Object transformation relative to camera
@@ -208,6 +382,14 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+    private:
+        /* If the volume is a sphere, this is a box enclosing it */
+        Math::Range<dimensions, T> _boundingBox;
+        T _boundingSphereRadius;
+        InstancedDrawableBatch<dimensions, T>* _instanceBatch;
+        UnsignedInt _sortKey;
+        BoundingVolume _boundingVolume;
 };
 
 /**
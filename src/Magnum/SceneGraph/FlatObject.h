@@ -0,0 +1,401 @@
+#ifndef Magnum_SceneGraph_FlatObject_h
+#define Magnum_SceneGraph_FlatObject_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatObject, alias @ref Magnum::SceneGraph::BasicFlatObject2D, @ref Magnum::SceneGraph::BasicFlatObject3D, typedef @ref Magnum::SceneGraph::FlatObject2D, @ref Magnum::SceneGraph::FlatObject3D
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    enum class FlatObjectFlag: UnsignedByte {
+        /* Local transformation or parent changed since last update */
+        Changed = 1 << 0,
+        /* Absolute transformation changed since last clean */
+        Dirty = 1 << 1,
+        /* The object was destroyed, slot waits for compaction */
+        Removed = 1 << 2
+    };
+
+    typedef Containers::EnumSet<FlatObjectFlag> FlatObjectFlags;
+
+    CORRADE_ENUMSET_OPERATORS(FlatObjectFlags)
+
+    /* Hierarchy data of the whole scene, indexed by object index. Parent
+       index is always smaller than the child index (except when
+       needsReorder is set), the scene itself is at index 0. */
+    template<UnsignedInt dimensions, class T> struct FlatSceneData {
+        std::vector<UnsignedInt> parents;
+        std::vector<MatrixTypeFor<dimensions, T>> transformations;
+        std::vector<MatrixTypeFor<dimensions, T>> absoluteTransformations;
+        std::vector<FlatObjectFlags> flags;
+        std::vector<FlatObject<dimensions, T>*> objects;
+        bool needsUpdate{}, needsReorder{}, needsCompaction{};
+    };
+}
+
+/**
+@brief Object in a flat transformation hierarchy
+
+Alternative to @ref Object for large scenes. Instead of each object storing
+its own transformation and linked list of children, parent indices, relative
+and absolute transformations of all objects are stored in contiguous arrays in
+the @ref FlatScene, sorted so that parents are always before their children.
+Absolute transformations are then calculated in a single linear pass over the
+arrays instead of chasing pointers up the hierarchy, which scales to hundreds of
+thousands of objects.
+
+The object implements the @ref AbstractObject interface, so all features
+including @ref Camera, @ref Drawable and @ref Animable work with it the same
+way as with @ref Object. The transformation is always stored as a matrix,
+there's no choice of transformation implementation.
+
+@code{.cpp}
+typedef SceneGraph::FlatScene3D Scene3D;
+typedef SceneGraph::FlatObject3D Object3D;
+
+Scene3D scene;
+Object3D* object = new Object3D{&scene};
+object->setTransformation(Matrix4::translation(Vector3::xAxis(5.0f)));
+@endcode
+
+Every object has to be part of a scene during its whole lifetime, the parent
+can be changed only to another object in the same scene. Destroying an object
+destroys all its children. Compared to @ref Object there's no direct access to
+children list.
+
+@section SceneGraph-FlatObject-caching Transformation caching
+
+Changing object transformation or parent only marks the object as changed
+without touching its children. The change is propagated to the whole subtree
+during the next update, which is done implicitly by any function that needs
+the absolute transformation or dirty state --- such as @ref isDirty(),
+@ref absoluteTransformationMatrix(), @ref setClean() or
+@ref transformationMatrices(). @ref AbstractFeature::markDirty() is called
+during the update as well. Use @ref FlatScene::cleanAll() to clean all dirty
+objects in the scene in one pass.
+
+@section SceneGraph-FlatObject-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref FlatObject.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref FlatObject2D
+-   @ref FlatObject3D
+
+@see @ref FlatScene, @ref BasicFlatObject2D, @ref BasicFlatObject3D
+*/
+template<UnsignedInt dimensions, class T> class FlatObject: public AbstractObject<dimensions, T> {
+    public:
+        /** @brief Matrix type */
+        typedef MatrixTypeFor<dimensions, T> MatrixType;
+
+        /**
+         * @brief Constructor
+         * @param parent    Parent object
+         *
+         * The object is added to the scene @p parent is part of, with
+         * identity transformation. Unlike with @ref Object, the parent can't
+         * be @cpp nullptr @ce.
+         */
+        explicit FlatObject(FlatObject<dimensions, T>* parent);
+
+        /** @brief Copying is not allowed */
+        FlatObject(const FlatObject<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        FlatObject(FlatObject<dimensions, T>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all children and removes the object from the scene.
+         */
+        ~FlatObject();
+
+        /** @brief Copying is not allowed */
+        FlatObject<dimensions, T>& operator=(const FlatObject<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        FlatObject<dimensions, T>& operator=(FlatObject<dimensions, T>&&) = delete;
+
+        /**
+         * @{ @name Scene hierarchy
+         *
+         * See @ref scenegraph-hierarchy for more information.
+         */
+
+        /** @copydoc AbstractObject::scene() */
+        FlatScene<dimensions, T>* scene();
+        const FlatScene<dimensions, T>* scene() const; /**< @overload */
+
+        /** @brief Parent object or `nullptr`, if this is the scene */
+        FlatObject<dimensions, T>* parent();
+        const FlatObject<dimensions, T>* parent() const; /**< @overload */
+
+        /**
+         * @brief Add a child
+         *
+         * Calling `object.addChild<MyObject>(args...)` is equivalent to
+         * `new MyObject{args..., &object}`.
+         */
+        template<class U, class ...Args> U& addChild(Args... args) {
+            return *(new U{std::forward<Args>(args)..., this});
+        }
+
+        /**
+         * @brief Add a child allocated from a pool
+         *
+         * Calling `object.addChild<MyObject>(pool, args...)` is equivalent
+         * to `new(pool) MyObject{args..., &object}`. Expects that the object
+         * derives from @ref PoolAllocated, see @ref Pool for more information.
+         */
+        template<class U, class ...Args> U& addChild(Pool& pool, Args... args) {
+            static_assert(std::is_base_of<PoolAllocated, U>::value, "only types deriving from PoolAllocated can be allocated from a pool");
+            return *(new(pool) U{std::forward<Args>(args)..., this});
+        }
+
+        /**
+         * @brief Set parent object
+         * @return Reference to self (for method chaining)
+         *
+         * The parent has to be in the same scene and can't be a child of this
+         * object.
+         */
+        FlatObject<dimensions, T>& setParent(FlatObject<dimensions, T>* parent);
+
+        /*@}*/
+
+        /** @{ @name Object transformation */
+
+        /** @brief Object transformation */
+        MatrixType transformation() const {
+            return _data->transformations[_index];
+        }
+
+        /** @copydoc AbstractObject::transformationMatrix() */
+        MatrixType transformationMatrix() const { return transformation(); }
+
+        /**
+         * @brief Set transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Setting transformation of the scene is not allowed.
+         */
+        FlatObject<dimensions, T>& setTransformation(const MatrixType& transformation);
+
+        /**
+         * @brief Reset object transformation
+         * @return Reference to self (for method chaining)
+         */
+        FlatObject<dimensions, T>& resetTransformation() {
+            return setTransformation({});
+        }
+
+        /**
+         * @brief Transform object
+         * @return Reference to self (for method chaining)
+         *
+         * Multiplies the transformation from the left.
+         */
+        FlatObject<dimensions, T>& transform(const MatrixType& transformation) {
+            return setTransformation(transformation*this->transformation());
+        }
+
+        /**
+         * @brief Transform object as a local transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Multiplies the transformation from the right.
+         */
+        FlatObject<dimensions, T>& transformLocal(const MatrixType& transformation) {
+            return setTransformation(this->transformation()*transformation);
+        }
+
+        /**
+         * @brief Translate object
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::translation()
+         * or @ref Math::Matrix3::translation().
+         */
+        FlatObject<dimensions, T>& translate(const VectorTypeFor<dimensions, T>& vector) {
+            return transform(MatrixType::translation(vector));
+        }
+
+        /**
+         * @brief Scale object
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::scaling()
+         * or @ref Math::Matrix3::scaling().
+         */
+        FlatObject<dimensions, T>& scale(const VectorTypeFor<dimensions, T>& vector) {
+            return transform(MatrixType::scaling(vector));
+        }
+
+        /** @copydoc AbstractObject::absoluteTransformationMatrix() */
+        MatrixType absoluteTransformationMatrix() const;
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object
+         *
+         * All transformations are premultiplied with @p initialTransformationMatrix,
+         * if specified. Currently implemented only for the scene.
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<FlatObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
+        /*@}*/
+
+        /**
+         * @{ @name Transformation caching
+         *
+         * See @ref scenegraph-features-caching for more information.
+         */
+
+        /**
+         * @brief Clean absolute transformations of given set of objects
+         *
+         * Only dirty objects in the list are cleaned.
+         * @see @ref FlatScene::cleanAll()
+         */
+        static void setClean(const std::vector<std::reference_wrapper<FlatObject<dimensions, T>>>& objects);
+
+        /** @copydoc AbstractObject::isDirty() */
+        bool isDirty() const;
+
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Marks the object as changed, the change is propagated to its
+         * children and @ref AbstractFeature::markDirty() is called on next
+         * update, as described in @ref SceneGraph-FlatObject-caching.
+         */
+        void setDirty();
+
+        /**
+         * @brief Clean object absolute transformation
+         *
+         * Calls @ref AbstractFeature::clean() and/or @ref AbstractFeature::cleanInverted()
+         * on all object features which have caching enabled and on features
+         * of all parents which are not already clean. If the object is
+         * already clean, the function does nothing.
+         */
+        void setClean();
+
+        /*@}*/
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+        /* Used by FlatScene, which then populates the data */
+        explicit FlatObject(): _data{}, _index{}, _childCount{} {}
+
+        bool isScene() const { return _index == 0; }
+    #endif
+
+    private:
+        friend FlatScene<dimensions, T>;
+
+        FlatObject<dimensions, T>* doScene() override final;
+        const FlatObject<dimensions, T>* doScene() const override final;
+
+        FlatObject<dimensions, T>* doParent() override final;
+        const FlatObject<dimensions, T>* doParent() const override final;
+
+        MatrixType MAGNUM_SCENEGRAPH_LOCAL doTransformationMatrix() const override final {
+            return transformation();
+        }
+        MatrixType MAGNUM_SCENEGRAPH_LOCAL doAbsoluteTransformationMatrix() const override final {
+            return absoluteTransformationMatrix();
+        }
+
+        void doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const override final;
+
+        bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
+        void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
+        void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
+        void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) override final;
+
+        void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal();
+
+        typedef Implementation::FlatObjectFlag Flag;
+        Implementation::FlatSceneData<dimensions, T>* _data;
+        UnsignedInt _index, _childCount;
+};
+
+/**
+@brief Flat object for two-dimensional scenes
+
+Convenience alternative to @cpp FlatObject<2, T> @ce. See @ref FlatObject for
+more information.
+@see @ref FlatObject2D, @ref BasicFlatObject3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatObject2D = FlatObject<2, T>;
+#endif
+
+/**
+@brief Flat object for two-dimensional float scenes
+
+@see @ref FlatObject3D
+*/
+typedef BasicFlatObject2D<Float> FlatObject2D;
+
+/**
+@brief Flat object for three-dimensional scenes
+
+Convenience alternative to @cpp FlatObject<3, T> @ce. See @ref FlatObject for
+more information.
+@see @ref FlatObject3D, @ref BasicFlatObject2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatObject3D = FlatObject<3, T>;
+#endif
+
+/**
+@brief Flat object for three-dimensional float scenes
+
+@see @ref FlatObject2D
+*/
+typedef BasicFlatObject3D<Float> FlatObject3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatObject<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatObject<3, Float>;
+#endif
+
+}}
+
+#endif
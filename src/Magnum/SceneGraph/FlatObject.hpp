@@ -0,0 +1,417 @@
+#ifndef Magnum_SceneGraph_FlatObject_hpp
+#define Magnum_SceneGraph_FlatObject_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatObject.h and @ref FlatScene.h
+ */
+
+#include <algorithm>
+
+#include "Magnum/SceneGraph/FlatObject.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/parallelImplementation.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>::FlatObject(FlatObject<dimensions, T>* parent): _data{}, _index{}, _childCount{} {
+    /* With graceful asserts the object is left with zero index, which the
+       destructor treats as a scene and doesn't touch the (null) data */
+    CORRADE_ASSERT(parent,
+        "SceneGraph::FlatObject: the parent can't be null", );
+
+    _data = parent->_data;
+    _index = UnsignedInt(parent->_data->objects.size());
+    Implementation::FlatSceneData<dimensions, T>& d = *_data;
+
+    /* Appending to the end, so the parent is always before the child */
+    d.parents.push_back(parent->_index);
+    d.transformations.emplace_back();
+    d.absoluteTransformations.emplace_back();
+    d.flags.push_back(Flag::Changed);
+    d.objects.push_back(this);
+    d.needsUpdate = true;
+    ++parent->_childCount;
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>::~FlatObject() {
+    /* The scene destroys all its objects in its own destructor */
+    if(isScene()) return;
+
+    Implementation::FlatSceneData<dimensions, T>& d = *_data;
+
+    /* Destroy all children, unless this is already done by some parent. The
+       descendants are all after this object, so a single pass marking
+       objects with removed parents finds them. Destroy them in reverse so
+       they don't need to search for their own children again. */
+    if(_childCount && !(d.flags[_index] & Flag::Removed)) {
+        if(d.needsReorder) scene()->rebuild();
+
+        d.flags[_index] |= Flag::Removed;
+        std::vector<FlatObject<dimensions, T>*> descendants;
+        for(std::size_t i = _index + 1; i != d.objects.size(); ++i) {
+            if(!d.objects[i] || !(d.flags[d.parents[i]] & Flag::Removed)) continue;
+            d.flags[i] |= Flag::Removed;
+            descendants.push_back(d.objects[i]);
+        }
+
+        for(auto it = descendants.rbegin(); it != descendants.rend(); ++it)
+            delete *it;
+    }
+
+    /* Remove the object, the slot is reclaimed on next update. The parent
+       might be already gone if the whole scene is being destroyed. */
+    if(FlatObject<dimensions, T>* parent = d.objects[d.parents[_index]])
+        --parent->_childCount;
+    d.flags[_index] |= Flag::Removed;
+    d.objects[_index] = nullptr;
+    d.needsCompaction = true;
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>* FlatObject<dimensions, T>::scene() {
+    return static_cast<FlatScene<dimensions, T>*>(_data->objects[0]);
+}
+
+template<UnsignedInt dimensions, class T> const FlatScene<dimensions, T>* FlatObject<dimensions, T>::scene() const {
+    return static_cast<const FlatScene<dimensions, T>*>(_data->objects[0]);
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>* FlatObject<dimensions, T>::parent() {
+    return isScene() ? nullptr : _data->objects[_data->parents[_index]];
+}
+
+template<UnsignedInt dimensions, class T> const FlatObject<dimensions, T>* FlatObject<dimensions, T>::parent() const {
+    return isScene() ? nullptr : _data->objects[_data->parents[_index]];
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>* FlatObject<dimensions, T>::doScene() {
+    return scene();
+}
+
+template<UnsignedInt dimensions, class T> const FlatObject<dimensions, T>* FlatObject<dimensions, T>::doScene() const {
+    return scene();
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>* FlatObject<dimensions, T>::doParent() {
+    return parent();
+}
+
+template<UnsignedInt dimensions, class T> const FlatObject<dimensions, T>* FlatObject<dimensions, T>::doParent() const {
+    return parent();
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>& FlatObject<dimensions, T>::setParent(FlatObject<dimensions, T>* const parentPointer) {
+    CORRADE_ASSERT(!isScene(),
+        "SceneGraph::FlatObject::setParent(): can't set parent of the scene", *this);
+    CORRADE_ASSERT(parentPointer,
+        "SceneGraph::FlatObject::setParent(): the parent can't be null", *this);
+    FlatObject<dimensions, T>& parent = *parentPointer;
+    CORRADE_ASSERT(parent._data == _data,
+        "SceneGraph::FlatObject::setParent(): the parent is not part of the same scene", *this);
+
+    Implementation::FlatSceneData<dimensions, T>& d = *_data;
+    if(d.parents[_index] == parent._index) return *this;
+
+    /* Object cannot be parented to its child */
+    for(UnsignedInt p = parent._index; p; p = d.parents[p])
+        CORRADE_ASSERT(p != _index,
+            "SceneGraph::FlatObject::setParent(): can't parent an object to its child", *this);
+
+    --d.objects[d.parents[_index]]->_childCount;
+    ++parent._childCount;
+    d.parents[_index] = parent._index;
+
+    /* The parent has to be before the child, reorder on next update if not */
+    if(parent._index > _index) d.needsReorder = true;
+
+    setDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>& FlatObject<dimensions, T>::setTransformation(const MatrixType& transformation) {
+    /* Setting transformation is forbidden for the scene */
+    /** @todo Assert for this? */
+    if(!isScene()) {
+        _data->transformations[_index] = transformation;
+        setDirty();
+    }
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> auto FlatObject<dimensions, T>::absoluteTransformationMatrix() const -> MatrixType {
+    const_cast<FlatScene<dimensions, T>*>(scene())->update();
+    return _data->absoluteTransformations[_index];
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const {
+    transformationMatrices.clear();
+    CORRADE_ASSERT(isScene(), "SceneGraph::FlatObject::transformationMatrices(): currently implemented only for the scene", );
+
+    const_cast<FlatScene<dimensions, T>*>(scene())->update();
+
+    transformationMatrices.reserve(objects.size());
+    for(const auto o: objects) {
+        /** @todo Ensure this doesn't crash, somehow */
+        const FlatObject<dimensions, T>& object = static_cast<const FlatObject<dimensions, T>&>(o.get());
+        CORRADE_ASSERT(object._data == _data, "SceneGraph::FlatObject::transformationMatrices(): the objects are not part of the same scene", );
+        transformationMatrices.push_back(initialTransformationMatrix*_data->absoluteTransformations[object._index]);
+    }
+}
+
+template<UnsignedInt dimensions, class T> auto FlatObject<dimensions, T>::transformationMatrices(const std::vector<std::reference_wrapper<FlatObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    CORRADE_ASSERT(isScene(), "SceneGraph::FlatObject::transformationMatrices(): currently implemented only for the scene", {});
+
+    const_cast<FlatScene<dimensions, T>*>(scene())->update();
+
+    std::vector<MatrixType> transformationMatrices;
+    transformationMatrices.reserve(objects.size());
+    for(const FlatObject<dimensions, T>& o: objects) {
+        CORRADE_ASSERT(o._data == _data, "SceneGraph::FlatObject::transformationMatrices(): the objects are not part of the same scene", {});
+        transformationMatrices.push_back(initialTransformationMatrix*_data->absoluteTransformations[o._index]);
+    }
+
+    return transformationMatrices;
+}
+
+template<UnsignedInt dimensions, class T> bool FlatObject<dimensions, T>::isDirty() const {
+    const_cast<FlatScene<dimensions, T>*>(scene())->update();
+    return !!(_data->flags[_index] & Flag::Dirty);
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::setDirty() {
+    /* Let observers such as SpatialIndex know that something changed */
+    Implementation::nextObjectGeneration();
+
+    /* Propagated to children and features on next update. The update flag
+       is shared by the whole scene, so if this is called from
+       AnimableGroup::step() on multiple threads, it's set after all threads
+       finish. */
+    _data->flags[_index] |= Flag::Changed;
+    if(Implementation::deferShared([](void* data) {
+        static_cast<Implementation::FlatSceneData<dimensions, T>*>(data)->needsUpdate = true;
+    }, _data)) return;
+    _data->needsUpdate = true;
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::setClean() {
+    scene()->update();
+
+    /* The object (and all its parents) are already clean, nothing to do */
+    Implementation::FlatSceneData<dimensions, T>& d = *_data;
+    if(!(d.flags[_index] & Flag::Dirty)) return;
+
+    /* Collect all dirty parents, clean them going down from the root. The
+       absolute transformations are already calculated by the update so the
+       order matters only for the order of feature cleaning. */
+    std::vector<FlatObject<dimensions, T>*> objects;
+    for(UnsignedInt i = _index; d.flags[i] & Flag::Dirty; i = d.parents[i]) {
+        objects.push_back(d.objects[i]);
+        if(!i) break;
+    }
+
+    for(auto it = objects.rbegin(); it != objects.rend(); ++it) {
+        (*it)->setCleanInternal();
+        CORRADE_ASSERT(!(*it)->isDirty(), "SceneGraph::FlatObject::setClean(): original implementation was not called", );
+    }
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) {
+    /* Same as setClean(const std::vector<std::reference_wrapper<FlatObject<dimensions, T>>>&),
+       but without casting the list first */
+    /** @todo Ensure this doesn't crash, somehow */
+    for(auto o: objects) static_cast<FlatObject<dimensions, T>&>(o.get()).setClean();
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::setClean(const std::vector<std::reference_wrapper<FlatObject<dimensions, T>>>& objects) {
+    /* Each object cleans only its dirty parents, so every object is visited
+       at most once */
+    for(FlatObject<dimensions, T>& o: objects) o.setClean();
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::setCleanInternal() {
+    const MatrixType& absoluteTransformation = _data->absoluteTransformations[_index];
+
+    /* "Lazy storage" for inverted transformation matrix */
+    bool invertedComputed = false;
+    MatrixType invertedMatrix;
+
+    /* Clean all features */
+    for(AbstractFeature<dimensions, T>& feature: this->features()) {
+        if(feature.cachedTransformations() & CachedTransformation::Absolute)
+            feature.clean(absoluteTransformation);
+
+        /* Cached inverse absolute transformation, compute it if it wasn't
+            computed already */
+        if(feature.cachedTransformations() & CachedTransformation::InvertedAbsolute) {
+            if(!invertedComputed) {
+                invertedComputed = true;
+                invertedMatrix = absoluteTransformation.inverted();
+            }
+
+            feature.cleanInverted(invertedMatrix);
+        }
+    }
+
+    /* Mark object as clean */
+    _data->flags[_index] &= ~Flag::Dirty;
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>::FlatScene() {
+    /* The scene is the first object, its transformation is always identity */
+    this->_data = this;
+    this->parents.push_back(0);
+    this->transformations.emplace_back();
+    this->absoluteTransformations.emplace_back();
+    this->flags.push_back(Implementation::FlatObjectFlag::Changed);
+    this->objects.push_back(this);
+    this->needsUpdate = true;
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>::~FlatScene() {
+    /* Mark everything as removed first so the objects don't search for
+       their children, then destroy children before their parents */
+    for(std::size_t i = 1; i < this->objects.size(); ++i)
+        this->flags[i] |= Implementation::FlatObjectFlag::Removed;
+    for(std::size_t i = this->objects.size(); i > 1; --i)
+        delete this->objects[i - 1];
+}
+
+template<UnsignedInt dimensions, class T> std::size_t FlatScene<dimensions, T>::objectCount() const {
+    return this->objects.size() - std::count(this->objects.begin(), this->objects.end(), nullptr);
+}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::cleanAll() {
+    update();
+
+    /* Parents are before children, so features of parents get cleaned
+       first, the same as with FlatObject::setClean() */
+    for(std::size_t i = 0; i != this->objects.size(); ++i) {
+        if(!(this->flags[i] & Implementation::FlatObjectFlag::Dirty)) continue;
+        this->objects[i]->setCleanInternal();
+        CORRADE_ASSERT(!(this->flags[i] & Implementation::FlatObjectFlag::Dirty), "SceneGraph::FlatScene::cleanAll(): original implementation was not called", );
+    }
+}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::update() {
+    if(this->needsReorder || this->needsCompaction) rebuild();
+    if(!this->needsUpdate) return;
+
+    std::vector<UnsignedInt>& parents = this->parents;
+    std::vector<Implementation::FlatObjectFlags>& flags = this->flags;
+    std::vector<MatrixTypeFor<dimensions, T>>& transformations = this->transformations;
+    std::vector<MatrixTypeFor<dimensions, T>>& absoluteTransformations = this->absoluteTransformations;
+    const std::size_t count = parents.size();
+
+    /* Parents are always before children, so a single pass is enough to
+       propagate the changes down the hierarchy. Absolute transformation of
+       the scene is always identity. */
+    for(std::size_t i = 1; i != count; ++i) {
+        const UnsignedInt parent = parents[i];
+        if(!((flags[i]|flags[parent]) & Implementation::FlatObjectFlag::Changed)) continue;
+
+        flags[i] |= Implementation::FlatObjectFlag::Changed;
+        absoluteTransformations[i] = absoluteTransformations[parent]*transformations[i];
+    }
+
+    /* Mark the changed objects as dirty, notify their features if they were
+       clean before */
+    for(std::size_t i = 0; i != count; ++i) {
+        if(!(flags[i] & Implementation::FlatObjectFlag::Changed)) continue;
+
+        flags[i] &= ~Implementation::FlatObjectFlag::Changed;
+        if(flags[i] & Implementation::FlatObjectFlag::Dirty) continue;
+
+        flags[i] |= Implementation::FlatObjectFlag::Dirty;
+        for(AbstractFeature<dimensions, T>& feature: this->objects[i]->features())
+            feature.markDirty();
+    }
+
+    this->needsUpdate = false;
+}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::rebuild() {
+    const std::size_t count = this->objects.size();
+
+    /* Children of each object in a compressed array, skipping removed
+       objects. Children of object i are in [childOffsets[i],
+       childOffsets[i + 1]). */
+    std::vector<UnsignedInt> childOffsets(count + 1);
+    for(std::size_t i = 1; i != count; ++i)
+        if(this->objects[i]) ++childOffsets[this->parents[i] + 1];
+    for(std::size_t i = 0; i != count; ++i)
+        childOffsets[i + 1] += childOffsets[i];
+    std::vector<UnsignedInt> children(childOffsets[count]);
+    {
+        std::vector<UnsignedInt> childCursors(childOffsets.begin(), childOffsets.end() - 1);
+        for(std::size_t i = 1; i != count; ++i)
+            if(this->objects[i]) children[childCursors[this->parents[i]]++] = UnsignedInt(i);
+    }
+
+    /* Depth-first order, so parents are before children and whole subtrees
+       are contiguous */
+    std::vector<UnsignedInt> order;
+    order.reserve(children.size() + 1);
+    std::vector<UnsignedInt> stack{0};
+    while(!stack.empty()) {
+        const UnsignedInt i = stack.back();
+        stack.pop_back();
+        order.push_back(i);
+        for(UnsignedInt c = childOffsets[i + 1]; c != childOffsets[i]; --c)
+            stack.push_back(children[c - 1]);
+    }
+
+    /* Permute all arrays, update object indices */
+    std::vector<UnsignedInt> newIndices(count);
+    for(std::size_t i = 0; i != order.size(); ++i)
+        newIndices[order[i]] = UnsignedInt(i);
+
+    std::vector<UnsignedInt> parents(order.size());
+    std::vector<MatrixTypeFor<dimensions, T>> transformations(order.size());
+    std::vector<MatrixTypeFor<dimensions, T>> absoluteTransformations(order.size());
+    std::vector<Implementation::FlatObjectFlags> flags(order.size());
+    std::vector<FlatObject<dimensions, T>*> objects(order.size());
+    for(std::size_t i = 0; i != order.size(); ++i) {
+        const UnsignedInt o = order[i];
+        parents[i] = newIndices[this->parents[o]];
+        transformations[i] = this->transformations[o];
+        absoluteTransformations[i] = this->absoluteTransformations[o];
+        flags[i] = this->flags[o];
+        objects[i] = this->objects[o];
+        objects[i]->_index = UnsignedInt(i);
+    }
+
+    this->parents = std::move(parents);
+    this->transformations = std::move(transformations);
+    this->absoluteTransformations = std::move(absoluteTransformations);
+    this->flags = std::move(flags);
+    this->objects = std::move(objects);
+    this->needsReorder = this->needsCompaction = false;
+}
+
+}}
+
+#endif
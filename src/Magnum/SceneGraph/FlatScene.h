@@ -0,0 +1,143 @@
+#ifndef Magnum_SceneGraph_FlatScene_h
+#define Magnum_SceneGraph_FlatScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatScene, alias @ref Magnum::SceneGraph::BasicFlatScene2D, @ref Magnum::SceneGraph::BasicFlatScene3D, typedef @ref Magnum::SceneGraph::FlatScene2D, @ref Magnum::SceneGraph::FlatScene3D
+ */
+
+#include "Magnum/SceneGraph/FlatObject.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Scene with a flat transformation hierarchy
+
+Root of a @ref FlatObject hierarchy, owning the contiguous arrays with
+transformations of all objects in the scene. Can't have a parent or
+non-default transformation. Destroying the scene destroys all objects in it.
+See @ref FlatObject for more information.
+
+@section SceneGraph-FlatScene-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref FlatObject.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref FlatScene2D
+-   @ref FlatScene3D
+
+@see @ref BasicFlatScene2D, @ref BasicFlatScene3D
+*/
+template<UnsignedInt dimensions, class T> class FlatScene
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    : private Implementation::FlatSceneData<dimensions, T>, public FlatObject<dimensions, T>
+    #else
+    : public FlatObject<dimensions, T>
+    #endif
+{
+    public:
+        explicit FlatScene();
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all objects in the scene.
+         */
+        ~FlatScene();
+
+        /**
+         * @brief Object count
+         *
+         * Count of all objects in the scene, including the scene itself.
+         */
+        std::size_t objectCount() const;
+
+        /**
+         * @brief Clean all dirty objects in the scene
+         *
+         * Equivalent to calling @ref FlatObject::setClean() on all objects in
+         * the scene, but done in a single pass over the objects.
+         */
+        void cleanAll();
+
+    private:
+        friend FlatObject<dimensions, T>;
+
+        /* Propagates changes to children, updates absolute transformations
+           of changed objects and marks them as dirty */
+        void MAGNUM_SCENEGRAPH_LOCAL update();
+
+        /* Removes slots of destroyed objects and sorts the remaining ones in
+           depth-first order so parents are always before children */
+        void MAGNUM_SCENEGRAPH_LOCAL rebuild();
+};
+
+/**
+@brief Flat scene for two-dimensional scenes
+
+Convenience alternative to @cpp FlatScene<2, T> @ce. See @ref FlatScene for
+more information.
+@see @ref FlatScene2D, @ref BasicFlatScene3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatScene2D = FlatScene<2, T>;
+#endif
+
+/**
+@brief Flat scene for two-dimensional float scenes
+
+@see @ref FlatScene3D
+*/
+typedef BasicFlatScene2D<Float> FlatScene2D;
+
+/**
+@brief Flat scene for three-dimensional scenes
+
+Convenience alternative to @cpp FlatScene<3, T> @ce. See @ref FlatScene for
+more information.
+@see @ref FlatScene3D, @ref BasicFlatScene2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatScene3D = FlatScene<3, T>;
+#endif
+
+/**
+@brief Flat scene for three-dimensional float scenes
+
+@see @ref FlatScene2D
+*/
+typedef BasicFlatScene3D<Float> FlatScene3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatScene<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatScene<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef Magnum_SceneGraph_InstancedDrawable_h
+#define Magnum_SceneGraph_InstancedDrawable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::InstancedDrawable, @ref Magnum::SceneGraph::InstancedDrawableBatch, alias @ref Magnum::SceneGraph::BasicInstancedDrawable2D, @ref Magnum::SceneGraph::BasicInstancedDrawable3D, @ref Magnum::SceneGraph::BasicInstancedDrawableBatch2D, @ref Magnum::SceneGraph::BasicInstancedDrawableBatch3D, typedef @ref Magnum::SceneGraph::InstancedDrawable2D, @ref Magnum::SceneGraph::InstancedDrawable3D, @ref Magnum::SceneGraph::InstancedDrawableBatch2D, @ref Magnum::SceneGraph::InstancedDrawableBatch3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/Drawable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Batch of instanced drawables
+
+State shared by a set of @ref InstancedDrawable features --- usually a mesh,
+a shader and material parameters. When a @ref DrawableGroup containing
+instanced drawables is drawn using @ref Camera::draw(), transformations of all
+visible drawables sharing the same batch are gathered and passed to a single
+@ref draw() call, which is meant to draw them all using a single instanced
+draw call.
+
+@section SceneGraph-InstancedDrawableBatch-usage Usage
+
+Subclass the batch and implement @ref draw(). It's up to the implementation
+how the transformations get to the GPU, the following example uploads them to
+a per-instance buffer and draws them with a shader that has
+@ref Shaders::Phong::Flag::InstancedTransformation enabled:
+
+@code{.cpp}
+class PhongBatch: public SceneGraph::InstancedDrawableBatch3D {
+    public:
+        explicit PhongBatch(GL::Mesh& mesh, Shaders::Phong& shader, const Color4& color): _mesh(mesh), _shader(shader), _color{color} {
+            _mesh.addVertexBufferInstanced(_instanceBuffer, 1, 0,
+                Shaders::Phong::TransformationMatrix{});
+        }
+
+    private:
+        void draw(Containers::ArrayView<const Matrix4> transformationMatrices, Containers::ArrayView<SceneGraph::InstancedDrawable3D* const>, SceneGraph::Camera3D& camera) override {
+            _instanceBuffer.setData(transformationMatrices, GL::BufferUsage::StreamDraw);
+            _mesh.setInstanceCount(Int(transformationMatrices.size()));
+            _shader.setDiffuseColor(_color)
+                .setProjectionMatrix(camera.projectionMatrix());
+            _mesh.draw(_shader);
+        }
+
+        GL::Mesh& _mesh;
+        Shaders::Phong& _shader;
+        GL::Buffer _instanceBuffer;
+        Color4 _color;
+};
+@endcode
+
+Then add @ref InstancedDrawable features referencing the batch to your objects
+and draw the group as usual. The instanced drawables can be mixed with
+ordinary drawables in the same group and they can be culled and sorted the
+same way, see @ref SceneGraph-Drawable-culling and
+@ref SceneGraph-Drawable-sorting.
+
+@code{.cpp}
+Shaders::Phong shader{Shaders::Phong::Flag::InstancedTransformation};
+PhongBatch redSpheres{sphereMesh, shader, 0xff0000_rgbf};
+SceneGraph::DrawableGroup3D drawables;
+
+for(const Vector3& position: positions) {
+    auto object = new Object3D{&scene};
+    object->translate(position);
+    (new SceneGraph::InstancedDrawable3D{*object, redSpheres, &drawables})
+        ->setBoundingSphere({}, 1.0f);
+}
+
+// ...
+
+camera->draw(drawables);
+@endcode
+
+The batch is drawn at the place of the first of its visible drawables in the
+draw order and the transformations are in the draw order as well. That means
+with @ref DrawOrder::StateFrontToBack the instances get drawn front to back,
+but with @ref DrawOrder::BackToFrontState the order is preserved only among
+instances of a single batch.
+
+The batch is expected to outlive all drawables referencing it. A batch can't
+be drawn recursively from its own @ref draw().
+
+@see @ref scenegraph, @ref BasicInstancedDrawableBatch2D,
+    @ref BasicInstancedDrawableBatch3D, @ref InstancedDrawableBatch2D,
+    @ref InstancedDrawableBatch3D
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawableBatch {
+    public:
+        explicit InstancedDrawableBatch() = default;
+
+        /** @brief Copying is not allowed */
+        InstancedDrawableBatch(const InstancedDrawableBatch<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        InstancedDrawableBatch(InstancedDrawableBatch<dimensions, T>&&) = delete;
+
+        virtual ~InstancedDrawableBatch() = default;
+
+        /** @brief Copying is not allowed */
+        InstancedDrawableBatch<dimensions, T>& operator=(const InstancedDrawableBatch<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        InstancedDrawableBatch<dimensions, T>& operator=(InstancedDrawableBatch<dimensions, T>&&) = delete;
+
+        /**
+         * @brief Draw the instances using given camera
+         * @param transformationMatrices    Transformations of the instances
+         *      relative to camera
+         * @param drawables                 Drawables corresponding to the
+         *      transformations, for fetching additional per-instance data
+         * @param camera                    Camera
+         *
+         * Both views have the same size, which is never zero. Projection
+         * matrix can be retrieved from
+         * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
+         */
+        virtual void draw(Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformationMatrices, Containers::ArrayView<InstancedDrawable<dimensions, T>* const> drawables, Camera<dimensions, T>& camera) = 0;
+
+    private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        friend Camera<dimensions, T>;
+        #endif
+
+        /* Instances gathered by Camera::draw(), kept here so the memory is
+           reused across frames */
+        std::vector<MatrixTypeFor<dimensions, T>> _transformationMatrices;
+        std::vector<InstancedDrawable<dimensions, T>*> _drawables;
+};
+
+/**
+@brief Instanced drawable
+
+A @ref Drawable that doesn't draw itself, but is drawn together with other
+drawables sharing the same @ref InstancedDrawableBatch. See its documentation
+for more information.
+
+@see @ref scenegraph, @ref BasicInstancedDrawable2D,
+    @ref BasicInstancedDrawable3D, @ref InstancedDrawable2D,
+    @ref InstancedDrawable3D
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawable: public Drawable<dimensions, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this drawable belongs to
+         * @param batch     Batch this drawable is drawn with
+         * @param drawables Group this drawable belongs to
+         *
+         * Adds the feature to the object and also to the group, if specified.
+         * Otherwise you can use @ref DrawableGroup::add().
+         */
+        explicit InstancedDrawable(AbstractObject<dimensions, T>& object, InstancedDrawableBatch<dimensions, T>& batch, DrawableGroup<dimensions, T>* drawables = nullptr): Drawable<dimensions, T>{object, drawables} {
+            Drawable<dimensions, T>::_instanceBatch = &batch;
+        }
+
+        /** @brief Batch this drawable is drawn with */
+        InstancedDrawableBatch<dimensions, T>& batch() {
+            return *Drawable<dimensions, T>::_instanceBatch;
+        }
+
+        /** @overload */
+        const InstancedDrawableBatch<dimensions, T>& batch() const {
+            return *Drawable<dimensions, T>::_instanceBatch;
+        }
+
+        /**
+         * @brief Draw the object using given camera
+         *
+         * Draws just this drawable by passing a single instance to
+         * @ref InstancedDrawableBatch::draw(). Not called by
+         * @ref Camera::draw(), which draws whole batches instead.
+         */
+        void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) override {
+            InstancedDrawable<dimensions, T>* const self = this;
+            batch().draw({&transformationMatrix, 1}, {&self, 1}, camera);
+        }
+};
+
+/**
+@brief Instanced drawable for two-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawable<2, T> @ce. See
+@ref InstancedDrawableBatch for more information.
+@see @ref InstancedDrawable2D, @ref BasicInstancedDrawable3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+#endif
+
+/**
+@brief Instanced drawable for two-dimensional float scenes
+
+@see @ref InstancedDrawable3D
+*/
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+
+/**
+@brief Instanced drawable for three-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawable<3, T> @ce. See
+@ref InstancedDrawableBatch for more information.
+@see @ref InstancedDrawable3D, @ref BasicInstancedDrawable2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+#endif
+
+/**
+@brief Instanced drawable for three-dimensional float scenes
+
+@see @ref InstancedDrawable2D
+*/
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+
+/**
+@brief Batch of instanced drawables for two-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawableBatch<2, T> @ce. See
+@ref InstancedDrawableBatch for more information.
+@see @ref InstancedDrawableBatch2D, @ref BasicInstancedDrawableBatch3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawableBatch2D = InstancedDrawableBatch<2, T>;
+#endif
+
+/**
+@brief Batch of instanced drawables for two-dimensional float scenes
+
+@see @ref InstancedDrawableBatch3D
+*/
+typedef BasicInstancedDrawableBatch2D<Float> InstancedDrawableBatch2D;
+
+/**
+@brief Batch of instanced drawables for three-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawableBatch<3, T> @ce. See
+@ref InstancedDrawableBatch for more information.
+@see @ref InstancedDrawableBatch3D, @ref BasicInstancedDrawableBatch2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawableBatch3D = InstancedDrawableBatch<3, T>;
+#endif
+
+/**
+@brief Batch of instanced drawables for three-dimensional float scenes
+
+@see @ref InstancedDrawableBatch2D
+*/
+typedef BasicInstancedDrawableBatch3D<Float> InstancedDrawableBatch3D;
+
+}}
+
+#endif
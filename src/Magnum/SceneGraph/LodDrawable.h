@@ -0,0 +1,466 @@
+#ifndef Magnum_SceneGraph_LodDrawable_h
+#define Magnum_SceneGraph_LodDrawable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::LodDrawable, @ref Magnum::SceneGraph::LodChain, alias @ref Magnum::SceneGraph::BasicLodDrawable2D, @ref Magnum::SceneGraph::BasicLodDrawable3D, @ref Magnum::SceneGraph::BasicLodChain2D, @ref Magnum::SceneGraph::BasicLodChain3D, typedef @ref Magnum::SceneGraph::LodDrawable2D, @ref Magnum::SceneGraph::LodDrawable3D, @ref Magnum::SceneGraph::LodChain2D, @ref Magnum::SceneGraph::LodChain3D
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Level-of-detail chain
+
+Screen-space sizes at which levels of detail of a @ref LodDrawable are
+selected, shared by all drawables with the same set of levels, together with
+statistics about which levels were drawn.
+
+@section SceneGraph-LodChain-usage Usage
+
+The chain is specified by a list of minimal sizes in pixels, one for each
+level, starting with the most detailed one. The size is a diameter of the
+drawable bounding volume projected to the screen and the first level with the
+minimal size not larger than the projected size is selected. If the drawable
+is smaller than the last minimal size, it's not drawn at all. Set the last
+minimal size to @cpp 0.0f @ce to draw the least detailed level regardless of
+the size.
+
+@code{.cpp}
+// Level 0 for drawables larger than 300 pixels, level 1 for 100 -- 300
+// pixels, level 2 for 20 -- 100 pixels, smaller ones are not drawn
+SceneGraph::LodChain3D chain{{300.0f, 100.0f, 20.0f}};
+@endcode
+
+To avoid popping when the size is near to the boundary between two levels,
+the drawable switches to a more detailed level only when its size is larger
+than the minimal size by given @ref hysteresis() fraction and to a less
+detailed level only when it's smaller by the same fraction.
+
+@section SceneGraph-LodChain-statistics Statistics
+
+Every @ref LodDrawable::draw() call increments the count of draws of
+selected level in the chain, or the count of skipped draws if the drawable was
+too small. Count of level switches is tracked as well, which is useful for
+tuning the hysteresis. The statistics are accumulated until
+@ref resetStatistics() is called, for example at the beginning of every frame.
+
+@see @ref scenegraph, @ref BasicLodChain2D, @ref BasicLodChain3D,
+    @ref LodChain2D, @ref LodChain3D
+*/
+template<UnsignedInt dimensions, class T> class LodChain {
+    public:
+        /**
+         * @brief Constructor
+         * @param minimalSizes  Minimal projected size in pixels for each
+         *      level, expected to be in descending order
+         * @param hysteresis    Fraction of the minimal size by which the
+         *      projected size has to cross it to switch the level. Expected
+         *      to be in range @f$ [0, 1) @f$.
+         */
+        explicit LodChain(std::vector<T> minimalSizes, T hysteresis = T(0.1)): _minimalSizes{std::move(minimalSizes)}, _hysteresis{hysteresis}, _drawCounts(_minimalSizes.size()), _skipCount{}, _switchCount{} {
+            CORRADE_ASSERT(hysteresis >= T(0) && hysteresis < T(1),
+                "SceneGraph::LodChain: hysteresis expected to be in range [0, 1) but got" << hysteresis, );
+            for(std::size_t i = 1; i < _minimalSizes.size(); ++i) {
+                CORRADE_ASSERT(_minimalSizes[i] <= _minimalSizes[i - 1],
+                    "SceneGraph::LodChain: minimal sizes are not in descending order", );
+            }
+        }
+
+        /** @brief Copying is not allowed */
+        LodChain(const LodChain<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        LodChain(LodChain<dimensions, T>&&) = delete;
+
+        /** @brief Copying is not allowed */
+        LodChain<dimensions, T>& operator=(const LodChain<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        LodChain<dimensions, T>& operator=(LodChain<dimensions, T>&&) = delete;
+
+        /** @brief Level count */
+        UnsignedInt levelCount() const { return UnsignedInt(_minimalSizes.size()); }
+
+        /** @brief Minimal projected size in pixels for each level */
+        const std::vector<T>& minimalSizes() const { return _minimalSizes; }
+
+        /** @brief Hysteresis */
+        T hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Level for given projected size
+         *
+         * Returns the first level with minimal size not larger than @p size,
+         * or @ref levelCount() if @p size is smaller than all of them. Doesn't
+         * take @ref hysteresis() into account.
+         */
+        UnsignedInt levelFor(T size) const {
+            /* There's usually just a few levels, linear search is fine */
+            for(std::size_t i = 0; i != _minimalSizes.size(); ++i)
+                if(size >= _minimalSizes[i]) return UnsignedInt(i);
+            return levelCount();
+        }
+
+        /**
+         * @brief Count of draws of given level
+         *
+         * Since the last call to @ref resetStatistics(). Expects that
+         * @p level is less than @ref levelCount().
+         */
+        UnsignedInt drawCount(UnsignedInt level) const {
+            CORRADE_ASSERT(level < _drawCounts.size(),
+                "SceneGraph::LodChain::drawCount(): level" << level << "out of range for" << _drawCounts.size() << "levels", {});
+            return _drawCounts[level];
+        }
+
+        /**
+         * @brief Count of skipped draws
+         *
+         * Count of @ref LodDrawable::draw() calls since the last call to
+         * @ref resetStatistics() in which the drawable was smaller than the
+         * minimal size of the last level and thus wasn't drawn.
+         */
+        UnsignedInt skipCount() const { return _skipCount; }
+
+        /**
+         * @brief Count of level switches
+         *
+         * Count of @ref LodDrawable::draw() calls since the last call to
+         * @ref resetStatistics() in which the drawable selected a different
+         * level than in the previous call, including switches to and from
+         * not being drawn at all.
+         */
+        UnsignedInt switchCount() const { return _switchCount; }
+
+        /**
+         * @brief Reset statistics
+         * @return Reference to self (for method chaining)
+         *
+         * Sets @ref drawCount(), @ref skipCount() and @ref switchCount() to
+         * zero.
+         */
+        LodChain<dimensions, T>& resetStatistics() {
+            for(UnsignedInt& count: _drawCounts) count = 0;
+            _skipCount = _switchCount = 0;
+            return *this;
+        }
+
+    private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        friend LodDrawable<dimensions, T>;
+        #endif
+
+        std::vector<T> _minimalSizes;
+        T _hysteresis;
+        std::vector<UnsignedInt> _drawCounts;
+        UnsignedInt _skipCount, _switchCount;
+};
+
+/**
+@brief Level-of-detail drawable
+
+A @ref Drawable that selects one of the levels of a @ref LodChain based on
+its size on the screen and draws it.
+
+@section SceneGraph-LodDrawable-usage Usage
+
+Subclass the drawable and implement @ref drawLevel(), which gets the
+selected level. The following example draws one of the views into a mesh
+containing all levels:
+
+@code{.cpp}
+class LodMesh: public SceneGraph::LodDrawable3D {
+    public:
+        explicit LodMesh(Object3D& object, SceneGraph::LodChain3D& chain, std::vector<GL::MeshView>& levels, Shaders::Phong& shader, SceneGraph::DrawableGroup3D& drawables): SceneGraph::LodDrawable3D{object, chain, &drawables}, _levels(levels), _shader(shader) {}
+
+    private:
+        void drawLevel(UnsignedInt level, const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            _shader.setTransformationMatrix(transformationMatrix)
+                .setNormalMatrix(transformationMatrix.rotationScaling())
+                .setProjectionMatrix(camera.projectionMatrix());
+            _levels[level].draw(_shader);
+        }
+
+        std::vector<GL::MeshView>& _levels;
+        Shaders::Phong& _shader;
+};
+@endcode
+
+The projected size is calculated from the bounding volume set using
+@ref setBoundingSphere() or @ref setBoundingBox(), which also makes the
+drawable subject to frustum culling in @ref Camera::draw(), see
+@ref SceneGraph-Drawable-culling. Drawables without a bounding volume always
+use the most detailed level. The size depends on the camera viewport, so make
+sure to keep it up-to-date using @ref Camera::setViewport().
+
+@code{.cpp}
+SceneGraph::LodChain3D chain{{300.0f, 100.0f, 20.0f}};
+std::vector<GL::MeshView> levels{...};
+
+for(const Vector3& position: positions) {
+    auto object = new Object3D{&scene};
+    object->translate(position);
+    (new LodMesh{*object, chain, levels, shader, drawables})
+        ->setBoundingSphere({}, 1.0f);
+}
+
+// ...
+
+chain.resetStatistics();
+camera->draw(drawables);
+@endcode
+
+@see @ref scenegraph, @ref BasicLodDrawable2D, @ref BasicLodDrawable3D,
+    @ref LodDrawable2D, @ref LodDrawable3D
+*/
+template<UnsignedInt dimensions, class T> class LodDrawable: public Drawable<dimensions, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this drawable belongs to
+         * @param chain     Level-of-detail chain
+         * @param drawables Group this drawable belongs to
+         *
+         * Adds the feature to the object and also to the group, if specified.
+         * Otherwise you can use @ref DrawableGroup::add(). The chain is
+         * expected to outlive the drawable.
+         */
+        explicit LodDrawable(AbstractObject<dimensions, T>& object, LodChain<dimensions, T>& chain, DrawableGroup<dimensions, T>* drawables = nullptr): Drawable<dimensions, T>{object, drawables}, _chain(&chain), _level{NoLevel} {}
+
+        /** @brief Level-of-detail chain */
+        LodChain<dimensions, T>& chain() { return *_chain; }
+
+        /** @overload */
+        const LodChain<dimensions, T>& chain() const { return *_chain; }
+
+        /**
+         * @brief Level selected in the last draw
+         *
+         * If the drawable was too small to be drawn or wasn't drawn yet,
+         * returns @ref LodChain::levelCount().
+         */
+        UnsignedInt level() const {
+            return _level == NoLevel ? _chain->levelCount() : _level;
+        }
+
+        /**
+         * @brief Projected size
+         * @param transformationMatrix  Object transformation relative to
+         *      camera
+         * @param camera                Camera
+         *
+         * Diameter of the bounding volume in pixels, calculated from camera
+         * projection matrix and viewport. Transformations with non-uniform
+         * scaling use the largest scaling factor. The size is calculated as
+         * if the drawable was in the center of the screen, thus for
+         * perspective projection it's slightly smaller than the actual size
+         * near the screen edges. If the drawable has no bounding volume or
+         * the camera is inside it, returns infinity.
+         */
+        T projectedSize(const MatrixTypeFor<dimensions, T>& transformationMatrix, const Camera<dimensions, T>& camera) const;
+
+        /**
+         * @brief Draw the object using given camera
+         *
+         * Selects a level based on @ref projectedSize(), updates statistics
+         * of the @ref chain() and calls @ref drawLevel() with the selected
+         * level, unless the drawable is too small to be drawn.
+         */
+        void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) override;
+
+    protected:
+        /**
+         * @brief Draw given level
+         * @param level                 Level to draw, always less than
+         *      @ref LodChain::levelCount()
+         * @param transformationMatrix  Object transformation relative to
+         *      camera
+         * @param camera                Camera
+         */
+        virtual void drawLevel(UnsignedInt level, const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+    private:
+        enum: UnsignedInt { NoLevel = ~UnsignedInt{} };
+
+        LodChain<dimensions, T>* _chain;
+        UnsignedInt _level;
+};
+
+template<UnsignedInt dimensions, class T> T LodDrawable<dimensions, T>::projectedSize(const MatrixTypeFor<dimensions, T>& transformationMatrix, const Camera<dimensions, T>& camera) const {
+    T radius;
+    switch(this->boundingVolume()) {
+        case BoundingVolume::Sphere:
+            radius = this->boundingSphereRadius();
+            break;
+        case BoundingVolume::Box:
+            radius = this->boundingBox().size().length()/T(2);
+            break;
+        case BoundingVolume::None:
+        default:
+            return Math::Constants<T>::inf();
+    }
+
+    /* Largest scaling in any direction */
+    const auto rotationScaling = transformationMatrix.rotationScaling();
+    T scalingSquared{};
+    for(std::size_t i = 0; i != dimensions; ++i)
+        scalingSquared = std::max(scalingSquared, rotationScaling[i].dot());
+
+    /* W coordinate of the center in clip space, equal to the distance from
+       the camera for perspective projection and 1 for orthographic */
+    const VectorTypeFor<dimensions, T> center = transformationMatrix.transformPoint(this->boundingSphereCenter());
+    const MatrixTypeFor<dimensions, T> projectionMatrix = camera.projectionMatrix();
+    T w = projectionMatrix[dimensions][dimensions];
+    for(std::size_t i = 0; i != dimensions; ++i)
+        w += projectionMatrix[i][dimensions]*center[i];
+    const T projectedRadius = radius*std::sqrt(scalingSquared);
+    if(w <= projectedRadius*std::abs(projectionMatrix[dimensions - 1][dimensions]))
+        return Math::Constants<T>::inf();
+
+    /* Normalized device coordinates span two units over the whole viewport,
+       so the radius in NDC multiplied by viewport size is the diameter in
+       pixels */
+    const Vector2i viewport = camera.viewport();
+    const T scale = std::max(std::abs(projectionMatrix[0][0])*T(viewport.x()),
+                             std::abs(projectionMatrix[1][1])*T(viewport.y()));
+    return scale*projectedRadius/w;
+}
+
+template<UnsignedInt dimensions, class T> void LodDrawable<dimensions, T>::draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) {
+    LodChain<dimensions, T>& chain = *_chain;
+    const T size = projectedSize(transformationMatrix, camera);
+
+    /* The first selection is done without hysteresis. Otherwise switch to a
+       more detailed level only if it would be selected even with the size
+       decreased by the hysteresis and to a less detailed level only if it
+       would be selected even with the size increased by it. */
+    UnsignedInt level;
+    if(_level == NoLevel) level = chain.levelFor(size);
+    else {
+        const UnsignedInt moreDetailed = chain.levelFor(size/(T(1) + chain._hysteresis));
+        const UnsignedInt lessDetailed = chain.levelFor(size/(T(1) - chain._hysteresis));
+        if(moreDetailed < _level) level = moreDetailed;
+        else if(lessDetailed > _level) level = lessDetailed;
+        else level = _level;
+        if(level != _level) ++chain._switchCount;
+    }
+    _level = level;
+
+    if(level == chain.levelCount()) {
+        ++chain._skipCount;
+        return;
+    }
+
+    ++chain._drawCounts[level];
+    drawLevel(level, transformationMatrix, camera);
+}
+
+/**
+@brief Level-of-detail drawable for two-dimensional scenes
+
+Convenience alternative to @cpp LodDrawable<2, T> @ce. See @ref LodDrawable
+for more information.
+@see @ref LodDrawable2D, @ref BasicLodDrawable3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodDrawable2D = LodDrawable<2, T>;
+#endif
+
+/**
+@brief Level-of-detail drawable for two-dimensional float scenes
+
+@see @ref LodDrawable3D
+*/
+typedef BasicLodDrawable2D<Float> LodDrawable2D;
+
+/**
+@brief Level-of-detail drawable for three-dimensional scenes
+
+Convenience alternative to @cpp LodDrawable<3, T> @ce. See @ref LodDrawable
+for more information.
+@see @ref LodDrawable3D, @ref BasicLodDrawable2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodDrawable3D = LodDrawable<3, T>;
+#endif
+
+/**
+@brief Level-of-detail drawable for three-dimensional float scenes
+
+@see @ref LodDrawable2D
+*/
+typedef BasicLodDrawable3D<Float> LodDrawable3D;
+
+/**
+@brief Level-of-detail chain for two-dimensional scenes
+
+Convenience alternative to @cpp LodChain<2, T> @ce. See @ref LodChain for
+more information.
+@see @ref LodChain2D, @ref BasicLodChain3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodChain2D = LodChain<2, T>;
+#endif
+
+/**
+@brief Level-of-detail chain for two-dimensional float scenes
+
+@see @ref LodChain3D
+*/
+typedef BasicLodChain2D<Float> LodChain2D;
+
+/**
+@brief Level-of-detail chain for three-dimensional scenes
+
+Convenience alternative to @cpp LodChain<3, T> @ce. See @ref LodChain for
+more information.
+@see @ref LodChain3D, @ref BasicLodChain2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodChain3D = LodChain<3, T>;
+#endif
+
+/**
+@brief Level-of-detail chain for three-dimensional float scenes
+
+@see @ref LodChain2D
+*/
+typedef BasicLodChain3D<Float> LodChain3D;
+
+}}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Object.h"
+
+#include <atomic>
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+namespace {
+    /* Transformations can be changed from multiple threads, e.g. from
+       AnimableGroup::step(), so the counter has to be atomic. Zero is the
+       initial generation of all objects. */
+    std::atomic<UnsignedLong> globalObjectGeneration{0};
+}
+
+UnsignedLong objectGeneration() {
+    return globalObjectGeneration.load(std::memory_order_relaxed);
+}
+
+UnsignedLong nextObjectGeneration() {
+    return globalObjectGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+}}}
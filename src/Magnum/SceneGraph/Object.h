@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::SceneGraph::Object
  */
 
+#include <memory>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/SceneGraph/AbstractFeature.h"
@@ -47,6 +48,25 @@ namespace Implementation {
     typedef Containers::EnumSet<ObjectFlag> ObjectFlags;
 
     CORRADE_ENUMSET_OPERATORS(ObjectFlags)
+
+    /* Temporary arrays used by Object::setClean(), Object::transformations()
+       and related functions. Stored in the Scene, so their memory is reused
+       across frames instead of being allocated on every call. */
+    template<class Transformation> struct ObjectScratch {
+        std::vector<Object<Transformation>*> objects;
+        std::vector<Object<Transformation>*> path;
+        std::vector<typename Transformation::DataType> transformations;
+        std::vector<UnsignedInt> parentJoints;
+        std::vector<UnsignedInt> stack;
+    };
+
+    /* Global counter for tracking changes in object transformations. Every
+       object gets a new value from nextObjectGeneration() whenever its
+       transformation or parent changes, so a maximum of the values along the
+       path to the root changes whenever anything on the path changes and the
+       current value changes whenever anything changes anywhere. */
+    MAGNUM_SCENEGRAPH_EXPORT UnsignedLong objectGeneration();
+    MAGNUM_SCENEGRAPH_EXPORT UnsignedLong nextObjectGeneration();
 }
 
 /**
@@ -207,6 +227,18 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             return *(new T{std::forward<Args>(args)..., this});
         }
 
+        /**
+         * @brief Add a child allocated from a pool
+         *
+         * Calling `object.addChild<MyObject>(pool, args...)` is equivalent
+         * to `new(pool) MyObject{args..., &object}`. Expects that the object
+         * derives from @ref PoolAllocated, see @ref Pool for more information.
+         */
+        template<class T, class ...Args> T& addChild(Pool& pool, Args... args) {
+            static_assert(std::is_base_of<PoolAllocated, T>::value, "only types deriving from PoolAllocated can be allocated from a pool");
+            return *(new(pool) T{std::forward<Args>(args)..., this});
+        }
+
         /**
          * @brief Set parent object
          * @return Reference to self (for method chaining)
@@ -251,29 +283,75 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /**
          * @brief Transformation relative to root object
          *
+         * If @ref setAbsoluteTransformationCached() is enabled, returns a
+         * cached value, recalculating it only if transformation of the object
+         * or any of its parents changed since the last call. Otherwise the
+         * transformation is composed from transformations of all parents up
+         * to the root, using cached values of parents that have caching
+         * enabled.
          * @see @ref absoluteTransformationMatrix()
          */
         typename Transformation::DataType absoluteTransformation() const;
 
+        /**
+         * @brief Whether the absolute transformation is cached
+         *
+         * @see @ref setAbsoluteTransformationCached()
+         */
+        bool isAbsoluteTransformationCached() const {
+            return !!absoluteTransformationCache;
+        }
+
+        /**
+         * @brief Set whether the absolute transformation is cached
+         * @return Reference to self (for method chaining)
+         *
+         * Disabled by default. When enabled, @ref absoluteTransformation()
+         * and @ref absoluteTransformationMatrix() remember the calculated
+         * value and each object remembers when its transformation or parent
+         * changed last time. Repeated queries then cost @f$ \mathcal{O}(1) @f$
+         * if no transformation changed anywhere in the meantime. Otherwise
+         * the path to the root is checked for changes and only cached values
+         * that went stale are recalculated. Enabling the caching on objects
+         * higher in the hierarchy speeds up queries on all their children as
+         * well.
+         *
+         * The cache is updated during the query, so, unlike with caching
+         * disabled, absolute transformation of the same object or objects
+         * sharing a cached parent shouldn't be queried from multiple threads
+         * at once.
+         * @see @ref scenegraph-features-caching
+         */
+        Object<Transformation>& setAbsoluteTransformationCached(bool cached);
+
         /**
          * @brief Transformation matrices of given set of objects relative to this object
          *
          * All transformations are premultiplied with @p initialTransformationMatrix,
          * if specified.
-         * @see @ref transformations()
+         * @see @ref transformations(), @ref transformationMatricesInto()
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Put transformation matrices of given set of objects relative to this object into given array
+         *
+         * Like @ref transformationMatrices(), but puts the result into
+         * @p transformationMatrices, reusing its memory. Temporary memory
+         * used by the calculation is stored in the scene and reused as well,
+         * so calling this function every frame with the same array doesn't
+         * allocate once the memory grows large enough.
+         */
+        void transformationMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
          * All transformations can be premultiplied with @p initialTransformation,
          * if specified.
-         * @see @ref transformationMatrices()
+         * @see @ref transformationMatrices(), @ref transformationsInto()
          */
-        /* `objects` passed by copy intentionally (to allow move from
-           transformationMatrices() and avoid copy in the function itself) */
-        std::vector<typename Transformation::DataType> transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation =
+        std::vector<typename Transformation::DataType> transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation =
             #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
             typename Transformation::DataType()
             #else
@@ -281,6 +359,21 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             #endif
             ) const;
 
+        /**
+         * @brief Put transformations of given group of objects relative to this object into given array
+         *
+         * Like @ref transformations(), but puts the result into
+         * @p transformations, reusing its memory. See
+         * @ref transformationMatricesInto() for more information.
+         */
+        void transformationsInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<typename Transformation::DataType>& transformations, const typename Transformation::DataType& initialTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            ) const;
+
         /*@}*/
 
         /**
@@ -291,17 +384,50 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 
         /**
          * @brief Clean absolute transformations of given set of objects
+         * @param objects       Objects to clean
+         * @param threadCount   Count of threads to clean the objects on. If
+         *      set to @cpp 0 @ce, all available hardware threads are used.
          *
-         * Only dirty objects in the list are cleaned.
+         * Only dirty objects in the list are cleaned. The absolute
+         * transformations are always calculated on the calling thread, if
+         * @p threadCount is larger than @cpp 1 @ce, the objects are then
+         * divided into equally sized batches and @ref AbstractFeature::clean()
+         * / @ref AbstractFeature::cleanInverted() of features in each batch
+         * is called from a different thread. In that case the features must
+         * not access any state shared with features of other objects without
+         * synchronization. Spawning the threads has a non-negligible
+         * overhead, so it's worth doing only for large sets of objects and
+         * features with expensive cleaning.
          * @see @ref setClean()
          */
-        /* `objects` passed by copy intentionally (to avoid copy internally) */
-        static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects);
+        static void setClean(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, UnsignedInt threadCount = 1);
 
-        /** @copydoc AbstractObject::isDirty() */
-        bool isDirty() const { return !!(flags & Flag::Dirty); }
+        /**
+         * @brief Whether absolute transformation is dirty
+         *
+         * Returns @cpp true @ce if transformation of the object or any parent
+         * has changed since last call to @ref setClean(), @cpp false @ce
+         * otherwise. All objects are dirty by default. As the dirty state is
+         * stored only on the objects which were explicitly marked as dirty,
+         * the function goes up the hierarchy until it finds a dirty object or
+         * the root.
+         * @see @ref scenegraph-features-caching
+         */
+        bool isDirty() const;
 
-        /** @copydoc AbstractObject::setDirty() */
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Calls @ref AbstractFeature::markDirty() on all object features,
+         * marks the object as dirty and puts it into a list of dirty objects
+         * of its @ref Scene. The children are implicitly dirty as well, but
+         * they are not touched --- @ref AbstractFeature::markDirty() is called
+         * on their features once they get marked as dirty themselves, at the
+         * latest when their parent is cleaned without them. If the object is
+         * already marked as dirty, the function does nothing.
+         * @see @ref scenegraph-features-caching, @ref setClean(),
+         *      @ref isDirty(), @ref Scene::cleanAll()
+         */
         void setDirty();
 
         /**
@@ -312,7 +438,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          * calls @ref setClean() on every parent which is not already clean. If
          * the object is already clean, the function does nothing.
          *
-         * See also @ref setClean(std::vector<std::reference_wrapper<Object<Transformation>>>),
+         * See also @ref setClean(const std::vector<std::reference_wrapper<Object<Transformation>>>&, UnsignedInt),
          * which cleans given set of objects more efficiently than when calling
          * @ref setClean() on each object individually.
          * @see @ref scenegraph-features-caching, @ref setDirty(),
@@ -332,6 +458,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Containers::LinkedList<Object<Transformation>>;
         friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+        friend Scene<Transformation>;
         #endif
 
         Object<Transformation>* doScene() override final;
@@ -347,21 +474,59 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             return absoluteTransformationMatrix();
         }
 
-        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const override final;
-
-        typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
+        void doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const override final;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
         void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
 
+        MAGNUM_SCENEGRAPH_LOCAL Implementation::ObjectScratch<Transformation>* scratch() const;
+        bool MAGNUM_SCENEGRAPH_LOCAL transformationsInternal(Implementation::ObjectScratch<Transformation>& scratch, const typename Transformation::DataType& initialTransformation) const;
+        void MAGNUM_SCENEGRAPH_LOCAL transformationMatricesInternal(Implementation::ObjectScratch<Transformation>& scratch, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const;
+
+        template<class T> static void setCleanList(const std::vector<std::reference_wrapper<T>>& objects, UnsignedInt threadCount);
         void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
+        static void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const std::vector<Object<Transformation>*>& objects, const std::vector<typename Transformation::DataType>& transformations, UnsignedInt threadCount);
+
+        /* Called from Scene */
+        void addDirtyObject(Scene<Transformation>& scene);
+        static void cleanDirtyObjects(Scene<Transformation>& scene, UnsignedInt threadCount);
+
+        void MAGNUM_SCENEGRAPH_LOCAL removeDirtyObject(Scene<Transformation>& scene);
+        void MAGNUM_SCENEGRAPH_LOCAL removeDirtyObjects(Scene<Transformation>& scene);
+        void MAGNUM_SCENEGRAPH_LOCAL setChildrenDirty(Scene<Transformation>* scene);
+
+        UnsignedLong MAGNUM_SCENEGRAPH_LOCAL absoluteTransformationGeneration(UnsignedLong globalGeneration) const;
 
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
-        UnsignedShort counter;
+        enum: UnsignedInt {
+            NoJoint = ~UnsignedInt{},
+            ComputedJoint = ~UnsignedInt{} - 1,
+            NoDirtyIndex = ~UnsignedInt{}
+        };
+
+        /* Joint index used only inside transformations(), NoJoint otherwise */
+        UnsignedInt counter;
+        /* Position in the list of dirty objects in the scene or NoDirtyIndex
+           if the object is not there */
+        UnsignedInt dirtyIndex;
         Flags flags;
+
+        /* Value of the global generation counter at the last change of
+           transformation or parent */
+        UnsignedLong generation;
+
+        struct AbsoluteTransformationCache {
+            typename Transformation::DataType transformation;
+            /* Maximum of object generations on the path to the root at the
+               time of calculation */
+            UnsignedLong generation;
+            /* Global generation at the time of the last check */
+            UnsignedLong checkedGeneration;
+        };
+        std::unique_ptr<AbsoluteTransformationCache> absoluteTransformationCache;
 };
 
 }}
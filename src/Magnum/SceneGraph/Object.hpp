@@ -31,10 +31,12 @@
 
 #include <algorithm>
 #include <stack>
+#include <utility>
 
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/parallelImplementation.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -43,11 +45,21 @@ template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~Abstra
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(NoJoint), dirtyIndex(NoDirtyIndex), flags(Flag::Dirty), generation(0) {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    /* Destroy the children while this object is still connected to the
+       scene, so they can remove themselves from the dirty object list */
+    children().clear();
+
+    if(dirtyIndex != NoDirtyIndex) {
+        Scene<Transformation>* scene = this->scene();
+        CORRADE_INTERNAL_ASSERT(scene);
+        removeDirtyObject(*scene);
+    }
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
     Object<Transformation>* p(this);
@@ -90,13 +102,29 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
         p = p->parent();
     }
 
+    /* If the object is going to be moved to a different scene, remove it and
+       all its children from the dirty object list of the old scene */
+    Scene<Transformation>* oldScene = scene();
+    if(oldScene && (!parent || parent->scene() != oldScene))
+        removeDirtyObjects(*oldScene);
+
     /* Remove the object from old parent children list */
     if(this->parent()) this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
 
     /* Add the object to list of new parent */
     if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
 
-    setDirty();
+    /* The path to the root changed, invalidate cached absolute
+       transformations of this object and its children */
+    generation = Implementation::nextObjectGeneration();
+
+    /* Mark the object as dirty. If it was dirty already, make sure it's in
+       the dirty object list of the new scene. */
+    if(!(flags & Flag::Dirty)) setDirty();
+    else if(dirtyIndex == NoDirtyIndex) {
+        if(Scene<Transformation>* scene = this->scene()) addDirtyObject(*scene);
+    }
+
     return *this;
 }
 
@@ -112,11 +140,64 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
 }
 
 template<class Transformation> typename Transformation::DataType Object<Transformation>::absoluteTransformation() const {
+    if(absoluteTransformationCache) {
+        absoluteTransformationGeneration(Implementation::objectGeneration());
+        return absoluteTransformationCache->transformation;
+    }
+
     if(!parent()) return Transformation::transformation();
     return Implementation::Transformation<Transformation>::compose(parent()->absoluteTransformation(), Transformation::transformation());
 }
 
+template<class Transformation> UnsignedLong Object<Transformation>::absoluteTransformationGeneration(const UnsignedLong globalGeneration) const {
+    /* Nothing changed anywhere since the last check, the cached generation
+       is still the current one */
+    if(absoluteTransformationCache && absoluteTransformationCache->checkedGeneration == globalGeneration)
+        return absoluteTransformationCache->generation;
+
+    /* Go up to the root or the first cached parent that's known to be
+       up-to-date, updating cached parents on the way */
+    const Object<Transformation>* const parent = this->parent();
+    const UnsignedLong absoluteGeneration = parent ? std::max(generation, parent->absoluteTransformationGeneration(globalGeneration)) : generation;
+    if(!absoluteTransformationCache) return absoluteGeneration;
+
+    /* Recalculate only if something on the path changed. If the parent is
+       cached, it's up-to-date now, so its absoluteTransformation() returns
+       right away. */
+    AbsoluteTransformationCache& cache = *absoluteTransformationCache;
+    if(cache.generation != absoluteGeneration) {
+        cache.transformation = parent ?
+            Implementation::Transformation<Transformation>::compose(parent->absoluteTransformation(), Transformation::transformation()) :
+            Transformation::transformation();
+        cache.generation = absoluteGeneration;
+    }
+    cache.checkedGeneration = globalGeneration;
+    return absoluteGeneration;
+}
+
+template<class Transformation> Object<Transformation>& Object<Transformation>::setAbsoluteTransformationCached(const bool cached) {
+    if(!cached) absoluteTransformationCache = nullptr;
+    else if(!absoluteTransformationCache) {
+        /* Generations are never all ones, so the first query calculates the
+           value */
+        absoluteTransformationCache.reset(new AbsoluteTransformationCache{{}, ~UnsignedLong{}, ~UnsignedLong{}});
+    }
+
+    return *this;
+}
+
+template<class Transformation> bool Object<Transformation>::isDirty() const {
+    for(const Object<Transformation>* o = this; o; o = o->parent())
+        if(o->flags & Flag::Dirty) return true;
+
+    return false;
+}
+
 template<class Transformation> void Object<Transformation>::setDirty() {
+    /* Called on every transformation change, invalidate cached absolute
+       transformations even if the object is already dirty */
+    generation = Implementation::nextObjectGeneration();
+
     /* The transformation of this object (and all children) is already dirty,
        nothing to do */
     if(flags & Flag::Dirty) return;
@@ -125,69 +206,200 @@ template<class Transformation> void Object<Transformation>::setDirty() {
     for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
         feature.markDirty();
 
-    /* Make all children dirty */
-    for(Object<Transformation>& child: children())
-        child.setDirty();
-
-    /* Mark object as dirty */
+    /* Mark object as dirty and remember it in the scene. The children are
+       implicitly dirty as well, they're marked only when this object gets
+       cleaned without them. The scene list is shared, so if this is called
+       from AnimableGroup::step() on multiple threads, it's updated after all
+       threads finish. */
     flags |= Flag::Dirty;
+    if(Implementation::deferShared([](void* data) {
+        Object<Transformation>& object = *static_cast<Object<Transformation>*>(data);
+        if(Scene<Transformation>* scene = object.scene()) object.addDirtyObject(*scene);
+    }, this)) return;
+    if(Scene<Transformation>* scene = this->scene()) addDirtyObject(*scene);
 }
 
-template<class Transformation> void Object<Transformation>::setClean() {
-    /* The object (and all its parents) are already clean, nothing to do */
-    if(!(flags & Flag::Dirty)) return;
+template<class Transformation> void Object<Transformation>::setChildrenDirty(Scene<Transformation>* const scene) {
+    for(Object<Transformation>& child: children()) {
+        /* The child is going to be cleaned as well, skip */
+        if(child.flags & Flag::Visited) continue;
 
-    /* Collect all parents, compute base transformation */
-    std::stack<Object<Transformation>*> objects;
-    typename Transformation::DataType absoluteTransformation;
-    Object<Transformation>* p = static_cast<Object<Transformation>*>(this);
-    for(;;) {
-        objects.push(p);
+        if(!(child.flags & Flag::Dirty)) {
+            for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: child.features())
+                feature.markDirty();
+            child.flags |= Flag::Dirty;
+        }
 
-        p = p->parent();
+        /* The child might have been already dirty before this object got into
+           the scene, so add it to the list even if the flag was there */
+        if(scene && child.dirtyIndex == NoDirtyIndex) child.addDirtyObject(*scene);
+    }
+}
 
-        /* On root object, base transformation is identity */
-        if(!p) break;
+template<class Transformation> void Object<Transformation>::addDirtyObject(Scene<Transformation>& scene) {
+    if(dirtyIndex != NoDirtyIndex) return;
 
-        /* Parent object is clean, base transformation is its absolute
-           transformation */
-        if(!p->isDirty()) {
-            absoluteTransformation = p->absoluteTransformation();
-            break;
+    dirtyIndex = UnsignedInt(scene._dirtyObjects.size());
+    scene._dirtyObjects.push_back(this);
+}
+
+template<class Transformation> void Object<Transformation>::removeDirtyObject(Scene<Transformation>& scene) {
+    CORRADE_INTERNAL_ASSERT(dirtyIndex < scene._dirtyObjects.size() && scene._dirtyObjects[dirtyIndex] == this);
+
+    /* Move the last object in place of this one */
+    Object<Transformation>* const last = scene._dirtyObjects.back();
+    scene._dirtyObjects[dirtyIndex] = last;
+    last->dirtyIndex = dirtyIndex;
+    scene._dirtyObjects.pop_back();
+    dirtyIndex = NoDirtyIndex;
+}
+
+namespace Implementation {
+
+/* Moves scratch memory out of the scene for the lifetime of the instance and
+   puts it back on destruction. If a feature calls back into the scene graph
+   while the memory is in use (e.g. from AbstractFeature::clean()), the nested
+   call gets empty arrays instead of overwriting the ones in use. */
+template<class Transformation> class ObjectScratchGuard: public ObjectScratch<Transformation> {
+    public:
+        explicit ObjectScratchGuard(ObjectScratch<Transformation>* scratch): _scratch{scratch} {
+            if(scratch) std::swap<ObjectScratch<Transformation>>(*this, *scratch);
+            this->objects.clear();
+            this->path.clear();
+            this->transformations.clear();
+            this->parentJoints.clear();
+            this->stack.clear();
+        }
+
+        ~ObjectScratchGuard() {
+            if(_scratch) std::swap<ObjectScratch<Transformation>>(*this, *_scratch);
         }
+
+    private:
+        ObjectScratch<Transformation>* _scratch;
+};
+
+}
+
+template<class Transformation> Implementation::ObjectScratch<Transformation>* Object<Transformation>::scratch() const {
+    const Scene<Transformation>* scene = this->scene();
+    return scene ? &scene->_scratch : nullptr;
+}
+
+template<class Transformation> void Object<Transformation>::removeDirtyObjects(Scene<Transformation>& scene) {
+    if(scene._dirtyObjects.empty()) return;
+
+    Implementation::ObjectScratchGuard<Transformation> scratch{&scene._scratch};
+    scratch.path.push_back(this);
+    while(!scratch.path.empty()) {
+        Object<Transformation>* o = scratch.path.back();
+        scratch.path.pop_back();
+
+        if(o->dirtyIndex != NoDirtyIndex) o->removeDirtyObject(scene);
+        for(Object<Transformation>& child: o->children())
+            scratch.path.push_back(&child);
     }
+}
+
+template<class Transformation> void Object<Transformation>::setClean() {
+    /* Find the topmost object which is marked as dirty and the root */
+    std::size_t dirtyCount = 0;
+    std::size_t count = 0;
+    Object<Transformation>* root = nullptr;
+    for(Object<Transformation>* o = this; o; o = o->parent()) {
+        ++count;
+        if(o->flags & Flag::Dirty) dirtyCount = count;
+        root = o;
+    }
+
+    /* The object (and all its parents) are already clean, nothing to do */
+    if(!dirtyCount) return;
+
+    /* Collect all parents up to the root */
+    Scene<Transformation>* scene = root->isScene() ? static_cast<Scene<Transformation>*>(root) : nullptr;
+    Implementation::ObjectScratchGuard<Transformation> scratch{scene ? &scene->_scratch : nullptr};
+    std::vector<Object<Transformation>*>& objects = scratch.path;
+    for(Object<Transformation>* o = this; o; o = o->parent())
+        objects.push_back(o);
 
-    /* Clean features on every collected object, going down from root object */
-    while(!objects.empty()) {
-        Object<Transformation>* o = objects.top();
-        objects.pop();
+    /* Parents of the topmost dirty object are clean, base transformation is
+       their absolute transformation */
+    typename Transformation::DataType absoluteTransformation;
+    for(std::size_t i = objects.size(); i != dirtyCount; --i)
+        absoluteTransformation = Implementation::Transformation<Transformation>::compose(absoluteTransformation, objects[i - 1]->transformation());
+
+    /* Mark the objects which are going to be cleaned, so the dirty state
+       isn't propagated to them */
+    for(std::size_t i = 0; i != dirtyCount; ++i)
+        objects[i]->flags |= Flag::Visited;
+
+    /* Clean features on every collected object, going down from the topmost
+       dirty object. Children that are not cleaned are marked as dirty
+       instead. */
+    for(std::size_t i = dirtyCount; i != 0; --i) {
+        Object<Transformation>* o = objects[i - 1];
+        o->flags &= ~Flag::Visited;
+        o->setChildrenDirty(scene);
 
         /* Compose transformation and clean object */
         absoluteTransformation = Implementation::Transformation<Transformation>::compose(absoluteTransformation, o->transformation());
-        CORRADE_INTERNAL_ASSERT(o->isDirty());
         o->setCleanInternal(absoluteTransformation);
         CORRADE_ASSERT(!o->isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
     }
 }
 
-template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
-    castObjects.reserve(objects.size());
+template<class Transformation> void Object<Transformation>::doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const {
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    Implementation::ObjectScratchGuard<Transformation> scratch{this->scratch()};
     /** @todo Ensure this doesn't crash, somehow */
-    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+    for(auto o: objects) scratch.objects.push_back(&static_cast<Object<Transformation>&>(o.get()));
 
-    return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
+    transformationMatricesInternal(scratch, transformationMatrices, initialTransformationMatrix);
 }
 
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
-    std::vector<MatrixType> transformationMatrices(transformations.size());
-    for(std::size_t i = 0; i != objects.size(); ++i)
-        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
-
+    std::vector<MatrixType> transformationMatrices;
+    transformationMatricesInto(objects, transformationMatrices, initialTransformationMatrix);
     return transformationMatrices;
 }
 
+template<class Transformation> void Object<Transformation>::transformationMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const {
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    Implementation::ObjectScratchGuard<Transformation> scratch{this->scratch()};
+    for(Object<Transformation>& o: objects) scratch.objects.push_back(&o);
+
+    transformationMatricesInternal(scratch, transformationMatrices, initialTransformationMatrix);
+}
+
+template<class Transformation> void Object<Transformation>::transformationMatricesInternal(Implementation::ObjectScratch<Transformation>& scratch, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const {
+    transformationMatrices.clear();
+    if(!transformationsInternal(scratch, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix)))
+        return;
+
+    transformationMatrices.resize(scratch.transformations.size());
+    for(std::size_t i = 0; i != transformationMatrices.size(); ++i)
+        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(scratch.transformations[i]);
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation) const {
+    std::vector<typename Transformation::DataType> transformations;
+    transformationsInto(objects, transformations, initialTransformation);
+    return transformations;
+}
+
+template<class Transformation> void Object<Transformation>::transformationsInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<typename Transformation::DataType>& transformations, const typename Transformation::DataType& initialTransformation) const {
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    Implementation::ObjectScratchGuard<Transformation> scratch{this->scratch()};
+    for(Object<Transformation>& o: objects) scratch.objects.push_back(&o);
+
+    transformations.clear();
+    if(transformationsInternal(scratch, initialTransformation))
+        transformations.assign(scratch.transformations.begin(), scratch.transformations.end());
+}
+
 /*
 Computing absolute transformations for given list of objects
 
@@ -198,188 +410,281 @@ divided into two groups:
    child in the subtree
  - "non-joints", i.e. paths between joints
 
-Then for all joints their transformation (relative to parent joint) is
-computed and recursively concatenated together. Resulting transformations for
-joints which were originally in `object` list is then returned.
+Then for all joints their transformation relative to parent joint is computed
+and these are then concatenated together, going from the root. Resulting
+transformations for joints which were originally in `object` list is then
+returned.
+
+Every object is visited at most once when marking the joints and once when
+computing the relative transformations, so the whole operation is linear in
+the size of the subtree. The only per-object state are the flags and the
+joint index, anything else is in the scratch arrays.
+
+The objects are taken from `scratch.objects`, the transformations are put
+into `scratch.transformations`. Both have the same size after the function
+returns. Returns false if the objects are not part of this scene.
 */
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+template<class Transformation> bool Object<Transformation>::transformationsInternal(Implementation::ObjectScratch<Transformation>& scratch, const typename Transformation::DataType& initialTransformation) const {
+    std::vector<Object<Transformation>*>& jointObjects = scratch.objects;
 
     /* Remember object count for later */
-    std::size_t objectCount = objects.size();
+    const std::size_t objectCount = jointObjects.size();
 
     /* Mark all original objects as joints and create initial list of joints
        from them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
+    for(std::size_t i = 0; i != objectCount; ++i) {
         /* Multiple occurences of one object in the array, don't overwrite it
            with different counter */
-        if(objects[i].get().counter != 0xFFFFu) continue;
+        if(jointObjects[i]->counter != NoJoint) continue;
 
-        objects[i].get().counter = UnsignedShort(i);
-        objects[i].get().flags |= Flag::Joint;
+        jointObjects[i]->counter = UnsignedInt(i);
+        jointObjects[i]->flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
 
-    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
-    #endif
-
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
-
-    /* Mark all objects up the hierarchy as visited */
-    auto it = objects.begin();
-    while(!objects.empty()) {
-        /* Already visited, remove and continue to next (duplicate occurence) */
-        if(it->get().flags & Flag::Visited) {
-            it = objects.erase(it);
-            continue;
-        }
+    /* Mark all objects up the hierarchy as visited. Each object goes up until
+       it reaches an object that was already visited from some other object
+       (which then becomes a joint), a joint or the root. */
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        Object<Transformation>* o = jointObjects[i];
+
+        /* Already visited, nothing to do (duplicate occurence) */
+        if(o->flags & Flag::Visited) continue;
+
+        for(;;) {
+            /* Mark the object as visited */
+            o->flags |= Flag::Visited;
 
-        /* Mark the object as visited */
-        it->get().flags |= Flag::Visited;
-
-        Object<Transformation>* parent = it->get().parent();
-
-        /* If this is root object, remove from list */
-        if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
-            it = objects.erase(it);
-
-        /* Parent is an joint or already visited - remove current from list */
-        } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
-            it = objects.erase(it);
-
-            /* If not already marked as joint, mark it as such and add it to
-               list of joint objects */
-            if(!(parent->flags & Flag::Joint)) {
-                CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", {});
-                CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
-                parent->counter = UnsignedShort(jointObjects.size());
-                parent->flags |= Flag::Joint;
-                jointObjects.push_back(*parent);
+            Object<Transformation>* parent = o->parent();
+
+            /* If this is root object, done */
+            if(!parent) {
+                CORRADE_ASSERT(o == this, "SceneGraph::Object::transformations(): the objects are not part of the same tree", false);
+                break;
             }
 
-        /* Else go up the hierarchy */
-        } else *it = *parent;
+            /* Parent is a joint or already visited, done. If not already
+               marked as joint, mark it as such and add it to list of joint
+               objects. */
+            if(parent->flags & (Flag::Visited|Flag::Joint)) {
+                if(!(parent->flags & Flag::Joint)) {
+                    CORRADE_INTERNAL_ASSERT(parent->counter == NoJoint);
+                    parent->counter = UnsignedInt(jointObjects.size());
+                    parent->flags |= Flag::Joint;
+                    jointObjects.push_back(parent);
+                }
+                break;
+            }
 
-        /* Cycle if reached end */
-        if(it == objects.end()) it = objects.begin();
+            /* Else go up the hierarchy */
+            o = parent;
+        }
     }
 
-    /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+    /* Compute transformations of all joints relative to their parent joint,
+       cleaning the visited marks on the way */
+    std::vector<typename Transformation::DataType>& jointTransformations = scratch.transformations;
+    std::vector<UnsignedInt>& parentJoints = scratch.parentJoints;
+    jointTransformations.resize(jointObjects.size());
+    parentJoints.assign(jointObjects.size(), NoJoint);
+    for(std::size_t i = 0; i != jointObjects.size(); ++i) {
+        Object<Transformation>* o = jointObjects[i];
+
+        /* Second or next occurence of a duplicate object, done later */
+        if(o->counter != i) continue;
+
+        jointTransformations[i] = o->transformation();
+        for(;;) {
+            CORRADE_INTERNAL_ASSERT(o->flags & Flag::Visited);
+            o->flags &= ~Flag::Visited;
+
+            Object<Transformation>* parent = o->parent();
+
+            /* Root object, the transformation is relative to it */
+            if(!parent) {
+                CORRADE_INTERNAL_ASSERT(o->isScene());
+                break;
+            }
 
-    /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
-        computeJointTransformation(jointObjects, jointTransformations, i, initialTransformation);
+            /* Joint object, remember it */
+            if(parent->flags & Flag::Joint) {
+                parentJoints[i] = parent->counter;
+                break;
+            }
+
+            /* Else compose transformation with parent, go up the hierarchy */
+            jointTransformations[i] = Implementation::Transformation<Transformation>::compose(parent->transformation(), jointTransformations[i]);
+            o = parent;
+        }
+    }
+
+    /* Concatenate the joint transformations, going down from the root. Uses
+       an explicit stack instead of recursion, as there can be arbitrarily
+       long chains of joints. Joints that are already concatenated get their
+       parent index replaced with ComputedJoint. */
+    std::vector<UnsignedInt>& stack = scratch.stack;
+    for(std::size_t i = 0; i != jointObjects.size(); ++i) {
+        if(jointObjects[i]->counter != i) continue;
+
+        for(UnsignedInt joint = UnsignedInt(i); joint != NoJoint && parentJoints[joint] != ComputedJoint; joint = parentJoints[joint])
+            stack.push_back(joint);
+
+        while(!stack.empty()) {
+            const UnsignedInt joint = stack.back();
+            stack.pop_back();
+
+            const UnsignedInt parentJoint = parentJoints[joint];
+            jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(
+                parentJoint == NoJoint ? initialTransformation : jointTransformations[parentJoint],
+                jointTransformations[joint]);
+            parentJoints[joint] = ComputedJoint;
+        }
+    }
 
     /* Copy transformation for second or next occurences from first occurence
        of duplicate object */
     for(std::size_t i = 0; i != objectCount; ++i) {
-        if(jointObjects[i].get().counter != i)
-            jointTransformations[i] = jointTransformations[jointObjects[i].get().counter];
+        if(jointObjects[i]->counter != i)
+            jointTransformations[i] = jointTransformations[jointObjects[i]->counter];
     }
 
     /* All visited marks are now cleaned, clean joint marks and counters */
-    for(auto i: jointObjects) {
+    for(Object<Transformation>* o: jointObjects) {
         /* All not-already cleaned objects (...duplicate occurences) should
            have joint mark */
-        CORRADE_INTERNAL_ASSERT(i.get().counter == 0xFFFFu || i.get().flags & Flag::Joint);
-        i.get().flags &= ~Flag::Joint;
-        i.get().counter = 0xFFFFu;
+        CORRADE_INTERNAL_ASSERT(o->counter == NoJoint || o->flags & Flag::Joint);
+        o->flags &= ~Flag::Joint;
+        o->counter = NoJoint;
     }
 
-    /* Shrink the array to contain only transformations of requested objects and return */
+    /* Shrink the arrays to contain only the requested objects and their
+       transformations */
+    jointObjects.resize(objectCount);
     jointTransformations.resize(objectCount);
-    return jointTransformations;
+    return true;
 }
 
-template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
-    std::reference_wrapper<Object<Transformation>> o = jointObjects[joint];
-
-    /* Transformation already computed ("unvisited" by this function before
-       either due to recursion or duplicate object occurences), done */
-    if(!(o.get().flags & Flag::Visited)) return jointTransformations[joint];
-
-    /* Initialize transformation */
-    jointTransformations[joint] = o.get().transformation();
+template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) {
+    /** @todo Ensure this doesn't crash, somehow */
+    setCleanList(objects, 1);
+}
 
-    /* Go up until next joint or root */
-    for(;;) {
-        /* Clean visited mark */
-        CORRADE_INTERNAL_ASSERT(o.get().flags & Flag::Visited);
-        o.get().flags &= ~Flag::Visited;
+template<class Transformation> void Object<Transformation>::setClean(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const UnsignedInt threadCount) {
+    setCleanList(objects, threadCount);
+}
 
-        Object<Transformation>* parent = o.get().parent();
+template<class Transformation> template<class T> void Object<Transformation>::setCleanList(const std::vector<std::reference_wrapper<T>>& objects, const UnsignedInt threadCount) {
+    if(objects.empty()) return;
 
-        /* Root object, compose transformation with initial, done */
-        if(!parent) {
-            CORRADE_INTERNAL_ASSERT(o.get().isScene());
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(initialTransformation, jointTransformations[joint]));
+    /* All objects are expected to be in the same scene, use its scratch
+       memory */
+    Implementation::ObjectScratchGuard<Transformation> scratch{static_cast<Object<Transformation>&>(objects.front().get()).scratch()};
+
+    /* Go up the hierarchy from every object in the list to find out if it's
+       dirty. Add the object and all its dirty parents to the list of objects
+       to clean, marking them as visited so they aren't added more than once.
+       If the walk reaches an object that was already added, everything below
+       it is dirty as well. */
+    std::vector<Object<Transformation>*>& dirtyObjects = scratch.objects;
+    std::vector<Object<Transformation>*>& path = scratch.path;
+    for(T& object: objects) {
+        path.clear();
+        std::size_t dirtyCount = 0;
+        for(Object<Transformation>* o = &static_cast<Object<Transformation>&>(object); o; o = o->parent()) {
+            if(o->flags & Flag::Visited) {
+                dirtyCount = path.size();
+                break;
+            }
 
-        /* Joint object, compose transformation with the joint, done */
-        } else if(parent->flags & Flag::Joint) {
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(computeJointTransformation(jointObjects, jointTransformations, parent->counter, initialTransformation), jointTransformations[joint]));
+            path.push_back(o);
+            if(o->flags & Flag::Dirty) dirtyCount = path.size();
+        }
 
-        /* Else compose transformation with parent, go up the hierarchy */
-        } else {
-            jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(parent->transformation(), jointTransformations[joint]);
-            o = *parent;
+        for(std::size_t i = 0; i != dirtyCount; ++i) {
+            path[i]->flags |= Flag::Visited;
+            dirtyObjects.push_back(path[i]);
         }
     }
-}
 
-template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) {
-    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
-    castObjects.reserve(objects.size());
-    /** @todo Ensure this doesn't crash, somehow */
-    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+    /* No dirty objects, done */
+    if(dirtyObjects.empty()) return;
 
-    setClean(std::move(castObjects));
-}
+    /* Children of the objects that are not going to be cleaned are marked as
+       dirty instead. Then cleanup all marks. */
+    Scene<Transformation>* scene = dirtyObjects[0]->scene();
+    for(Object<Transformation>* o: dirtyObjects) o->setChildrenDirty(scene);
+    for(Object<Transformation>* o: dirtyObjects) o->flags &= ~Flag::Visited;
 
-template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
-    /* Remove all clean objects from the list */
-    auto firstClean = std::remove_if(objects.begin(), objects.end(), [](Object<Transformation>& o) { return !o.isDirty(); });
-    objects.erase(firstClean, objects.end());
+    CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
 
-    /* No dirty objects left, done */
-    if(objects.empty()) return;
+    /* Compute absolute transformations */
+    if(!scene->transformationsInternal(scratch, {})) return;
 
-    /* Add non-clean parents to the list. Mark each added object as visited, so
-       they aren't added more than once */
-    for(std::size_t end = objects.size(), i = 0; i != end; ++i) {
-        Object<Transformation>& o = objects[i];
-        o.flags |= Flag::Visited;
+    /* Go through all objects and clean them. Every object is in the list just
+       once and its absolute transformation is already known, so the objects
+       can be cleaned in any order and from any thread. */
+    setCleanInternal(dirtyObjects, scratch.transformations, threadCount);
+}
 
-        Object<Transformation>* parent = o.parent();
-        while(parent && !(parent->flags & Flag::Visited) && parent->isDirty()) {
-            objects.push_back(*parent);
-            parent = parent->parent();
+template<class Transformation> void Object<Transformation>::setCleanInternal(const std::vector<Object<Transformation>*>& objects, const std::vector<typename Transformation::DataType>& transformations, const UnsignedInt threadCount) {
+    struct State {
+        const std::vector<Object<Transformation>*>& objects;
+        const std::vector<typename Transformation::DataType>& transformations;
+    } state{objects, transformations};
+    Implementation::parallelFor(objects.size(), threadCount, [](void* data, std::size_t begin, std::size_t end) {
+        const State& state = *static_cast<const State*>(data);
+        for(std::size_t i = begin; i != end; ++i) {
+            state.objects[i]->setCleanInternal(state.transformations[i]);
+            /* Checking just the object itself, the parents might be cleaned
+               later or on another thread */
+            CORRADE_ASSERT(!(state.objects[i]->flags & Flag::Dirty), "SceneGraph::Object::setClean(): original implementation was not called", );
         }
-    }
+    }, &state);
+}
 
-    /* Cleanup all marks */
-    for(auto o: objects) o.get().flags &= ~Flag::Visited;
+template<class Transformation> void Object<Transformation>::cleanDirtyObjects(Scene<Transformation>& scene, const UnsignedInt threadCount) {
+    Implementation::ObjectScratchGuard<Transformation> scratch{&scene._scratch};
+
+    /* Collect all objects in subtrees of the dirty objects together with
+       their absolute transformations. The object arrays are used as a queue
+       for a breadth-first traversal of each subtree. */
+    std::vector<Object<Transformation>*>& objects = scratch.objects;
+    std::vector<typename Transformation::DataType>& transformations = scratch.transformations;
+    for(Object<Transformation>* const dirtyObject: scene._dirtyObjects) {
+        dirtyObject->dirtyIndex = NoDirtyIndex;
+
+        /* The object was cleaned in the meantime */
+        if(!(dirtyObject->flags & Flag::Dirty)) continue;
+
+        /* If any parent is dirty as well, the object will be cleaned as a
+           part of its subtree, otherwise the parent transformations are the
+           base transformation for the subtree. The topmost dirty object is
+           always in the list, so no subtree is missed. */
+        bool parentDirty = false;
+        typename Transformation::DataType absoluteTransformation = dirtyObject->transformation();
+        for(Object<Transformation>* o = dirtyObject->parent(); o; o = o->parent()) {
+            if(o->flags & Flag::Dirty) {
+                parentDirty = true;
+                break;
+            }
 
-    /* Compute absolute transformations */
-    Scene<Transformation>* scene = objects[0].get().scene();
-    CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
-    std::vector<typename Transformation::DataType> transformations(scene->transformations(objects));
+            absoluteTransformation = Implementation::Transformation<Transformation>::compose(o->transformation(), absoluteTransformation);
+        }
+        if(parentDirty) continue;
+
+        std::size_t i = objects.size();
+        objects.push_back(dirtyObject);
+        transformations.push_back(absoluteTransformation);
+        for(; i != objects.size(); ++i) {
+            for(Object<Transformation>& child: objects[i]->children()) {
+                objects.push_back(&child);
+                transformations.push_back(Implementation::Transformation<Transformation>::compose(transformations[i], child.transformation()));
+            }
+        }
+    }
 
-    /* Go through all objects and clean them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
-        /* The object might be duplicated in the list, don't clean it more than once */
-        if(!objects[i].get().isDirty()) continue;
+    scene._dirtyObjects.clear();
 
-        objects[i].get().setCleanInternal(transformations[i]);
-        CORRADE_ASSERT(!objects[i].get().isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
-    }
+    setCleanInternal(objects, transformations, threadCount);
 }
 
 template<class Transformation> void Object<Transformation>::setCleanInternal(const typename Transformation::DataType& absoluteTransformation) {
@@ -0,0 +1,105 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Pool.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+/* Block sizes are rounded up to this, which also keeps all blocks in a chunk
+   suitably aligned */
+constexpr std::size_t Granularity = alignof(std::max_align_t);
+
+struct Header {
+    Pool* pool;
+    std::size_t size;
+};
+
+constexpr std::size_t HeaderSize = (sizeof(Header) + Granularity - 1)/Granularity*Granularity;
+
+}
+
+Pool::Pool(const std::size_t chunkSize): _chunkSize{chunkSize}, _allocationCount{}, _current{}, _end{} {}
+
+Pool::~Pool() {
+    CORRADE_ASSERT(!_allocationCount,
+        "SceneGraph::Pool: destroyed with" << _allocationCount << "allocations still alive", );
+}
+
+void* Pool::allocate(std::size_t size) {
+    size = (size + Granularity - 1)/Granularity*Granularity;
+    const std::size_t index = size/Granularity;
+    ++_allocationCount;
+
+    /* Reuse a previously deallocated block of the same size */
+    if(index < _freeBlocks.size() && _freeBlocks[index]) {
+        void* const block = _freeBlocks[index];
+        _freeBlocks[index] = *static_cast<void**>(block);
+        return block;
+    }
+
+    /* Reserve a new chunk if the current one is not large enough. The
+       remainder of the previous chunk is wasted, which is not a problem as
+       long as the chunk size is considerably larger than the objects. */
+    if(std::size_t(_end - _current) < size) {
+        const std::size_t chunkSize = size > _chunkSize ? size : _chunkSize;
+        _chunks.emplace_back(new char[chunkSize]);
+        _current = _chunks.back().get();
+        _end = _current + chunkSize;
+    }
+
+    void* const block = _current;
+    _current += size;
+    return block;
+}
+
+void Pool::deallocate(void* const data, std::size_t size) {
+    size = (size + Granularity - 1)/Granularity*Granularity;
+    const std::size_t index = size/Granularity;
+    --_allocationCount;
+
+    if(index >= _freeBlocks.size()) _freeBlocks.resize(index + 1);
+    *static_cast<void**>(data) = _freeBlocks[index];
+    _freeBlocks[index] = data;
+}
+
+void* PoolAllocated::allocate(const std::size_t size, Pool* const pool) {
+    void* const block = pool ? pool->allocate(HeaderSize + size) : ::operator new(HeaderSize + size);
+    *static_cast<Header*>(block) = Header{pool, HeaderSize + size};
+    return static_cast<char*>(block) + HeaderSize;
+}
+
+void PoolAllocated::deallocate(void* const data) {
+    if(!data) return;
+
+    Header* const header = reinterpret_cast<Header*>(static_cast<char*>(data) - HeaderSize);
+    if(header->pool) header->pool->deallocate(header, header->size);
+    else ::operator delete(header);
+}
+
+}}
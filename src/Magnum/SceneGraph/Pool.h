@@ -0,0 +1,222 @@
+#ifndef Magnum_SceneGraph_Pool_h
+#define Magnum_SceneGraph_Pool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::Pool, @ref Magnum::SceneGraph::PoolAllocated, @ref Magnum::SceneGraph::Pooled
+ */
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Memory pool for objects and features
+
+Every object and feature is by default a separate heap allocation. When
+creating and destroying large amounts of them, for example when loading and
+unloading a level, the allocator overhead adds up and the memory gets
+fragmented. Objects and features can be instead allocated from a pool, which
+reserves memory in large chunks and reuses memory of destroyed objects for
+new ones.
+
+Pool allocation is opt-in for each type. Either derive your object or feature
+from @ref PoolAllocated in addition to its base, or wrap an existing type in
+@ref Pooled:
+
+@code{.cpp}
+class MyDrawable: public SceneGraph::Drawable3D, public SceneGraph::PoolAllocated {
+    // ...
+};
+
+typedef SceneGraph::Pooled<Object3D> PooledObject3D;
+
+SceneGraph::Pool pool;
+Scene3D scene;
+
+PooledObject3D& object = scene.addChild<PooledObject3D>(pool);
+MyDrawable& drawable = object.addFeature<MyDrawable>(pool, drawables);
+@endcode
+
+The above is equivalent to `new(pool) PooledObject3D{&scene}` and
+`new(pool) MyDrawable{object, drawables}`. The objects and features are
+destroyed the same way as heap-allocated ones --- either explicitly using
+@cpp delete @ce or together with their parent --- and there's no difference
+in their behavior. Destroying a pool-allocated subtree puts its memory back to
+the pool, where it's reused by objects of the same size. The memory itself is
+released all at once when the pool is destroyed. Pool-allocated and
+heap-allocated objects can be freely mixed in the same hierarchy. Types that
+don't derive from @ref PoolAllocated are allocated the usual way, without any
+overhead.
+
+@attention All objects and features allocated from a pool have to be
+    destroyed before the pool itself, otherwise the behavior is undefined.
+    The easiest way to ensure that is declaring the pool *before* the scene,
+    as shown above.
+
+The pool is not thread-safe, objects and features using the same pool
+shouldn't be created or destroyed from multiple threads at once.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT Pool {
+    public:
+        /**
+         * @brief Constructor
+         * @param chunkSize     Size of memory chunks reserved from the heap
+         *
+         * No memory is reserved until the first allocation.
+         */
+        explicit Pool(std::size_t chunkSize = 65536);
+
+        /** @brief Copying is not allowed */
+        Pool(const Pool&) = delete;
+
+        /** @brief Moving is not allowed */
+        Pool(Pool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Releases all reserved memory. Expects that there are no
+         * allocations left, i.e. that all objects and features allocated
+         * from this pool were already destroyed.
+         */
+        ~Pool();
+
+        /** @brief Copying is not allowed */
+        Pool& operator=(const Pool&) = delete;
+
+        /** @brief Moving is not allowed */
+        Pool& operator=(Pool&&) = delete;
+
+        /** @brief Size of reserved memory chunks */
+        std::size_t chunkSize() const { return _chunkSize; }
+
+        /** @brief Count of memory chunks reserved from the heap */
+        std::size_t chunkCount() const { return _chunks.size(); }
+
+        /** @brief Count of allocations that weren't deallocated yet */
+        std::size_t allocationCount() const { return _allocationCount; }
+
+        /**
+         * @brief Allocate memory
+         *
+         * Returns memory of at least @p size bytes, aligned for any scalar
+         * type. Memory previously deallocated with the same rounded-up size
+         * is reused, otherwise the memory is taken from the last reserved
+         * chunk, reserving a new one if it's not large enough. You don't
+         * need to call this function directly, use @ref Object::addChild(),
+         * @ref AbstractObject::addFeature() or the
+         * @cpp new(pool) @ce expression instead.
+         * @see @ref deallocate()
+         */
+        void* allocate(std::size_t size);
+
+        /**
+         * @brief Deallocate memory
+         *
+         * The @p data are expected to be allocated using @ref allocate() with
+         * the same @p size.
+         */
+        void deallocate(void* data, std::size_t size);
+
+    private:
+        std::size_t _chunkSize, _allocationCount;
+        char* _current;
+        char* _end;
+        /* Heads of intrusive lists of free blocks, indexed by block size
+           divided by granularity */
+        std::vector<void*> _freeBlocks;
+        std::vector<std::unique_ptr<char[]>> _chunks;
+};
+
+/**
+@brief Base for pool-allocated objects and features
+
+Provides class-specific @cpp operator new @ce and @cpp operator delete @ce
+allowing the type to be created with `new(pool)`, see @ref Pool for an
+example. Each allocation is prefixed with a small header remembering the pool
+it came from, so the @cpp delete @ce done by the parent object returns the
+memory to the right place. That works also when deleting through a base
+pointer, as the base destructors are virtual. A type that's both an object
+and a feature should derive from this class only once.
+
+Instances of a type deriving from this class can be also created with plain
+@cpp new @ce, in which case the memory is taken from the heap. Placement
+@cpp new @ce works as well, but such instances can't be destroyed using
+@cpp delete @ce.
+@see @ref Pooled
+*/
+class MAGNUM_SCENEGRAPH_EXPORT PoolAllocated {
+    public:
+        /** @brief Allocate on the heap */
+        static void* operator new(std::size_t size) { return allocate(size, nullptr); }
+
+        /** @brief Allocate from a pool */
+        static void* operator new(std::size_t size, Pool& pool) { return allocate(size, &pool); }
+
+        /** @brief Placement new */
+        static void* operator new(std::size_t, void* data) { return data; }
+
+        /** @brief Deallocate */
+        static void operator delete(void* data) { deallocate(data); }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Called only if a constructor throws */
+        static void operator delete(void* data, Pool&) { deallocate(data); }
+        static void operator delete(void*, void*) {}
+        #endif
+
+    protected:
+        /* Not meant to be used standalone */
+        PoolAllocated() = default;
+
+    private:
+        static void* allocate(std::size_t size, Pool* pool);
+        static void deallocate(void* data);
+};
+
+/**
+@brief Pool-allocated variant of an existing object or feature type
+
+Derives from @p T and @ref PoolAllocated, forwarding all constructor
+arguments to @p T. Useful for types that are not subclassed otherwise, such
+as @ref Object3D. See @ref Pool for an example.
+*/
+template<class T> class Pooled: public T, public PoolAllocated {
+    public:
+        /** @brief Constructor */
+        template<class ...Args> explicit Pooled(Args&&... args): T{std::forward<Args>(args)...} {}
+};
+
+}}
+
+#endif
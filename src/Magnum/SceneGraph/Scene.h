@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Scene
  */
 
+#include <vector>
+
 #include "Magnum/SceneGraph/Object.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -38,13 +40,59 @@ namespace Magnum { namespace SceneGraph {
 
 Basically @ref Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+@section SceneGraph-Scene-dirty Dirty objects
+
+The scene keeps a list of objects that were explicitly marked as dirty using
+@ref Object::setDirty() (or implicitly by changing their transformation or
+parent). Marking an object as dirty thus doesn't need to go through all its
+children and @ref cleanAll() cleans all dirty objects in the scene in a single
+pass, going only through the subtrees that actually need to be cleaned.
 */
 template<class Transformation> class Scene: public Object<Transformation> {
     public:
-        explicit Scene() = default;
+        explicit Scene() {
+            Object<Transformation>::addDirtyObject(*this);
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all objects in the scene.
+         */
+        ~Scene() {
+            /* Destroy the children while the scene still exists, so they
+               can remove themselves from the dirty object list */
+            this->children().clear();
+            this->dirtyIndex = Object<Transformation>::NoDirtyIndex;
+        }
+
+        /**
+         * @brief Clean all dirty objects in the scene
+         * @param threadCount   Count of threads to clean the objects on. If
+         *      set to @cpp 0 @ce, all available hardware threads are used.
+         *
+         * Goes through the list of objects marked as dirty and cleans them
+         * together with all their children. Equivalent to calling
+         * @ref Object::setClean(const std::vector<std::reference_wrapper<Object<Transformation>>>&, UnsignedInt)
+         * with a list of all objects in the scene, but without the need to
+         * have such list and going only through the dirty subtrees. See its
+         * documentation for more information about cleaning on multiple
+         * threads.
+         * @see @ref Object::setDirty(), @ref Object::isDirty()
+         */
+        void cleanAll(UnsignedInt threadCount = 1) {
+            Object<Transformation>::cleanDirtyObjects(*this, threadCount);
+        }
 
     private:
+        friend Object<Transformation>;
+
         bool isScene() const override final { return true; }
+
+        std::vector<Object<Transformation>*> _dirtyObjects;
+        /* Mutable because it's used also by const Object::transformations() */
+        mutable Implementation::ObjectScratch<Transformation> _scratch;
 };
 
 }}
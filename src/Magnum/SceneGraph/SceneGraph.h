@@ -100,6 +100,8 @@ template<class T> using BasicCamera3D = Camera<3, T>;
 typedef BasicCamera2D<Float> Camera2D;
 typedef BasicCamera3D<Float> Camera3D;
 
+enum class BoundingVolume: UnsignedByte;
+enum class DrawOrder: UnsignedByte;
 template<UnsignedInt, class> class Drawable;
 template<class T> using BasicDrawable2D = Drawable<2, T>;
 template<class T> using BasicDrawable3D = Drawable<3, T>;
@@ -123,6 +125,42 @@ template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
 typedef BasicDrawableGroup2D<Float> DrawableGroup2D;
 typedef BasicDrawableGroup3D<Float> DrawableGroup3D;
 
+template<UnsignedInt, class> class FlatObject;
+template<class T> using BasicFlatObject2D = FlatObject<2, T>;
+template<class T> using BasicFlatObject3D = FlatObject<3, T>;
+typedef BasicFlatObject2D<Float> FlatObject2D;
+typedef BasicFlatObject3D<Float> FlatObject3D;
+
+template<UnsignedInt, class> class FlatScene;
+template<class T> using BasicFlatScene2D = FlatScene<2, T>;
+template<class T> using BasicFlatScene3D = FlatScene<3, T>;
+typedef BasicFlatScene2D<Float> FlatScene2D;
+typedef BasicFlatScene3D<Float> FlatScene3D;
+
+template<UnsignedInt, class> class InstancedDrawable;
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+
+template<UnsignedInt, class> class InstancedDrawableBatch;
+template<class T> using BasicInstancedDrawableBatch2D = InstancedDrawableBatch<2, T>;
+template<class T> using BasicInstancedDrawableBatch3D = InstancedDrawableBatch<3, T>;
+typedef BasicInstancedDrawableBatch2D<Float> InstancedDrawableBatch2D;
+typedef BasicInstancedDrawableBatch3D<Float> InstancedDrawableBatch3D;
+
+template<UnsignedInt, class> class LodChain;
+template<class T> using BasicLodChain2D = LodChain<2, T>;
+template<class T> using BasicLodChain3D = LodChain<3, T>;
+typedef BasicLodChain2D<Float> LodChain2D;
+typedef BasicLodChain3D<Float> LodChain3D;
+
+template<UnsignedInt, class> class LodDrawable;
+template<class T> using BasicLodDrawable2D = LodDrawable<2, T>;
+template<class T> using BasicLodDrawable3D = LodDrawable<3, T>;
+typedef BasicLodDrawable2D<Float> LodDrawable2D;
+typedef BasicLodDrawable3D<Float> LodDrawable3D;
+
 template<class> class BasicMatrixTransformation2D;
 template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
@@ -130,6 +168,10 @@ typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
 
+class Pool;
+class PoolAllocated;
+template<class> class Pooled;
+
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
 typedef BasicRigidMatrixTransformation2D<Float> RigidMatrixTransformation2D;
@@ -137,6 +179,27 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<UnsignedInt, class> class SpatialBounds;
+template<class T> using BasicSpatialBounds2D = SpatialBounds<2, T>;
+template<class T> using BasicSpatialBounds3D = SpatialBounds<3, T>;
+typedef BasicSpatialBounds2D<Float> SpatialBounds2D;
+typedef BasicSpatialBounds3D<Float> SpatialBounds3D;
+
+template<UnsignedInt, class> class SpatialIndex;
+template<class T> using BasicSpatialIndex2D = SpatialIndex<2, T>;
+template<class T> using BasicSpatialIndex3D = SpatialIndex<3, T>;
+typedef BasicSpatialIndex2D<Float> SpatialIndex2D;
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
+enum class Interpolation: UnsignedByte;
+template<class> class Track;
+
+template<UnsignedInt, class> class TrackPlayer;
+template<class T> using BasicTrackPlayer2D = TrackPlayer<2, T>;
+template<class T> using BasicTrackPlayer3D = TrackPlayer<3, T>;
+typedef BasicTrackPlayer2D<Float> TrackPlayer2D;
+typedef BasicTrackPlayer3D<Float> TrackPlayer3D;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
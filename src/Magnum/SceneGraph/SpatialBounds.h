@@ -0,0 +1,185 @@
+#ifndef Magnum_SceneGraph_SpatialBounds_h
+#define Magnum_SceneGraph_SpatialBounds_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SpatialBounds, alias @ref Magnum::SceneGraph::BasicSpatialBounds2D, @ref Magnum::SceneGraph::BasicSpatialBounds3D, typedef @ref Magnum::SceneGraph::SpatialBounds2D, @ref Magnum::SceneGraph::SpatialBounds3D
+ */
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Spatial bounds
+
+Adds an axis-aligned bounding box to an object and puts the object into a
+@ref SpatialIndex, which can then efficiently answer which objects are inside
+a box, near a point, inside a view frustum or hit by a ray.
+
+@section SceneGraph-SpatialBounds-usage Usage
+
+Add the feature with a box enclosing the object in object-local coordinates
+to objects that should be indexed:
+
+@code{.cpp}
+Scene3D scene;
+SceneGraph::SpatialIndex3D index{{Vector3{-1000.0f}, Vector3{1000.0f}}};
+
+Object3D* object = new Object3D{&scene};
+new SceneGraph::SpatialBounds3D{*object, {Vector3{-0.5f}, Vector3{0.5f}}, &index};
+@endcode
+
+The index is updated incrementally. The absolute bounds are recalculated when
+the object transformation gets cleaned, so the easiest is to call
+@ref Scene::cleanAll() once per frame before querying the index. Otherwise
+@ref SpatialIndex::update(), which is called implicitly by all queries,
+updates objects that were transformed (directly or through any of their
+parents), newly added or had their bounds changed.
+
+@section SceneGraph-SpatialBounds-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref SpatialBounds.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref SpatialBounds2D, @ref SpatialIndex2D
+-   @ref SpatialBounds3D, @ref SpatialIndex3D
+
+@see @ref scenegraph, @ref BasicSpatialBounds2D, @ref BasicSpatialBounds3D,
+    @ref SpatialBounds2D, @ref SpatialBounds3D, @ref SpatialIndex
+*/
+template<UnsignedInt dimensions, class T> class SpatialBounds: public AbstractGroupedFeature<dimensions, SpatialBounds<dimensions, T>, T> {
+    friend SpatialIndex<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this feature belongs to
+         * @param bounds    Bounding box in object-local coordinates
+         * @param index     Spatial index this feature belongs to
+         *
+         * Adds the feature to the object and also to the index, if
+         * specified. Otherwise you can use @ref SpatialIndex::add().
+         */
+        explicit SpatialBounds(AbstractObject<dimensions, T>& object, const Math::Range<dimensions, T>& bounds, SpatialIndex<dimensions, T>* index = nullptr);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the feature from the index, if it belongs to any.
+         */
+        ~SpatialBounds();
+
+        /**
+         * @brief Spatial index containing this feature
+         *
+         * If the feature doesn't belong to any index, returns `nullptr`.
+         */
+        SpatialIndex<dimensions, T>* spatialIndex();
+
+        /** @overload */
+        const SpatialIndex<dimensions, T>* spatialIndex() const;
+
+        /** @brief Bounding box in object-local coordinates */
+        Math::Range<dimensions, T> bounds() const { return _bounds; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The box is in object-local coordinates. The absolute bounds get
+         * updated on next @ref SpatialIndex::update().
+         */
+        SpatialBounds<dimensions, T>& setBounds(const Math::Range<dimensions, T>& bounds);
+
+        /**
+         * @brief Absolute bounding box
+         *
+         * Axis-aligned box enclosing @ref bounds() transformed with absolute
+         * object transformation, as of the last update. Before the first
+         * update the value is undefined.
+         */
+        Math::Range<dimensions, T> absoluteBounds() const { return _absoluteBounds; }
+
+    private:
+        void markDirty() override;
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+        Math::Range<dimensions, T> _bounds, _absoluteBounds;
+
+        /* Node of the index this feature is in and position in its feature
+           list, position in the list of features waiting for an update */
+        UnsignedInt _node, _nodeIndex, _pendingIndex;
+};
+
+/**
+@brief Spatial bounds for two-dimensional scenes
+
+Convenience alternative to @cpp SpatialBounds<2, T> @ce. See
+@ref SpatialBounds for more information.
+@see @ref SpatialBounds2D, @ref BasicSpatialBounds3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialBounds2D = SpatialBounds<2, T>;
+#endif
+
+/**
+@brief Spatial bounds for two-dimensional float scenes
+
+@see @ref SpatialBounds3D
+*/
+typedef BasicSpatialBounds2D<Float> SpatialBounds2D;
+
+/**
+@brief Spatial bounds for three-dimensional scenes
+
+Convenience alternative to @cpp SpatialBounds<3, T> @ce. See
+@ref SpatialBounds for more information.
+@see @ref SpatialBounds3D, @ref BasicSpatialBounds2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialBounds3D = SpatialBounds<3, T>;
+#endif
+
+/**
+@brief Spatial bounds for three-dimensional float scenes
+
+@see @ref SpatialBounds2D
+*/
+typedef BasicSpatialBounds3D<Float> SpatialBounds3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialBounds<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialBounds<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,359 @@
+#ifndef Magnum_SceneGraph_SpatialBounds_hpp
+#define Magnum_SceneGraph_SpatialBounds_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref SpatialBounds.h and @ref SpatialIndex.h
+ */
+
+#include <algorithm>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/SpatialBounds.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+#include "Magnum/SceneGraph/boundsImplementation.h"
+#include "Magnum/SceneGraph/parallelImplementation.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> SpatialBounds<dimensions, T>::SpatialBounds(AbstractObject<dimensions, T>& object, const Math::Range<dimensions, T>& bounds, SpatialIndex<dimensions, T>* index): AbstractGroupedFeature<dimensions, SpatialBounds<dimensions, T>, T>{object}, _bounds{bounds}, _node{SpatialIndex<dimensions, T>::NoIndex}, _nodeIndex{}, _pendingIndex{SpatialIndex<dimensions, T>::NoIndex} {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+    if(index) index->add(*this);
+}
+
+template<UnsignedInt dimensions, class T> SpatialBounds<dimensions, T>::~SpatialBounds() {
+    if(SpatialIndex<dimensions, T>* index = spatialIndex()) index->detach(*this);
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>* SpatialBounds<dimensions, T>::spatialIndex() {
+    return static_cast<SpatialIndex<dimensions, T>*>(AbstractGroupedFeature<dimensions, SpatialBounds<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> const SpatialIndex<dimensions, T>* SpatialBounds<dimensions, T>::spatialIndex() const {
+    return static_cast<const SpatialIndex<dimensions, T>*>(AbstractGroupedFeature<dimensions, SpatialBounds<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> SpatialBounds<dimensions, T>& SpatialBounds<dimensions, T>::setBounds(const Math::Range<dimensions, T>& bounds) {
+    _bounds = bounds;
+    if(SpatialIndex<dimensions, T>* index = spatialIndex()) index->enqueue(*this);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialBounds<dimensions, T>::markDirty() {
+    if(SpatialIndex<dimensions, T>* index = spatialIndex()) index->enqueue(*this);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialBounds<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    /* The bounds can be calculated in parallel, only the tree update needs
+       to be serialized */
+    _absoluteBounds = Implementation::transformedBoundingBox<dimensions, T>(absoluteTransformationMatrix, _bounds);
+
+    if(SpatialIndex<dimensions, T>* index = spatialIndex()) {
+        std::lock_guard<std::mutex> lock{index->_mutex};
+        index->place(*this);
+    }
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>::SpatialIndex(const Math::Range<dimensions, T>& bounds, const UnsignedInt maxDepth): _maxDepth{maxDepth}, _generation{Implementation::objectGeneration()} {
+    _nodes.push_back({bounds.center(), bounds.size()/T(2), NoIndex, 0, 0, {}});
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>::~SpatialIndex() {
+    /* The features are removed from the group in the base destructor, reset
+       their indices so they don't try to detach themselves later */
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        SpatialBounds<dimensions, T>& feature = (*this)[i];
+        feature._node = NoIndex;
+        feature._pendingIndex = NoIndex;
+    }
+}
+
+template<UnsignedInt dimensions, class T> Math::Range<dimensions, T> SpatialIndex<dimensions, T>::bounds() const {
+    return {_nodes[0].center - _nodes[0].halfSize, _nodes[0].center + _nodes[0].halfSize};
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>& SpatialIndex<dimensions, T>::add(SpatialBounds<dimensions, T>& feature) {
+    /* FeatureGroup::add() would remove the feature only from the group and
+       not from the tree */
+    if(SpatialIndex<dimensions, T>* previous = feature.spatialIndex())
+        previous->detach(feature);
+
+    FeatureGroup<dimensions, SpatialBounds<dimensions, T>, T>::add(feature);
+    enqueue(feature);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>& SpatialIndex<dimensions, T>::remove(SpatialBounds<dimensions, T>& feature) {
+    CORRADE_ASSERT(feature.spatialIndex() == this,
+        "SceneGraph::SpatialIndex::remove(): feature is not part of this index", *this);
+
+    detach(feature);
+    FeatureGroup<dimensions, SpatialBounds<dimensions, T>, T>::remove(feature);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::update() {
+    /* Transforming an object marks only its own features as dirty, features
+       of its children are marked only once the object gets cleaned. If any
+       object was transformed since the last update, put features of all
+       objects that are dirty because of their parents to the pending list as
+       well. If nothing was transformed, there's nothing else to update. */
+    const UnsignedLong generation = Implementation::objectGeneration();
+    if(generation != _generation) {
+        _generation = generation;
+        for(std::size_t i = 0; i != this->size(); ++i) {
+            SpatialBounds<dimensions, T>& feature = (*this)[i];
+            if(feature._pendingIndex == NoIndex && feature.object().isDirty())
+                enqueue(feature);
+        }
+    }
+
+    while(!_pending.empty()) {
+        SpatialBounds<dimensions, T>& feature = *_pending.back();
+        AbstractObject<dimensions, T>& object = feature.object();
+
+        /* Cleaning the object calls SpatialBounds::clean(), which places the
+           feature into the tree. Children of the object get marked as dirty
+           and thus added to the pending list, so they're updated as well. */
+        if(object.isDirty()) object.setClean();
+
+        /* The object was already clean (or the feature doesn't cache the
+           absolute transformation anymore), calculate the bounds from
+           scratch */
+        if(feature._pendingIndex != NoIndex) {
+            feature._absoluteBounds = Implementation::transformedBoundingBox<dimensions, T>(object.absoluteTransformationMatrix(), feature._bounds);
+            place(feature);
+        }
+    }
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt SpatialIndex<dimensions, T>::nodeFor(const Math::Range<dimensions, T>& bounds) {
+    const VectorTypeFor<dimensions, T> center = bounds.center();
+    const VectorTypeFor<dimensions, T> size = bounds.size();
+
+    /* Features outside of the tree stay in the root, which is always
+       visited. Written in a way that puts NaNs there as well. */
+    if(!(Math::abs(center - _nodes[0].center) <= _nodes[0].halfSize).all())
+        return 0;
+
+    UnsignedInt node = 0;
+    for(UnsignedInt depth = 0; depth != _maxDepth; ++depth) {
+        /* Feature is put into the child containing its center, so it has to
+           fit into the loose bounds of the child, which are as large as this
+           node */
+        const VectorTypeFor<dimensions, T> nodeCenter = _nodes[node].center;
+        const VectorTypeFor<dimensions, T> childHalfSize = _nodes[node].halfSize/T(2);
+        if(!(size <= _nodes[node].halfSize).all()) break;
+
+        /* Create the children on first use. Not holding a reference to the
+           node, as the array gets reallocated. */
+        if(!_nodes[node].firstChild) {
+            const UnsignedInt firstChild = UnsignedInt(_nodes.size());
+            _nodes[node].firstChild = firstChild;
+            for(UnsignedInt i = 0; i != 1 << dimensions; ++i) {
+                VectorTypeFor<dimensions, T> childCenter = nodeCenter;
+                for(UnsignedInt j = 0; j != dimensions; ++j)
+                    childCenter[j] += (i & (1 << j)) ? childHalfSize[j] : -childHalfSize[j];
+                _nodes.push_back({childCenter, childHalfSize, node, 0, 0, {}});
+            }
+        }
+
+        UnsignedInt child = 0;
+        for(UnsignedInt j = 0; j != dimensions; ++j)
+            if(center[j] >= nodeCenter[j]) child |= 1 << j;
+        node = _nodes[node].firstChild + child;
+    }
+
+    return node;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::place(SpatialBounds<dimensions, T>& feature) {
+    if(feature._pendingIndex != NoIndex) dequeue(feature);
+
+    /* Move the feature only if it doesn't belong to its node anymore */
+    const UnsignedInt node = nodeFor(feature._absoluteBounds);
+    if(node == feature._node) return;
+
+    if(feature._node != NoIndex) erase(feature);
+    insert(feature, node);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::insert(SpatialBounds<dimensions, T>& feature, const UnsignedInt node) {
+    feature._node = node;
+    feature._nodeIndex = UnsignedInt(_nodes[node].features.size());
+    _nodes[node].features.push_back(&feature);
+    for(UnsignedInt n = node; n != NoIndex; n = _nodes[n].parent)
+        ++_nodes[n].count;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::erase(SpatialBounds<dimensions, T>& feature) {
+    std::vector<SpatialBounds<dimensions, T>*>& features = _nodes[feature._node].features;
+
+    /* Move the last feature in place of this one */
+    SpatialBounds<dimensions, T>* const last = features.back();
+    features[feature._nodeIndex] = last;
+    last->_nodeIndex = feature._nodeIndex;
+    features.pop_back();
+
+    for(UnsignedInt n = feature._node; n != NoIndex; n = _nodes[n].parent)
+        --_nodes[n].count;
+    feature._node = NoIndex;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::enqueue(SpatialBounds<dimensions, T>& feature) {
+    if(feature._pendingIndex != NoIndex) return;
+
+    /* If the object is transformed from AnimableGroup::step() on multiple
+       threads, the queue is updated after all threads finish */
+    if(Implementation::deferShared([](void* data) {
+        SpatialBounds<dimensions, T>& feature = *static_cast<SpatialBounds<dimensions, T>*>(data);
+        if(SpatialIndex<dimensions, T>* index = feature.spatialIndex()) index->enqueue(feature);
+    }, &feature)) return;
+
+    feature._pendingIndex = UnsignedInt(_pending.size());
+    _pending.push_back(&feature);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::dequeue(SpatialBounds<dimensions, T>& feature) {
+    /* Move the last feature in place of this one */
+    SpatialBounds<dimensions, T>* const last = _pending.back();
+    _pending[feature._pendingIndex] = last;
+    last->_pendingIndex = feature._pendingIndex;
+    _pending.pop_back();
+    feature._pendingIndex = NoIndex;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::detach(SpatialBounds<dimensions, T>& feature) {
+    if(feature._node != NoIndex) erase(feature);
+    if(feature._pendingIndex != NoIndex) dequeue(feature);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::queryInto(const Intersects intersects, const void* const state, const bool sortByDistance, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out) {
+    update();
+
+    out.clear();
+    _hits.clear();
+    _stack.clear();
+
+    /* The root is always visited, as it contains also features that are
+       outside of the tree */
+    if(_nodes[0].count) _stack.push_back(0);
+    while(!_stack.empty()) {
+        const Implementation::SpatialIndexNode<dimensions, T>& node = _nodes[_stack.back()];
+        _stack.pop_back();
+
+        for(SpatialBounds<dimensions, T>* const feature: node.features) {
+            const T distance = intersects(feature->_absoluteBounds, state);
+            if(distance == Math::Constants<T>::inf()) continue;
+
+            if(sortByDistance) _hits.emplace_back(distance, feature);
+            else out.push_back(*feature);
+        }
+
+        if(!node.firstChild) continue;
+
+        /* Visit only non-empty children whose loose bounds intersect */
+        for(UnsignedInt i = 0; i != 1 << dimensions; ++i) {
+            const Implementation::SpatialIndexNode<dimensions, T>& child = _nodes[node.firstChild + i];
+            if(!child.count) continue;
+
+            const VectorTypeFor<dimensions, T> looseHalfSize = child.halfSize*T(2);
+            if(intersects({child.center - looseHalfSize, child.center + looseHalfSize}, state) == Math::Constants<T>::inf())
+                continue;
+
+            _stack.push_back(node.firstChild + i);
+        }
+    }
+
+    if(!sortByDistance) return;
+
+    std::sort(_hits.begin(), _hits.end(), [](const std::pair<T, SpatialBounds<dimensions, T>*>& a, const std::pair<T, SpatialBounds<dimensions, T>*>& b) {
+        return a.first < b.first;
+    });
+    out.reserve(_hits.size());
+    for(const std::pair<T, SpatialBounds<dimensions, T>*>& hit: _hits)
+        out.push_back(*hit.second);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::boxQueryInto(const Math::Range<dimensions, T>& box, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out) {
+    queryInto([](const Math::Range<dimensions, T>& bounds, const void* state) {
+        const Math::Range<dimensions, T>& box = *static_cast<const Math::Range<dimensions, T>*>(state);
+        return (bounds.min() <= box.max()).all() && (box.min() <= bounds.max()).all() ? T(0) : Math::Constants<T>::inf();
+    }, &box, false, out);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::sphereQueryInto(const VectorTypeFor<dimensions, T>& center, const T radius, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out) {
+    struct Sphere {
+        VectorTypeFor<dimensions, T> center;
+        T radiusSquared;
+    } sphere{center, radius*radius};
+
+    queryInto([](const Math::Range<dimensions, T>& bounds, const void* state) {
+        const Sphere& sphere = *static_cast<const Sphere*>(state);
+
+        /* Squared distance of the center to the nearest point of the box */
+        const VectorTypeFor<dimensions, T> distance = Math::max(Math::max(bounds.min() - sphere.center, sphere.center - bounds.max()), VectorTypeFor<dimensions, T>{T(0)});
+        return distance.dot() <= sphere.radiusSquared ? T(0) : Math::Constants<T>::inf();
+    }, &sphere, false, out);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::rayQueryInto(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out, const T maxDistance) {
+    struct Ray {
+        VectorTypeFor<dimensions, T> origin, direction;
+        T maxDistance;
+    } ray{origin, direction, maxDistance};
+
+    queryInto([](const Math::Range<dimensions, T>& bounds, const void* state) {
+        const Ray& ray = *static_cast<const Ray*>(state);
+
+        /* Intersect the ray with slabs of all dimensions, the ray enters the
+           box after entering all slabs and leaves it after leaving any slab */
+        T near{0};
+        T far = ray.maxDistance;
+        for(UnsignedInt i = 0; i != dimensions; ++i) {
+            if(ray.direction[i] == T(0)) {
+                if(ray.origin[i] < bounds.min()[i] || ray.origin[i] > bounds.max()[i])
+                    return Math::Constants<T>::inf();
+                continue;
+            }
+
+            T a = (bounds.min()[i] - ray.origin[i])/ray.direction[i];
+            T b = (bounds.max()[i] - ray.origin[i])/ray.direction[i];
+            if(a > b) std::swap(a, b);
+            near = Math::max(near, a);
+            far = Math::min(far, b);
+            if(near > far) return Math::Constants<T>::inf();
+        }
+
+        return near;
+    }, &ray, true, out);
+}
+
+}}
+
+#endif
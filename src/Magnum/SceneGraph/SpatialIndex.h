@@ -0,0 +1,304 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_h
+#define Magnum_SceneGraph_SpatialIndex_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SpatialIndex, alias @ref Magnum::SceneGraph::BasicSpatialIndex2D, @ref Magnum::SceneGraph::BasicSpatialIndex3D, typedef @ref Magnum::SceneGraph::SpatialIndex2D, @ref Magnum::SceneGraph::SpatialIndex3D
+ */
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/SpatialBounds.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    template<UnsignedInt dimensions, class T> struct SpatialIndexNode {
+        /* Center and half size of the node. Features are put into the node
+           containing their center, so the loose bounds of the node are twice
+           as large as the node itself. */
+        VectorTypeFor<dimensions, T> center, halfSize;
+
+        /* Index of the parent and of the first of 2^dimensions consecutive
+           children, zero if the node has no children */
+        UnsignedInt parent, firstChild;
+
+        /* Count of features in this node and all its children */
+        std::size_t count;
+
+        std::vector<SpatialBounds<dimensions, T>*> features;
+    };
+}
+
+/**
+@brief Spatial index
+
+Group of @ref SpatialBounds features organized in a loose quadtree (in 2D) or
+a loose octree (in 3D) by their absolute bounds. See @ref SpatialBounds for
+usage information.
+
+@section SceneGraph-SpatialIndex-structure Structure
+
+The tree covers the range passed to the constructor. Each feature is put into
+the deepest node that is at least as large as its bounds and contains their
+center. Because of that, bounds of the features in a node can extend outside
+of the node by at most half of its size in each direction and a query needs
+to visit only nodes whose such enlarged --- loose --- bounds intersect the
+query. Features that are outside of the covered range are put into the root
+node, which is visited by every query. Nodes are created on demand and are not
+deleted when they become empty, empty subtrees are skipped by the queries.
+
+When a feature gets updated, its absolute bounds are recalculated and it's
+moved to another node only if it no longer belongs to the original one, so
+the cost of an update is proportional to tree depth and not to feature count.
+The updates done while cleaning object transformations are serialized with a
+mutex, so it's possible to clean the scene on multiple threads. Queries
+however shouldn't be done while the scene is being cleaned.
+
+@section SceneGraph-SpatialIndex-queries Queries
+
+All queries first call @ref update() and then put references to features
+whose absolute bounds intersect given shape into an output array, reusing its
+memory:
+
+@code{.cpp}
+std::vector<std::reference_wrapper<SceneGraph::SpatialBounds3D>> found;
+index.sphereQueryInto(listener.translation(), 50.0f, found);
+for(SceneGraph::SpatialBounds3D& bounds: found) {
+    // activate audio sources near the listener ...
+}
+@endcode
+
+The tests are done only against the axis-aligned bounds, so the results are
+conservative with respect to actual object shape.
+
+@see @ref scenegraph, @ref BasicSpatialIndex2D, @ref BasicSpatialIndex3D,
+    @ref SpatialIndex2D, @ref SpatialIndex3D
+*/
+template<UnsignedInt dimensions, class T> class SpatialIndex: public FeatureGroup<dimensions, SpatialBounds<dimensions, T>, T> {
+    friend SpatialBounds<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param bounds    Range covered by the tree
+         * @param maxDepth  Max depth of the tree
+         *
+         * Features smaller than the deepest nodes are put into the deepest
+         * nodes containing them.
+         */
+        explicit SpatialIndex(const Math::Range<dimensions, T>& bounds, UnsignedInt maxDepth = 8);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all features from the index.
+         */
+        ~SpatialIndex();
+
+        /** @brief Range covered by the tree */
+        Math::Range<dimensions, T> bounds() const;
+
+        /** @brief Max depth of the tree */
+        UnsignedInt maxDepth() const { return _maxDepth; }
+
+        /**
+         * @brief Count of tree nodes
+         *
+         * Initially there's just the root node.
+         */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Add feature to the index
+         * @return Reference to self (for method chaining)
+         *
+         * If the feature is part of another index, it's removed from it. The
+         * feature is put into the tree on next @ref update().
+         */
+        SpatialIndex<dimensions, T>& add(SpatialBounds<dimensions, T>& feature);
+
+        /**
+         * @brief Remove feature from the index
+         * @return Reference to self (for method chaining)
+         *
+         * The feature must be part of the index.
+         */
+        SpatialIndex<dimensions, T>& remove(SpatialBounds<dimensions, T>& feature);
+
+        /**
+         * @brief Update the index
+         *
+         * Puts newly added features into the tree and updates features whose
+         * object or any of its parents was transformed or whose bounds
+         * changed since the last update, cleaning their objects if needed.
+         * Features whose object was cleaned in the meantime (e.g. using
+         * @ref Scene::cleanAll()) are already up-to-date. If any object was
+         * transformed since the last update, all features in the index are
+         * checked for a dirty parent, otherwise only the features that were
+         * directly affected are processed. Called implicitly by all queries.
+         */
+        void update();
+
+        /**
+         * @brief Query features intersecting given box
+         *
+         * Puts all features whose absolute bounds intersect @p box into
+         * @p out, replacing its previous contents. Touching counts as an
+         * intersection.
+         */
+        void boxQueryInto(const Math::Range<dimensions, T>& box, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out);
+
+        /**
+         * @brief Query features intersecting given sphere
+         *
+         * Puts all features whose absolute bounds intersect sphere (or a
+         * circle in 2D) with given @p center and @p radius into @p out,
+         * replacing its previous contents.
+         */
+        void sphereQueryInto(const VectorTypeFor<dimensions, T>& center, T radius, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out);
+
+        /**
+         * @brief Query features intersecting given frustum
+         *
+         * Puts all features whose absolute bounds intersect @p frustum into
+         * @p out, replacing its previous contents. Available only in 3D. Uses
+         * @ref Math::Geometry::Intersection::boxFrustum(), so the result is
+         * conservative.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        void frustumQueryInto(const Math::Frustum<T>& frustum, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out);
+        #else
+        template<UnsignedInt d = dimensions> void frustumQueryInto(const Math::Frustum<T>& frustum, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out) {
+            static_assert(d == 3, "frustum queries are available only in 3D");
+            queryInto([](const Math::Range<dimensions, T>& box, const void* state) {
+                return Math::Geometry::Intersection::boxFrustum<T>(box, *static_cast<const Math::Frustum<T>*>(state)) ? T(0) : Math::Constants<T>::inf();
+            }, &frustum, false, out);
+        }
+        #endif
+
+        /**
+         * @brief Query features hit by given ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param out           Output array
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      @p direction
+         *
+         * Puts all features whose absolute bounds are hit by the ray into
+         * @p out, replacing its previous contents, sorted by the distance at
+         * which the ray enters the bounds. For picking, the first feature is
+         * usually the candidate to test in more detail.
+         */
+        void rayQueryInto(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out, T maxDistance = Math::Constants<T>::inf());
+
+    private:
+        enum: UnsignedInt { NoIndex = ~UnsignedInt{} };
+
+        /* Returns distance at which the shape intersects given box or
+           infinity if it doesn't intersect */
+        typedef T(*Intersects)(const Math::Range<dimensions, T>&, const void*);
+
+        /* Used from the inline frustum query, so can't be local */
+        void queryInto(Intersects intersects, const void* state, bool sortByDistance, std::vector<std::reference_wrapper<SpatialBounds<dimensions, T>>>& out);
+
+        UnsignedInt nodeFor(const Math::Range<dimensions, T>& bounds);
+        void place(SpatialBounds<dimensions, T>& feature);
+        void insert(SpatialBounds<dimensions, T>& feature, UnsignedInt node);
+        void erase(SpatialBounds<dimensions, T>& feature);
+        void enqueue(SpatialBounds<dimensions, T>& feature);
+        void dequeue(SpatialBounds<dimensions, T>& feature);
+        void detach(SpatialBounds<dimensions, T>& feature);
+
+        std::vector<Implementation::SpatialIndexNode<dimensions, T>> _nodes;
+        std::vector<SpatialBounds<dimensions, T>*> _pending;
+
+        /* Temporary arrays for queries, kept to reuse the memory */
+        std::vector<UnsignedInt> _stack;
+        std::vector<std::pair<T, SpatialBounds<dimensions, T>*>> _hits;
+
+        UnsignedInt _maxDepth;
+
+        /* Object generation as of the last update, used to detect whether
+           anything could have been transformed since */
+        UnsignedLong _generation;
+
+        /* SpatialBounds::clean() can be called from multiple threads */
+        std::mutex _mutex;
+};
+
+/**
+@brief Spatial index for two-dimensional scenes
+
+Convenience alternative to @cpp SpatialIndex<2, T> @ce. See
+@ref SpatialBounds for more information.
+@see @ref SpatialIndex2D, @ref BasicSpatialIndex3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialIndex2D = SpatialIndex<2, T>;
+#endif
+
+/**
+@brief Spatial index for two-dimensional float scenes
+
+@see @ref SpatialIndex3D
+*/
+typedef BasicSpatialIndex2D<Float> SpatialIndex2D;
+
+/**
+@brief Spatial index for three-dimensional scenes
+
+Convenience alternative to @cpp SpatialIndex<3, T> @ce. See
+@ref SpatialBounds for more information.
+@see @ref SpatialIndex3D, @ref BasicSpatialIndex2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialIndex3D = SpatialIndex<3, T>;
+#endif
+
+/**
+@brief Spatial index for three-dimensional float scenes
+
+@see @ref SpatialIndex2D
+*/
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialIndex<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialIndex<3, Float>;
+#endif
+
+}}
+
+#endif
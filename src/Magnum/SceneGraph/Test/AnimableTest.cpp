@@ -24,11 +24,15 @@
 */
 
 #include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/SceneGraph/Animable.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialBounds.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
 
 namespace Magnum { namespace SceneGraph { namespace Test {
 
@@ -41,6 +45,9 @@ struct AnimableTest: TestSuite::Tester {
     void repeat();
     void stop();
     void pause();
+    void stepMultithreaded();
+    void stepMultithreadedStopFromStep();
+    void stepMultithreadedTransform();
 
     void deleteWhileRunning();
 
@@ -48,6 +55,7 @@ struct AnimableTest: TestSuite::Tester {
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 AnimableTest::AnimableTest() {
     addTests({&AnimableTest::state,
@@ -56,6 +64,9 @@ AnimableTest::AnimableTest() {
               &AnimableTest::repeat,
               &AnimableTest::stop,
               &AnimableTest::pause,
+              &AnimableTest::stepMultithreaded,
+              &AnimableTest::stepMultithreadedStopFromStep,
+              &AnimableTest::stepMultithreadedTransform,
 
               &AnimableTest::deleteWhileRunning,
 
@@ -355,6 +366,164 @@ void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+void AnimableTest::stepMultithreaded() {
+    class LoggingAnimable: public SceneGraph::Animable3D {
+        public:
+            LoggingAnimable(AbstractObject3D& object, AnimableGroup3D* group, std::string& log, char id, Float duration): SceneGraph::Animable3D(object, group), time(-1.0f), delta(0.0f), steps(0), _log(log), _id{id} {
+                setDuration(duration);
+                setState(AnimationState::Running);
+            }
+
+            Float time, delta;
+            Int steps;
+
+        protected:
+            void animationStep(Float t, Float d) override {
+                time = t;
+                delta = d;
+                ++steps;
+            }
+
+            void animationStarted() override {
+                _log += _id;
+                _log += "started;";
+            }
+
+            void animationPaused() override {
+                _log += _id;
+                _log += "paused;";
+            }
+
+            void animationStopped() override {
+                _log += _id;
+                _log += "stopped;";
+            }
+
+        private:
+            std::string& _log;
+            char _id;
+    };
+
+    Object3D object;
+    AnimableGroup3D group;
+    std::string log;
+    std::vector<LoggingAnimable*> animables;
+    for(Int i = 0; i != 100; ++i)
+        animables.push_back(new LoggingAnimable{object, &group, log, char('a' + i%26), i < 3 ? 2.0f + i : 0.0f});
+
+    /* The callbacks are called on the calling thread in order the animables
+       were added */
+    group.step(1.0f, 0.5f, 4);
+    CORRADE_COMPARE(group.runningCount(), 100);
+    CORRADE_COMPARE(log.substr(0, 24), "astarted;bstarted;cstart");
+    for(LoggingAnimable* animable: animables) {
+        CORRADE_COMPARE(animable->time, 0.0f);
+        CORRADE_COMPARE(animable->delta, 0.5f);
+        CORRADE_COMPARE(animable->steps, 1);
+    }
+
+    /* The first two are out of their duration, another gets paused */
+    log.clear();
+    animables[50]->setState(AnimationState::Paused);
+    group.step(4.5f, 0.75f, 0);
+    CORRADE_COMPARE(log, "astopped;bstopped;ypaused;");
+    CORRADE_COMPARE(group.runningCount(), 97);
+    CORRADE_COMPARE(animables[0]->steps, 1);
+    CORRADE_COMPARE(animables[1]->steps, 1);
+    CORRADE_COMPARE(animables[2]->time, 3.5f);
+    CORRADE_COMPARE(animables[50]->steps, 1);
+    CORRADE_COMPARE(animables[99]->time, 3.5f);
+    CORRADE_COMPARE(animables[99]->delta, 0.75f);
+    CORRADE_COMPARE(animables[99]->steps, 2);
+}
+
+void AnimableTest::stepMultithreadedStopFromStep() {
+    class SelfStoppingAnimable: public SceneGraph::Animable3D {
+        public:
+            SelfStoppingAnimable(AbstractObject3D& object, AnimableGroup3D* group): SceneGraph::Animable3D(object, group), steps(0) {
+                setState(AnimationState::Running);
+            }
+
+            Int steps;
+
+        protected:
+            void animationStep(Float t, Float) override {
+                ++steps;
+                if(t >= 1.0f) setState(AnimationState::Stopped);
+            }
+    };
+
+    Object3D object;
+    AnimableGroup3D group;
+    std::vector<SelfStoppingAnimable*> animables;
+    for(Int i = 0; i != 16; ++i)
+        animables.push_back(new SelfStoppingAnimable{object, &group});
+
+    group.step(1.0f, 0.5f, 4);
+    CORRADE_COMPARE(group.runningCount(), 16);
+    group.step(2.0f, 0.5f, 4);
+    CORRADE_COMPARE(group.runningCount(), 16);
+
+    /* The state change gets processed in next step */
+    group.step(3.0f, 0.5f, 4);
+    CORRADE_COMPARE(group.runningCount(), 0);
+    for(SelfStoppingAnimable* animable: animables) {
+        CORRADE_COMPARE(animable->state(), AnimationState::Stopped);
+        CORRADE_COMPARE(animable->steps, 2);
+    }
+}
+
+void AnimableTest::stepMultithreadedTransform() {
+    class MovingAnimable: public SceneGraph::Animable3D {
+        public:
+            MovingAnimable(Object3D& object, AnimableGroup3D* group, Float speed): SceneGraph::Animable3D(object, group), _object(object), _speed{speed} {
+                setState(AnimationState::Running);
+            }
+
+        protected:
+            void animationStep(Float t, Float) override {
+                _object.setTransformation(Matrix4::translation(Vector3::xAxis(t*_speed)));
+            }
+
+        private:
+            Object3D& _object;
+            Float _speed;
+    };
+
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-1000.0f}, Vector3{1000.0f}}};
+    AnimableGroup3D group;
+    std::vector<Object3D*> objects;
+    std::vector<SpatialBounds3D*> bounds;
+    for(Int i = 0; i != 200; ++i) {
+        /* The bounds are on a child, which gets marked as dirty only when
+           cleaning the parent */
+        objects.push_back(new Object3D{&scene});
+        Object3D* child = new Object3D{objects.back()};
+        bounds.push_back(new SpatialBounds3D{*child, {Vector3{-0.5f}, Vector3{0.5f}}, &index});
+        new MovingAnimable{*objects.back(), &group, Float(i)};
+    }
+    scene.cleanAll();
+    index.update();
+
+    /* Setting the transformation from multiple threads registers the dirty
+       objects in the scene and the spatial index after all threads finish */
+    group.step(1.0f, 0.5f, 4);
+    group.step(3.0f, 0.5f, 4);
+    scene.cleanAll();
+    index.update();
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        CORRADE_VERIFY(!objects[i]->isDirty());
+        CORRADE_COMPARE(bounds[i]->absoluteBounds().center(), Vector3::xAxis(2.0f*i));
+
+        index.boxQueryInto({Vector3::xAxis(2.0f*i) - Vector3{0.1f}, Vector3::xAxis(2.0f*i) + Vector3{0.1f}}, found);
+        CORRADE_COMPARE(found.size(), 1);
+        CORRADE_COMPARE(&found[0].get(), bounds[i]);
+    }
+}
+
 void AnimableTest::deleteWhileRunning() {
     Object3D object;
     AnimableGroup3D group;
@@ -25,11 +25,14 @@
 
 #include <Corrade/TestSuite/Tester.h>
 
-#include "Magnum/SceneGraph/Camera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
-#include "Magnum/SceneGraph/Camera.h"
-#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/AbstractFeature.hpp"
+#include "Magnum/SceneGraph/Camera.hpp" /* aspectRatioFix() and Double specialization */
+#include "Magnum/SceneGraph/FeatureGroup.hpp"
+#include "Magnum/SceneGraph/Drawable.hpp"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.hpp"
 #include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph { namespace Test {
@@ -46,11 +49,24 @@ struct CameraTest: TestSuite::Tester {
     void projectionSizePerspective();
     void projectionSizeViewport();
     void draw();
+    void drawCulled2D();
+    void drawCulled3D();
+    void drawCulled3DDouble();
+    void drawCulledNoBoundingVolume();
+    void drawSorted2D();
+    void drawSortedStateFrontToBack();
+    void drawSortedBackToFrontState();
+    void drawSortedCulled();
+    void drawInstanced();
+    void drawInstancedCulledSorted();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<Double>> Object3Dd;
+typedef SceneGraph::Scene<SceneGraph::BasicMatrixTransformation3D<Double>> Scene3Dd;
 
 CameraTest::CameraTest() {
     addTests({&CameraTest::fixAspectRatio,
@@ -61,7 +77,17 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeOrthographic,
               &CameraTest::projectionSizePerspective,
               &CameraTest::projectionSizeViewport,
-              &CameraTest::draw});
+              &CameraTest::draw,
+              &CameraTest::drawCulled2D,
+              &CameraTest::drawCulled3D,
+              &CameraTest::drawCulled3DDouble,
+              &CameraTest::drawCulledNoBoundingVolume,
+              &CameraTest::drawSorted2D,
+              &CameraTest::drawSortedStateFrontToBack,
+              &CameraTest::drawSortedBackToFrontState,
+              &CameraTest::drawSortedCulled,
+              &CameraTest::drawInstanced,
+              &CameraTest::drawInstancedCulledSorted});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -210,6 +236,385 @@ void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Matrix4());
 }
 
+namespace {
+
+template<UnsignedInt dimensions, class T> class IdDrawable: public SceneGraph::Drawable<dimensions, T> {
+    public:
+        IdDrawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* group, std::vector<Int>& drawn, Int id): SceneGraph::Drawable<dimensions, T>{object, group}, _drawn(drawn), _id{id} {}
+
+    protected:
+        void draw(const MatrixTypeFor<dimensions, T>&, Camera<dimensions, T>&) override {
+            _drawn.push_back(_id);
+        }
+
+    private:
+        std::vector<Int>& _drawn;
+        Int _id;
+};
+
+}
+
+void CameraTest::drawCulled2D() {
+    DrawableGroup2D group;
+    Scene2D scene;
+    std::vector<Int> drawn;
+
+    /* Inside */
+    Object2D a{&scene};
+    a.translate({1.0f, 1.0f});
+    (new IdDrawable<2, Float>{a, &group, drawn, 0})
+        ->setBoundingSphere({}, 0.5f);
+
+    /* Outside, left */
+    Object2D b{&scene};
+    b.translate({-5.0f, 0.0f});
+    (new IdDrawable<2, Float>{b, &group, drawn, 1})
+        ->setBoundingSphere({}, 0.5f);
+
+    /* Outside, but the scaled box reaches inside */
+    Object2D c{&scene};
+    c.scale(Vector2{8.0f})
+     .translate({0.0f, 5.0f});
+    (new IdDrawable<2, Float>{c, &group, drawn, 2})
+        ->setBoundingBox({{-0.5f, -0.5f}, {0.5f, 0.5f}});
+
+    /* Outside, up */
+    Object2D d{&scene};
+    d.translate({0.0f, 5.0f});
+    (new IdDrawable<2, Float>{d, &group, drawn, 3})
+        ->setBoundingBox({{-0.5f, -0.5f}, {0.5f, 0.5f}});
+
+    /* The camera sees [-2, 2] in both directions */
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({4.0f, 4.0f}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 0);
+
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 2}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 2);
+
+    /* Moving the camera up brings the last one into view and the first one
+       out of it */
+    drawn.clear();
+    cameraObject.translate({0.0f, 4.0f});
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{2, 3}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 2);
+}
+
+template<class T, class Object, class Scene> void drawCulled3DImplementation(std::vector<Int>& drawn, std::size_t& culledCount) {
+    typedef Math::Vector3<T> Vector3;
+    DrawableGroup<3, T> group;
+    Scene scene;
+
+    /* In front */
+    Object a{&scene};
+    a.translate({T(0.0), T(0.0), T(-5.0)});
+    (new IdDrawable<3, T>{a, &group, drawn, 0})
+        ->setBoundingSphere({}, T(1.0));
+
+    /* Behind */
+    Object b{&scene};
+    b.translate({T(0.0), T(0.0), T(5.0)});
+    (new IdDrawable<3, T>{b, &group, drawn, 1})
+        ->setBoundingSphere({}, T(1.0));
+
+    /* Far on the right */
+    Object c{&scene};
+    c.translate({T(20.0), T(0.0), T(-5.0)});
+    (new IdDrawable<3, T>{c, &group, drawn, 2})
+        ->setBoundingBox({Vector3{T(-1.0)}, Vector3{T(1.0)}});
+
+    /* Far on the right, but the scaled box reaches inside */
+    Object d{&scene};
+    d.scale(Vector3{T(20.0)})
+     .translate({T(20.0), T(0.0), T(-5.0)});
+    (new IdDrawable<3, T>{d, &group, drawn, 3})
+        ->setBoundingBox({Vector3{T(-1.0)}, Vector3{T(1.0)}});
+
+    /* Far on the right, but the scaled sphere offset from the origin is
+       inside */
+    Object e{&scene};
+    e.scale(Vector3{T(2.0)})
+     .translate({T(20.0), T(0.0), T(-5.0)});
+    (new IdDrawable<3, T>{e, &group, drawn, 4})
+        ->setBoundingSphere({T(-10.0), T(0.0), T(0.0)}, T(0.5));
+
+    /* Beyond the far plane */
+    Object f{&scene};
+    f.translate({T(0.0), T(0.0), T(-500.0)});
+    (new IdDrawable<3, T>{f, &group, drawn, 5})
+        ->setBoundingSphere({}, T(1.0));
+
+    /* Behind the camera, but sheared so the sphere reaches 1.73 units towards
+       the near plane. The columns are only 1.41 units long. */
+    Object g{&scene};
+    g.setTransformation({{T(1.0), T(0.0), T(1.0), T(0.0)},
+                         {T(0.0), T(1.0), T(1.0), T(0.0)},
+                         {T(0.0), T(0.0), T(1.0), T(0.0)},
+                         {T(0.0), T(0.0), T(1.55), T(1.0)}});
+    (new IdDrawable<3, T>{g, &group, drawn, 6})
+        ->setBoundingSphere({}, T(1.0));
+
+    Object cameraObject{&scene};
+    Camera<3, T> camera{cameraObject};
+    camera.setProjectionMatrix(Math::Matrix4<T>::perspectiveProjection(Math::Deg<T>(T(90.0)), T(1.0), T(0.1), T(100.0)));
+    camera.draw(group);
+    culledCount = camera.culledDrawableCount();
+}
+
+void CameraTest::drawCulled3D() {
+    std::vector<Int> drawn;
+    std::size_t culledCount;
+    drawCulled3DImplementation<Float, Object3D, Scene3D>(drawn, culledCount);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 3, 4, 6}));
+    CORRADE_COMPARE(culledCount, 3);
+}
+
+void CameraTest::drawCulled3DDouble() {
+    /* Goes through the generic (non-optimized) batch tests */
+    std::vector<Int> drawn;
+    std::size_t culledCount;
+    drawCulled3DImplementation<Double, Object3Dd, Scene3Dd>(drawn, culledCount);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 3, 4, 6}));
+    CORRADE_COMPARE(culledCount, 3);
+}
+
+void CameraTest::drawCulledNoBoundingVolume() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+
+    /* Behind the camera, but without a bounding volume so always drawn */
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(5.0f));
+    new IdDrawable<3, Float>{a, &group, drawn, 0};
+
+    /* Behind the camera */
+    Object3D b{&scene};
+    b.translate(Vector3::zAxis(5.0f));
+    (new IdDrawable<3, Float>{b, &group, drawn, 1})
+        ->setBoundingSphere({}, 1.0f);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 1);
+
+    /* Resetting the volume draws everything again */
+    drawn.clear();
+    group[1].resetBoundingVolume();
+    CORRADE_VERIFY(group[1].boundingVolume() == BoundingVolume::None);
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 1}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 0);
+}
+
+void CameraTest::drawSorted2D() {
+    DrawableGroup2D group;
+    Scene2D scene;
+    std::vector<Int> drawn;
+
+    /* There's no depth in 2D, so it's sorted just by the key and drawables
+       with the same key stay in insertion order */
+    Object2D a{&scene};
+    const UnsignedInt keys[]{0x30000, 0x00002, 0x30000, 0x00001, 0x12345, 0x00002};
+    for(Int i = 0; i != 6; ++i)
+        (new IdDrawable<2, Float>{a, &group, drawn, i})
+            ->setSortKey(keys[i]);
+
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.draw(group, DrawOrder::StateFrontToBack);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{3, 1, 5, 4, 0, 2}));
+
+    drawn.clear();
+    camera.draw(group, DrawOrder::BackToFrontState);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{3, 1, 5, 4, 0, 2}));
+
+    /* Unsorted order is the original */
+    drawn.clear();
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 1, 2, 3, 4, 5}));
+}
+
+namespace {
+
+/* Two shaders, each drawable at different depth, some of them behind the
+   camera */
+void populateSorted(Object3D& parent, DrawableGroup3D& group, std::vector<Int>& drawn) {
+    const Float depths[]{10.0f, 2.0f, -3.0f, 7.5f, 0.5f, 1000.0f, 7.5f, -0.25f};
+    const UnsignedInt keys[]{1, 0, 1, 0, 0, 1, 1, 0};
+    for(Int i = 0; i != 8; ++i) {
+        Object3D* object = new Object3D{&parent};
+        object->translate(Vector3::zAxis(-depths[i]));
+        (new IdDrawable<3, Float>{*object, &group, drawn, i})
+            ->setSortKey(keys[i] << 31);
+    }
+}
+
+}
+
+void CameraTest::drawSortedStateFrontToBack() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+    populateSorted(scene, group, drawn);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.draw(group, DrawOrder::StateFrontToBack);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{7, 4, 1, 3, 2, 6, 0, 5}));
+
+    /* Turning the camera around reverses the depth order */
+    drawn.clear();
+    cameraObject.rotateY(Deg(180.0f));
+    camera.draw(group, DrawOrder::StateFrontToBack);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{3, 1, 4, 7, 5, 0, 6, 2}));
+}
+
+void CameraTest::drawSortedBackToFrontState() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+    populateSorted(scene, group, drawn);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.draw(group, DrawOrder::BackToFrontState);
+    /* 3 and 6 are at the same depth, then it's sorted by the key */
+    CORRADE_COMPARE(drawn, (std::vector<Int>{5, 0, 3, 6, 1, 4, 7, 2}));
+}
+
+void CameraTest::drawSortedCulled() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+    populateSorted(scene, group, drawn);
+
+    /* Give everything a bounding sphere, then 2 and 7 behind the camera and 5
+       beyond the far plane get culled */
+    for(std::size_t i = 0; i != group.size(); ++i)
+        group[i].setBoundingSphere({}, 0.1f);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+    camera.draw(group, DrawOrder::StateFrontToBack);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{4, 1, 3, 6, 0}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 3);
+}
+
+namespace {
+
+class IdBatch: public InstancedDrawableBatch3D {
+    public:
+        IdBatch(std::vector<Int>& drawn, Int id): _drawn(drawn), _id{id} {}
+
+        std::vector<Float> translations;
+        std::vector<InstancedDrawable3D*> drawables;
+
+    protected:
+        void draw(Containers::ArrayView<const Matrix4> transformationMatrices, Containers::ArrayView<InstancedDrawable3D* const> drawables, Camera3D&) override {
+            _drawn.push_back(_id);
+            for(const Matrix4& transformation: transformationMatrices)
+                translations.push_back(transformation.translation().x());
+            this->drawables.insert(this->drawables.end(), drawables.begin(), drawables.end());
+        }
+
+    private:
+        std::vector<Int>& _drawn;
+        Int _id;
+};
+
+}
+
+void CameraTest::drawInstanced() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+    IdBatch a{drawn, 10};
+    IdBatch b{drawn, 11};
+
+    Object3D o0{&scene};
+    Object3D o1{&scene};
+    Object3D o2{&scene};
+    Object3D o3{&scene};
+    Object3D o4{&scene};
+    Object3D o5{&scene};
+    o1.translate(Vector3::xAxis(1.0f));
+    o3.translate(Vector3::xAxis(3.0f));
+    o4.translate(Vector3::xAxis(4.0f));
+    o5.translate(Vector3::xAxis(5.0f));
+    new IdDrawable<3, Float>{o0, &group, drawn, 0};
+    auto a1 = new InstancedDrawable3D{o1, a, &group};
+    new IdDrawable<3, Float>{o2, &group, drawn, 2};
+    auto b3 = new InstancedDrawable3D{o3, b, &group};
+    auto a4 = new InstancedDrawable3D{o4, a, &group};
+    auto b5 = new InstancedDrawable3D{o5, b, &group};
+    CORRADE_VERIFY(!group[0].instanceBatch());
+    CORRADE_VERIFY(group[1].instanceBatch() == &a);
+    CORRADE_VERIFY(&a4->batch() == &a);
+
+    Object3D cameraObject{&scene};
+    cameraObject.translate(Vector3::xAxis(-1.0f));
+    Camera3D camera{cameraObject};
+
+    /* Each batch is drawn once at the place of its first drawable, with
+       camera-relative transformations */
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 10, 2, 11}));
+    CORRADE_COMPARE(a.translations, (std::vector<Float>{2.0f, 5.0f}));
+    CORRADE_COMPARE(b.translations, (std::vector<Float>{4.0f, 6.0f}));
+    CORRADE_VERIFY(a.drawables == (std::vector<InstancedDrawable3D*>{a1, a4}));
+    CORRADE_VERIFY(b.drawables == (std::vector<InstancedDrawable3D*>{b3, b5}));
+
+    /* Drawing again doesn't accumulate the previous instances */
+    drawn.clear();
+    a.translations.clear();
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 10, 2, 11}));
+    CORRADE_COMPARE(a.translations, (std::vector<Float>{2.0f, 5.0f}));
+
+    /* Drawing a single instanced drawable directly */
+    drawn.clear();
+    a.translations.clear();
+    a.drawables.clear();
+    static_cast<Drawable3D*>(a4)->draw(Matrix4::translation(Vector3::xAxis(7.0f)), camera);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{10}));
+    CORRADE_COMPARE(a.translations, (std::vector<Float>{7.0f}));
+    CORRADE_VERIFY(a.drawables == (std::vector<InstancedDrawable3D*>{a4}));
+}
+
+void CameraTest::drawInstancedCulledSorted() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+    IdBatch a{drawn, 10};
+
+    /* Instances at various distances, the one at -200 is beyond the far plane
+       and the one at +2 behind the camera */
+    for(Float z: {-5.0f, -200.0f, -1.0f, 2.0f, -3.0f}) {
+        Object3D* o = new Object3D{&scene};
+        o->translate({z, 0.0f, z});
+        (new InstancedDrawable3D{*o, a, &group})
+            ->setBoundingSphere({}, 0.1f);
+    }
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    /* Single batch with the visible instances front to back */
+    camera.draw(group, DrawOrder::StateFrontToBack);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{10}));
+    CORRADE_COMPARE(a.translations, (std::vector<Float>{-1.0f, -3.0f, -5.0f}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 2);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
@@ -0,0 +1,612 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct FlatObjectTest: TestSuite::Tester {
+    explicit FlatObjectTest();
+
+    void construct();
+    void constructNullParent();
+    void parenting();
+    void parentingReorder();
+    void setParentScene();
+    void setParentDifferentScene();
+    void setParentCyclic();
+    void destroy();
+    void destroyReordered();
+    void absoluteTransformation();
+    void transformations();
+    void transformationsNotScene();
+    void transformationsDifferentScene();
+    void setClean();
+    void setCleanList();
+    void cleanAll();
+    void markDirty();
+    void draw();
+
+    void transformations50k();
+    void transformations50kObject();
+    void cleanAll50k();
+};
+
+typedef SceneGraph::FlatObject3D Object3D;
+typedef SceneGraph::FlatScene3D Scene3D;
+
+class CachingObject: public Object3D, AbstractFeature3D {
+    public:
+        CachingObject(Object3D* parent): Object3D{parent}, AbstractFeature3D{*this} {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Matrix4 cleanedAbsoluteTransformation;
+
+    protected:
+        void clean(const Matrix4& absoluteTransformation) override {
+            cleanedAbsoluteTransformation = absoluteTransformation;
+        }
+};
+
+FlatObjectTest::FlatObjectTest() {
+    addTests({&FlatObjectTest::construct,
+              &FlatObjectTest::constructNullParent,
+              &FlatObjectTest::parenting,
+              &FlatObjectTest::parentingReorder,
+              &FlatObjectTest::setParentScene,
+              &FlatObjectTest::setParentDifferentScene,
+              &FlatObjectTest::setParentCyclic,
+              &FlatObjectTest::destroy,
+              &FlatObjectTest::destroyReordered,
+              &FlatObjectTest::absoluteTransformation,
+              &FlatObjectTest::transformations,
+              &FlatObjectTest::transformationsNotScene,
+              &FlatObjectTest::transformationsDifferentScene,
+              &FlatObjectTest::setClean,
+              &FlatObjectTest::setCleanList,
+              &FlatObjectTest::cleanAll,
+              &FlatObjectTest::markDirty,
+              &FlatObjectTest::draw});
+
+    addBenchmarks({&FlatObjectTest::transformations50k,
+                   &FlatObjectTest::transformations50kObject,
+                   &FlatObjectTest::cleanAll50k}, 5);
+}
+
+void FlatObjectTest::construct() {
+    Scene3D scene;
+    CORRADE_COMPARE(scene.objectCount(), 1);
+    CORRADE_VERIFY(!scene.parent());
+    CORRADE_COMPARE(scene.scene(), &scene);
+
+    Object3D a{&scene};
+    CORRADE_COMPARE(scene.objectCount(), 2);
+    CORRADE_COMPARE(a.parent(), &scene);
+    CORRADE_COMPARE(a.scene(), &scene);
+    CORRADE_COMPARE(a.transformation(), Matrix4{});
+
+    Object3D& b = a.addChild<Object3D>();
+    CORRADE_COMPARE(scene.objectCount(), 3);
+    CORRADE_COMPARE(b.parent(), &a);
+
+    /* Abstract interface */
+    AbstractObject3D& abstract = a;
+    CORRADE_COMPARE(abstract.scene(), &scene);
+    CORRADE_COMPARE(abstract.parent(), &scene);
+}
+
+void FlatObjectTest::constructNullParent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Object3D a{nullptr};
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatObject: the parent can't be null\n");
+}
+
+void FlatObjectTest::parenting() {
+    Scene3D scene;
+
+    Object3D* childOne = new Object3D{&scene};
+    Object3D* childTwo = new Object3D{&scene};
+    CORRADE_COMPARE(childOne->parent(), &scene);
+    CORRADE_COMPARE(childTwo->parent(), &scene);
+
+    /* Reparent to another */
+    childTwo->setParent(childOne);
+    CORRADE_COMPARE(childTwo->parent(), childOne);
+
+    /* Setting the same parent again is a no-op */
+    childTwo->setParent(childOne);
+    CORRADE_COMPARE(childTwo->parent(), childOne);
+
+    /* Delete child */
+    delete childTwo;
+    CORRADE_COMPARE(scene.objectCount(), 2);
+    CORRADE_COMPARE(childOne->parent(), &scene);
+}
+
+void FlatObjectTest::parentingReorder() {
+    Scene3D scene;
+
+    /* Parenting to an object that was created later breaks the topological
+       order, which has to be fixed before calculating the transformations */
+    Object3D* a = new Object3D{&scene};
+    a->translate(Vector3::xAxis(1.0f));
+    Object3D* b = new Object3D{a};
+    b->translate(Vector3::yAxis(2.0f));
+    Object3D* c = new Object3D{&scene};
+    c->translate(Vector3::zAxis(3.0f));
+    a->setParent(c);
+
+    CORRADE_COMPARE(a->parent(), c);
+    CORRADE_COMPARE(b->parent(), a);
+    CORRADE_COMPARE(c->parent(), &scene);
+    CORRADE_COMPARE(b->absoluteTransformationMatrix(), Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(a->absoluteTransformationMatrix(), Matrix4::translation({1.0f, 0.0f, 3.0f}));
+
+    /* The order got fixed, the objects still point to the right slots */
+    CORRADE_COMPARE(a->transformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(b->transformation(), Matrix4::translation(Vector3::yAxis(2.0f)));
+    CORRADE_COMPARE(c->transformation(), Matrix4::translation(Vector3::zAxis(3.0f)));
+}
+
+void FlatObjectTest::setParentScene() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    Object3D a{&scene};
+    scene.setParent(&a);
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatObject::setParent(): can't set parent of the scene\n");
+}
+
+void FlatObjectTest::setParentDifferentScene() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    Scene3D another;
+    Object3D a{&scene};
+    Object3D b{&another};
+    a.setParent(&b);
+    CORRADE_COMPARE(a.parent(), &scene);
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatObject::setParent(): the parent is not part of the same scene\n");
+}
+
+void FlatObjectTest::setParentCyclic() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+    a.setParent(&a);
+    a.setParent(&b);
+    CORRADE_COMPARE(a.parent(), &scene);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatObject::setParent(): can't parent an object to its child\n"
+        "SceneGraph::FlatObject::setParent(): can't parent an object to its child\n");
+}
+
+void FlatObjectTest::destroy() {
+    Scene3D scene;
+
+    Object3D* a = new Object3D{&scene};
+    Object3D* b = new Object3D{a};
+    new Object3D{b};
+    new Object3D{a};
+    Object3D* c = new Object3D{&scene};
+    c->translate(Vector3::xAxis(1.0f));
+    Object3D* d = new Object3D{c};
+    d->translate(Vector3::yAxis(1.0f));
+    CORRADE_COMPARE(scene.objectCount(), 7);
+
+    /* Destroys the whole subtree */
+    delete a;
+    CORRADE_COMPARE(scene.objectCount(), 3);
+
+    /* The remaining objects are still consistent after compaction */
+    CORRADE_COMPARE(d->parent(), c);
+    CORRADE_COMPARE(d->absoluteTransformationMatrix(), Matrix4::translation({1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(scene.objectCount(), 3);
+
+    /* Destroying a leaf */
+    delete d;
+    CORRADE_COMPARE(scene.objectCount(), 2);
+    CORRADE_COMPARE(c->absoluteTransformationMatrix(), Matrix4::translation({1.0f, 0.0f, 0.0f}));
+
+    /* The rest gets destroyed by the scene */
+}
+
+void FlatObjectTest::destroyReordered() {
+    Scene3D scene;
+
+    /* The child is before the parent, destruction has to find it anyway */
+    Object3D* a = new Object3D{&scene};
+    Object3D* b = new Object3D{&scene};
+    a->setParent(b);
+    new Object3D{a};
+    CORRADE_COMPARE(scene.objectCount(), 4);
+
+    delete b;
+    CORRADE_COMPARE(scene.objectCount(), 1);
+
+    /* And also when destroying the whole scene with unordered objects */
+    Object3D* c = new Object3D{&scene};
+    Object3D* d = new Object3D{&scene};
+    c->setParent(d);
+}
+
+void FlatObjectTest::absoluteTransformation() {
+    Scene3D s;
+
+    /* Proper transformation composition */
+    Object3D o{&s};
+    o.translate(Vector3::xAxis(2.0f));
+    CORRADE_COMPARE(o.transformation(), Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(o.transformationMatrix(), Matrix4::translation(Vector3::xAxis(2.0f)));
+    Object3D o2{&o};
+    o2.transform(Matrix4::rotationY(Deg(90.0f)));
+    CORRADE_COMPARE(o2.absoluteTransformationMatrix(),
+        Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::rotationY(Deg(90.0f)));
+
+    /* Changing the parent transformation updates the children */
+    o.setTransformation(Matrix4::translation(Vector3::zAxis(3.0f)));
+    CORRADE_COMPARE(o2.absoluteTransformationMatrix(),
+        Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::rotationY(Deg(90.0f)));
+
+    /* Transformation of the scene can't be changed */
+    s.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(s.transformation(), Matrix4{});
+    CORRADE_COMPARE(s.absoluteTransformationMatrix(), Matrix4{});
+}
+
+void FlatObjectTest::transformations() {
+    Scene3D s;
+
+    Object3D first{&s};
+    first.transform(Matrix4::rotationZ(Deg(30.0f)));
+    Object3D second{&first};
+    second.scale(Vector3(0.5f));
+    Object3D third{&first};
+    third.translate(Vector3::xAxis(5.0f));
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    CORRADE_COMPARE(s.transformationMatrices({second, third, second, first}, initial), (std::vector<Matrix4>{
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))
+    }));
+
+    /* Abstract interface */
+    const AbstractObject3D& abstract = s;
+    CORRADE_COMPARE(abstract.transformationMatrices({third}), (std::vector<Matrix4>{
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f))
+    }));
+}
+
+void FlatObjectTest::transformationsNotScene() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D s;
+    Object3D o{&s};
+    o.transformationMatrices({o});
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatObject::transformationMatrices(): currently implemented only for the scene\n");
+}
+
+void FlatObjectTest::transformationsDifferentScene() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D s;
+    Scene3D another;
+    Object3D o{&another};
+    s.transformationMatrices({o});
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatObject::transformationMatrices(): the objects are not part of the same scene\n");
+}
+
+void FlatObjectTest::setClean() {
+    Scene3D scene;
+
+    class CachingInvertedFeature: public AbstractFeature3D {
+        public:
+            explicit CachingInvertedFeature(AbstractObject3D& object): AbstractFeature3D{object} {
+                setCachedTransformations(CachedTransformation::InvertedAbsolute);
+            }
+
+            Matrix4 cleanedInvertedAbsoluteTransformation;
+
+            void cleanInverted(const Matrix4& invertedAbsoluteTransformation) override {
+                cleanedInvertedAbsoluteTransformation = invertedAbsoluteTransformation;
+            }
+    };
+
+    CachingObject* childOne = new CachingObject{&scene};
+    childOne->scale(Vector3(2.0f));
+
+    CachingObject* childTwo = new CachingObject{childOne};
+    childTwo->translate(Vector3::xAxis(1.0f));
+    CachingInvertedFeature* childTwoFeature = new CachingInvertedFeature{*childTwo};
+
+    CachingObject* childThree = new CachingObject{childTwo};
+    childThree->transform(Matrix4::rotationY(Deg(90.0f)));
+
+    /* Object is dirty at the beginning */
+    CORRADE_VERIFY(scene.isDirty());
+    CORRADE_VERIFY(childOne->isDirty());
+    CORRADE_VERIFY(childTwo->isDirty());
+    CORRADE_VERIFY(childThree->isDirty());
+
+    /* Clean the object and all its dirty parents (but not children) */
+    childTwo->setClean();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!childOne->isDirty());
+    CORRADE_VERIFY(!childTwo->isDirty());
+    CORRADE_VERIFY(childThree->isDirty());
+
+    /* Verify the right matrices were passed */
+    CORRADE_COMPARE(childOne->cleanedAbsoluteTransformation, Matrix4::scaling(Vector3(2.0f)));
+    CORRADE_COMPARE(childTwo->cleanedAbsoluteTransformation, childTwo->absoluteTransformationMatrix());
+    CORRADE_COMPARE(childTwoFeature->cleanedInvertedAbsoluteTransformation, childTwo->absoluteTransformationMatrix().inverted());
+
+    /* Mark object and all its children as dirty (but not parents) */
+    childTwo->setDirty();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!childOne->isDirty());
+    CORRADE_VERIFY(childTwo->isDirty());
+    CORRADE_VERIFY(childThree->isDirty());
+
+    /* If any object in the hierarchy is already clean, it shouldn't clean it
+       again */
+    childOne->cleanedAbsoluteTransformation = Matrix4{Math::ZeroInit};
+    childTwo->setClean();
+    CORRADE_COMPARE(childOne->cleanedAbsoluteTransformation, Matrix4{Math::ZeroInit});
+
+    /* Reparenting makes the object and its children dirty, not the parents */
+    childThree->setClean();
+    childTwo->setParent(&scene);
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!childOne->isDirty());
+    CORRADE_VERIFY(childTwo->isDirty());
+    CORRADE_VERIFY(childThree->isDirty());
+
+    /* Setting transformation as well */
+    scene.cleanAll();
+    childTwo->setTransformation(Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(childTwo->isDirty());
+    CORRADE_VERIFY(childThree->isDirty());
+}
+
+void FlatObjectTest::setCleanList() {
+    /* Verify it doesn't crash when passed empty list */
+    Object3D::setClean({});
+
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    b.setClean();
+    Object3D c{&scene};
+    c.translate(Vector3::zAxis(3.0f));
+    CachingObject d{&c};
+    d.scale(Vector3(-2.0f));
+    Object3D e{&scene};
+
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_VERIFY(d.isDirty());
+    CORRADE_VERIFY(e.isDirty());
+
+    /* Only the listed objects and their parents should be cleaned, also
+       through the abstract interface */
+    AbstractObject3D::setClean({a, d});
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_VERIFY(e.isDirty());
+
+    /* Verify that right transformation was passed */
+    CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
+}
+
+void FlatObjectTest::cleanAll() {
+    Scene3D scene;
+    CachingObject a{&scene};
+    a.translate(Vector3::zAxis(3.0f));
+    CachingObject b{&a};
+    b.scale(Vector3(-2.0f));
+    CachingObject c{&scene};
+    c.transform(Matrix4::rotationX(Deg(90.0f)));
+
+    scene.cleanAll();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f)));
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::rotationX(Deg(90.0f)));
+
+    /* Clean objects are not cleaned again */
+    a.cleanedAbsoluteTransformation = Matrix4{Math::ZeroInit};
+    c.translate(Vector3::xAxis(1.0f));
+    scene.cleanAll();
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, Matrix4{Math::ZeroInit});
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationX(Deg(90.0f)));
+}
+
+void FlatObjectTest::markDirty() {
+    class DirtyCountingFeature: public AbstractFeature3D {
+        public:
+            explicit DirtyCountingFeature(AbstractObject3D& object): AbstractFeature3D{object} {}
+
+            Int dirtyCount{};
+
+            void markDirty() override { ++dirtyCount; }
+    };
+
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+    DirtyCountingFeature feature{b};
+    scene.cleanAll();
+    CORRADE_COMPARE(feature.dirtyCount, 1);
+
+    /* Marking the parent dirty repeatedly notifies the feature only once */
+    a.translate(Vector3::xAxis(1.0f));
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_COMPARE(feature.dirtyCount, 2);
+
+    a.setDirty();
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_COMPARE(feature.dirtyCount, 2);
+}
+
+void FlatObjectTest::draw() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, Matrix4& result): SceneGraph::Drawable3D(object, group), result(result) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                result = transformationMatrix;
+            }
+
+        private:
+            Matrix4& result;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D first{&scene};
+    Matrix4 firstTransformation;
+    first.scale(Vector3(5.0f));
+    new Drawable(first, &group, firstTransformation);
+
+    Object3D second{&scene};
+    Matrix4 secondTransformation;
+    second.translate(Vector3::yAxis(3.0f));
+    new Drawable(second, &group, secondTransformation);
+
+    Object3D third{&second};
+    Matrix4 thirdTransformation;
+    third.translate(Vector3::zAxis(-1.5f));
+    new Drawable(third, &group, thirdTransformation);
+
+    Camera3D camera(third);
+    camera.draw(group);
+
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3(5.0f)));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(1.5f)));
+    CORRADE_COMPARE(thirdTransformation, Matrix4());
+}
+
+namespace {
+    enum: std::size_t { BenchmarkObjectCount = 50000 };
+
+    /* Ten levels deep, ten objects in each of the first four levels and then
+       chains of the remaining levels */
+    template<class Object, class Scene> std::vector<std::reference_wrapper<Object>> populate(Scene& scene, Object*(*create)(Object*)) {
+        std::vector<std::reference_wrapper<Object>> objects;
+        objects.reserve(BenchmarkObjectCount);
+        Object* parent = &scene;
+        for(std::size_t i = 0; i != BenchmarkObjectCount; ++i) {
+            if(i % 10 == 0) parent = i ? &objects[i/10 - 1].get() : &scene;
+            Object* o = create(parent);
+            o->translate(Vector3::xAxis(Float(i % 10)));
+            objects.push_back(*o);
+        }
+        return objects;
+    }
+
+    SceneGraph::FlatObject3D* createFlat(SceneGraph::FlatObject3D* parent) {
+        return new SceneGraph::FlatObject3D{parent};
+    }
+
+    typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> LinkedObject3D;
+    typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> LinkedScene3D;
+
+    LinkedObject3D* createLinked(LinkedObject3D* parent) {
+        return new LinkedObject3D{parent};
+    }
+}
+
+void FlatObjectTest::transformations50k() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects = populate<Object3D>(scene, createFlat);
+
+    std::vector<Matrix4> transformations;
+    CORRADE_BENCHMARK(1) {
+        /* Move the first level so everything has to be recalculated */
+        objects[0].get().translate(Vector3::yAxis(1.0f));
+        transformations = scene.transformationMatrices(objects);
+    }
+
+    CORRADE_COMPARE(transformations.size(), std::size_t(BenchmarkObjectCount));
+}
+
+void FlatObjectTest::transformations50kObject() {
+    LinkedScene3D scene;
+    std::vector<std::reference_wrapper<LinkedObject3D>> objects = populate<LinkedObject3D>(scene, createLinked);
+
+    std::vector<Matrix4> transformations;
+    CORRADE_BENCHMARK(1) {
+        objects[0].get().translate(Vector3::yAxis(1.0f));
+        transformations = scene.transformationMatrices(objects);
+    }
+
+    CORRADE_COMPARE(transformations.size(), std::size_t(BenchmarkObjectCount));
+}
+
+void FlatObjectTest::cleanAll50k() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects = populate<Object3D>(scene, createFlat);
+    for(Object3D& o: objects) new CachingObject{&o};
+
+    CORRADE_BENCHMARK(1) {
+        objects[0].get().translate(Vector3::yAxis(1.0f));
+        scene.cleanAll();
+    }
+
+    CORRADE_VERIFY(!objects.back().get().isDirty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatObjectTest)
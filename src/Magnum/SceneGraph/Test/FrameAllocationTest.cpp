@@ -0,0 +1,303 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace {
+    /* Incremented on every heap allocation in the whole executable */
+    std::size_t allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if(void* const data = std::malloc(size ? size : 1)) return data;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* data) noexcept {
+    std::free(data);
+}
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+/* Verifies that the per-frame code paths don't allocate once the memory
+   reused across frames is large enough */
+struct FrameAllocationTest: TestSuite::Tester {
+    explicit FrameAllocationTest();
+
+    void objectSetClean();
+    void objectSetCleanList();
+    void abstractObjectSetCleanList();
+    void objectTransformationMatricesInto();
+    void sceneCleanAll();
+    void cameraDraw();
+    void cameraDrawCulled();
+    void cameraDrawSorted();
+    void cameraDrawInstanced();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+FrameAllocationTest::FrameAllocationTest() {
+    addTests({&FrameAllocationTest::objectSetClean,
+              &FrameAllocationTest::objectSetCleanList,
+              &FrameAllocationTest::abstractObjectSetCleanList,
+              &FrameAllocationTest::objectTransformationMatricesInto,
+              &FrameAllocationTest::sceneCleanAll,
+              &FrameAllocationTest::cameraDraw,
+              &FrameAllocationTest::cameraDrawCulled,
+              &FrameAllocationTest::cameraDrawSorted,
+              &FrameAllocationTest::cameraDrawInstanced});
+}
+
+namespace {
+
+/* Calls the function three times to let the reused memory grow, then returns
+   count of allocations done by the fourth call */
+template<class F> std::size_t frameAllocations(F f) {
+    for(std::size_t i = 0; i != 3; ++i) f();
+
+    const std::size_t count = allocationCount;
+    f();
+    return allocationCount - count;
+}
+
+class CountingDrawable: public SceneGraph::Drawable3D {
+    public:
+        explicit CountingDrawable(AbstractObject3D& object, DrawableGroup3D& group, std::size_t& drawCount): SceneGraph::Drawable3D{object, &group}, _drawCount(drawCount) {}
+
+    private:
+        void draw(const Matrix4&, Camera3D&) override { ++_drawCount; }
+
+        std::size_t& _drawCount;
+};
+
+class CountingBatch: public SceneGraph::InstancedDrawableBatch3D {
+    public:
+        explicit CountingBatch(std::size_t& drawCount): _drawCount(drawCount) {}
+
+    private:
+        void draw(Containers::ArrayView<const Matrix4> transformationMatrices, Containers::ArrayView<InstancedDrawable3D* const>, Camera3D&) override {
+            _drawCount += transformationMatrices.size();
+        }
+
+        std::size_t& _drawCount;
+};
+
+/* Four levels of objects, three children each, with a drawable on every
+   object */
+void populate(Object3D& parent, DrawableGroup3D& group, std::vector<std::reference_wrapper<Object3D>>& objects, std::size_t& drawCount, Int level = 0) {
+    for(Int i = 0; i != 3; ++i) {
+        Object3D* object = new Object3D{&parent};
+        object->translate({Float(i) - 1.0f, 0.0f, -2.0f});
+        new CountingDrawable{*object, group, drawCount};
+        objects.push_back(*object);
+        if(level != 3) populate(*object, group, objects, drawCount, level + 1);
+    }
+}
+
+}
+
+void FrameAllocationTest::objectSetClean() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+
+    Object3D& leaf = objects.back();
+    Object3D& root = *leaf.parent()->parent()->parent();
+    const std::size_t allocations = frameAllocations([&]{
+        root.rotateY(Deg(1.0f));
+        leaf.setClean();
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_VERIFY(!leaf.isDirty());
+}
+
+void FrameAllocationTest::objectSetCleanList() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+
+    const std::size_t allocations = frameAllocations([&]{
+        objects[0].get().rotateY(Deg(1.0f));
+        objects[objects.size()/2].get().rotateY(Deg(1.0f));
+        Object3D::setClean(objects);
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_VERIFY(!objects.back().get().isDirty());
+}
+
+void FrameAllocationTest::abstractObjectSetCleanList() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+
+    /* This is what Shapes::ShapeGroup and Audio::PlayableGroup use */
+    std::vector<std::reference_wrapper<AbstractObject3D>> abstractObjects{objects.begin(), objects.end()};
+    const std::size_t allocations = frameAllocations([&]{
+        objects[0].get().rotateY(Deg(1.0f));
+        AbstractObject3D::setClean(abstractObjects);
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_VERIFY(!objects.back().get().isDirty());
+}
+
+void FrameAllocationTest::objectTransformationMatricesInto() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+
+    std::vector<Matrix4> transformations;
+    const std::size_t allocations = frameAllocations([&]{
+        objects[0].get().rotateY(Deg(1.0f));
+        scene.transformationMatricesInto(objects, transformations);
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_COMPARE(transformations.size(), objects.size());
+    CORRADE_COMPARE(transformations.back(), objects.back().get().absoluteTransformationMatrix());
+}
+
+void FrameAllocationTest::sceneCleanAll() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+
+    const std::size_t allocations = frameAllocations([&]{
+        objects[0].get().rotateY(Deg(1.0f));
+        objects[objects.size()/2].get().rotateY(Deg(1.0f));
+        scene.cleanAll();
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_VERIFY(!objects.back().get().isDirty());
+}
+
+void FrameAllocationTest::cameraDraw() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    const std::size_t allocations = frameAllocations([&]{
+        cameraObject.rotateY(Deg(1.0f));
+        camera.draw(group);
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_COMPARE(drawCount, 4*group.size());
+}
+
+void FrameAllocationTest::cameraDrawCulled() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        if(i % 2) group[i].setBoundingSphere({}, 0.5f);
+        else group[i].setBoundingBox({Vector3{-0.5f}, Vector3{0.5f}});
+    }
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    /* Narrow field of view, so some drawables are culled */
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(10.0f), 1.0f, 0.1f, 100.0f));
+    const std::size_t allocations = frameAllocations([&]{
+        cameraObject.rotateY(Deg(1.0f));
+        camera.draw(group);
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_VERIFY(camera.culledDrawableCount() > 0);
+    CORRADE_VERIFY(camera.culledDrawableCount() < group.size());
+}
+
+void FrameAllocationTest::cameraDrawSorted() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+    for(std::size_t i = 0; i != group.size(); ++i)
+        group[i].setSortKey(i % 3);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    const std::size_t allocations = frameAllocations([&]{
+        cameraObject.rotateY(Deg(1.0f));
+        camera.draw(group, DrawOrder::StateFrontToBack);
+        camera.draw(group, DrawOrder::BackToFrontState);
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_COMPARE(drawCount, 8*group.size());
+}
+
+void FrameAllocationTest::cameraDrawInstanced() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::size_t drawCount = 0;
+    populate(scene, group, objects, drawCount);
+
+    /* Add instanced drawables in two batches to every object */
+    std::size_t instanceCount = 0;
+    CountingBatch a{instanceCount}, b{instanceCount};
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        new InstancedDrawable3D{objects[i], i % 2 ? a : b, &group};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    const std::size_t allocations = frameAllocations([&]{
+        cameraObject.rotateY(Deg(1.0f));
+        camera.draw(group);
+        camera.draw(group, DrawOrder::StateFrontToBack);
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_COMPARE(drawCount, 8*objects.size());
+    CORRADE_COMPARE(instanceCount, 8*objects.size());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FrameAllocationTest)
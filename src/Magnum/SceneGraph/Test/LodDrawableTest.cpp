@@ -0,0 +1,398 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/LodDrawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct LodDrawableTest: TestSuite::Tester {
+    explicit LodDrawableTest();
+
+    void chainConstruct();
+    void chainConstructNotSorted();
+    void chainConstructInvalidHysteresis();
+    void chainDrawCountOutOfRange();
+
+    void projectedSize2D();
+    void projectedSize3D();
+    void projectedSize3DOrthographic();
+    void projectedSizeCameraInside();
+    void projectedSizeNoBoundingVolume();
+
+    void draw();
+    void drawHysteresis();
+    void drawCulled();
+    void resetStatistics();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+LodDrawableTest::LodDrawableTest() {
+    addTests({&LodDrawableTest::chainConstruct,
+              &LodDrawableTest::chainConstructNotSorted,
+              &LodDrawableTest::chainConstructInvalidHysteresis,
+              &LodDrawableTest::chainDrawCountOutOfRange,
+
+              &LodDrawableTest::projectedSize2D,
+              &LodDrawableTest::projectedSize3D,
+              &LodDrawableTest::projectedSize3DOrthographic,
+              &LodDrawableTest::projectedSizeCameraInside,
+              &LodDrawableTest::projectedSizeNoBoundingVolume,
+
+              &LodDrawableTest::draw,
+              &LodDrawableTest::drawHysteresis,
+              &LodDrawableTest::drawCulled,
+              &LodDrawableTest::resetStatistics});
+}
+
+namespace {
+
+template<UnsignedInt dimensions> struct RecordingDrawable: LodDrawable<dimensions, Float> {
+    explicit RecordingDrawable(AbstractObject<dimensions, Float>& object, LodChain<dimensions, Float>& chain, DrawableGroup<dimensions, Float>* drawables, std::vector<std::pair<Int, UnsignedInt>>* drawn = nullptr, Int id = 0): LodDrawable<dimensions, Float>{object, chain, drawables}, drawn{drawn}, id{id} {}
+
+    void drawLevel(UnsignedInt level, const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {
+        drawn->emplace_back(id, level);
+    }
+
+    std::vector<std::pair<Int, UnsignedInt>>* drawn;
+    Int id;
+};
+
+/* Camera in the origin looking down -Z. Sphere of radius 1 at distance d is
+   100/d pixels large. */
+struct Camera3DSetup {
+    explicit Camera3DSetup(): cameraObject{&scene}, camera{cameraObject} {
+        camera.setViewport({100, 100});
+        camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 1000.0f));
+    }
+
+    Scene3D scene;
+    Object3D cameraObject;
+    Camera3D camera;
+};
+
+}
+
+void LodDrawableTest::chainConstruct() {
+    LodChain3D chain{{50.0f, 20.0f, 20.0f, 5.0f}, 0.25f};
+    CORRADE_COMPARE(chain.levelCount(), 4);
+    CORRADE_COMPARE(chain.minimalSizes(), (std::vector<Float>{50.0f, 20.0f, 20.0f, 5.0f}));
+    CORRADE_COMPARE(chain.hysteresis(), 0.25f);
+    CORRADE_COMPARE(chain.skipCount(), 0);
+    CORRADE_COMPARE(chain.switchCount(), 0);
+    CORRADE_COMPARE(chain.drawCount(3), 0);
+
+    CORRADE_COMPARE(chain.levelFor(Constants::inf()), 0);
+    CORRADE_COMPARE(chain.levelFor(50.0f), 0);
+    CORRADE_COMPARE(chain.levelFor(49.9f), 1);
+    CORRADE_COMPARE(chain.levelFor(20.0f), 1);
+    CORRADE_COMPARE(chain.levelFor(5.0f), 3);
+    CORRADE_COMPARE(chain.levelFor(4.9f), 4);
+    CORRADE_COMPARE(chain.levelFor(0.0f), 4);
+
+    /* Default hysteresis, least detailed level drawn always */
+    LodChain2D chain2{{10.0f, 0.0f}};
+    CORRADE_COMPARE(chain2.hysteresis(), 0.1f);
+    CORRADE_COMPARE(chain2.levelFor(0.0f), 1);
+}
+
+void LodDrawableTest::chainConstructNotSorted() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    LodChain3D{{5.0f, 20.0f}};
+    CORRADE_COMPARE(out.str(), "SceneGraph::LodChain: minimal sizes are not in descending order\n");
+}
+
+void LodDrawableTest::chainConstructInvalidHysteresis() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    LodChain3D{{20.0f, 5.0f}, 1.0f};
+    LodChain3D{{20.0f, 5.0f}, -0.5f};
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::LodChain: hysteresis expected to be in range [0, 1) but got 1\n"
+        "SceneGraph::LodChain: hysteresis expected to be in range [0, 1) but got -0.5\n");
+}
+
+void LodDrawableTest::chainDrawCountOutOfRange() {
+    LodChain3D chain{{20.0f, 5.0f}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    chain.drawCount(2);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LodChain::drawCount(): level 2 out of range for 2 levels\n");
+}
+
+void LodDrawableTest::projectedSize2D() {
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.setViewport({200, 200});
+    camera.setProjectionMatrix(Matrix3::projection({20.0f, 20.0f}));
+
+    LodChain2D chain{{10.0f}};
+    Object2D object{&scene};
+    RecordingDrawable<2> drawable{object, chain, nullptr};
+
+    /* Sphere of diameter 2 in a 20-unit wide view of 200 pixels */
+    drawable.setBoundingSphere({1.0f, 0.0f}, 1.0f);
+    CORRADE_COMPARE(drawable.projectedSize(Matrix3::translation({3.0f, 2.0f}), camera), 20.0f);
+    CORRADE_COMPARE(drawable.projectedSize(Matrix3::scaling({1.0f, 3.0f}), camera), 60.0f);
+
+    /* Square with side 2 */
+    drawable.setBoundingBox({{-1.0f, -1.0f}, {1.0f, 1.0f}});
+    CORRADE_COMPARE(drawable.projectedSize({}, camera), 20.0f*Constants::sqrt2());
+}
+
+void LodDrawableTest::projectedSize3D() {
+    Camera3DSetup setup;
+    LodChain3D chain{{10.0f}};
+    Object3D object{&setup.scene};
+    RecordingDrawable<3> drawable{object, chain, nullptr};
+
+    drawable.setBoundingSphere({0.0f, 0.0f, 1.0f}, 1.0f);
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-11.0f)), setup.camera), 10.0f);
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-21.0f)), setup.camera), 5.0f);
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-20.5f))*Matrix4::scaling({0.5f, 2.0f, 0.5f}), setup.camera), 10.0f);
+
+    /* Cube with side 2 */
+    drawable.setBoundingBox({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-10.0f)), setup.camera), 10.0f*Constants::sqrt3());
+
+    /* Viewport size affects the result */
+    setup.camera.setViewport({200, 100});
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-10.0f)), setup.camera), 20.0f*Constants::sqrt3());
+}
+
+void LodDrawableTest::projectedSize3DOrthographic() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setViewport({100, 100});
+    camera.setProjectionMatrix(Matrix4::orthographicProjection({20.0f, 20.0f}, 0.1f, 1000.0f));
+
+    LodChain3D chain{{10.0f}};
+    Object3D object{&scene};
+    RecordingDrawable<3> drawable{object, chain, nullptr};
+    drawable.setBoundingSphere({}, 1.0f);
+
+    /* The distance doesn't matter */
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-10.0f)), camera), 10.0f);
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-100.0f)), camera), 10.0f);
+}
+
+void LodDrawableTest::projectedSizeCameraInside() {
+    Camera3DSetup setup;
+    LodChain3D chain{{10.0f}};
+    Object3D object{&setup.scene};
+    RecordingDrawable<3> drawable{object, chain, nullptr};
+    drawable.setBoundingSphere({}, 2.0f);
+
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-1.0f)), setup.camera), Constants::inf());
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(1.0f)), setup.camera), Constants::inf());
+}
+
+void LodDrawableTest::projectedSizeNoBoundingVolume() {
+    Camera3DSetup setup;
+    LodChain3D chain{{10.0f}};
+    Object3D object{&setup.scene};
+    RecordingDrawable<3> drawable{object, chain, nullptr};
+
+    CORRADE_COMPARE(drawable.projectedSize(Matrix4::translation(Vector3::zAxis(-1000.0f)), setup.camera), Constants::inf());
+}
+
+void LodDrawableTest::draw() {
+    Camera3DSetup setup;
+    LodChain3D chain{{50.0f, 20.0f, 5.0f}, 0.0f};
+    DrawableGroup3D group;
+    std::vector<std::pair<Int, UnsignedInt>> drawn;
+
+    /* 66, 25, 10 and 2 pixels large, the last one has no bounding volume */
+    Object3D a{&setup.scene}, b{&setup.scene}, c{&setup.scene}, d{&setup.scene}, e{&setup.scene};
+    a.translate(Vector3::zAxis(-1.5f));
+    b.translate(Vector3::zAxis(-4.0f));
+    c.translate(Vector3::zAxis(-10.0f));
+    d.translate(Vector3::zAxis(-50.0f));
+    e.translate(Vector3::zAxis(-500.0f));
+    RecordingDrawable<3> da{a, chain, &group, &drawn, 0};
+    RecordingDrawable<3> db{b, chain, &group, &drawn, 1};
+    RecordingDrawable<3> dc{c, chain, &group, &drawn, 2};
+    RecordingDrawable<3> dd{d, chain, &group, &drawn, 3};
+    RecordingDrawable<3> de{e, chain, &group, &drawn, 4};
+    da.setBoundingSphere({}, 1.0f);
+    db.setBoundingSphere({}, 1.0f);
+    dc.setBoundingSphere({}, 1.0f);
+    dd.setBoundingSphere({}, 1.0f);
+
+    CORRADE_COMPARE(da.level(), 3);
+
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<std::pair<Int, UnsignedInt>>{
+        {0, 0}, {1, 1}, {2, 2}, {4, 0}}));
+    CORRADE_COMPARE(da.level(), 0);
+    CORRADE_COMPARE(db.level(), 1);
+    CORRADE_COMPARE(dc.level(), 2);
+    CORRADE_COMPARE(dd.level(), 3);
+    CORRADE_COMPARE(de.level(), 0);
+    CORRADE_COMPARE(chain.drawCount(0), 2);
+    CORRADE_COMPARE(chain.drawCount(1), 1);
+    CORRADE_COMPARE(chain.drawCount(2), 1);
+    CORRADE_COMPARE(chain.skipCount(), 1);
+
+    /* The first selection is not counted as a switch */
+    CORRADE_COMPARE(chain.switchCount(), 0);
+
+    /* Moving the first one away, statistics accumulate */
+    a.translate(Vector3::zAxis(-50.0f));
+    drawn.clear();
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<std::pair<Int, UnsignedInt>>{
+        {1, 1}, {2, 2}, {4, 0}}));
+    CORRADE_COMPARE(da.level(), 3);
+    CORRADE_COMPARE(chain.drawCount(0), 3);
+    CORRADE_COMPARE(chain.skipCount(), 3);
+    CORRADE_COMPARE(chain.switchCount(), 1);
+}
+
+void LodDrawableTest::drawHysteresis() {
+    Camera3DSetup setup;
+    LodChain3D chain{{20.0f, 5.0f}, 0.2f};
+    DrawableGroup3D group;
+    std::vector<std::pair<Int, UnsignedInt>> drawn;
+
+    Object3D object{&setup.scene};
+    RecordingDrawable<3> drawable{object, chain, &group, &drawn};
+    drawable.setBoundingSphere({}, 1.0f);
+
+    /* 25 pixels */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-4.0f)));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawable.level(), 0);
+
+    /* 18.2 pixels, not enough to switch */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-5.5f)));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawable.level(), 0);
+    CORRADE_COMPARE(chain.switchCount(), 0);
+
+    /* 14.3 pixels, switches */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-7.0f)));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawable.level(), 1);
+    CORRADE_COMPARE(chain.switchCount(), 1);
+
+    /* 22.2 pixels, not enough to switch back */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-4.5f)));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawable.level(), 1);
+    CORRADE_COMPARE(chain.switchCount(), 1);
+
+    /* 28.6 pixels, switches back */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-3.5f)));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawable.level(), 0);
+    CORRADE_COMPARE(chain.switchCount(), 2);
+
+    /* 4.5 pixels, still drawn with the last level */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-22.0f)));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawable.level(), 1);
+    CORRADE_COMPARE(chain.skipCount(), 0);
+
+    /* 3.3 pixels, skipped */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-30.0f)));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(drawable.level(), 2);
+    CORRADE_COMPARE(chain.skipCount(), 1);
+    CORRADE_COMPARE(chain.switchCount(), 4);
+
+    CORRADE_COMPARE(drawn, (std::vector<std::pair<Int, UnsignedInt>>{
+        {0, 0}, {0, 0}, {0, 1}, {0, 1}, {0, 0}, {0, 1}}));
+}
+
+void LodDrawableTest::drawCulled() {
+    Camera3DSetup setup;
+    LodChain3D chain{{20.0f, 5.0f}};
+    DrawableGroup3D group;
+    std::vector<std::pair<Int, UnsignedInt>> drawn;
+
+    /* Outside of the frustum, not drawn at all, doesn't affect the
+       statistics */
+    Object3D object{&setup.scene};
+    object.translate(Vector3::zAxis(4.0f));
+    RecordingDrawable<3> drawable{object, chain, &group, &drawn};
+    drawable.setBoundingSphere({}, 1.0f);
+
+    setup.camera.draw(group);
+    CORRADE_VERIFY(drawn.empty());
+    CORRADE_COMPARE(setup.camera.culledDrawableCount(), 1);
+    CORRADE_COMPARE(drawable.level(), 2);
+    CORRADE_COMPARE(chain.skipCount(), 0);
+}
+
+void LodDrawableTest::resetStatistics() {
+    Camera3DSetup setup;
+    LodChain3D chain{{20.0f, 5.0f}};
+    DrawableGroup3D group;
+    std::vector<std::pair<Int, UnsignedInt>> drawn;
+
+    Object3D a{&setup.scene}, b{&setup.scene};
+    a.translate(Vector3::zAxis(-4.0f));
+    b.translate(Vector3::zAxis(-100.0f));
+    RecordingDrawable<3> da{a, chain, &group, &drawn};
+    RecordingDrawable<3> db{b, chain, &group, &drawn};
+    da.setBoundingSphere({}, 1.0f);
+    db.setBoundingSphere({}, 1.0f);
+
+    setup.camera.draw(group);
+    a.translate(Vector3::zAxis(-10.0f));
+    setup.camera.draw(group);
+    CORRADE_COMPARE(chain.drawCount(0), 1);
+    CORRADE_COMPARE(chain.drawCount(1), 1);
+    CORRADE_COMPARE(chain.skipCount(), 2);
+    CORRADE_COMPARE(chain.switchCount(), 1);
+
+    chain.resetStatistics();
+    CORRADE_COMPARE(chain.drawCount(0), 0);
+    CORRADE_COMPARE(chain.drawCount(1), 0);
+    CORRADE_COMPARE(chain.skipCount(), 0);
+    CORRADE_COMPARE(chain.switchCount(), 0);
+
+    /* The selected levels are kept */
+    CORRADE_COMPARE(da.level(), 1);
+    CORRADE_COMPARE(db.level(), 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::LodDrawableTest)
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
@@ -41,13 +42,32 @@ struct ObjectTest: TestSuite::Tester {
     void scene();
     void setParentKeepTransformation();
     void absoluteTransformation();
+    void absoluteTransformationCached();
+    void absoluteTransformationCachedParentChanged();
+    void absoluteTransformationCachedReparented();
+    void absoluteTransformationCachedPartially();
     void transformations();
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationsManyObjects();
+    void transformationsDeepHierarchy();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
+    void setCleanListParallel();
+    void setDirtyChildren();
+    void setDirtyPropagateOnClean();
+    void sceneCleanAll();
+    void sceneCleanAllParallel();
+    void sceneDirtyObjectsDestroyed();
+    void sceneDirtyObjectsMovedToOtherScene();
+
+    void setDirtyCleanAll50k();
+    void setDirtyCleanList50k();
+    void absoluteTransformation50k();
+    void absoluteTransformationCached50k();
+    void absoluteTransformationCached50kMoved();
 
     void rangeBasedForChildren();
     void rangeBasedForFeatures();
@@ -56,6 +76,16 @@ struct ObjectTest: TestSuite::Tester {
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
+class DirtyCountingFeature: public AbstractFeature3D {
+    public:
+        explicit DirtyCountingFeature(AbstractObject3D& object): AbstractFeature3D{object} {}
+
+        Int markedDirty{};
+
+    protected:
+        void markDirty() override { ++markedDirty; }
+};
+
 class CachingObject: public Object3D, AbstractFeature3D {
     public:
         CachingObject(Object3D* parent = nullptr): Object3D(parent), AbstractFeature3D(*this) {
@@ -78,16 +108,35 @@ ObjectTest::ObjectTest() {
               &ObjectTest::scene,
               &ObjectTest::setParentKeepTransformation,
               &ObjectTest::absoluteTransformation,
+              &ObjectTest::absoluteTransformationCached,
+              &ObjectTest::absoluteTransformationCachedParentChanged,
+              &ObjectTest::absoluteTransformationCachedReparented,
+              &ObjectTest::absoluteTransformationCachedPartially,
               &ObjectTest::transformations,
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsManyObjects,
+              &ObjectTest::transformationsDeepHierarchy,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
               &ObjectTest::setCleanListBulk,
+              &ObjectTest::setCleanListParallel,
+              &ObjectTest::setDirtyChildren,
+              &ObjectTest::setDirtyPropagateOnClean,
+              &ObjectTest::sceneCleanAll,
+              &ObjectTest::sceneCleanAllParallel,
+              &ObjectTest::sceneDirtyObjectsDestroyed,
+              &ObjectTest::sceneDirtyObjectsMovedToOtherScene,
 
               &ObjectTest::rangeBasedForChildren,
               &ObjectTest::rangeBasedForFeatures});
+
+    addBenchmarks({&ObjectTest::setDirtyCleanAll50k,
+                   &ObjectTest::setDirtyCleanList50k,
+                   &ObjectTest::absoluteTransformation50k,
+                   &ObjectTest::absoluteTransformationCached50k,
+                   &ObjectTest::absoluteTransformationCached50kMoved}, 5);
 }
 
 void ObjectTest::addFeature() {
@@ -205,6 +254,126 @@ void ObjectTest::absoluteTransformation() {
     CORRADE_COMPARE(o3.absoluteTransformation(), Matrix4::translation({1.0f, 2.0f, 3.0f}));
 }
 
+void ObjectTest::absoluteTransformationCached() {
+    Scene3D s;
+    Object3D o{&s};
+    o.translate(Vector3::xAxis(2.0f));
+    Object3D o2{&o};
+    o2.rotateY(Deg(90.0f));
+    CORRADE_VERIFY(!o2.isAbsoluteTransformationCached());
+
+    o2.setAbsoluteTransformationCached(true);
+    CORRADE_VERIFY(o2.isAbsoluteTransformationCached());
+    CORRADE_COMPARE(o2.absoluteTransformation(),
+        Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::rotationY(Deg(90.0f)));
+    /* Second time it's taken from the cache */
+    CORRADE_COMPARE(o2.absoluteTransformation(),
+        Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::rotationY(Deg(90.0f)));
+    CORRADE_COMPARE(o2.absoluteTransformationMatrix(),
+        Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::rotationY(Deg(90.0f)));
+
+    /* Own transformation change gets picked up */
+    o2.translate(Vector3::yAxis(1.0f));
+    CORRADE_COMPARE(o2.absoluteTransformation(),
+        Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::translation(Vector3::yAxis(1.0f))*Matrix4::rotationY(Deg(90.0f)));
+
+    /* Also when the object was already dirty before */
+    CORRADE_VERIFY(o2.isDirty());
+    o2.resetTransformation();
+    CORRADE_COMPARE(o2.absoluteTransformation(), Matrix4::translation(Vector3::xAxis(2.0f)));
+
+    /* Disabling the cache */
+    o2.setAbsoluteTransformationCached(false);
+    CORRADE_VERIFY(!o2.isAbsoluteTransformationCached());
+    o2.translate(Vector3::zAxis(1.0f));
+    CORRADE_COMPARE(o2.absoluteTransformation(), Matrix4::translation({2.0f, 0.0f, 1.0f}));
+
+    /* Root object */
+    Object3D o3;
+    o3.setAbsoluteTransformationCached(true)
+      .translate({1.0f, 2.0f, 3.0f});
+    CORRADE_COMPARE(o3.absoluteTransformation(), Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    o3.translate({1.0f, 2.0f, 3.0f});
+    CORRADE_COMPARE(o3.absoluteTransformation(), Matrix4::translation({2.0f, 4.0f, 6.0f}));
+}
+
+void ObjectTest::absoluteTransformationCachedParentChanged() {
+    Scene3D s;
+    Object3D a{&s};
+    Object3D b{&a};
+    Object3D c{&b};
+    a.translate(Vector3::xAxis(1.0f));
+    b.translate(Vector3::yAxis(1.0f));
+    c.translate(Vector3::zAxis(1.0f));
+    a.setAbsoluteTransformationCached(true);
+    c.setAbsoluteTransformationCached(true);
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 1.0f}));
+
+    /* Change in unrelated object doesn't affect anything */
+    Object3D d{&s};
+    d.translate(Vector3::xAxis(5.0f));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 1.0f}));
+
+    /* Change in uncached parent */
+    b.translate(Vector3::yAxis(1.0f));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({1.0f, 2.0f, 1.0f}));
+
+    /* Change in cached parent, queried through the child first */
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({2.0f, 2.0f, 1.0f}));
+    CORRADE_COMPARE(a.absoluteTransformation(), Matrix4::translation({2.0f, 0.0f, 0.0f}));
+
+    /* Change in cached parent, queried through the parent first */
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(a.absoluteTransformation(), Matrix4::translation({3.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({3.0f, 2.0f, 1.0f}));
+}
+
+void ObjectTest::absoluteTransformationCachedReparented() {
+    Scene3D s;
+    Object3D a{&s};
+    Object3D b{&s};
+    Object3D c{&a};
+    a.translate(Vector3::xAxis(1.0f));
+    b.translate(Vector3::yAxis(1.0f));
+    c.setAbsoluteTransformationCached(true);
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    c.setParent(&b);
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation(Vector3::yAxis(1.0f)));
+
+    /* Reparenting the parent is detected too */
+    b.setParent(&a);
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 0.0f}));
+
+    c.setParent(nullptr);
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4{});
+}
+
+void ObjectTest::absoluteTransformationCachedPartially() {
+    /* Deep hierarchy with every third object cached, compared to the same
+       hierarchy without any caching */
+    Scene3D s1, s2;
+    std::vector<Object3D*> cached, uncached;
+    for(std::size_t i = 0; i != 30; ++i) {
+        cached.push_back(new Object3D{i ? cached.back() : &s1});
+        uncached.push_back(new Object3D{i ? uncached.back() : &s2});
+        cached.back()->setAbsoluteTransformationCached(i % 3 == 1);
+        cached.back()->rotateZ(Deg(Float(i)));
+        uncached.back()->rotateZ(Deg(Float(i)));
+        cached.back()->translate(Vector3::xAxis(Float(i)));
+        uncached.back()->translate(Vector3::xAxis(Float(i)));
+    }
+
+    for(std::size_t i: {29, 14, 29, 0, 29, 1, 1}) {
+        for(std::size_t j = 0; j != 30; ++j)
+            CORRADE_COMPARE(cached[j]->absoluteTransformation(), uncached[j]->absoluteTransformation());
+
+        cached[i]->translate(Vector3::yAxis(1.0f));
+        uncached[i]->translate(Vector3::yAxis(1.0f));
+    }
+}
+
 void ObjectTest::transformations() {
     Scene3D s;
 
@@ -304,6 +473,56 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsManyObjects() {
+    Scene3D s;
+
+    /* More than 65535 objects, which was a limit in the past. Each group of
+       four objects shares a parent, so there's also more than 65535 joints
+       in total. */
+    std::vector<Object3D*> parents;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    for(std::size_t i = 0; i != 20000; ++i) {
+        Object3D* parent = new Object3D{&s};
+        parent->translate(Vector3::xAxis(Float(i)));
+        parents.push_back(parent);
+        for(std::size_t j = 0; j != 4; ++j) {
+            Object3D* o = new Object3D{parent};
+            o->translate(Vector3::yAxis(Float(j)));
+            objects.push_back(*o);
+        }
+    }
+    for(Object3D* parent: parents) objects.push_back(*parent);
+
+    std::vector<Matrix4> transformations = s.transformations(objects, Matrix4::translation(Vector3::zAxis(1.0f)));
+    CORRADE_COMPARE(transformations.size(), 100000);
+    CORRADE_COMPARE(transformations[0], Matrix4::translation({0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(transformations[4*12345 + 3], Matrix4::translation({12345.0f, 3.0f, 1.0f}));
+    CORRADE_COMPARE(transformations[80000 + 19999], Matrix4::translation({19999.0f, 0.0f, 1.0f}));
+}
+
+void ObjectTest::transformationsDeepHierarchy() {
+    Scene3D s;
+
+    /* A long chain where every object is a joint, which would overflow the
+       stack when processed recursively */
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    Object3D* parent = &s;
+    for(std::size_t i = 0; i != 10000; ++i) {
+        parent = new Object3D{parent};
+        parent->translate(Vector3::xAxis(1.0f));
+        objects.push_back(*parent);
+    }
+
+    /* Reversed so the deepest joint is processed first */
+    std::reverse(objects.begin(), objects.end());
+
+    std::vector<Matrix4> transformations = s.transformations(objects);
+    CORRADE_COMPARE(transformations.size(), 10000);
+    CORRADE_COMPARE(transformations.front(), Matrix4::translation(Vector3::xAxis(10000.0f)));
+    CORRADE_COMPARE(transformations[5000], Matrix4::translation(Vector3::xAxis(5000.0f)));
+    CORRADE_COMPARE(transformations.back(), Matrix4::translation(Vector3::xAxis(1.0f)));
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -484,6 +703,332 @@ void ObjectTest::setCleanListBulk() {
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
 }
 
+void ObjectTest::setCleanListParallel() {
+    Scene3D scene;
+
+    /* A few parents with many caching children, the list contains the
+       children twice and none of the parents */
+    std::vector<CachingObject*> objects;
+    std::vector<std::reference_wrapper<Object3D>> list;
+    for(std::size_t i = 0; i != 10; ++i) {
+        CachingObject* parent = new CachingObject{&scene};
+        parent->translate(Vector3::xAxis(Float(i)));
+        objects.push_back(parent);
+        for(std::size_t j = 0; j != 100; ++j) {
+            CachingObject* child = new CachingObject{parent};
+            child->rotateY(Deg(Float(j)));
+            objects.push_back(child);
+            list.push_back(*child);
+            list.push_back(*child);
+        }
+    }
+
+    /* Zero means all available threads, make sure that works too */
+    for(UnsignedInt threadCount: {4u, 0u}) {
+        scene.setDirty();
+        for(CachingObject* o: objects) o->cleanedAbsoluteTransformation = Matrix4{Math::ZeroInit};
+
+        Object3D::setClean(list, threadCount);
+        for(CachingObject* o: objects) {
+            CORRADE_VERIFY(!o->isDirty());
+            CORRADE_COMPARE(o->cleanedAbsoluteTransformation, o->absoluteTransformationMatrix());
+        }
+    }
+}
+
+void ObjectTest::setDirtyChildren() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+    Object3D c{&b};
+    DirtyCountingFeature aFeature{a};
+    DirtyCountingFeature cFeature{c};
+    c.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+
+    /* Marking a parent dirty makes the children dirty too, but markDirty()
+       is called only on features of the object itself */
+    a.setDirty();
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_COMPARE(aFeature.markedDirty, 1);
+    CORRADE_COMPARE(cFeature.markedDirty, 0);
+
+    /* Marking it again doesn't do anything */
+    a.setDirty();
+    CORRADE_COMPARE(aFeature.markedDirty, 1);
+
+    /* Marking a child dirty explicitly calls markDirty() on its features */
+    c.setDirty();
+    CORRADE_COMPARE(cFeature.markedDirty, 1);
+
+    /* Cleaning the leaf cleans all */
+    c.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+}
+
+void ObjectTest::setDirtyPropagateOnClean() {
+    Scene3D scene;
+    Object3D a{&scene};
+    CachingObject* b = new CachingObject{&a};
+    CachingObject* c = new CachingObject{&a};
+    c->translate(Vector3::yAxis(2.0f));
+    CachingObject* d = new CachingObject{c};
+    d->translate(Vector3::xAxis(3.0f));
+    DirtyCountingFeature cFeature{*c};
+    DirtyCountingFeature dFeature{*d};
+    scene.cleanAll();
+    CORRADE_VERIFY(!d->isDirty());
+
+    a.translate(Vector3::zAxis(1.0f));
+    CORRADE_VERIFY(b->isDirty());
+    CORRADE_VERIFY(c->isDirty());
+    CORRADE_VERIFY(d->isDirty());
+    CORRADE_COMPARE(cFeature.markedDirty, 0);
+
+    /* Cleaning one child marks the other one as dirty, calling markDirty() on
+       its features. Its children are still dirty implicitly. */
+    b->setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b->isDirty());
+    CORRADE_VERIFY(c->isDirty());
+    CORRADE_VERIFY(d->isDirty());
+    CORRADE_COMPARE(cFeature.markedDirty, 1);
+    CORRADE_COMPARE(dFeature.markedDirty, 0);
+    CORRADE_COMPARE(b->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(1.0f)));
+
+    /* The same when cleaning through a list */
+    Object3D::setClean({*c});
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_VERIFY(d->isDirty());
+    CORRADE_COMPARE(dFeature.markedDirty, 1);
+    CORRADE_COMPARE(c->cleanedAbsoluteTransformation, Matrix4::translation({0.0f, 2.0f, 1.0f}));
+
+    /* The pushed-down dirty state gets cleaned by the scene as well */
+    scene.cleanAll();
+    CORRADE_VERIFY(!d->isDirty());
+    CORRADE_COMPARE(d->cleanedAbsoluteTransformation, Matrix4::translation({3.0f, 2.0f, 1.0f}));
+}
+
+void ObjectTest::sceneCleanAll() {
+    Scene3D scene;
+    CachingObject* a = new CachingObject{&scene};
+    a->scale(Vector3(2.0f));
+    CachingObject* b = new CachingObject{a};
+    b->translate(Vector3::xAxis(1.0f));
+    CachingObject* c = new CachingObject{b};
+    c->rotateY(Deg(90.0f));
+    CachingObject* d = new CachingObject{&scene};
+    d->translate(Vector3::yAxis(-1.0f));
+
+    /* Everything is dirty at the beginning */
+    scene.cleanAll();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_VERIFY(!b->isDirty());
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_VERIFY(!d->isDirty());
+    CORRADE_COMPARE(a->cleanedAbsoluteTransformation, a->absoluteTransformationMatrix());
+    CORRADE_COMPARE(b->cleanedAbsoluteTransformation, b->absoluteTransformationMatrix());
+    CORRADE_COMPARE(c->cleanedAbsoluteTransformation, c->absoluteTransformationMatrix());
+    CORRADE_COMPARE(d->cleanedAbsoluteTransformation, d->absoluteTransformationMatrix());
+
+    /* Only the dirty subtree is cleaned, including objects marked dirty in
+       both the subtree and its parent */
+    d->cleanedAbsoluteTransformation = Matrix4{Math::ZeroInit};
+    c->translate(Vector3::zAxis(1.0f));
+    b->translate(Vector3::zAxis(1.0f));
+    scene.cleanAll();
+    CORRADE_VERIFY(!b->isDirty());
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_COMPARE(b->cleanedAbsoluteTransformation, b->absoluteTransformationMatrix());
+    CORRADE_COMPARE(c->cleanedAbsoluteTransformation, c->absoluteTransformationMatrix());
+    CORRADE_COMPARE(d->cleanedAbsoluteTransformation, Matrix4{Math::ZeroInit});
+
+    /* Nothing dirty, nothing to do */
+    b->cleanedAbsoluteTransformation = Matrix4{Math::ZeroInit};
+    scene.cleanAll();
+    CORRADE_COMPARE(b->cleanedAbsoluteTransformation, Matrix4{Math::ZeroInit});
+}
+
+void ObjectTest::sceneCleanAllParallel() {
+    Scene3D scene;
+    std::vector<CachingObject*> objects;
+    for(std::size_t i = 0; i != 10; ++i) {
+        CachingObject* parent = new CachingObject{&scene};
+        parent->translate(Vector3::xAxis(Float(i)));
+        objects.push_back(parent);
+        for(std::size_t j = 0; j != 100; ++j) {
+            CachingObject* child = new CachingObject{parent};
+            child->rotateY(Deg(Float(j)));
+            objects.push_back(child);
+        }
+    }
+
+    for(UnsignedInt threadCount: {4u, 0u}) {
+        scene.setDirty();
+        scene.cleanAll(threadCount);
+        for(CachingObject* o: objects) {
+            CORRADE_VERIFY(!o->isDirty());
+            CORRADE_COMPARE(o->cleanedAbsoluteTransformation, o->absoluteTransformationMatrix());
+        }
+    }
+}
+
+void ObjectTest::sceneDirtyObjectsDestroyed() {
+    Scene3D scene;
+    CachingObject* a = new CachingObject{&scene};
+    Object3D* b = new Object3D{a};
+    new Object3D{b};
+    CachingObject* c = new CachingObject{&scene};
+
+    /* Destroying dirty objects removes them from the scene */
+    delete b;
+    scene.cleanAll();
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_VERIFY(!c->isDirty());
+
+    /* Objects marked dirty by cleaning their siblings as well */
+    Object3D* d = new Object3D{a};
+    Object3D* e = new Object3D{a};
+    a->setDirty();
+    d->setClean();
+    CORRADE_VERIFY(e->isDirty());
+    delete e;
+    a->translate(Vector3::xAxis(1.0f));
+    delete a;
+    c->translate(Vector3::xAxis(1.0f));
+    scene.cleanAll();
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_COMPARE(c->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(1.0f)));
+}
+
+void ObjectTest::sceneDirtyObjectsMovedToOtherScene() {
+    Scene3D scene1;
+    Scene3D scene2;
+    CachingObject* a = new CachingObject{&scene1};
+    a->translate(Vector3::xAxis(1.0f));
+    CachingObject* b = new CachingObject{a};
+    b->setDirty();
+
+    /* Moving an object to another scene moves it to the dirty object list of
+       the new scene */
+    a->setParent(&scene2);
+    scene1.cleanAll();
+    CORRADE_VERIFY(a->isDirty());
+    CORRADE_VERIFY(b->isDirty());
+    scene2.cleanAll();
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_VERIFY(!b->isDirty());
+    CORRADE_COMPARE(b->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* Object which was removed from a scene while dirty gets added to the
+       list once it's back */
+    b->setDirty();
+    a->setParent(nullptr);
+    a->setParent(&scene1);
+    scene1.cleanAll();
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_VERIFY(!b->isDirty());
+
+    /* Destroying the scene removes everything */
+    b->setDirty();
+    a->setParent(&scene2);
+}
+
+namespace {
+    enum: std::size_t { BenchmarkObjectCount = 50000 };
+
+    /* Ten objects on the first level, then ten children of each object until
+       the count is reached */
+    std::vector<std::reference_wrapper<Object3D>> populate(Scene3D& scene) {
+        std::vector<std::reference_wrapper<Object3D>> objects;
+        objects.reserve(BenchmarkObjectCount);
+        for(std::size_t i = 0; i != BenchmarkObjectCount; ++i) {
+            CachingObject* o = new CachingObject{i < 10 ? static_cast<Object3D*>(&scene) : &objects[i/10 - 1].get()};
+            o->translate(Vector3::xAxis(Float(i % 10)));
+            objects.push_back(*o);
+        }
+        return objects;
+    }
+}
+
+void ObjectTest::setDirtyCleanAll50k() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects = populate(scene);
+
+    CORRADE_BENCHMARK(1) {
+        /* Move the first level so everything has to be recalculated */
+        for(std::size_t i = 0; i != 10; ++i)
+            objects[i].get().translate(Vector3::yAxis(1.0f));
+        scene.cleanAll();
+    }
+
+    CORRADE_VERIFY(!objects.back().get().isDirty());
+}
+
+void ObjectTest::setDirtyCleanList50k() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects = populate(scene);
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != 10; ++i)
+            objects[i].get().translate(Vector3::yAxis(1.0f));
+        Object3D::setClean(objects);
+    }
+
+    CORRADE_VERIFY(!objects.back().get().isDirty());
+}
+
+void ObjectTest::absoluteTransformation50k() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects = populate(scene);
+
+    Matrix4 sum{Math::ZeroInit};
+    CORRADE_BENCHMARK(1) {
+        for(Object3D& o: objects)
+            sum += o.absoluteTransformation();
+    }
+
+    CORRADE_VERIFY(sum != Matrix4{Math::ZeroInit});
+}
+
+void ObjectTest::absoluteTransformationCached50k() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects = populate(scene);
+    for(Object3D& o: objects) o.setAbsoluteTransformationCached(true);
+
+    /* Nothing changes between the iterations */
+    Matrix4 sum{Math::ZeroInit};
+    CORRADE_BENCHMARK(1) {
+        for(Object3D& o: objects)
+            sum += o.absoluteTransformation();
+    }
+
+    CORRADE_VERIFY(sum != Matrix4{Math::ZeroInit});
+}
+
+void ObjectTest::absoluteTransformationCached50kMoved() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects = populate(scene);
+    for(Object3D& o: objects) o.setAbsoluteTransformationCached(true);
+
+    /* Moving one object on the first level, so a tenth of the objects has to
+       be recalculated */
+    Matrix4 sum{Math::ZeroInit};
+    CORRADE_BENCHMARK(1) {
+        objects[0].get().translate(Vector3::yAxis(1.0f));
+        for(Object3D& o: objects)
+            sum += o.absoluteTransformation();
+    }
+
+    CORRADE_VERIFY(sum != Matrix4{Math::ZeroInit});
+}
+
 void ObjectTest::rangeBasedForChildren() {
     Scene3D scene;
     Object3D a(&scene);
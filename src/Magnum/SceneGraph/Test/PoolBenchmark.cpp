@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.hpp"
+#include "Magnum/SceneGraph/Pool.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+/* Creating and destroying a hierarchy of ObjectCount objects with a feature
+   each */
+struct PoolBenchmark: TestSuite::Tester {
+    explicit PoolBenchmark();
+
+    void createDestroyHeap();
+    void createDestroyPool();
+    void createDestroyPoolReused();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef Pooled<Object3D> PooledObject3D;
+
+PoolBenchmark::PoolBenchmark() {
+    addBenchmarks({&PoolBenchmark::createDestroyHeap,
+                   &PoolBenchmark::createDestroyPool,
+                   &PoolBenchmark::createDestroyPoolReused}, 10);
+}
+
+namespace {
+
+constexpr std::size_t ObjectCount = 100000;
+
+struct Feature: AbstractFeature3D {
+    explicit Feature(AbstractObject3D& object): AbstractFeature3D{object} {}
+};
+
+struct PooledFeature: AbstractFeature3D, PoolAllocated {
+    explicit PooledFeature(AbstractObject3D& object): AbstractFeature3D{object} {}
+};
+
+/* Ten objects in each level, so the subtrees are destroyed recursively */
+std::size_t populateHeap(Object3D& parent, std::size_t count) {
+    std::size_t created = 0;
+    while(created != count) {
+        Object3D& object = parent.addChild<Object3D>();
+        object.addFeature<Feature>();
+        ++created;
+        if(count - created >= 10) created += populateHeap(object, 9);
+    }
+    return created;
+}
+
+std::size_t populatePool(Pool& pool, Object3D& parent, std::size_t count) {
+    std::size_t created = 0;
+    while(created != count) {
+        Object3D& object = parent.addChild<PooledObject3D>(pool);
+        object.addFeature<PooledFeature>(pool);
+        ++created;
+        if(count - created >= 10) created += populatePool(pool, object, 9);
+    }
+    return created;
+}
+
+}
+
+void PoolBenchmark::createDestroyHeap() {
+    std::size_t created = 0;
+    CORRADE_BENCHMARK(1) {
+        Scene3D scene;
+        created += populateHeap(scene, ObjectCount);
+    }
+
+    CORRADE_COMPARE(created % ObjectCount, 0);
+}
+
+void PoolBenchmark::createDestroyPool() {
+    std::size_t created = 0;
+    CORRADE_BENCHMARK(1) {
+        Pool pool;
+        Scene3D scene;
+        created += populatePool(pool, scene, ObjectCount);
+    }
+
+    CORRADE_COMPARE(created % ObjectCount, 0);
+}
+
+void PoolBenchmark::createDestroyPoolReused() {
+    /* Memory of the previous iteration gets reused */
+    Pool pool;
+    std::size_t created = 0;
+    CORRADE_BENCHMARK(1) {
+        Scene3D scene;
+        created += populatePool(pool, scene, ObjectCount);
+    }
+
+    CORRADE_COMPARE(created % ObjectCount, 0);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::PoolBenchmark)
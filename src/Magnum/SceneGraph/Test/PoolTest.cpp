@@ -0,0 +1,327 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <type_traits>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/FlatObject.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.hpp"
+#include "Magnum/SceneGraph/Pool.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct PoolTest: TestSuite::Tester {
+    explicit PoolTest();
+
+    void construct();
+    void allocate();
+    void allocateReuse();
+    void allocateLargerThanChunk();
+    void destroyWithAllocations();
+
+    void notPooledByDefault();
+    void addChild();
+    void addChildFlat();
+    void addFeature();
+    void objectIsFeature();
+    void deleteExplicitly();
+    void mixedWithHeap();
+    void reuseAfterSubtreeDestruction();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef Pooled<Object3D> PooledObject3D;
+typedef Pooled<FlatObject3D> PooledFlatObject3D;
+
+PoolTest::PoolTest() {
+    addTests({&PoolTest::construct,
+              &PoolTest::allocate,
+              &PoolTest::allocateReuse,
+              &PoolTest::allocateLargerThanChunk,
+              &PoolTest::destroyWithAllocations,
+
+              &PoolTest::notPooledByDefault,
+              &PoolTest::addChild,
+              &PoolTest::addChildFlat,
+              &PoolTest::addFeature,
+              &PoolTest::objectIsFeature,
+              &PoolTest::deleteExplicitly,
+              &PoolTest::mixedWithHeap,
+              &PoolTest::reuseAfterSubtreeDestruction});
+}
+
+namespace {
+
+struct Feature: AbstractFeature3D, PoolAllocated {
+    explicit Feature(AbstractObject3D& object, Int value, Int* destructed): AbstractFeature3D{object}, value{value}, destructed{destructed} {}
+    ~Feature() { ++*destructed; }
+
+    Int value;
+    Int* destructed;
+};
+
+struct CachingObject: Object3D, AbstractFeature3D, PoolAllocated {
+    explicit CachingObject(Int* destructed, Object3D* parent = nullptr): Object3D{parent}, AbstractFeature3D{*this}, destructed{destructed} {}
+    ~CachingObject() { ++*destructed; }
+
+    Int* destructed;
+};
+
+}
+
+void PoolTest::construct() {
+    Pool pool{1024};
+    CORRADE_COMPARE(pool.chunkSize(), 1024);
+    CORRADE_COMPARE(pool.chunkCount(), 0);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void PoolTest::allocate() {
+    Pool pool{1024};
+    void* a = pool.allocate(100);
+    void* b = pool.allocate(3);
+    void* c = pool.allocate(100);
+    CORRADE_COMPARE(pool.chunkCount(), 1);
+    CORRADE_COMPARE(pool.allocationCount(), 3);
+
+    /* All suitably aligned and not overlapping */
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % alignof(std::max_align_t), 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b) % alignof(std::max_align_t), 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(c) % alignof(std::max_align_t), 0);
+    CORRADE_VERIFY(static_cast<char*>(b) >= static_cast<char*>(a) + 100);
+    CORRADE_VERIFY(static_cast<char*>(c) >= static_cast<char*>(b) + 3);
+
+    pool.deallocate(a, 100);
+    pool.deallocate(b, 3);
+    pool.deallocate(c, 100);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void PoolTest::allocateReuse() {
+    Pool pool{1024};
+    void* a = pool.allocate(100);
+    void* b = pool.allocate(100);
+    pool.deallocate(a, 100);
+
+    /* Different size doesn't reuse the freed block */
+    void* c = pool.allocate(200);
+    CORRADE_VERIFY(c != a);
+
+    /* Same size does, the last freed block first */
+    pool.deallocate(b, 100);
+    CORRADE_COMPARE(pool.allocate(100), b);
+    CORRADE_COMPARE(pool.allocate(100), a);
+    CORRADE_COMPARE(pool.chunkCount(), 1);
+    CORRADE_COMPARE(pool.allocationCount(), 3);
+
+    pool.deallocate(a, 100);
+    pool.deallocate(b, 100);
+    pool.deallocate(c, 200);
+}
+
+void PoolTest::allocateLargerThanChunk() {
+    Pool pool{256};
+    void* a = pool.allocate(200);
+    CORRADE_COMPARE(pool.chunkCount(), 1);
+
+    /* Doesn't fit into the remaining space, new chunk */
+    void* b = pool.allocate(200);
+    CORRADE_COMPARE(pool.chunkCount(), 2);
+
+    /* Larger than a chunk, gets a dedicated one */
+    void* c = pool.allocate(1000);
+    CORRADE_COMPARE(pool.chunkCount(), 3);
+
+    pool.deallocate(a, 200);
+    pool.deallocate(b, 200);
+    pool.deallocate(c, 1000);
+}
+
+void PoolTest::destroyWithAllocations() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    {
+        Pool pool;
+        pool.allocate(16);
+        pool.allocate(16);
+    }
+    CORRADE_COMPARE(out.str(), "SceneGraph::Pool: destroyed with 2 allocations still alive\n");
+}
+
+void PoolTest::notPooledByDefault() {
+    /* Pool allocation is opt-in, the builtin types have the default allocation
+       functions */
+    CORRADE_VERIFY((!std::is_base_of<PoolAllocated, Object3D>::value));
+    CORRADE_VERIFY((!std::is_base_of<PoolAllocated, AbstractObject3D>::value));
+    CORRADE_VERIFY((!std::is_base_of<PoolAllocated, AbstractFeature3D>::value));
+    CORRADE_VERIFY((std::is_base_of<PoolAllocated, PooledObject3D>::value));
+    CORRADE_VERIFY((std::is_base_of<Object3D, PooledObject3D>::value));
+
+    /* Objects created with the global new can be deleted */
+    Scene3D scene;
+    Object3D* object = ::new Object3D{&scene};
+    delete object;
+    CORRADE_VERIFY(scene.children().isEmpty());
+}
+
+void PoolTest::addChild() {
+    Pool pool{4096};
+    {
+        Scene3D scene;
+        PooledObject3D& a = scene.addChild<PooledObject3D>(pool);
+        PooledObject3D& b = a.addChild<PooledObject3D>(pool);
+        CORRADE_COMPARE(pool.allocationCount(), 2);
+        CORRADE_COMPARE(a.parent(), &scene);
+        CORRADE_COMPARE(b.parent(), &a);
+
+        /* The objects are in the pool */
+        CORRADE_COMPARE(pool.chunkCount(), 1);
+
+        /* Heap allocation still works the same */
+        scene.addChild<Object3D>();
+        CORRADE_COMPARE(pool.allocationCount(), 2);
+    }
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void PoolTest::addChildFlat() {
+    Pool pool{4096};
+    {
+        FlatScene3D scene;
+        PooledFlatObject3D& a = scene.addChild<PooledFlatObject3D>(pool);
+        PooledFlatObject3D& b = a.addChild<PooledFlatObject3D>(pool);
+        CORRADE_COMPARE(pool.allocationCount(), 2);
+        CORRADE_COMPARE(a.parent(), &scene);
+        CORRADE_COMPARE(b.parent(), &a);
+    }
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void PoolTest::addFeature() {
+    Pool pool{4096};
+    Int destructed = 0;
+    {
+        Scene3D scene;
+        PooledObject3D& object = scene.addChild<PooledObject3D>(pool);
+        Feature& feature = object.addFeature<Feature>(pool, 42, &destructed);
+
+        /* Pool-allocated types can be allocated on the heap as well */
+        object.addFeature<Feature>(17, &destructed);
+        CORRADE_COMPARE(pool.allocationCount(), 2);
+        CORRADE_COMPARE(&feature.object(), &object);
+        CORRADE_COMPARE(feature.value, 42);
+    }
+    CORRADE_COMPARE(destructed, 2);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void PoolTest::objectIsFeature() {
+    Pool pool{4096};
+    Int destructed = 0;
+    {
+        Scene3D scene;
+        CachingObject& object = scene.addChild<CachingObject>(pool, &destructed);
+        CORRADE_COMPARE(pool.allocationCount(), 1);
+        CORRADE_COMPARE(object.features().first(), &object);
+    }
+    CORRADE_COMPARE(destructed, 1);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void PoolTest::deleteExplicitly() {
+    Pool pool{4096};
+    Int destructed = 0;
+    Scene3D scene;
+    Object3D* object = new(pool) PooledObject3D{&scene};
+    AbstractFeature3D* feature = new(pool) Feature{*object, 3, &destructed};
+    CORRADE_COMPARE(pool.allocationCount(), 2);
+
+    /* Deleting through a base pointer returns the memory to the pool */
+    delete feature;
+    CORRADE_COMPARE(destructed, 1);
+    CORRADE_COMPARE(pool.allocationCount(), 1);
+    CORRADE_VERIFY(object->features().isEmpty());
+
+    delete object;
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+    CORRADE_VERIFY(scene.children().isEmpty());
+}
+
+void PoolTest::mixedWithHeap() {
+    Pool pool{4096};
+    Int destructed = 0;
+    {
+        Scene3D scene;
+        Object3D& pooled = scene.addChild<PooledObject3D>(pool);
+        Object3D& heap = pooled.addChild<Object3D>();
+        heap.addChild<PooledObject3D>(pool).addFeature<Feature>(pool, 0, &destructed);
+        heap.addFeature<Feature>(1, &destructed);
+        pooled.addFeature<Feature>(2, &destructed);
+        CORRADE_COMPARE(pool.allocationCount(), 3);
+
+        /* Reparenting doesn't care where the object came from */
+        heap.setParent(&scene);
+        pooled.setParent(&heap);
+    }
+    CORRADE_COMPARE(destructed, 3);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void PoolTest::reuseAfterSubtreeDestruction() {
+    Pool pool{4096};
+    Scene3D scene;
+
+    auto populate = [&](Object3D& root) {
+        for(std::size_t i = 0; i != 100; ++i)
+            root.addChild<PooledObject3D>(pool).addChild<PooledObject3D>(pool);
+    };
+
+    Object3D* root = &scene.addChild<PooledObject3D>(pool);
+    populate(*root);
+    const std::size_t chunkCount = pool.chunkCount();
+    CORRADE_COMPARE(pool.allocationCount(), 201);
+    CORRADE_VERIFY(chunkCount > 1);
+
+    /* Destroying the subtree puts everything back to the pool, populating it
+       again doesn't need any new memory */
+    delete root;
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+    root = &scene.addChild<PooledObject3D>(pool);
+    populate(*root);
+    CORRADE_COMPARE(pool.allocationCount(), 201);
+    CORRADE_COMPARE(pool.chunkCount(), chunkCount);
+
+    delete root;
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::PoolTest)
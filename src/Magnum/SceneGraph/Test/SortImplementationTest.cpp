@@ -0,0 +1,189 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/SceneGraph/sortImplementation.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SortImplementationTest: TestSuite::Tester {
+    explicit SortImplementationTest();
+
+    void sortableFloat();
+    void sortFloats();
+    void sortStable();
+    void sortSkippedPasses();
+    void sortIdenticalKeys();
+    void sortOddPassCount();
+    void sortSmall();
+};
+
+SortImplementationTest::SortImplementationTest() {
+    addTests({&SortImplementationTest::sortableFloat,
+              &SortImplementationTest::sortFloats,
+              &SortImplementationTest::sortStable,
+              &SortImplementationTest::sortSkippedPasses,
+              &SortImplementationTest::sortIdenticalKeys,
+              &SortImplementationTest::sortOddPassCount,
+              &SortImplementationTest::sortSmall});
+}
+
+namespace {
+
+/* Sorts the keys and puts a (stable) permutation of 0, 1, 2, ... into the
+   returned values */
+std::vector<UnsignedInt> sort(std::vector<UnsignedLong>& keys, std::vector<UnsignedLong>& keyScratch, std::vector<UnsignedInt>& valueScratch) {
+    std::vector<UnsignedInt> values(keys.size());
+    for(std::size_t i = 0; i != values.size(); ++i) values[i] = UnsignedInt(i);
+    Implementation::radixSort(
+        Containers::ArrayView<UnsignedLong>{keys.data(), keys.size()},
+        Containers::ArrayView<UnsignedInt>{values.data(), values.size()},
+        Containers::ArrayView<UnsignedLong>{keyScratch.data(), keyScratch.size()},
+        Containers::ArrayView<UnsignedInt>{valueScratch.data(), valueScratch.size()});
+    return values;
+}
+
+std::vector<UnsignedInt> sort(std::vector<UnsignedLong>& keys) {
+    std::vector<UnsignedLong> keyScratch(keys.size());
+    std::vector<UnsignedInt> valueScratch(keys.size());
+    return sort(keys, keyScratch, valueScratch);
+}
+
+}
+
+void SortImplementationTest::sortableFloat() {
+    /* Ordered, including denormals and both zeros */
+    const Float values[]{
+        -Constants::inf(), -1.0e30f, -100.0f, -1.0f, -0.5f, -1.0e-40f, -0.0f,
+        0.0f, 1.0e-40f, 0.5f, 1.0f, 100.0f, 1.0e30f, Constants::inf()};
+    for(std::size_t i = 1; i != 14; ++i)
+        CORRADE_VERIFY(Implementation::sortableFloat(values[i - 1]) < Implementation::sortableFloat(values[i]));
+
+    /* Negative zero is directly below positive zero */
+    CORRADE_COMPARE(Implementation::sortableFloat(-0.0f) + 1, Implementation::sortableFloat(0.0f));
+}
+
+void SortImplementationTest::sortFloats() {
+    const std::vector<Float> floats{
+        3.5f, -0.0f, -2.0f, 0.0f, 1.0e-40f, -1.0e-40f, 100.0f, -100.0f,
+        0.25f, -0.25f, 0.0f, -0.0f, -Constants::inf(), Constants::inf()};
+    std::vector<UnsignedLong> keys;
+    for(Float f: floats) keys.push_back(Implementation::sortableFloat(f));
+
+    const std::vector<UnsignedInt> values = sort(keys);
+
+    /* Negative zeros are put before positive zeros, otherwise the order is
+       the same as with a stable sort */
+    std::vector<UnsignedInt> expected(floats.size());
+    for(std::size_t i = 0; i != expected.size(); ++i) expected[i] = UnsignedInt(i);
+    std::stable_sort(expected.begin(), expected.end(), [&](UnsignedInt a, UnsignedInt b) {
+        if(floats[a] == floats[b]) return std::signbit(floats[a]) && !std::signbit(floats[b]);
+        return floats[a] < floats[b];
+    });
+    CORRADE_COMPARE_AS(values, expected, TestSuite::Compare::Container);
+    CORRADE_VERIFY(std::is_sorted(keys.begin(), keys.end()));
+}
+
+void SortImplementationTest::sortStable() {
+    std::vector<UnsignedLong> keys{
+        0x0300000000000002ull, 0x0100000000000001ull, 0x0300000000000002ull,
+        0x0100000000000001ull, 0x0000000000000000ull, 0x0300000000000002ull};
+    const std::vector<UnsignedInt> values = sort(keys);
+    CORRADE_COMPARE_AS(values, (std::vector<UnsignedInt>{4, 1, 3, 0, 2, 5}),
+        TestSuite::Compare::Container);
+}
+
+void SortImplementationTest::sortSkippedPasses() {
+    /* The keys differ only in bytes 4 and 6 (counting from the least
+       significant one), so there are just two passes and the result of the
+       first one (ordered only by byte 4) stays in the scratch memory. If the other passes weren't skipped,
+       there would be eight passes and the scratch memory would contain the
+       keys ordered by all bytes but the last, which is the final order. */
+    std::vector<UnsignedLong> keys{
+        0x1122330044005566ull, 0x1122330144005566ull,
+        0x1100330244005566ull, 0x1101330344005566ull};
+    std::vector<UnsignedLong> keyScratch(keys.size());
+    std::vector<UnsignedInt> valueScratch(keys.size());
+    const std::vector<UnsignedInt> values = sort(keys, keyScratch, valueScratch);
+
+    CORRADE_COMPARE_AS(values, (std::vector<UnsignedInt>{2, 3, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(valueScratch, (std::vector<UnsignedInt>{0, 1, 2, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(std::is_sorted(keys.begin(), keys.end()));
+}
+
+void SortImplementationTest::sortIdenticalKeys() {
+    /* No pass at all, the scratch memory isn't touched */
+    std::vector<UnsignedLong> keys(5, 0x8000000012345678ull);
+    std::vector<UnsignedLong> keyScratch(keys.size(), 0xdeadbeefull);
+    std::vector<UnsignedInt> valueScratch(keys.size(), 0xcafe);
+    const std::vector<UnsignedInt> values = sort(keys, keyScratch, valueScratch);
+
+    CORRADE_COMPARE_AS(values, (std::vector<UnsignedInt>{0, 1, 2, 3, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(keyScratch, (std::vector<UnsignedLong>(5, 0xdeadbeefull)),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(valueScratch, (std::vector<UnsignedInt>(5, 0xcafe)),
+        TestSuite::Compare::Container);
+}
+
+void SortImplementationTest::sortOddPassCount() {
+    /* One and three differing bytes, the result ends up in the scratch memory
+       and has to be copied back */
+    std::vector<UnsignedLong> oneByte{0x30, 0x10, 0xff, 0x00, 0x10};
+    CORRADE_COMPARE_AS(sort(oneByte), (std::vector<UnsignedInt>{3, 1, 4, 0, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(oneByte, (std::vector<UnsignedLong>{0x00, 0x10, 0x10, 0x30, 0xff}),
+        TestSuite::Compare::Container);
+
+    std::vector<UnsignedLong> threeBytes{
+        0x0100000000020003ull, 0x0000000000030001ull,
+        0x0100000000010002ull, 0x0000000000030000ull};
+    CORRADE_COMPARE_AS(sort(threeBytes), (std::vector<UnsignedInt>{3, 1, 2, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(std::is_sorted(threeBytes.begin(), threeBytes.end()));
+}
+
+void SortImplementationTest::sortSmall() {
+    std::vector<UnsignedLong> empty;
+    CORRADE_VERIFY(sort(empty).empty());
+
+    std::vector<UnsignedLong> one{0xffull};
+    CORRADE_COMPARE_AS(sort(one), (std::vector<UnsignedInt>{0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(one[0], 0xffull);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SortImplementationTest)
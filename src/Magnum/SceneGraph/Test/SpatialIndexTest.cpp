@@ -0,0 +1,631 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SpatialIndexTest: TestSuite::Tester {
+    explicit SpatialIndexTest();
+
+    void construct();
+    void boxQuery();
+    void sphereQuery();
+    void frustumQuery();
+    void rayQuery();
+    void query2D();
+    void outsideBounds();
+    void updateTransformed();
+    void updateCleaned();
+    void updateChildren();
+    void updateChildrenParentWithoutBounds();
+    void updateChildrenFlat();
+    void setBounds();
+    void remove();
+    void destroy();
+    void destroyIndex();
+    void moveToAnotherIndex();
+    void bruteForce();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SpatialIndexTest::SpatialIndexTest() {
+    addTests({&SpatialIndexTest::construct,
+              &SpatialIndexTest::boxQuery,
+              &SpatialIndexTest::sphereQuery,
+              &SpatialIndexTest::frustumQuery,
+              &SpatialIndexTest::rayQuery,
+              &SpatialIndexTest::query2D,
+              &SpatialIndexTest::outsideBounds,
+              &SpatialIndexTest::updateTransformed,
+              &SpatialIndexTest::updateCleaned,
+              &SpatialIndexTest::updateChildren,
+              &SpatialIndexTest::updateChildrenParentWithoutBounds,
+              &SpatialIndexTest::updateChildrenFlat,
+              &SpatialIndexTest::setBounds,
+              &SpatialIndexTest::remove,
+              &SpatialIndexTest::destroy,
+              &SpatialIndexTest::destroyIndex,
+              &SpatialIndexTest::moveToAnotherIndex,
+              &SpatialIndexTest::bruteForce});
+}
+
+namespace {
+
+template<UnsignedInt dimensions> class IdBounds: public SpatialBounds<dimensions, Float> {
+    public:
+        explicit IdBounds(AbstractObject<dimensions, Float>& object, SpatialIndex<dimensions, Float>* index, Int id): SpatialBounds<dimensions, Float>{object, {VectorTypeFor<dimensions, Float>{-0.5f}, VectorTypeFor<dimensions, Float>{0.5f}}, index}, id{id} {}
+
+        Int id;
+};
+
+/* Sorted IDs of found features, unless the order is significant */
+template<UnsignedInt dimensions> std::vector<Int> ids(const std::vector<std::reference_wrapper<SpatialBounds<dimensions, Float>>>& found, bool sort = true) {
+    std::vector<Int> out;
+    for(SpatialBounds<dimensions, Float>& bounds: found)
+        out.push_back(static_cast<IdBounds<dimensions>&>(bounds).id);
+    if(sort) std::sort(out.begin(), out.end());
+    return out;
+}
+
+}
+
+void SpatialIndexTest::construct() {
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{30.0f}}, 4};
+    CORRADE_COMPARE(index.bounds(), (Range3D{Vector3{-10.0f}, Vector3{30.0f}}));
+    CORRADE_COMPARE(index.maxDepth(), 4);
+    CORRADE_COMPARE(index.nodeCount(), 1);
+    CORRADE_VERIFY(index.isEmpty());
+
+    /* Small object gets placed into the deepest node, creating all nodes on
+       the way */
+    Scene3D scene;
+    Object3D object{&scene};
+    IdBounds<3> bounds{object, &index, 0};
+    CORRADE_VERIFY(bounds.spatialIndex() == &index);
+    CORRADE_COMPARE(index.size(), 1);
+    CORRADE_COMPARE(index.nodeCount(), 1);
+
+    index.update();
+    CORRADE_COMPARE(index.nodeCount(), 1 + 4*8);
+    CORRADE_COMPARE(bounds.absoluteBounds(), (Range3D{Vector3{-0.5f}, Vector3{0.5f}}));
+}
+
+void SpatialIndexTest::boxQuery() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    a.translate({1.0f, 2.0f, 3.0f});
+    new IdBounds<3>{a, &index, 0};
+
+    Object3D b{&scene};
+    b.translate({50.0f, 2.0f, 3.0f});
+    new IdBounds<3>{b, &index, 1};
+
+    /* Large one, reaching into the queried box */
+    Object3D c{&scene};
+    c.scale(Vector3{60.0f})
+     .translate({-30.0f, 0.0f, 0.0f});
+    new IdBounds<3>{c, &index, 2};
+
+    Object3D d{&scene};
+    d.translate({-5.0f, -5.0f, -5.0f});
+    new IdBounds<3>{d, &index, 3};
+
+    scene.cleanAll();
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.boxQueryInto({{0.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 10.0f}}, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0, 2}));
+
+    /* Touching counts */
+    index.boxQueryInto({{-10.0f, -10.0f, -10.0f}, {-5.5f, -5.5f, -5.5f}}, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{2, 3}));
+
+    /* Previous contents get replaced */
+    index.boxQueryInto({{40.0f, 0.0f, 0.0f}, {60.0f, 10.0f, 10.0f}}, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+
+    index.boxQueryInto({Vector3{90.0f}, Vector3{95.0f}}, found);
+    CORRADE_VERIFY(found.empty());
+}
+
+void SpatialIndexTest::sphereQuery() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    a.translate({3.0f, 0.0f, 0.0f});
+    new IdBounds<3>{a, &index, 0};
+
+    /* Corner of the box is further away than the sphere radius, even though
+       it's inside a box enclosing the sphere */
+    Object3D b{&scene};
+    b.translate({2.5f, 2.5f, 2.5f});
+    new IdBounds<3>{b, &index, 1};
+
+    Object3D c{&scene};
+    c.translate({0.0f, -20.0f, 0.0f});
+    new IdBounds<3>{c, &index, 2};
+
+    scene.cleanAll();
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({}, 3.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+
+    index.sphereQueryInto({0.0f, -10.0f, 0.0f}, 9.7f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{2}));
+}
+
+void SpatialIndexTest::frustumQuery() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    /* In front of the camera */
+    Object3D a{&scene};
+    a.translate({0.0f, 0.0f, -10.0f});
+    new IdBounds<3>{a, &index, 0};
+
+    /* Behind */
+    Object3D b{&scene};
+    b.translate({0.0f, 0.0f, 10.0f});
+    new IdBounds<3>{b, &index, 1};
+
+    /* Too far */
+    Object3D c{&scene};
+    c.translate({0.0f, 0.0f, -60.0f});
+    new IdBounds<3>{c, &index, 2};
+
+    /* On the side, outside of the field of view */
+    Object3D d{&scene};
+    d.translate({20.0f, 0.0f, -10.0f});
+    new IdBounds<3>{d, &index, 3};
+
+    scene.cleanAll();
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.frustumQueryInto(Frustum::fromMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 50.0f)), found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+}
+
+void SpatialIndexTest::rayQuery() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    a.translate({20.0f, 0.0f, 0.0f});
+    new IdBounds<3>{a, &index, 0};
+
+    Object3D b{&scene};
+    b.translate({5.0f, 0.25f, 0.0f});
+    new IdBounds<3>{b, &index, 1};
+
+    /* Next to the ray */
+    Object3D c{&scene};
+    c.translate({10.0f, 2.0f, 0.0f});
+    new IdBounds<3>{c, &index, 2};
+
+    /* Behind the origin */
+    Object3D d{&scene};
+    d.translate({-5.0f, 0.0f, 0.0f});
+    new IdBounds<3>{d, &index, 3};
+
+    /* Containing the origin */
+    Object3D e{&scene};
+    e.scale(Vector3{4.0f});
+    new IdBounds<3>{e, &index, 4};
+
+    scene.cleanAll();
+
+    /* Sorted by distance */
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.rayQueryInto({}, Vector3::xAxis(), found);
+    CORRADE_COMPARE(ids(found, false), (std::vector<Int>{4, 1, 0}));
+
+    /* Limited distance, in multiples of the direction */
+    index.rayQueryInto({}, Vector3::xAxis(2.0f), found, 5.0f);
+    CORRADE_COMPARE(ids(found, false), (std::vector<Int>{4, 1}));
+
+    /* Diagonal direction, starting inside of one of the boxes */
+    index.rayQueryInto({-5.0f, 0.0f, 0.0f}, {15.0f, 2.0f, 0.0f}, found);
+    CORRADE_COMPARE(ids(found, false), (std::vector<Int>{3, 4, 2}));
+}
+
+void SpatialIndexTest::query2D() {
+    Scene2D scene;
+    SpatialIndex2D index{{Vector2{-100.0f}, Vector2{100.0f}}, 3};
+
+    Object2D a{&scene};
+    a.translate({1.0f, 1.0f});
+    new IdBounds<2>{a, &index, 0};
+
+    Object2D b{&scene};
+    b.translate({-40.0f, 30.0f});
+    new IdBounds<2>{b, &index, 1};
+
+    /* The paths share only the root children */
+    scene.cleanAll();
+    CORRADE_COMPARE(index.nodeCount(), 1 + 4 + 2*2*4);
+
+    std::vector<std::reference_wrapper<SpatialBounds2D>> found;
+    index.boxQueryInto({{-50.0f, 0.0f}, {0.0f, 50.0f}}, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+
+    index.sphereQueryInto({}, 2.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+
+    index.rayQueryInto({-45.0f, 30.0f}, Vector2::xAxis(), found);
+    CORRADE_COMPARE(ids(found, false), (std::vector<Int>{1}));
+}
+
+void SpatialIndexTest::outsideBounds() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+
+    Object3D a{&scene};
+    a.translate({500.0f, 0.0f, 0.0f});
+    new IdBounds<3>{a, &index, 0};
+
+    /* Larger than the whole tree */
+    Object3D b{&scene};
+    b.scale(Vector3{100.0f});
+    new IdBounds<3>{b, &index, 1};
+
+    scene.cleanAll();
+
+    /* Both are in the root, nothing else was created */
+    CORRADE_COMPARE(index.nodeCount(), 1);
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.boxQueryInto({{490.0f, -1.0f, -1.0f}, {510.0f, 1.0f, 1.0f}}, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+}
+
+void SpatialIndexTest::updateTransformed() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    IdBounds<3> bounds{a, &index, 0};
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+
+    /* Moving the object without cleaning the scene, the query picks it up
+       and cleans the object */
+    a.translate({50.0f, 0.0f, 0.0f});
+    CORRADE_VERIFY(a.isDirty());
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_VERIFY(found.empty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_COMPARE(bounds.absoluteBounds(), (Range3D{{49.5f, -0.5f, -0.5f}, {50.5f, 0.5f, 0.5f}}));
+
+    index.sphereQueryInto({50.0f, 0.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+}
+
+void SpatialIndexTest::updateCleaned() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    IdBounds<3> bounds{a, &index, 0};
+    scene.cleanAll();
+    CORRADE_COMPARE(bounds.absoluteBounds(), (Range3D{Vector3{-0.5f}, Vector3{0.5f}}));
+
+    /* Cleaning the scene on multiple threads updates the tree as well */
+    a.translate({0.0f, 0.0f, 20.0f});
+    scene.cleanAll(4);
+    CORRADE_COMPARE(bounds.absoluteBounds(), (Range3D{{-0.5f, -0.5f, 19.5f}, {0.5f, 0.5f, 20.5f}}));
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.boxQueryInto({{-1.0f, -1.0f, 19.0f}, {1.0f, 1.0f, 21.0f}}, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+    index.boxQueryInto({Vector3{-1.0f}, Vector3{1.0f}}, found);
+    CORRADE_VERIFY(found.empty());
+}
+
+void SpatialIndexTest::updateChildren() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D parent{&scene};
+    new IdBounds<3>{parent, &index, 0};
+    Object3D child{&parent};
+    child.translate({0.0f, 5.0f, 0.0f});
+    new IdBounds<3>{child, &index, 1};
+
+    /* Transforming the parent moves the child as well */
+    parent.translate({30.0f, 0.0f, 0.0f});
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({30.0f, 5.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+    index.sphereQueryInto({}, 10.0f, found);
+    CORRADE_VERIFY(found.empty());
+}
+
+void SpatialIndexTest::updateChildrenParentWithoutBounds() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D parent{&scene};
+    Object3D child{&parent};
+    child.translate({0.0f, 5.0f, 0.0f});
+    new IdBounds<3>{child, &index, 0};
+    Object3D grandchild{&child};
+    grandchild.translate({0.0f, 5.0f, 0.0f});
+    new IdBounds<3>{grandchild, &index, 1};
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({0.0f, 5.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+    CORRADE_VERIFY(!parent.isDirty());
+
+    /* Transforming the parent marks only the parent as dirty, the features
+       of its children have to be updated nevertheless */
+    parent.translate({30.0f, 0.0f, 0.0f});
+    index.sphereQueryInto({30.0f, 5.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+    index.sphereQueryInto({30.0f, 10.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+    index.sphereQueryInto({}, 20.0f, found);
+    CORRADE_VERIFY(found.empty());
+    CORRADE_VERIFY(!parent.isDirty());
+    CORRADE_VERIFY(!grandchild.isDirty());
+
+    /* Transforming a sibling subtree doesn't affect the features */
+    Object3D other{&scene};
+    other.translate({-30.0f, 0.0f, 0.0f});
+    index.sphereQueryInto({30.0f, 10.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+}
+
+void SpatialIndexTest::updateChildrenFlat() {
+    FlatScene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    FlatObject3D parent{&scene};
+    FlatObject3D child{&parent};
+    child.translate({0.0f, 5.0f, 0.0f});
+    new IdBounds<3>{child, &index, 0};
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({0.0f, 5.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+
+    parent.translate({30.0f, 0.0f, 0.0f});
+    index.sphereQueryInto({30.0f, 5.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+    index.sphereQueryInto({}, 10.0f, found);
+    CORRADE_VERIFY(found.empty());
+}
+
+void SpatialIndexTest::setBounds() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    IdBounds<3> bounds{a, &index, 0};
+    scene.cleanAll();
+
+    bounds.setBounds({{10.0f, -0.5f, -0.5f}, {11.0f, 0.5f, 0.5f}});
+    CORRADE_COMPARE(bounds.bounds(), (Range3D{{10.0f, -0.5f, -0.5f}, {11.0f, 0.5f, 0.5f}}));
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_VERIFY(found.empty());
+    index.sphereQueryInto({10.5f, 0.0f, 0.0f}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+    CORRADE_COMPARE(bounds.absoluteBounds(), (Range3D{{10.0f, -0.5f, -0.5f}, {11.0f, 0.5f, 0.5f}}));
+}
+
+void SpatialIndexTest::remove() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    IdBounds<3> boundsA{a, &index, 0};
+    Object3D b{&scene};
+    IdBounds<3> boundsB{b, &index, 1};
+
+    /* Removing a feature that's still waiting for an update */
+    index.remove(boundsA);
+    CORRADE_VERIFY(!boundsA.spatialIndex());
+    CORRADE_COMPARE(index.size(), 1);
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+
+    /* Removing a feature that's in the tree */
+    index.remove(boundsB);
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_VERIFY(found.empty());
+
+    /* Transforming the objects doesn't affect the index anymore */
+    a.translate({1.0f, 0.0f, 0.0f});
+    b.translate({1.0f, 0.0f, 0.0f});
+    scene.cleanAll();
+    index.sphereQueryInto({}, 10.0f, found);
+    CORRADE_VERIFY(found.empty());
+    CORRADE_COMPARE(boundsB.absoluteBounds(), (Range3D{{0.5f, -0.5f, -0.5f}, {1.5f, 0.5f, 0.5f}}));
+}
+
+void SpatialIndexTest::destroy() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D* a = new Object3D{&scene};
+    new IdBounds<3>{*a, &index, 0};
+    Object3D* b = new Object3D{&scene};
+    new IdBounds<3>{*b, &index, 1};
+    Object3D* c = new Object3D{&scene};
+    new IdBounds<3>{*c, &index, 2};
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0, 1, 2}));
+
+    /* Destroy one in the tree and one waiting for an update */
+    delete a;
+    c->translate(Vector3{0.1f});
+    delete c;
+    CORRADE_COMPARE(index.size(), 1);
+
+    index.sphereQueryInto({}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{1}));
+}
+
+void SpatialIndexTest::destroyIndex() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    IdBounds<3>* boundsA;
+    IdBounds<3>* boundsB;
+    {
+        SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+        boundsA = new IdBounds<3>{a, &index, 0};
+        boundsB = new IdBounds<3>{b, &index, 1};
+        scene.cleanAll();
+        b.translate(Vector3{1.0f});
+    }
+
+    /* The features are not part of any index anymore and can be transformed
+       and destroyed safely */
+    CORRADE_VERIFY(!boundsA->spatialIndex());
+    CORRADE_VERIFY(!boundsB->spatialIndex());
+    a.translate(Vector3{1.0f});
+    scene.cleanAll();
+    CORRADE_COMPARE(boundsA->absoluteBounds(), (Range3D{Vector3{0.5f}, Vector3{1.5f}}));
+    delete boundsA;
+    delete boundsB;
+}
+
+void SpatialIndexTest::moveToAnotherIndex() {
+    Scene3D scene;
+    SpatialIndex3D first{{Vector3{-100.0f}, Vector3{100.0f}}};
+    SpatialIndex3D second{{Vector3{-100.0f}, Vector3{100.0f}}};
+
+    Object3D a{&scene};
+    IdBounds<3> bounds{a, &first, 0};
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    first.sphereQueryInto({}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+
+    second.add(bounds);
+    CORRADE_VERIFY(bounds.spatialIndex() == &second);
+    CORRADE_VERIFY(first.isEmpty());
+    CORRADE_COMPARE(second.size(), 1);
+
+    first.sphereQueryInto({}, 1.0f, found);
+    CORRADE_VERIFY(found.empty());
+    second.sphereQueryInto({}, 1.0f, found);
+    CORRADE_COMPARE(ids(found), (std::vector<Int>{0}));
+}
+
+void SpatialIndexTest::bruteForce() {
+    Scene3D scene;
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}, 6};
+
+    /* Objects of various sizes, some of them parented, some outside of the
+       tree. Deterministic pseudo-random numbers in [0, 1). */
+    UnsignedInt seed = 1;
+    auto random = [&seed]() {
+        seed = seed*1103515245u + 12345u;
+        return Float((seed >> 8) & 0xffff)/65536.0f;
+    };
+
+    std::vector<Object3D*> objects;
+    std::vector<IdBounds<3>*> features;
+    for(Int i = 0; i != 500; ++i) {
+        Object3D* object = new Object3D{i % 5 == 4 ? objects[i - 1] : &scene};
+        object->scale(Vector3{0.1f + 20.0f*random()*random()*random()})
+            .translate(Vector3{random(), random(), random()}*240.0f - Vector3{120.0f});
+        objects.push_back(object);
+        features.push_back(new IdBounds<3>{*object, &index, i});
+    }
+
+    std::vector<std::reference_wrapper<SpatialBounds3D>> found;
+    for(Int iteration = 0; iteration != 3; ++iteration) {
+        /* Move some of the objects around, every other iteration without
+           cleaning the scene first, otherwise cleaning on multiple threads */
+        for(Int i = 0; i < 500; i += 7)
+            objects[i]->translate(Vector3{random(), random(), random()}*40.0f - Vector3{20.0f});
+        if(iteration % 2) scene.cleanAll(4);
+
+        for(Int query = 0; query != 20; ++query) {
+            const Vector3 center = Vector3{random(), random(), random()}*200.0f - Vector3{100.0f};
+            const Range3D box{center - Vector3{10.0f*random()}, center + Vector3{10.0f*random()}};
+            index.boxQueryInto(box, found);
+
+            std::vector<Int> expected;
+            for(IdBounds<3>* feature: features) {
+                const Range3D b = feature->absoluteBounds();
+                if((b.min() <= box.max()).all() && (box.min() <= b.max()).all())
+                    expected.push_back(feature->id);
+            }
+            CORRADE_COMPARE(ids(found), expected);
+
+            const Float radius = 15.0f*random();
+            index.sphereQueryInto(center, radius, found);
+
+            expected.clear();
+            for(IdBounds<3>* feature: features) {
+                const Range3D b = feature->absoluteBounds();
+                if((Math::max(Math::max(b.min() - center, center - b.max()), Vector3{0.0f})).dot() <= radius*radius)
+                    expected.push_back(feature->id);
+            }
+            CORRADE_COMPARE(ids(found), expected);
+        }
+    }
+
+    /* All absolute bounds are up-to-date */
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        CORRADE_COMPARE(features[i]->absoluteBounds(), (Range3D{objects[i]->absoluteTransformationMatrix().transformPoint(Vector3{-0.5f}), objects[i]->absoluteTransformationMatrix().transformPoint(Vector3{0.5f})}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialIndexTest)
@@ -0,0 +1,215 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+
+#include "Magnum/SceneGraph/FlatObject.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+#include "Magnum/SceneGraph/TrackPlayer.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+/* Benchmarks of sampling TrackCount tracks per iteration. Time advances by
+   one frame every iteration, as in playback, so the hinted variants find
+   the keyframes in constant time. */
+struct TrackBenchmark: TestSuite::Tester {
+    explicit TrackBenchmark();
+
+    void sampleStep();
+    void sampleLinear();
+    void sampleLinearNoHint();
+    void sampleSlerp();
+    void sampleSlerpNoHint();
+    void sampleCubic();
+
+    void playerAdvance();
+};
+
+TrackBenchmark::TrackBenchmark() {
+    addBenchmarks({&TrackBenchmark::sampleStep,
+                   &TrackBenchmark::sampleLinear,
+                   &TrackBenchmark::sampleLinearNoHint,
+                   &TrackBenchmark::sampleSlerp,
+                   &TrackBenchmark::sampleSlerpNoHint,
+                   &TrackBenchmark::sampleCubic,
+
+                   &TrackBenchmark::playerAdvance}, 10);
+}
+
+namespace {
+
+constexpr std::size_t TrackCount = 100000;
+constexpr std::size_t KeyframeCount = 32;
+constexpr Float FrameDuration = 1.0f/60.0f;
+
+/* Keyframes spaced a bit irregularly, each track slightly offset */
+std::vector<Track<Vector3>> vectorTracks(Interpolation interpolation) {
+    std::vector<Track<Vector3>> out;
+    out.reserve(TrackCount);
+    for(std::size_t i = 0; i != TrackCount; ++i) {
+        std::vector<std::pair<Float, Vector3>> keyframes;
+        for(std::size_t j = 0; j != KeyframeCount; ++j)
+            keyframes.emplace_back(Float(j)*0.25f + Float(i % 3)*0.05f, Vector3{Float(j % 5), Float(i % 7), Float((i + j) % 3)});
+        out.emplace_back(std::move(keyframes), interpolation);
+    }
+    return out;
+}
+
+std::vector<Track<Quaternion>> quaternionTracks(Interpolation interpolation) {
+    std::vector<Track<Quaternion>> out;
+    out.reserve(TrackCount);
+    for(std::size_t i = 0; i != TrackCount; ++i) {
+        std::vector<std::pair<Float, Quaternion>> keyframes;
+        for(std::size_t j = 0; j != KeyframeCount; ++j)
+            keyframes.emplace_back(Float(j)*0.25f + Float(i % 3)*0.05f, Quaternion::rotation(Deg(Float(j*25 + i % 90)), Vector3::yAxis()));
+        out.emplace_back(std::move(keyframes), interpolation);
+    }
+    return out;
+}
+
+/* Going through the whole track and then starting from the beginning again */
+Float nextTime(Float time) {
+    time += FrameDuration;
+    return time > Float(KeyframeCount)*0.25f ? 0.0f : time;
+}
+
+}
+
+void TrackBenchmark::sampleStep() {
+    const std::vector<Track<Vector3>> tracks = vectorTracks(Interpolation::Step);
+    std::vector<std::size_t> hints(TrackCount);
+    std::vector<Vector3> out(TrackCount);
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != TrackCount; ++i)
+            out[i] = tracks[i].at(time, hints[i]);
+        time = nextTime(time);
+    }
+
+    CORRADE_COMPARE(out[1], tracks[1].at(time - FrameDuration));
+}
+
+void TrackBenchmark::sampleLinear() {
+    const std::vector<Track<Vector3>> tracks = vectorTracks(Interpolation::Linear);
+    std::vector<std::size_t> hints(TrackCount);
+    std::vector<Vector3> out(TrackCount);
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != TrackCount; ++i)
+            out[i] = tracks[i].at(time, hints[i]);
+        time = nextTime(time);
+    }
+
+    CORRADE_COMPARE(out[1], tracks[1].at(time - FrameDuration));
+}
+
+void TrackBenchmark::sampleLinearNoHint() {
+    const std::vector<Track<Vector3>> tracks = vectorTracks(Interpolation::Linear);
+    std::vector<Vector3> out(TrackCount);
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != TrackCount; ++i)
+            out[i] = tracks[i].at(time);
+        time = nextTime(time);
+    }
+
+    CORRADE_COMPARE(out[1], tracks[1].at(time - FrameDuration));
+}
+
+void TrackBenchmark::sampleSlerp() {
+    const std::vector<Track<Quaternion>> tracks = quaternionTracks(Interpolation::Slerp);
+    std::vector<std::size_t> hints(TrackCount);
+    std::vector<Quaternion> out(TrackCount);
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != TrackCount; ++i)
+            out[i] = tracks[i].at(time, hints[i]);
+        time = nextTime(time);
+    }
+
+    CORRADE_VERIFY(out[1].isNormalized());
+}
+
+void TrackBenchmark::sampleSlerpNoHint() {
+    const std::vector<Track<Quaternion>> tracks = quaternionTracks(Interpolation::Slerp);
+    std::vector<Quaternion> out(TrackCount);
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != TrackCount; ++i)
+            out[i] = tracks[i].at(time);
+        time = nextTime(time);
+    }
+
+    CORRADE_VERIFY(out[1].isNormalized());
+}
+
+void TrackBenchmark::sampleCubic() {
+    const std::vector<Track<Vector3>> tracks = vectorTracks(Interpolation::Cubic);
+    std::vector<std::size_t> hints(TrackCount);
+    std::vector<Vector3> out(TrackCount);
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != TrackCount; ++i)
+            out[i] = tracks[i].at(time, hints[i]);
+        time = nextTime(time);
+    }
+
+    CORRADE_COMPARE(out[1], tracks[1].at(time - FrameDuration));
+}
+
+void TrackBenchmark::playerAdvance() {
+    /* A third of the tracks of each kind, animating TrackCount/3 objects */
+    const std::vector<Track<Vector3>> translations = vectorTracks(Interpolation::Linear);
+    const std::vector<Track<Quaternion>> rotations = quaternionTracks(Interpolation::Slerp);
+
+    FlatScene3D scene;
+    TrackPlayer3D player{scene};
+    std::vector<FlatObject3D*> objects;
+    for(std::size_t i = 0; i != TrackCount/3; ++i) {
+        objects.push_back(new FlatObject3D{&scene});
+        player.add(*objects.back(), &translations[i], &rotations[i], &translations[TrackCount - i - 1]);
+    }
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        player.advance(time);
+        time = nextTime(time);
+    }
+
+    CORRADE_COMPARE(objects[1]->transformation().translation(), translations[1].at(time - FrameDuration));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackBenchmark)
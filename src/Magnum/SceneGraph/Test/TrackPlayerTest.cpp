@@ -0,0 +1,293 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/AnimableGroup.h"
+#include "Magnum/SceneGraph/FlatObject.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TrackPlayer.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct TrackPlayerTest: TestSuite::Tester {
+    explicit TrackPlayerTest();
+
+    void construct();
+    void add();
+    void clear();
+    void advance3D();
+    void advance2D();
+    void advanceNoTracks();
+    void advanceFlatObject();
+    void step();
+    void stepRepeated();
+    void sharedTracks();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+TrackPlayerTest::TrackPlayerTest() {
+    addTests({&TrackPlayerTest::construct,
+              &TrackPlayerTest::add,
+              &TrackPlayerTest::clear,
+              &TrackPlayerTest::advance3D,
+              &TrackPlayerTest::advance2D,
+              &TrackPlayerTest::advanceNoTracks,
+              &TrackPlayerTest::advanceFlatObject,
+              &TrackPlayerTest::step,
+              &TrackPlayerTest::stepRepeated,
+              &TrackPlayerTest::sharedTracks});
+}
+
+namespace {
+
+const Track<Vector3> Translation{{
+    {0.0f, {0.0f, 0.0f, 0.0f}},
+    {2.0f, {4.0f, 2.0f, 0.0f}}
+}};
+
+const Track<Quaternion> Rotation{{
+    {0.0f, Quaternion::rotation(Deg(0.0f), Vector3::zAxis())},
+    {1.0f, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())},
+    {3.0f, Quaternion::rotation(Deg(180.0f), Vector3::zAxis())}
+}, Interpolation::Slerp};
+
+const Track<Vector3> Scaling{{
+    {0.0f, Vector3{1.0f}},
+    {1.0f, Vector3{3.0f}}
+}, Interpolation::Step};
+
+}
+
+void TrackPlayerTest::construct() {
+    Scene3D scene;
+    TrackPlayer3D player{scene};
+    CORRADE_COMPARE(player.size(), 0);
+    CORRADE_COMPARE(player.duration(), 0.0f);
+    CORRADE_COMPARE(player.state(), AnimationState::Stopped);
+}
+
+void TrackPlayerTest::add() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    TrackPlayer3D player{scene};
+
+    /* Duration is extended to the longest track */
+    player.add(a, &Translation, nullptr);
+    CORRADE_COMPARE(player.size(), 1);
+    CORRADE_COMPARE(player.duration(), 2.0f);
+
+    player.add(b, nullptr, &Rotation, &Scaling);
+    CORRADE_COMPARE(player.size(), 2);
+    CORRADE_COMPARE(player.duration(), 3.0f);
+
+    /* Shorter track doesn't shorten it */
+    player.add(b, nullptr, nullptr, &Scaling);
+    CORRADE_COMPARE(player.duration(), 3.0f);
+}
+
+void TrackPlayerTest::clear() {
+    Scene3D scene;
+    Object3D a{&scene};
+    TrackPlayer3D player{scene};
+    player.add(a, &Translation, &Rotation)
+        .clear();
+    CORRADE_COMPARE(player.size(), 0);
+    CORRADE_COMPARE(player.duration(), 0.0f);
+
+    /* Nothing is written anymore */
+    player.advance(1.0f);
+    CORRADE_COMPARE(a.transformation(), Matrix4{});
+}
+
+void TrackPlayerTest::advance3D() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    TrackPlayer3D player{scene};
+    player.add(a, &Translation, &Rotation, &Scaling)
+        .add(b, &Translation, nullptr);
+
+    player.advance(1.0f);
+    CORRADE_COMPARE(a.transformation(),
+        Matrix4::translation({2.0f, 1.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(90.0f))*
+        Matrix4::scaling(Vector3{3.0f}));
+    CORRADE_COMPARE(b.transformation(), Matrix4::translation({2.0f, 1.0f, 0.0f}));
+    CORRADE_VERIFY(a.isDirty());
+
+    player.advance(2.0f);
+    CORRADE_COMPARE(a.transformation(),
+        Matrix4::translation({4.0f, 2.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(135.0f))*
+        Matrix4::scaling(Vector3{3.0f}));
+}
+
+void TrackPlayerTest::advance2D() {
+    const Track<Vector2> translation{{
+        {0.0f, {0.0f, 0.0f}},
+        {1.0f, {2.0f, -2.0f}}
+    }};
+    const Track<Complex> rotation{{
+        {0.0f, Complex::rotation(Deg(0.0f))},
+        {1.0f, Complex::rotation(Deg(90.0f))}
+    }};
+    const Track<Vector2> scaling{{
+        {0.0f, {1.0f, 1.0f}},
+        {1.0f, {1.0f, 3.0f}}
+    }};
+
+    const Track<Complex> rotationSlerp{{
+        {0.0f, Complex::rotation(Deg(0.0f))},
+        {1.0f, Complex::rotation(Deg(60.0f))}
+    }, Interpolation::Slerp};
+
+    Scene2D scene;
+    Object2D a{&scene};
+    Object2D b{&scene};
+    TrackPlayer2D player{scene};
+    player.add(a, &translation, &rotation, &scaling);
+    player.add(b, nullptr, &rotationSlerp, nullptr);
+
+    /* In the middle of the interval the rotation is normalized, so the
+       object isn't shrunk */
+    player.advance(0.5f);
+    CORRADE_COMPARE(a.transformation(),
+        Matrix3::translation({1.0f, -1.0f})*
+        Matrix3::rotation(Deg(45.0f))*
+        Matrix3::scaling({1.0f, 2.0f}));
+    CORRADE_COMPARE(a.transformation().right().length(), 1.0f);
+    CORRADE_COMPARE(b.transformation(), Matrix3::rotation(Deg(30.0f)));
+
+    player.advance(0.25f);
+    CORRADE_COMPARE(a.transformation().right().length(), 1.0f);
+    CORRADE_COMPARE(b.transformation(), Matrix3::rotation(Deg(15.0f)));
+    CORRADE_COMPARE(b.transformation().right().length(), 1.0f);
+
+    player.advance(1.0f);
+    CORRADE_COMPARE(a.transformation(),
+        Matrix3::translation({2.0f, -2.0f})*
+        Matrix3::rotation(Deg(90.0f))*
+        Matrix3::scaling({1.0f, 3.0f}));
+    CORRADE_COMPARE(b.transformation(), Matrix3::rotation(Deg(60.0f)));
+}
+
+void TrackPlayerTest::advanceNoTracks() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3{1.0f});
+    TrackPlayer3D player{scene};
+    player.add(a, nullptr, nullptr);
+
+    /* Identity transformation gets written */
+    player.advance(1.0f);
+    CORRADE_COMPARE(a.transformation(), Matrix4{});
+}
+
+void TrackPlayerTest::advanceFlatObject() {
+    FlatScene3D scene;
+    FlatObject3D a{&scene};
+    TrackPlayer3D player{scene};
+    player.add(a, &Translation, &Rotation);
+
+    player.advance(0.5f);
+    CORRADE_COMPARE(a.transformation(),
+        Matrix4::translation({1.0f, 0.5f, 0.0f})*
+        Matrix4::rotationZ(Deg(45.0f)));
+}
+
+void TrackPlayerTest::step() {
+    Scene3D scene;
+    Object3D a{&scene};
+    AnimableGroup3D group;
+    TrackPlayer3D* player = new TrackPlayer3D{scene, &group};
+    player->add(a, &Translation, nullptr)
+        .setState(AnimationState::Running);
+
+    /* Time is relative to the animation start */
+    group.step(10.0f, 0.5f);
+    CORRADE_COMPARE(a.transformation(), Matrix4{});
+    group.step(10.5f, 0.5f);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({1.0f, 0.5f, 0.0f}));
+
+    /* After the duration the animation stops, keeping the last written
+       value */
+    group.step(12.5f, 0.5f);
+    CORRADE_COMPARE(player->state(), AnimationState::Stopped);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({1.0f, 0.5f, 0.0f}));
+}
+
+void TrackPlayerTest::stepRepeated() {
+    Scene3D scene;
+    Object3D a{&scene};
+    AnimableGroup3D group;
+    TrackPlayer3D* player = new TrackPlayer3D{scene, &group};
+    player->add(a, &Translation, nullptr)
+        .setRepeated(true)
+        .setState(AnimationState::Running);
+
+    group.step(0.0f, 0.5f);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({3.0f, 1.5f, 0.0f}));
+
+    /* Second loop, the hint goes back to the start */
+    group.step(2.5f, 0.5f);
+    CORRADE_COMPARE(player->state(), AnimationState::Running);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({1.0f, 0.5f, 0.0f}));
+}
+
+void TrackPlayerTest::sharedTracks() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+
+    /* Two players sharing the same tracks at different positions */
+    TrackPlayer3D first{scene};
+    first.add(a, &Translation, &Rotation);
+    TrackPlayer3D second{scene};
+    second.add(b, &Translation, &Rotation);
+
+    first.advance(0.5f);
+    second.advance(2.5f);
+    first.advance(1.0f);
+    CORRADE_COMPARE(a.transformation(),
+        Matrix4::translation({2.0f, 1.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(90.0f)));
+    CORRADE_COMPARE(b.transformation(),
+        Matrix4::translation({4.0f, 2.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(157.5f)));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackPlayerTest)
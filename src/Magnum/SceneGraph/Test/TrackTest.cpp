@@ -0,0 +1,309 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/SceneGraph/Track.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct TrackTest: TestSuite::Tester {
+    explicit TrackTest();
+
+    void construct();
+    void constructEmpty();
+    void constructNotSorted();
+    void constructSlerpNotQuaternion();
+    void constructCubicQuaternion();
+
+    void sampleEmpty();
+    void sampleSingleKeyframe();
+    void sampleClamp();
+    void sampleStep();
+    void sampleLinear();
+    void sampleLinearQuaternion();
+    void sampleLinearComplex();
+    void sampleSlerp();
+    void sampleSlerpComplex();
+    void sampleCubic();
+    void sampleCubicLinearMotion();
+
+    void hintSequential();
+    void hintSkip();
+    void hintBackwards();
+    void hintInvalid();
+
+    void debugInterpolation();
+};
+
+TrackTest::TrackTest() {
+    addTests({&TrackTest::construct,
+              &TrackTest::constructEmpty,
+              &TrackTest::constructNotSorted,
+              &TrackTest::constructSlerpNotQuaternion,
+              &TrackTest::constructCubicQuaternion,
+
+              &TrackTest::sampleEmpty,
+              &TrackTest::sampleSingleKeyframe,
+              &TrackTest::sampleClamp,
+              &TrackTest::sampleStep,
+              &TrackTest::sampleLinear,
+              &TrackTest::sampleLinearQuaternion,
+              &TrackTest::sampleLinearComplex,
+              &TrackTest::sampleSlerp,
+              &TrackTest::sampleSlerpComplex,
+              &TrackTest::sampleCubic,
+              &TrackTest::sampleCubicLinearMotion,
+
+              &TrackTest::hintSequential,
+              &TrackTest::hintSkip,
+              &TrackTest::hintBackwards,
+              &TrackTest::hintInvalid,
+
+              &TrackTest::debugInterpolation});
+}
+
+void TrackTest::construct() {
+    Track<Vector3> track{{
+        {0.5f, Vector3{1.0f}},
+        {2.0f, Vector3{3.0f}}
+    }, Interpolation::Cubic};
+    CORRADE_COMPARE(track.keyframes().size(), 2);
+    CORRADE_COMPARE(track.keyframes()[1].first, 2.0f);
+    CORRADE_COMPARE(track.keyframes()[1].second, Vector3{3.0f});
+    CORRADE_COMPARE(track.interpolation(), Interpolation::Cubic);
+    CORRADE_COMPARE(track.duration(), 2.0f);
+}
+
+void TrackTest::constructEmpty() {
+    Track<Float> track;
+    CORRADE_VERIFY(track.keyframes().empty());
+    CORRADE_COMPARE(track.interpolation(), Interpolation::Linear);
+    CORRADE_COMPARE(track.duration(), 0.0f);
+}
+
+void TrackTest::constructNotSorted() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    Track<Float>{{{1.0f, 0.0f}, {0.5f, 1.0f}}};
+    CORRADE_COMPARE(out.str(), "SceneGraph::Track: keyframes are not sorted by time\n");
+}
+
+void TrackTest::constructSlerpNotQuaternion() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    Track<Vector3>{{}, Interpolation::Slerp};
+    CORRADE_COMPARE(out.str(), "SceneGraph::Track: slerp interpolation is available only for quaternions and complex numbers\n");
+}
+
+void TrackTest::constructCubicQuaternion() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    Track<Quaternion>{{}, Interpolation::Cubic};
+    Track<Complex>{{}, Interpolation::Cubic};
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::Track: cubic interpolation is not available for quaternions and complex numbers\n"
+        "SceneGraph::Track: cubic interpolation is not available for quaternions and complex numbers\n");
+}
+
+void TrackTest::sampleEmpty() {
+    CORRADE_COMPARE(Track<Vector3>{}.at(1.0f), Vector3{});
+    CORRADE_COMPARE(Track<Quaternion>{}.at(1.0f), Quaternion{});
+}
+
+void TrackTest::sampleSingleKeyframe() {
+    Track<Float> track{{{1.0f, 3.5f}}};
+    CORRADE_COMPARE(track.at(0.0f), 3.5f);
+    CORRADE_COMPARE(track.at(1.0f), 3.5f);
+    CORRADE_COMPARE(track.at(7.0f), 3.5f);
+}
+
+void TrackTest::sampleClamp() {
+    Track<Float> track{{{1.0f, 2.0f}, {2.0f, 4.0f}, {3.0f, 1.0f}}};
+    CORRADE_COMPARE(track.at(-5.0f), 2.0f);
+    CORRADE_COMPARE(track.at(1.0f), 2.0f);
+    CORRADE_COMPARE(track.at(3.0f), 1.0f);
+    CORRADE_COMPARE(track.at(10.0f), 1.0f);
+}
+
+void TrackTest::sampleStep() {
+    Track<Vector3> track{{
+        {0.0f, Vector3{1.0f}},
+        {1.0f, Vector3{2.0f}},
+        {2.0f, Vector3{5.0f}}
+    }, Interpolation::Step};
+    CORRADE_COMPARE(track.at(0.5f), Vector3{1.0f});
+    CORRADE_COMPARE(track.at(1.0f), Vector3{2.0f});
+    CORRADE_COMPARE(track.at(1.99f), Vector3{2.0f});
+    CORRADE_COMPARE(track.at(2.0f), Vector3{5.0f});
+}
+
+void TrackTest::sampleLinear() {
+    Track<Vector3> track{{
+        {0.0f, {0.0f, 0.0f, 0.0f}},
+        {1.0f, {2.0f, 4.0f, 0.0f}},
+        {3.0f, {2.0f, 0.0f, 1.0f}}
+    }};
+    CORRADE_COMPARE(track.at(0.25f), (Vector3{0.5f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(track.at(1.0f), (Vector3{2.0f, 4.0f, 0.0f}));
+    CORRADE_COMPARE(track.at(2.5f), (Vector3{2.0f, 1.0f, 0.75f}));
+}
+
+void TrackTest::sampleLinearQuaternion() {
+    const Quaternion a = Quaternion::rotation(Deg(0.0f), Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(Deg(90.0f), Vector3::xAxis());
+    Track<Quaternion> track{{{0.0f, a}, {2.0f, b}}};
+
+    /* Normalized */
+    CORRADE_COMPARE(track.at(1.0f), Math::lerp(a, b, 0.5f));
+    CORRADE_VERIFY(track.at(1.0f).isNormalized());
+}
+
+void TrackTest::sampleLinearComplex() {
+    const Complex a = Complex::rotation(Deg(0.0f));
+    const Complex b = Complex::rotation(Deg(90.0f));
+    Track<Complex> track{{{0.0f, a}, {2.0f, b}}};
+
+    /* Normalized, exactly in the middle of the interval */
+    CORRADE_COMPARE(track.at(1.0f), Complex::rotation(Deg(45.0f)));
+    CORRADE_COMPARE(track.at(1.0f).length(), 1.0f);
+    CORRADE_VERIFY(track.at(0.5f).isNormalized());
+}
+
+void TrackTest::sampleSlerp() {
+    const Quaternion a = Quaternion::rotation(Deg(0.0f), Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(Deg(90.0f), Vector3::xAxis());
+    Track<Quaternion> track{{{0.0f, a}, {2.0f, b}}, Interpolation::Slerp};
+
+    CORRADE_COMPARE(track.at(0.5f), Quaternion::rotation(Deg(22.5f), Vector3::xAxis()));
+    CORRADE_COMPARE(track.at(1.0f), Quaternion::rotation(Deg(45.0f), Vector3::xAxis()));
+}
+
+void TrackTest::sampleSlerpComplex() {
+    const Complex a = Complex::rotation(Deg(0.0f));
+    const Complex b = Complex::rotation(Deg(90.0f));
+    Track<Complex> track{{{0.0f, a}, {2.0f, b}}, Interpolation::Slerp};
+
+    CORRADE_COMPARE(track.at(0.5f), Complex::rotation(Deg(22.5f)));
+    CORRADE_COMPARE(track.at(1.0f), Complex::rotation(Deg(45.0f)));
+
+    /* Shorter arc, going clockwise across the discontinuity */
+    Track<Complex> wrapped{{{0.0f, Complex::rotation(Deg(-170.0f))}, {1.0f, Complex::rotation(Deg(170.0f))}}, Interpolation::Slerp};
+    CORRADE_COMPARE(wrapped.at(0.25f), Complex::rotation(Deg(-175.0f)));
+}
+
+void TrackTest::sampleCubic() {
+    Track<Float> track{{{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 0.0f}, {4.0f, 2.0f}}, Interpolation::Cubic};
+
+    /* Passes through the keyframes */
+    CORRADE_COMPARE(track.at(1.0f), 1.0f);
+    CORRADE_COMPARE(track.at(2.0f), 0.0f);
+
+    /* Tangent at the first keyframe is one-sided (1), at the second it's
+       (0 - 0)/2 = 0, so the value is h10(0.5) + h01(0.5) */
+    CORRADE_COMPARE(track.at(0.5f), 0.625f);
+
+    /* Tangent at the second keyframe is (0 - 0)/2 = 0, at the third it's
+       (2 - 1)/3 scaled to the interval */
+    CORRADE_COMPARE(track.at(1.5f), 0.5f - 1.0f/24.0f);
+}
+
+void TrackTest::sampleCubicLinearMotion() {
+    /* Values on a line with uneven keyframe spacing are reproduced
+       exactly, without overshooting */
+    Track<Vector3> track{{
+        {0.0f, Vector3{0.0f}},
+        {0.5f, Vector3{1.0f}},
+        {2.0f, Vector3{4.0f}},
+        {2.25f, Vector3{4.5f}}
+    }, Interpolation::Cubic};
+    for(Float time: {0.1f, 0.4f, 0.75f, 1.3f, 1.9f, 2.1f})
+        CORRADE_COMPARE(track.at(time), Vector3{time*2.0f});
+}
+
+void TrackTest::hintSequential() {
+    Track<Float> track{{{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 2.0f}, {3.0f, 3.0f}, {4.0f, 4.0f}}};
+
+    std::size_t hint{};
+    CORRADE_COMPARE(track.at(0.5f, hint), 0.5f);
+    CORRADE_COMPARE(hint, 0);
+    CORRADE_COMPARE(track.at(0.75f, hint), 0.75f);
+    CORRADE_COMPARE(hint, 0);
+    CORRADE_COMPARE(track.at(1.5f, hint), 1.5f);
+    CORRADE_COMPARE(hint, 1);
+    CORRADE_COMPARE(track.at(2.0f, hint), 2.0f);
+    CORRADE_COMPARE(hint, 2);
+    CORRADE_COMPARE(track.at(3.5f, hint), 3.5f);
+    CORRADE_COMPARE(hint, 3);
+
+    /* After the end */
+    CORRADE_COMPARE(track.at(5.0f, hint), 4.0f);
+    CORRADE_COMPARE(hint, 3);
+}
+
+void TrackTest::hintSkip() {
+    Track<Float> track{{{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 2.0f}, {3.0f, 3.0f}, {4.0f, 4.0f}}};
+
+    /* Skipping more than one keyframe falls back to a binary search */
+    std::size_t hint{};
+    CORRADE_COMPARE(track.at(0.5f, hint), 0.5f);
+    CORRADE_COMPARE(track.at(3.25f, hint), 3.25f);
+    CORRADE_COMPARE(hint, 3);
+}
+
+void TrackTest::hintBackwards() {
+    Track<Float> track{{{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 2.0f}, {3.0f, 3.0f}, {4.0f, 4.0f}}};
+
+    std::size_t hint{};
+    CORRADE_COMPARE(track.at(3.5f, hint), 3.5f);
+    CORRADE_COMPARE(hint, 3);
+
+    /* Repeated animation going back to the start */
+    CORRADE_COMPARE(track.at(1.25f, hint), 1.25f);
+    CORRADE_COMPARE(hint, 1);
+    CORRADE_COMPARE(track.at(-1.0f, hint), 0.0f);
+    CORRADE_COMPARE(hint, 0);
+}
+
+void TrackTest::hintInvalid() {
+    Track<Float> track{{{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 2.0f}}};
+
+    /* Hint from a longer track */
+    std::size_t hint = 57;
+    CORRADE_COMPARE(track.at(1.5f, hint), 1.5f);
+    CORRADE_COMPARE(hint, 1);
+}
+
+void TrackTest::debugInterpolation() {
+    std::ostringstream o;
+    Debug(&o) << Interpolation::Slerp << Interpolation(0xbe);
+    CORRADE_COMPARE(o.str(), "SceneGraph::Interpolation::Slerp SceneGraph::Interpolation(0xbe)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackTest)
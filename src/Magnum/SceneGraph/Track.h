@@ -0,0 +1,287 @@
+#ifndef Magnum_SceneGraph_Track_h
+#define Magnum_SceneGraph_Track_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::Track, enum @ref Magnum::SceneGraph::Interpolation
+ */
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Keyframe interpolation
+
+@see @ref Track
+*/
+enum class Interpolation: UnsignedByte {
+    /** Value of the previous keyframe is used until the next keyframe. */
+    Step,
+
+    /**
+     * Linear interpolation between two keyframes. Quaternions and complex
+     * numbers are linearly interpolated and normalized, see
+     * @ref Math::lerp(const Quaternion<T>&, const Quaternion<T>&, T).
+     */
+    Linear,
+
+    /**
+     * Spherical linear interpolation between two keyframes, see
+     * @ref Math::slerp(const Quaternion<T>&, const Quaternion<T>&, T).
+     * Complex numbers are rotated with constant angular velocity along the
+     * shorter arc. Available only for quaternion and complex number tracks.
+     */
+    Slerp,
+
+    /**
+     * Cubic Hermite interpolation with tangents calculated from neighboring
+     * keyframes (Catmull-Rom spline taking keyframe spacing into account).
+     * The curve passes through all keyframes and keeps the velocity
+     * continuous. Not available for quaternion and complex number tracks.
+     */
+    Cubic
+};
+
+/** @debugoperatorenum{Interpolation} */
+MAGNUM_SCENEGRAPH_EXPORT Debug& operator<<(Debug& debug, Interpolation value);
+
+namespace Implementation {
+    template<class> struct IsRotation: std::false_type {};
+    template<class T> struct IsRotation<Math::Complex<T>>: std::true_type {};
+    template<class T> struct IsRotation<Math::Quaternion<T>>: std::true_type {};
+
+    template<class V> inline V trackLerp(const V& a, const V& b, Float t) {
+        return Math::lerp(a, b, t);
+    }
+    /* The generic Math::lerp() doesn't normalize complex numbers, which would
+       make the rotation scale the object as well */
+    template<class T> inline Math::Complex<T> trackLerp(const Math::Complex<T>& a, const Math::Complex<T>& b, Float t) {
+        return ((T(1) - T(t))*a + T(t)*b).normalized();
+    }
+    template<class T> inline Math::Quaternion<T> trackLerp(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, Float t) {
+        return Math::lerp(a, b, T(t));
+    }
+
+    template<class V> inline V trackSlerp(const V& a, const V& b, Float t) {
+        return Math::lerp(a, b, t);
+    }
+    /* Unlike the acos() of a dot product, the atan2() of the relative rotation
+       is well-conditioned also for (nearly) identical and opposite rotations */
+    template<class T> inline Math::Complex<T> trackSlerp(const Math::Complex<T>& a, const Math::Complex<T>& b, Float t) {
+        const Math::Complex<T> relative = a.conjugated()*b;
+        return a*Math::Complex<T>::rotation(Math::Rad<T>(T(t)*std::atan2(relative.imaginary(), relative.real())));
+    }
+    template<class T> inline Math::Quaternion<T> trackSlerp(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, Float t) {
+        return Math::slerp(a, b, T(t));
+    }
+}
+
+/**
+@brief Animation track
+
+Stores keyframes of a single animated value, such as position of an object, in
+a contiguous array of time and value pairs sorted by time, and samples it at
+arbitrary time using given @ref Interpolation. Before the first and after the
+last keyframe the value is clamped to the first or last keyframe. The track
+doesn't depend on rest of the scene graph, it's usually played using
+@ref TrackPlayer, which writes the sampled values to object transformations.
+
+@code{.cpp}
+SceneGraph::Track<Vector3> position{{
+    {0.0f, Vector3{0.0f}},
+    {1.5f, Vector3{2.0f, 1.0f, 0.0f}},
+    {4.0f, Vector3{5.0f, 0.0f, 0.0f}}
+}, SceneGraph::Interpolation::Cubic};
+
+Vector3 value = position.at(2.0f);
+@endcode
+
+@section SceneGraph-Track-hint Sampling with a hint
+
+Finding the keyframes surrounding given time needs a binary search in the
+general case. When the track is sampled repeatedly with increasing time, as
+is the case in playback, you can pass a variable holding index of the
+previously used keyframe to @ref at(Float, std::size_t&) const. If the time
+is still between the same keyframes or the immediately following ones, the
+value is found in constant time, otherwise it falls back to a binary search.
+The hint is updated on every call, one variable per track and playing
+instance is needed:
+
+@code{.cpp}
+std::size_t hint{};
+for(Float time: frameTimes) {
+    Vector3 value = position.at(time, hint);
+    // ...
+}
+@endcode
+
+@see @ref TrackPlayer, @ref Animable
+*/
+template<class V> class Track {
+    public:
+        /** @brief Value type */
+        typedef V ValueType;
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates a track with no keyframes. Sampling it returns a
+         * default-constructed value.
+         */
+        explicit Track(): _interpolation{Interpolation::Linear} {}
+
+        /**
+         * @brief Constructor
+         * @param keyframes     Pairs of keyframe time and value, sorted by
+         *      time
+         * @param interpolation Keyframe interpolation
+         *
+         * Expects that @ref Interpolation::Slerp is used only for quaternion
+         * and complex number tracks and @ref Interpolation::Cubic only for
+         * other tracks.
+         */
+        explicit Track(std::vector<std::pair<Float, V>> keyframes, Interpolation interpolation = Interpolation::Linear);
+
+        /** @brief Keyframes */
+        const std::vector<std::pair<Float, V>>& keyframes() const { return _keyframes; }
+
+        /** @brief Keyframe interpolation */
+        Interpolation interpolation() const { return _interpolation; }
+
+        /**
+         * @brief Duration
+         *
+         * Time of the last keyframe or @cpp 0.0f @ce if there are no
+         * keyframes. Usable as @ref Animable::setDuration().
+         */
+        Float duration() const {
+            return _keyframes.empty() ? 0.0f : _keyframes.back().first;
+        }
+
+        /**
+         * @brief Sample the track
+         *
+         * Finds the keyframes using a binary search. If you sample the track
+         * repeatedly with increasing time, use @ref at(Float, std::size_t&) const
+         * instead.
+         */
+        V at(Float time) const {
+            std::size_t hint{};
+            return at(time, hint);
+        }
+
+        /**
+         * @brief Sample the track with a hint
+         * @param time      Time at which to sample
+         * @param hint      Index of the keyframe used in the previous call,
+         *      updated on return
+         *
+         * See @ref SceneGraph-Track-hint for more information.
+         */
+        V at(Float time, std::size_t& hint) const;
+
+    private:
+        std::vector<std::pair<Float, V>> _keyframes;
+        Interpolation _interpolation;
+};
+
+template<class V> Track<V>::Track(std::vector<std::pair<Float, V>> keyframes, const Interpolation interpolation): _keyframes{std::move(keyframes)}, _interpolation{interpolation} {
+    CORRADE_ASSERT(interpolation != Interpolation::Slerp || Implementation::IsRotation<V>::value,
+        "SceneGraph::Track: slerp interpolation is available only for quaternions and complex numbers", );
+    CORRADE_ASSERT(interpolation != Interpolation::Cubic || !Implementation::IsRotation<V>::value,
+        "SceneGraph::Track: cubic interpolation is not available for quaternions and complex numbers", );
+    CORRADE_ASSERT(std::is_sorted(_keyframes.begin(), _keyframes.end(), [](const std::pair<Float, V>& a, const std::pair<Float, V>& b) { return a.first < b.first; }),
+        "SceneGraph::Track: keyframes are not sorted by time", );
+}
+
+template<class V> V Track<V>::at(const Float time, std::size_t& hint) const {
+    const std::size_t count = _keyframes.size();
+    if(!count) return V{};
+
+    /* Clamp before the first and after the last keyframe */
+    if(count == 1 || !(time > _keyframes.front().first)) {
+        hint = 0;
+        return _keyframes.front().second;
+    }
+    if(!(time < _keyframes.back().first)) {
+        hint = count - 2;
+        return _keyframes.back().second;
+    }
+
+    /* Sequential playback: the time is still in the hinted interval or in
+       the next one. Otherwise (time went back or skipped many keyframes)
+       do a binary search. Keyframes at the ends are handled above, so the
+       search always finds an interval inside the track. */
+    if(hint < count - 1 && _keyframes[hint].first <= time) {
+        if(time >= _keyframes[hint + 1].first) {
+            if(time < _keyframes[hint + 2].first) ++hint;
+            else hint = std::upper_bound(_keyframes.begin() + hint + 2, _keyframes.end(), time, [](Float time, const std::pair<Float, V>& keyframe) { return time < keyframe.first; }) - _keyframes.begin() - 1;
+        }
+    } else hint = std::upper_bound(_keyframes.begin(), _keyframes.end(), time, [](Float time, const std::pair<Float, V>& keyframe) { return time < keyframe.first; }) - _keyframes.begin() - 1;
+
+    const std::pair<Float, V>& a = _keyframes[hint];
+    const std::pair<Float, V>& b = _keyframes[hint + 1];
+    const Float duration = b.first - a.first;
+    const Float t = (time - a.first)/duration;
+
+    switch(_interpolation) {
+        case Interpolation::Step:
+            return a.second;
+        case Interpolation::Linear:
+            return Implementation::trackLerp(a.second, b.second, t);
+        case Interpolation::Slerp:
+            return Implementation::trackSlerp(a.second, b.second, t);
+        case Interpolation::Cubic: {
+            /* Tangents from neighbor keyframes, scaled to the interval
+               duration, one-sided at the ends of the track */
+            const std::pair<Float, V>& before = _keyframes[hint ? hint - 1 : hint];
+            const std::pair<Float, V>& after = _keyframes[hint + 2 < count ? hint + 2 : hint + 1];
+            const V tangentA = (b.second - before.second)*(duration/(b.first - before.first));
+            const V tangentB = (after.second - a.second)*(duration/(after.first - a.first));
+
+            const Float t2 = t*t;
+            const Float t3 = t2*t;
+            return a.second*(2.0f*t3 - 3.0f*t2 + 1.0f) + tangentA*(t3 - 2.0f*t2 + t) + b.second*(-2.0f*t3 + 3.0f*t2) + tangentB*(t3 - t2);
+        }
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef Magnum_SceneGraph_TrackPlayer_h
+#define Magnum_SceneGraph_TrackPlayer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::TrackPlayer, alias @ref Magnum::SceneGraph::BasicTrackPlayer2D, @ref Magnum::SceneGraph::BasicTrackPlayer3D, typedef @ref Magnum::SceneGraph::TrackPlayer2D, @ref Magnum::SceneGraph::TrackPlayer3D
+ */
+
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneGraph/Animable.h"
+#include "Magnum/SceneGraph/Track.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    template<UnsignedInt, class> struct TrackPlayerTraits;
+    template<class T> struct TrackPlayerTraits<2, T> {
+        typedef Math::Complex<T> RotationType;
+    };
+    template<class T> struct TrackPlayerTraits<3, T> {
+        typedef Math::Quaternion<T> RotationType;
+    };
+}
+
+/**
+@brief Animation track player
+
+@ref Animable that plays translation, rotation and scaling @ref Track "tracks"
+and writes the result to transformations of given objects. The tracks are
+referenced, not copied, so a single set of tracks can be shared by many
+players, each keeping its own playback position.
+
+@section SceneGraph-TrackPlayer-usage Usage
+
+Add the player to an object --- usually the root of an animated hierarchy ---
+and bind the tracks to objects that should be animated. Any object with a
+@cpp setTransformation() @ce function taking a matrix can be animated, such as
+@ref Object with @ref MatrixTransformation3D or a @ref FlatObject. The
+duration of the animation is set to the duration of the longest track, the
+animation is then controlled through the usual @ref Animable interface:
+
+@code{.cpp}
+SceneGraph::Track<Vector3> armTranslation{...};
+SceneGraph::Track<Quaternion> armRotation{..., SceneGraph::Interpolation::Slerp};
+
+auto player = new SceneGraph::TrackPlayer3D{character, &animables};
+player->add(*arm, &armTranslation, &armRotation)
+    .setRepeated(true)
+    .setState(SceneGraph::AnimationState::Running);
+@endcode
+
+Tracks that are @cpp nullptr @ce contribute an identity transformation. The
+objects have to exist for the whole lifetime of the player or until
+@ref clear() is called.
+
+@section SceneGraph-TrackPlayer-performance Performance
+
+Each track keeps a hint of the last used keyframe, so sampling is done in
+constant time when the animation is playing. The values of all bound tracks
+are first sampled and composed into an array of transformations in a single
+pass and then written to the objects in a second pass.
+
+Groups containing players can be stepped on multiple threads via
+@ref AnimableGroup::step(), as long as each object is bound to only one
+player. See @ref SceneGraph-Animable-multithreading for details.
+
+@section SceneGraph-TrackPlayer-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref TrackPlayer.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref TrackPlayer2D
+-   @ref TrackPlayer3D
+
+@see @ref scenegraph, @ref BasicTrackPlayer2D, @ref BasicTrackPlayer3D,
+    @ref TrackPlayer2D, @ref TrackPlayer3D
+*/
+template<UnsignedInt dimensions, class T> class TrackPlayer: public Animable<dimensions, T> {
+    public:
+        /** @brief Translation and scaling value type */
+        typedef VectorTypeFor<dimensions, T> VectorType;
+
+        /**
+         * @brief Rotation value type
+         *
+         * @ref Math::Complex in 2D, @ref Math::Quaternion in 3D.
+         */
+        typedef typename Implementation::TrackPlayerTraits<dimensions, T>::RotationType RotationType;
+
+        /** @brief Transformation matrix type */
+        typedef MatrixTypeFor<dimensions, T> MatrixType;
+
+        /**
+         * @brief Constructor
+         * @param object    Object this player belongs to
+         * @param group     Group this player belongs to
+         *
+         * Creates a stopped player with no tracks.
+         */
+        explicit TrackPlayer(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group = nullptr);
+
+        /** @brief Count of bound objects */
+        std::size_t size() const { return _bindings.size(); }
+
+        /**
+         * @brief Bind tracks to an object
+         * @param object        Object to animate
+         * @param translation   Translation track or @cpp nullptr @ce
+         * @param rotation      Rotation track or @cpp nullptr @ce
+         * @param scaling       Scaling track or @cpp nullptr @ce
+         * @return Reference to self (for method chaining)
+         *
+         * The object transformation is set to the translation, rotation and
+         * scaling applied in this order (i.e., scaling first) on every
+         * animation step. If the longest of the tracks is longer than
+         * current @ref duration(), the duration is extended to it.
+         */
+        template<class Object> TrackPlayer<dimensions, T>& add(Object& object, const Track<VectorType>* translation, const Track<RotationType>* rotation, const Track<VectorType>* scaling = nullptr) {
+            return addInternal(&object, [](void* object, const MatrixType& transformation) {
+                static_cast<Object*>(object)->setTransformation(transformation);
+            }, translation, rotation, scaling);
+        }
+
+        /**
+         * @brief Remove all bound objects
+         * @return Reference to self (for method chaining)
+         *
+         * Also resets @ref duration() to @cpp 0.0f @ce.
+         */
+        TrackPlayer<dimensions, T>& clear();
+
+        /**
+         * @brief Sample the tracks and update object transformations
+         *
+         * Called from @ref animationStep() with time from the animation
+         * start, you can call it directly to play the tracks without
+         * @ref AnimableGroup.
+         */
+        void advance(Float time);
+
+        /* Overloads to remove WTF-factor from method chaining order */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        TrackPlayer<dimensions, T>& setState(AnimationState state) {
+            Animable<dimensions, T>::setState(state);
+            return *this;
+        }
+        TrackPlayer<dimensions, T>& setRepeated(bool repeated) {
+            Animable<dimensions, T>::setRepeated(repeated);
+            return *this;
+        }
+        TrackPlayer<dimensions, T>& setRepeatCount(UnsignedShort count) {
+            Animable<dimensions, T>::setRepeatCount(count);
+            return *this;
+        }
+        #endif
+
+    private:
+        typedef void(*SetTransformation)(void*, const MatrixType&);
+
+        struct Binding {
+            void* object;
+            SetTransformation setTransformation;
+            const Track<VectorType>* translation;
+            const Track<RotationType>* rotation;
+            const Track<VectorType>* scaling;
+            std::size_t translationHint, rotationHint, scalingHint;
+        };
+
+        TrackPlayer<dimensions, T>& addInternal(void* object, SetTransformation setTransformation, const Track<VectorType>* translation, const Track<RotationType>* rotation, const Track<VectorType>* scaling);
+
+        void animationStep(Float time, Float delta) override;
+
+        std::vector<Binding> _bindings;
+
+        /* Sampled transformations, kept to reuse the memory */
+        std::vector<MatrixType> _transformations;
+};
+
+/**
+@brief Track player for two-dimensional scenes
+
+Convenience alternative to @cpp TrackPlayer<2, T> @ce. See @ref TrackPlayer
+for more information.
+@see @ref TrackPlayer2D, @ref BasicTrackPlayer3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicTrackPlayer2D = TrackPlayer<2, T>;
+#endif
+
+/**
+@brief Track player for two-dimensional float scenes
+
+@see @ref TrackPlayer3D
+*/
+typedef BasicTrackPlayer2D<Float> TrackPlayer2D;
+
+/**
+@brief Track player for three-dimensional scenes
+
+Convenience alternative to @cpp TrackPlayer<3, T> @ce. See @ref TrackPlayer
+for more information.
+@see @ref TrackPlayer3D, @ref BasicTrackPlayer2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicTrackPlayer3D = TrackPlayer<3, T>;
+#endif
+
+/**
+@brief Track player for three-dimensional float scenes
+
+@see @ref TrackPlayer2D
+*/
+typedef BasicTrackPlayer3D<Float> TrackPlayer3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT TrackPlayer<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT TrackPlayer<3, Float>;
+#endif
+
+}}
+
+#endif
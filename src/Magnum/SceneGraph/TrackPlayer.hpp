@@ -0,0 +1,90 @@
+#ifndef Magnum_SceneGraph_TrackPlayer_hpp
+#define Magnum_SceneGraph_TrackPlayer_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref TrackPlayer.h
+ */
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Animable.hpp"
+#include "Magnum/SceneGraph/TrackPlayer.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>::TrackPlayer(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): Animable<dimensions, T>{object, group} {}
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>& TrackPlayer<dimensions, T>::addInternal(void* const object, const SetTransformation setTransformation, const Track<VectorType>* const translation, const Track<RotationType>* const rotation, const Track<VectorType>* const scaling) {
+    _bindings.push_back({object, setTransformation, translation, rotation, scaling, 0, 0, 0});
+
+    Float duration = this->duration();
+    if(translation) duration = Math::max(duration, translation->duration());
+    if(rotation) duration = Math::max(duration, rotation->duration());
+    if(scaling) duration = Math::max(duration, scaling->duration());
+    this->setDuration(duration);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>& TrackPlayer<dimensions, T>::clear() {
+    _bindings.clear();
+    this->setDuration(0.0f);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void TrackPlayer<dimensions, T>::advance(const Float time) {
+    /* Sample all tracks first, so the keyframe data are accessed in one
+       tight loop */
+    _transformations.resize(_bindings.size());
+    for(std::size_t i = 0; i != _bindings.size(); ++i) {
+        Binding& binding = _bindings[i];
+
+        Math::Matrix<dimensions, T> rotationScaling;
+        if(binding.rotation)
+            rotationScaling = binding.rotation->at(time, binding.rotationHint).toMatrix();
+        if(binding.scaling) {
+            const VectorType scaling = binding.scaling->at(time, binding.scalingHint);
+            for(std::size_t j = 0; j != dimensions; ++j)
+                rotationScaling[j] *= scaling[j];
+        }
+
+        _transformations[i] = MatrixType::from(rotationScaling, binding.translation ?
+            binding.translation->at(time, binding.translationHint) : VectorType{});
+    }
+
+    /* Then write them to the objects */
+    for(std::size_t i = 0; i != _bindings.size(); ++i)
+        _bindings[i].setTransformation(_bindings[i].object, _transformations[i]);
+}
+
+template<UnsignedInt dimensions, class T> void TrackPlayer<dimensions, T>::animationStep(const Float time, Float) {
+    advance(time);
+}
+
+}}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef Magnum_SceneGraph_boundsImplementation_h
+#define Magnum_SceneGraph_boundsImplementation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+/* Axis-aligned box enclosing given box transformed with given matrix */
+template<UnsignedInt dimensions, class T> Math::Range<dimensions, T> transformedBoundingBox(const MatrixTypeFor<dimensions, T>& matrix, const Math::Range<dimensions, T>& box) {
+    const VectorTypeFor<dimensions, T> center = matrix.transformPoint(box.center());
+    const VectorTypeFor<dimensions, T> halfSize = box.size()/T(2);
+    VectorTypeFor<dimensions, T> extent;
+    for(std::size_t col = 0; col != dimensions; ++col)
+        for(std::size_t row = 0; row != dimensions; ++row)
+            extent[row] += Math::abs(matrix[col][row])*halfSize[col];
+    return {center - extent, center + extent};
+}
+
+/* Radius of a sphere with given radius transformed with given matrix, i.e.
+   the radius multiplied by the largest singular value of the upper-left part.
+   Instead of computing it exactly, the largest eigenvalue of its Gram matrix
+   is bounded from above by the largest absolute row sum (Gershgorin), which
+   is exact for rotation with arbitrary axis-aligned scaling and conservative
+   for shear. Just taking the longest column wouldn't be conservative with
+   shear. */
+template<UnsignedInt dimensions, class T> T transformedBoundingSphereRadius(const MatrixTypeFor<dimensions, T>& matrix, T radius) {
+    const auto rotationScaling = matrix.rotationScaling();
+    T maxScalingSquared{};
+    for(std::size_t col = 0; col != dimensions; ++col) {
+        T rowSum{};
+        for(std::size_t other = 0; other != dimensions; ++other)
+            rowSum += Math::abs(Math::dot(rotationScaling[col], rotationScaling[other]));
+        maxScalingSquared = Math::max(maxScalingSquared, rowSum);
+    }
+    return radius*std::sqrt(maxScalingSquared);
+}
+
+}}}
+
+#endif
@@ -30,11 +30,14 @@
 #include "Magnum/SceneGraph/DualComplexTransformation.h"
 #include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/FeatureGroup.hpp"
+#include "Magnum/SceneGraph/FlatObject.hpp"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Object.hpp"
 #include "Magnum/SceneGraph/RigidMatrixTransformation2D.h"
 #include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
+#include "Magnum/SceneGraph/SpatialBounds.hpp"
+#include "Magnum/SceneGraph/TrackPlayer.hpp"
 #include "Magnum/SceneGraph/TranslationTransformation.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -69,6 +72,11 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<3, Float>;
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualComplexTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualQuaternionTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicMatrixTransformation2D<Float>>;
@@ -77,6 +85,14 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformatio
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformation3D<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<2, Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP SpatialBounds<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP SpatialBounds<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP SpatialIndex<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP SpatialIndex<3, Float>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackPlayer<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackPlayer<3, Float>;
 #endif
 
 }}
@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "parallelImplementation.h"
+
+#include <utility>
+#include <vector>
+
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <thread>
+#endif
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+namespace {
+
+typedef std::vector<std::pair<void(*)(void*), void*>> Deferred;
+
+/* Deferred modifications of the chunk processed by current thread, null if
+   not inside parallelForDeferred() */
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#if !defined(CORRADE_GCC47_COMPATIBILITY) && !defined(CORRADE_TARGET_APPLE)
+thread_local
+#else
+__thread
+#endif
+#endif
+Deferred* currentDeferred = nullptr;
+
+UnsignedInt chunkCount(const std::size_t count, UnsignedInt threadCount) {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    /* Use all available cores if not specified otherwise. The function may
+       return 0 if it isn't able to detect anything. */
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+
+    /* Don't spawn threads with nothing to do */
+    if(threadCount > count) threadCount = UnsignedInt(count);
+    #else
+    threadCount = 1;
+    #endif
+
+    if(!count) return 0;
+    return threadCount ? threadCount : 1;
+}
+
+/* Calls function(state, chunk, begin, end) for all chunks, each on a
+   different thread */
+void parallelForChunks(const std::size_t count, const UnsignedInt chunkCount, void(*const function)(void*, std::size_t, std::size_t, std::size_t), void* const state) {
+    /* Single-threaded case, don't spawn anything */
+    if(chunkCount <= 1) {
+        if(count) function(state, 0, 0, count);
+        return;
+    }
+
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    /* Distribute the remainder over the first chunks, so the chunk sizes
+       differ by one at most */
+    const std::size_t chunkSize = count/chunkCount;
+    const std::size_t remainder = count%chunkCount;
+
+    /* Spawn threads for all chunks except the last one, process the last one
+       on this thread */
+    std::vector<std::thread> threads;
+    threads.reserve(chunkCount - 1);
+    std::size_t begin = 0;
+    for(std::size_t i = 0; i != chunkCount - 1; ++i) {
+        const std::size_t end = begin + chunkSize + (i < remainder ? 1 : 0);
+        threads.emplace_back(function, state, i, begin, end);
+        begin = end;
+    }
+    function(state, chunkCount - 1, begin, count);
+
+    for(std::thread& thread: threads) thread.join();
+    #endif
+}
+
+struct ParallelForState {
+    void(*function)(void*, std::size_t, std::size_t);
+    void* state;
+    Deferred* deferred;
+};
+
+}
+
+void parallelFor(const std::size_t count, const UnsignedInt threadCount, void(*const function)(void*, std::size_t, std::size_t), void* const state) {
+    ParallelForState data{function, state, nullptr};
+    parallelForChunks(count, chunkCount(count, threadCount), [](void* data, std::size_t, std::size_t begin, std::size_t end) {
+        const ParallelForState& d = *static_cast<ParallelForState*>(data);
+        d.function(d.state, begin, end);
+    }, &data);
+}
+
+void parallelForDeferred(const std::size_t count, const UnsignedInt threadCount, void(*const function)(void*, std::size_t, std::size_t), void* const state) {
+    /* Single-threaded case, there's no need to defer anything */
+    const UnsignedInt chunks = chunkCount(count, threadCount);
+    if(chunks <= 1) {
+        if(count) function(state, 0, count);
+        return;
+    }
+
+    std::vector<Deferred> deferred(chunks);
+    ParallelForState data{function, state, deferred.data()};
+    parallelForChunks(count, chunks, [](void* data, std::size_t chunk, std::size_t begin, std::size_t end) {
+        const ParallelForState& d = *static_cast<ParallelForState*>(data);
+        currentDeferred = d.deferred + chunk;
+        d.function(d.state, begin, end);
+        currentDeferred = nullptr;
+    }, &data);
+
+    /* Apply the modifications in chunk order */
+    for(const Deferred& chunk: deferred)
+        for(const std::pair<void(*)(void*), void*>& modification: chunk)
+            modification.first(modification.second);
+}
+
+bool deferShared(void(*const function)(void*), void* const data) {
+    if(!currentDeferred) return false;
+    currentDeferred->emplace_back(function, data);
+    return true;
+}
+
+}}}
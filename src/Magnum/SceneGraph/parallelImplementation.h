@@ -0,0 +1,68 @@
+#ifndef Magnum_SceneGraph_parallelImplementation_h
+#define Magnum_SceneGraph_parallelImplementation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+/*
+Splits the [0, count) range into at most threadCount consecutive chunks of
+roughly the same size and calls function(state, begin, end) for each of them,
+every chunk on a different thread. The calling thread processes the last
+chunk and the function returns after all chunks are processed. If
+threadCount is 0, std::thread::hardware_concurrency() is used. If there's
+just one chunk or the platform has no thread support (Emscripten without
+pthreads), everything is done on the calling thread.
+
+Not a template in order to have the threading dependency contained in the
+library and not in the headers.
+*/
+MAGNUM_SCENEGRAPH_EXPORT void parallelFor(std::size_t count, UnsignedInt threadCount, void(*function)(void*, std::size_t, std::size_t), void* state);
+
+/*
+Like parallelFor(), but modifications of state shared between the chunks that
+are passed to deferShared() from the function are not done directly. Instead
+they're collected for each chunk and done on the calling thread after all
+chunks are processed, in chunk order --- i.e., in the same order as if
+everything was done on a single thread.
+*/
+MAGNUM_SCENEGRAPH_EXPORT void parallelForDeferred(std::size_t count, UnsignedInt threadCount, void(*function)(void*, std::size_t, std::size_t), void* state);
+
+/*
+If called from a function executed by parallelForDeferred(), remembers
+function(data) to be called once all chunks are processed and returns true.
+Otherwise returns false and the caller is expected to do the modification
+directly.
+*/
+MAGNUM_SCENEGRAPH_EXPORT bool deferShared(void(*function)(void*), void* data);
+
+}}}
+
+#endif
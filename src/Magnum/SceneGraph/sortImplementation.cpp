@@ -0,0 +1,91 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "sortImplementation.h"
+
+#include <cstring>
+#include <utility>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+UnsignedInt sortableFloat(const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+
+    /* Negative values have reversed order, so flip all bits. Positive values
+       just need to be put above the negative ones. */
+    return bits & 0x80000000u ? ~bits : bits|0x80000000u;
+}
+
+void radixSort(const Containers::ArrayView<UnsignedLong> keys, const Containers::ArrayView<UnsignedInt> values, const Containers::ArrayView<UnsignedLong> keyScratch, const Containers::ArrayView<UnsignedInt> valueScratch) {
+    CORRADE_INTERNAL_ASSERT(values.size() == keys.size() && keyScratch.size() == keys.size() && valueScratch.size() == keys.size());
+    const std::size_t size = keys.size();
+    if(size < 2) return;
+
+    /* Bits that differ in at least one key, passes over bytes where nothing
+       differs are skipped */
+    UnsignedLong differentBits = 0;
+    for(std::size_t i = 1; i != size; ++i)
+        differentBits |= keys[i] ^ keys[0];
+
+    UnsignedLong* keysFrom = keys.data();
+    UnsignedInt* valuesFrom = values.data();
+    UnsignedLong* keysTo = keyScratch.data();
+    UnsignedInt* valuesTo = valueScratch.data();
+    for(UnsignedInt shift = 0; shift != 64; shift += 8) {
+        if(!((differentBits >> shift) & 0xff)) continue;
+
+        /* Histogram, converted to output offsets */
+        std::size_t offsets[256]{};
+        for(std::size_t i = 0; i != size; ++i)
+            ++offsets[(keysFrom[i] >> shift) & 0xff];
+        std::size_t offset = 0;
+        for(std::size_t& i: offsets) {
+            const std::size_t count = i;
+            i = offset;
+            offset += count;
+        }
+
+        /* Scatter */
+        for(std::size_t i = 0; i != size; ++i) {
+            const std::size_t to = offsets[(keysFrom[i] >> shift) & 0xff]++;
+            keysTo[to] = keysFrom[i];
+            valuesTo[to] = valuesFrom[i];
+        }
+
+        std::swap(keysFrom, keysTo);
+        std::swap(valuesFrom, valuesTo);
+    }
+
+    /* Odd number of passes, the result is in the scratch memory */
+    if(keysFrom != keys.data()) {
+        std::memcpy(keys.data(), keysFrom, size*sizeof(UnsignedLong));
+        std::memcpy(values.data(), valuesFrom, size*sizeof(UnsignedInt));
+    }
+}
+
+}}}
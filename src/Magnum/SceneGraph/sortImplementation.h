@@ -0,0 +1,52 @@
+#ifndef Magnum_SceneGraph_sortImplementation_h
+#define Magnum_SceneGraph_sortImplementation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+/*
+Converts a float to an unsigned integer with the same ordering, i.e. for
+a < b it holds that sortableFloat(a) < sortableFloat(b). NaNs end up on either
+end depending on their sign bit.
+*/
+MAGNUM_SCENEGRAPH_EXPORT UnsignedInt sortableFloat(Float value);
+
+/*
+Stable LSD radix sort of keys and values associated with them, eight bits at
+a time. Passes in which all keys have the same byte are skipped, so sorting
+keys that differ only in a few bits is cheap. Both scratch views are expected
+to have the same size as keys and values, the result is in keys and values.
+*/
+MAGNUM_SCENEGRAPH_EXPORT void radixSort(Containers::ArrayView<UnsignedLong> keys, Containers::ArrayView<UnsignedInt> values, Containers::ArrayView<UnsignedLong> keyScratch, Containers::ArrayView<UnsignedInt> valueScratch);
+
+}}}
+
+#endif
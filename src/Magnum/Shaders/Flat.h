@@ -40,7 +40,10 @@
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
-    enum class FlatFlag: UnsignedByte { Textured = 1 << 0 };
+    enum class FlatFlag: UnsignedByte {
+        Textured = 1 << 0,
+        InstancedTransformation = 1 << 1
+    };
     typedef Containers::EnumSet<FlatFlag> FlatFlags;
 }
 
@@ -59,6 +62,14 @@ texturing is enabled.
 
 For coloring the texture based on intensity you can use the @ref Vector shader.
 
+If you pass @ref Flag::InstancedTransformation to the constructor, the shader
+takes also a per-instance @ref TransformationMatrix attribute and the matrix
+set via @ref setTransformationProjectionMatrix() is applied after it. That
+allows drawing many copies of the same mesh in a single instanced draw call,
+for example from @ref SceneGraph::InstancedDrawableBatch::draw() with the
+projection matrix set as the uniform and camera-relative transformations in
+the instance buffer.
+
 @image html shaders-flat.png
 
 @section Shaders-Flat-usage Example usage
@@ -103,6 +114,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        /**
+         * @brief Per-instance transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix3 in 2D,
+         * @ref Matrix4 in 3D. Used only if @ref Flag::InstancedTransformation
+         * is set, expected to be added to the mesh using
+         * @ref GL::Mesh::addVertexBufferInstanced().
+         */
+        typedef typename Generic<dimensions>::TransformationMatrix TransformationMatrix;
+
         #ifdef DOXYGEN_GENERATING_OUTPUT
         /**
          * @brief Flag
@@ -110,7 +131,20 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * @see @ref Flags, @ref flags()
          */
         enum class Flag: UnsignedByte {
-            Textured = 1 << 0   /**< The shader uses texture instead of color */
+            Textured = 1 << 0,  /**< The shader uses texture instead of color */
+
+            /**
+             * The shader takes a per-instance @ref TransformationMatrix
+             * attribute, which is applied before the
+             * @ref setTransformationProjectionMatrix() "transformation and projection matrix".
+             * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+             *      @gl_extension{EXT,instanced_arrays} or
+             *      @gl_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+             *      in WebGL 1.0.
+             */
+            InstancedTransformation = 1 << 1
         };
 
         /**
@@ -148,6 +182,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
+         *
+         * If @ref Flag::InstancedTransformation is set, the matrix is applied
+         * after the per-instance @ref TransformationMatrix, so usually it's
+         * just the projection matrix.
          */
         Flat<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
             setUniform(_transformationProjectionMatrixUniform, matrix);
@@ -47,8 +47,19 @@ in mediump vec2 textureCoordinates;
 out mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat3 instancedTransformationMatrix;
+#endif
+
 void main() {
+    #ifndef INSTANCED_TRANSFORMATION
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
+    #else
+    gl_Position.xywz = vec4(transformationProjectionMatrix*instancedTransformationMatrix*vec3(position, 1.0), 0.0);
+    #endif
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
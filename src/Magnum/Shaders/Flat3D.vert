@@ -47,8 +47,19 @@ in mediump vec2 textureCoordinates;
 out mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
 void main() {
+    #ifndef INSTANCED_TRANSFORMATION
     gl_Position = transformationProjectionMatrix*position;
+    #else
+    gl_Position = transformationProjectionMatrix*instancedTransformationMatrix*position;
+    #endif
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
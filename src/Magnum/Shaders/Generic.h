@@ -89,6 +89,16 @@ template<UnsignedInt dimensions> struct Generic {
         CORRADE_DEPRECATED("use Color(Components, DataType, DataOptions) instead") constexpr explicit Color(DataType dataType = DataType::Float, DataOptions dataOptions = {});
         #endif
     };
+
+    /**
+     * @brief Per-instance transformation matrix
+     *
+     * @ref Matrix3 in 2D and @ref Matrix4 in 3D, occupying three or four
+     * consecutive locations. Used only by shaders with instanced
+     * transformation enabled, such as @ref Flat::Flag::InstancedTransformation
+     * or @ref Phong::Flag::InstancedTransformation.
+     */
+    typedef GL::Attribute<4, T> TransformationMatrix;
 };
 #endif
 
@@ -113,11 +123,13 @@ struct BaseGeneric {
 
 template<> struct Generic<2>: BaseGeneric {
     typedef GL::Attribute<0, Vector2> Position;
+    typedef GL::Attribute<4, Matrix3> TransformationMatrix;
 };
 
 template<> struct Generic<3>: BaseGeneric {
     typedef GL::Attribute<0, Vector3> Position;
     typedef GL::Attribute<2, Vector3> Normal;
+    typedef GL::Attribute<4, Matrix4> TransformationMatrix;
 };
 #endif
 
@@ -61,7 +61,9 @@ Phong::Phong(const Flags flags): _flags(flags) {
     GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
-    vert.addSource(flags ? "#define TEXTURED\n" : "")
+    const bool textured = bool(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture));
+    vert.addSource(textured ? "#define TEXTURED\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
         .addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.vert"));
     frag.addSource(flags & Flag::AmbientTexture ? "#define AMBIENT_TEXTURE\n" : "")
@@ -81,7 +83,8 @@ Phong::Phong(const Flags flags): _flags(flags) {
     {
         bindAttributeLocation(Position::Location, "position");
         bindAttributeLocation(Normal::Location, "normal");
-        if(flags) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+        if(textured) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+        if(flags & Flag::InstancedTransformation) bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
     }
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(link());
@@ -102,7 +105,7 @@ Phong::Phong(const Flags flags): _flags(flags) {
     }
 
     #ifndef MAGNUM_TARGET_GLES
-    if(flags && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    if(textured && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
     #endif
     {
         if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureLayer);
@@ -122,6 +125,13 @@ Phong::Phong(const Flags flags): _flags(flags) {
     setLightColor(Color4{1.0f});
     setShininess(80.0f);
     #endif
+
+    /* The uniform transformation is applied after the instanced one, default
+       it to identity so it can be left unset */
+    if(flags & Flag::InstancedTransformation) {
+        setTransformationMatrix({});
+        setNormalMatrix({});
+    }
 }
 
 Phong& Phong::bindAmbientTexture(GL::Texture2D& texture) {
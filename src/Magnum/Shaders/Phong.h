@@ -52,6 +52,15 @@ don't forget to also call appropriate subset of @ref bindAmbientTexture(),
 @ref bindTextures()). The texture is multipled by the color, which is by
 default set to fully opaque white for enabled textures.
 
+If you pass @ref Flag::InstancedTransformation to the constructor, the shader
+takes also a per-instance @ref TransformationMatrix attribute, applied before
+the matrix set via @ref setTransformationMatrix(). The per-instance normal
+matrix is derived from its upper-left 3x3 part, which is correct only for
+rotations and uniform scaling. That allows drawing many copies of the same
+mesh in a single instanced draw call, for example from
+@ref SceneGraph::InstancedDrawableBatch::draw() with camera-relative
+transformations in the instance buffer.
+
 @image html shaders-phong.png
 
 @section Shaders-Phong-usage Example usage
@@ -113,6 +122,15 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          */
         typedef Generic3D::TextureCoordinates TextureCoordinates;
 
+        /**
+         * @brief Per-instance transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix4. Used only
+         * if @ref Flag::InstancedTransformation is set, expected to be added
+         * to the mesh using @ref GL::Mesh::addVertexBufferInstanced().
+         */
+        typedef Generic3D::TransformationMatrix TransformationMatrix;
+
         /**
          * @brief Flag
          *
@@ -121,7 +139,22 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
         enum class Flag: UnsignedByte {
             AmbientTexture = 1 << 0,    /**< The shader uses ambient texture instead of color */
             DiffuseTexture = 1 << 1,    /**< The shader uses diffuse texture instead of color */
-            SpecularTexture = 1 << 2    /**< The shader uses specular texture instead of color */
+            SpecularTexture = 1 << 2,   /**< The shader uses specular texture instead of color */
+
+            /**
+             * The shader takes a per-instance @ref TransformationMatrix
+             * attribute, which is applied before the
+             * @ref setTransformationMatrix() "transformation matrix". The
+             * transformation and normal matrix are set to identity by
+             * default.
+             * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+             *      @gl_extension{EXT,instanced_arrays} or
+             *      @gl_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+             *      in WebGL 1.0.
+             */
+            InstancedTransformation = 1 << 3
         };
 
         /**
@@ -285,6 +318,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
         /**
          * @brief Set transformation matrix
          * @return Reference to self (for method chaining)
+         *
+         * If @ref Flag::InstancedTransformation is set, the matrix is applied
+         * after the per-instance @ref TransformationMatrix and defaults to
+         * an identity.
          */
         Phong& setTransformationMatrix(const Matrix4& matrix) {
             setUniform(_transformationMatrixUniform, matrix);
@@ -296,7 +333,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @return Reference to self (for method chaining)
          *
          * The matrix doesn't need to be normalized, as the renormalization
-         * must be done in the shader anyway.
+         * must be done in the shader anyway. If
+         * @ref Flag::InstancedTransformation is set, the matrix is applied
+         * after the per-instance normal matrix and defaults to an identity.
          */
         Phong& setNormalMatrix(const Matrix3x3& matrix) {
             setUniform(_normalMatrixUniform, matrix);
@@ -67,17 +67,30 @@ in mediump vec2 textureCoords;
 out mediump vec2 interpolatedTextureCoords;
 #endif
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
 out mediump vec3 transformedNormal;
 out highp vec3 lightDirection;
 out highp vec3 cameraDirection;
 
 void main() {
-    /* Transformed vertex position */
+    /* Transformed vertex position and normal vector. The per-instance normal
+       matrix is the upper-left part of the per-instance transformation, which
+       is enough for rotation and uniform scaling as the normal gets
+       renormalized in the fragment shader anyway. */
+    #ifndef INSTANCED_TRANSFORMATION
     highp vec4 transformedPosition4 = transformationMatrix*position;
-    highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
-
-    /* Transformed normal vector */
     transformedNormal = normalMatrix*normal;
+    #else
+    highp vec4 transformedPosition4 = transformationMatrix*instancedTransformationMatrix*position;
+    transformedNormal = normalMatrix*(mat3(instancedTransformationMatrix[0].xyz, instancedTransformationMatrix[1].xyz, instancedTransformationMatrix[2].xyz)*normal);
+    #endif
+    highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
 
     /* Direction to the light */
     lightDirection = normalize(light - transformedPosition);
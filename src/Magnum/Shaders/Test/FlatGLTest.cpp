@@ -35,13 +35,17 @@ struct FlatGLTest: GL::OpenGLTester {
     void compile3D();
     void compile2DTextured();
     void compile3DTextured();
+    void compile2DInstancedTransformation();
+    void compile3DInstancedTransformation();
 };
 
 FlatGLTest::FlatGLTest() {
     addTests({&FlatGLTest::compile2D,
               &FlatGLTest::compile3D,
               &FlatGLTest::compile2DTextured,
-              &FlatGLTest::compile3DTextured});
+              &FlatGLTest::compile3DTextured,
+              &FlatGLTest::compile2DInstancedTransformation,
+              &FlatGLTest::compile3DInstancedTransformation});
 }
 
 void FlatGLTest::compile2D() {
@@ -84,6 +88,26 @@ void FlatGLTest::compile3DTextured() {
     }
 }
 
+void FlatGLTest::compile2DInstancedTransformation() {
+    Shaders::Flat2D shader(Shaders::Flat2D::Flag::InstancedTransformation);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DInstancedTransformation() {
+    Shaders::Flat3D shader(Shaders::Flat3D::Flag::Textured|Shaders::Flat3D::Flag::InstancedTransformation);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::FlatGLTest)
@@ -39,6 +39,8 @@ struct PhongGLTest: GL::OpenGLTester {
     void compileAmbientSpecularTexture();
     void compileDiffuseSpecularTexture();
     void compileAmbientDiffuseSpecularTexture();
+    void compileInstancedTransformation();
+    void compileDiffuseTextureInstancedTransformation();
 };
 
 PhongGLTest::PhongGLTest() {
@@ -49,7 +51,9 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::compileAmbientDiffuseTexture,
               &PhongGLTest::compileAmbientSpecularTexture,
               &PhongGLTest::compileDiffuseSpecularTexture,
-              &PhongGLTest::compileAmbientDiffuseSpecularTexture});
+              &PhongGLTest::compileAmbientDiffuseSpecularTexture,
+              &PhongGLTest::compileInstancedTransformation,
+              &PhongGLTest::compileDiffuseTextureInstancedTransformation});
 }
 
 void PhongGLTest::compile() {
@@ -132,6 +136,26 @@ void PhongGLTest::compileAmbientDiffuseSpecularTexture() {
     }
 }
 
+void PhongGLTest::compileInstancedTransformation() {
+    Shaders::Phong shader(Shaders::Phong::Flag::InstancedTransformation);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileDiffuseTextureInstancedTransformation() {
+    Shaders::Phong shader(Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::InstancedTransformation);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::PhongGLTest)
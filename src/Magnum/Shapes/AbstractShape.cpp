@@ -27,6 +27,7 @@
 
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/SceneGraph/parallelImplementation.h"
 #include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/ShapeGroup.h"
 #include "Magnum/Shapes/Implementation/CollisionDispatch.h"
@@ -58,7 +59,15 @@ template<UnsignedInt dimensions> Collision<dimensions> AbstractShape<dimensions>
 }
 
 template<UnsignedInt dimensions> void AbstractShape<dimensions>::markDirty() {
-    if(group()) group()->setDirty();
+    if(!group()) return;
+
+    /* The group is shared with other shapes, if the object is transformed
+       from SceneGraph::AnimableGroup::step() on multiple threads, it's marked
+       after all threads finish */
+    if(SceneGraph::Implementation::deferShared([](void* group) {
+        static_cast<ShapeGroup<dimensions>*>(group)->setDirty();
+    }, group())) return;
+    group()->setDirty();
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -32,12 +32,11 @@ namespace Magnum { namespace Shapes {
 template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
     /* Clean all objects */
     if(!this->isEmpty()) {
-        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
-        objects.reserve(this->size());
+        _objects.clear();
         for(std::size_t i = 0; i != this->size(); ++i)
-            objects.push_back((*this)[i].object());
+            _objects.push_back((*this)[i].object());
 
-        SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+        SceneGraph::AbstractObject<dimensions, Float>::setClean(_objects);
     }
 
     dirty = false;
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Shapes::ShapeGroup, typedef @ref Magnum::Shapes::ShapeGroup2D, @ref Magnum::Shapes::ShapeGroup3D
  */
 
+#include <functional>
 #include <vector>
 
 #include "Magnum/SceneGraph/FeatureGroup.h"
@@ -89,6 +90,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
 
     private:
         bool dirty;
+        /* Reused by setClean() to avoid allocations on every call */
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _objects;
 };
 
 /**
@@ -0,0 +1,134 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shapes/Shape.h"
+#include "Magnum/Shapes/ShapeGroup.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace {
+    /* Incremented on every heap allocation in the whole executable */
+    std::size_t allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if(void* const data = std::malloc(size ? size : 1)) return data;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* data) noexcept {
+    std::free(data);
+}
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+/* Verifies that the per-frame collision detection doesn't allocate once the
+   memory reused across frames is large enough */
+struct FrameAllocationTest: TestSuite::Tester {
+    explicit FrameAllocationTest();
+
+    void shapeGroupSetClean();
+    void shapeGroupFirstCollision();
+};
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+FrameAllocationTest::FrameAllocationTest() {
+    addTests({&FrameAllocationTest::shapeGroupSetClean,
+              &FrameAllocationTest::shapeGroupFirstCollision});
+}
+
+namespace {
+
+/* Calls the function three times to let the reused memory grow, then returns
+   count of allocations done by the fourth call */
+template<class F> std::size_t frameAllocations(F f) {
+    for(std::size_t i = 0; i != 3; ++i) f();
+
+    const std::size_t count = allocationCount;
+    f();
+    return allocationCount - count;
+}
+
+/* Three levels of objects, four children each, with a sphere shape on every
+   object */
+void populate(Object3D& parent, ShapeGroup3D& group, std::vector<std::reference_wrapper<Object3D>>& objects, Int level = 0) {
+    for(Int i = 0; i != 4; ++i) {
+        Object3D* object = new Object3D{&parent};
+        object->translate({Float(i)*3.0f, Float(level)*3.0f, 0.0f});
+        new Shape<Sphere3D>{*object, {{}, 1.0f}, &group};
+        objects.push_back(*object);
+        if(level != 2) populate(*object, group, objects, level + 1);
+    }
+}
+
+}
+
+void FrameAllocationTest::shapeGroupSetClean() {
+    Scene3D scene;
+    ShapeGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    populate(scene, group, objects);
+
+    Object3D& root = objects.front();
+    const std::size_t allocations = frameAllocations([&]{
+        root.translate(Vector3::zAxis(1.0f));
+        CORRADE_VERIFY(group.isDirty());
+        group.setClean();
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_VERIFY(!group.isDirty());
+    CORRADE_VERIFY(!objects.back().get().isDirty());
+}
+
+void FrameAllocationTest::shapeGroupFirstCollision() {
+    Scene3D scene;
+    ShapeGroup3D group;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    populate(scene, group, objects);
+
+    /* Moving back and forth between the shapes so there's a collision every
+       other frame */
+    Object3D player{&scene};
+    Shape<Sphere3D> playerShape{player, {{}, 0.25f}, &group};
+    std::size_t collisionCount = 0;
+    const std::size_t allocations = frameAllocations([&]{
+        player.translate(Vector3::xAxis(1.5f));
+        if(group.firstCollision(playerShape)) ++collisionCount;
+    });
+    CORRADE_COMPARE(allocations, 0);
+    CORRADE_COMPARE(collisionCount, 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::FrameAllocationTest)